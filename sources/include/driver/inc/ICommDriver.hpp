@@ -45,6 +45,7 @@ class ICommDriver
             ReadMode mode = ReadMode::Exact;           ///< Operation mode
             uint8_t delimiter = '\n';                  ///< Delimiter for UntilDelimiter mode
             std::span<const uint8_t> token = {};       ///< Token for UntilToken mode
+            std::span<const int> token_lps = {};       ///< KMP failure table of token (optional, built by the driver if empty)
             bool use_buffer = true;                    ///< Enable internal buffering for token search
         };
 
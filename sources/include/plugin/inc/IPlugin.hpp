@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <string>
+#include <cstddef>
 
 
 ///////////////////////////////////////////////////////////////////
@@ -62,6 +63,19 @@ public:
     /** < interface used to get the privileged status (if can access the caller's structures) */
     virtual bool isPrivileged ( void ) const = 0;
 
+    /** < value returned by resolveCommand when id based dispatch is not available */
+    static constexpr size_t kInvalidCommandId = static_cast<size_t>(-1);
+
+    /** < optional: resolve a command name once to an id accepted by doDispatchById */
+    virtual size_t resolveCommand ( const std::string& strCmd ) const { (void)strCmd; return kInvalidCommandId; }
+
+    /** < optional: dispatch a command pre-resolved by resolveCommand (no name lookup) */
+    virtual bool doDispatchById ( size_t szCmdId, const std::string& strParams ) const { (void)szCmdId; (void)strParams; return false; }
+
+    /** < optional: doInit / doEnable may run concurrently with those of other plugins
+          (no shared library state, no access to the caller) */
+    virtual bool isConcurrentInitSafe ( void ) const { return false; }
+
 };
 
 
@@ -13,6 +13,7 @@
 // forward declaration
 class  PluginInterface;
 struct LogBuffer;
+namespace utrace { class TraceSession; }
 
 // definition of pointer to plugin interface
 using PluginInterfacePtr = std::shared_ptr<PluginInterface>;
@@ -26,6 +27,7 @@ using PluginInterfacePtr = std::shared_ptr<PluginInterface>;
 // information to be set to a plugin
 struct PluginDataSet {
     std::shared_ptr<LogBuffer>  shpLogger;
+    std::shared_ptr<utrace::TraceSession> shpTracer;   // nullptr: tracing not configured
     std::unordered_map<std::string, std::string> mapSettings;
 
 };
@@ -0,0 +1,22 @@
+#ifndef ISCRIPTCACHE_HPP
+#define ISCRIPTCACHE_HPP
+
+
+template <typename TScriptEntries>
+class IScriptCache
+{
+public:
+
+    IScriptCache() = default;
+    virtual ~IScriptCache() = default;
+
+    // true: sScriptEntries was filled from a cache entry that is still valid,
+    // reading and validation can be skipped
+    virtual bool loadScript(TScriptEntries& sScriptEntries) = 0;
+
+    // called after a successful dry run of freshly validated entries
+    virtual bool storeScript(const TScriptEntries& sScriptEntries) = 0;
+
+};
+
+#endif // ISCRIPTCACHE_HPP
@@ -36,6 +36,8 @@ int main(int argc, char const *argv[])
         CommandLineParser cli("Script execution tool");
         cli.add_option("script", "s", "script pathname", false, SCRIPT_DEFAULT);
         cli.add_option("inicfg", "c", "ini config pathname", false, SCRIPT_INI_CONFIG);
+        cli.add_option("profile", "p", "profile the execution, report pathname without extension", false);
+        cli.add_option("trace", "t", "record a timeline of the execution, Chrome trace (JSON) pathname", false);
         
         // Parse returns a result object with success status and error details
         auto result = cli.parse(argc, argv);
@@ -50,6 +52,8 @@ int main(int argc, char const *argv[])
         // Use get_or() for cleaner code with defaults
         std::string scriptPathName = cli.get_or("script", SCRIPT_DEFAULT);
         std::string iniPathName = cli.get_or("inicfg", SCRIPT_INI_CONFIG);
+        std::string profilePathName = cli.get_or("profile", "");
+        std::string tracePathName = cli.get_or("trace", "");
 
         IniCfgLoader iniLoader;
         if (iniLoader.load(iniPathName)) {
@@ -57,27 +61,69 @@ int main(int argc, char const *argv[])
                 size_t szLogSeverityConsole = static_cast<size_t>(LOGGER_DEFAULT_CONSOLE_SEVERITY);
                 size_t szLogSeverityFile    = static_cast<size_t>(LOGGER_DEFAULT_LOGFILE_SEVERITY);
                 bool   bLogIncludeDate      = true;
+                bool   bLogRelativeTime     = LOGGER_DEFAULT_RELATIVE_TIME;
                 bool   bLogColoredConsole   = true;
                 bool   bLog2FileEnabled     = true;
+                bool   bLogAsync            = false;
+                size_t szLogAsyncQueue      = LOGGER_DEFAULT_ASYNC_QUEUE;
+                size_t szLogAsyncFlushMs    = LOGGER_DEFAULT_ASYNC_FLUSH_MS;
+                bool   bLogAsyncCrashFlush  = false;
+                std::string strLogOverflow  = "BLOCK";
+                bool   bLogBinary           = false;
+                size_t szLogBinarySizeMb    = LOGGER_DEFAULT_BINARY_SIZE / (1024U * 1024U);
+                size_t szLogSeverityBinary  = static_cast<size_t>(LOGGER_DEFAULT_BINARY_SEVERITY);
+                std::string strLogBinaryFile = SCRIPT_LOG_BINARY_FILE_DEFAULT;
 
                 iniLoader.getNumFromIni (SCRIPT_INI_LOG_SEVERITY_CONSOLE, szLogSeverityConsole);
                 iniLoader.getNumFromIni (SCRIPT_INI_LOG_SEVERITY_FILE,    szLogSeverityFile);
                 iniLoader.getBoolFromIni(SCRIPT_INI_INCLUDE_DATE,         bLogIncludeDate);
+                iniLoader.getBoolFromIni(SCRIPT_INI_LOG_RELATIVE_TIME,    bLogRelativeTime);
                 iniLoader.getBoolFromIni(SCRIPT_INI_LOG_CONSOLE_COLORED,  bLogColoredConsole);
                 iniLoader.getBoolFromIni(SCRIPT_INI_ENABLE_LOG_TO_FILE,   bLog2FileEnabled);
+                iniLoader.getBoolFromIni(SCRIPT_INI_LOG_ASYNC,            bLogAsync);
+                iniLoader.getNumFromIni (SCRIPT_INI_LOG_ASYNC_QUEUE,      szLogAsyncQueue);
+                iniLoader.getNumFromIni (SCRIPT_INI_LOG_ASYNC_FLUSH_MS,   szLogAsyncFlushMs);
+                iniLoader.getStringFromIni(SCRIPT_INI_LOG_ASYNC_OVERFLOW, strLogOverflow);
+                iniLoader.getBoolFromIni(SCRIPT_INI_LOG_ASYNC_CRASH_FLUSH, bLogAsyncCrashFlush);
+                iniLoader.getBoolFromIni(SCRIPT_INI_LOG_BINARY,           bLogBinary);
+                iniLoader.getNumFromIni (SCRIPT_INI_LOG_BINARY_SIZE_MB,   szLogBinarySizeMb);
+                iniLoader.getNumFromIni (SCRIPT_INI_LOG_SEVERITY_BINARY,  szLogSeverityBinary);
+                iniLoader.getStringFromIni(SCRIPT_INI_LOG_BINARY_FILE,    strLogBinaryFile);
 
                 LOG_INIT(sizet2loglevel(szLogSeverityConsole).value_or(LOGGER_DEFAULT_CONSOLE_SEVERITY),
                          sizet2loglevel(szLogSeverityFile   ).value_or(LOGGER_DEFAULT_LOGFILE_SEVERITY),
                          bLog2FileEnabled,
                          bLogColoredConsole,
                          bLogIncludeDate);
+                log_local->setRelativeTime(bLogRelativeTime);
+
+                if (bLogAsync) {
+                    const auto overflow = string2logoverflow(strLogOverflow);
+                    if (!overflow) {
+                        LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Unknown"); LOG_STRING(SCRIPT_INI_LOG_ASYNC_OVERFLOW);
+                                  LOG_STRING(strLogOverflow); LOG_STRING("using BLOCK"));
+                    }
+                    if (!LOG_ASYNC_START(szLogAsyncQueue, overflow.value_or(LogOverflow::BLOCK), szLogAsyncFlushMs)) {
+                        LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Async logging not available, logging synchronously"));
+                    }
+                    if (bLogAsyncCrashFlush && !LOG_ASYNC_CRASH_FLUSH()) {
+                        LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Cannot enable"); LOG_STRING(SCRIPT_INI_LOG_ASYNC_CRASH_FLUSH));
+                    }
+                }
+
+                if (bLogBinary) {
+                    if (!LOG_BINARY_START(strLogBinaryFile, szLogBinarySizeMb * 1024U * 1024U,
+                                          sizet2loglevel(szLogSeverityBinary).value_or(LOGGER_DEFAULT_BINARY_SEVERITY))) {
+                        LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Cannot create the binary log"); LOG_STRING(strLogBinaryFile));
+                    }
+                }
             }  
         }
 
         LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING("Script: ["); LOG_STRING(scriptPathName); LOG_STRING("]"));
         LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING("Config: ["); LOG_STRING(iniPathName); LOG_STRING("]"));
 
-        ScriptClient client(scriptPathName, std::move(iniLoader));
+        ScriptClient client(scriptPathName, std::move(iniLoader), profilePathName, tracePathName);
         
         // dry execution for command validation
         if (client.execute(false)) {
@@ -87,5 +133,7 @@ int main(int argc, char const *argv[])
 
     } while(false);
 
+    LOG_DEINIT();
+
     return (true == bRetVal) ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+/**
+ * @file    Bench_BytecodeDispatch.cpp
+ * @brief   Plugin command throughput: IR interpreter vs. bytecode backend
+ *
+ * Runs the same generated script (a REPEAT loop of NOOP.NOP commands) once
+ * with BYTECODE_EXEC = FALSE and once with BYTECODE_EXEC = TRUE and reports
+ * the real-execution time per plugin command.
+ *
+ * Build with -DUSCRIPT_BUILD_BENCHMARKS=ON and run:
+ *     bench_bytecode_dispatch [iterations]
+ */
+
+#include "uScriptClient.hpp"
+#include "uIniCfgLoader.hpp"
+#include "uLogger.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+///////////////////////////////////////////////////////////////////
+//                       FIXTURE                                 //
+///////////////////////////////////////////////////////////////////
+
+static constexpr size_t kCommandsPerIteration = 4U;
+
+static bool writeScript(const std::string& strPath, size_t szIterations)
+{
+    std::ofstream ofs(strPath);
+    ofs << "LOAD_PLUGIN NOOP\n"
+        << "REPEAT body " << szIterations << "\n"
+        << "NOOP.NOP\n"
+        << "NOOP.NOP 0x4000 16\n"
+        << "v ?= NOOP.NOP 1\n"
+        << "NOOP.NOP $v\n"
+        << "END_REPEAT body\n";
+    return ofs.good();
+}
+
+static bool writeIni(const std::string& strPath, bool bBytecode)
+{
+    std::ofstream ofs(strPath);
+    ofs << "[SCRIPT]\n"
+        << "CMD_EXEC_DELAY = 0\n"
+        << "BYTECODE_EXEC  = " << (bBytecode ? "TRUE" : "FALSE") << "\n"
+        << "[NOOP]\n"
+        << "FAULT_TOLERANT = FALSE\n";
+    return ofs.good();
+}
+
+
+///////////////////////////////////////////////////////////////////
+//                         DRIVER                                //
+///////////////////////////////////////////////////////////////////
+
+// returns the real-execution time in ns, or a negative value on failure
+static double runOnce(const std::string& strScript, bool bBytecode)
+{
+    const std::string strIni = bBytecode ? "bench_dispatch_bc.ini" : "bench_dispatch_ir.ini";
+    if (false == writeIni(strIni, bBytecode)) {
+        return -1.0;
+    }
+
+    IniCfgLoader iniLoader;
+    if (false == iniLoader.load(strIni)) {
+        return -1.0;
+    }
+
+    ScriptClient client(strScript, std::move(iniLoader));
+    if (false == client.execute(false)) {
+        return -1.0;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    const bool bOk = client.execute(true);
+    auto t1 = std::chrono::steady_clock::now();
+
+    return bOk ? std::chrono::duration<double, std::nano>(t1 - t0).count() : -1.0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    const size_t szIterations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 20000U;
+
+    // the interpreter loads plugins from "plugins/" relative to the working directory
+    std::filesystem::current_path(BENCH_WORK_DIR);
+
+    // keep the console quiet; only failures are reported
+    LOG_INIT(LOG_ERROR, LOG_ERROR, false, false, false);
+
+    const std::string strScript = "bench_dispatch.txt";
+    if (false == writeScript(strScript, szIterations)) {
+        std::cerr << "cannot write " << strScript << "\n";
+        return EXIT_FAILURE;
+    }
+
+    const double dIrNs = runOnce(strScript, false);
+    const double dBcNs = runOnce(strScript, true);
+    if ((dIrNs < 0.0) || (dBcNs < 0.0)) {
+        std::cerr << "script execution failed\n";
+        return EXIT_FAILURE;
+    }
+
+    const double dCommands = static_cast<double>(szIterations * kCommandsPerIteration);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "plugin commands: " << static_cast<size_t>(dCommands) << "\n"
+              << "IR interpreter : " << (dIrNs / dCommands) << " ns/command\n"
+              << "bytecode       : " << (dBcNs / dCommands) << " ns/command\n"
+              << "speedup        : " << (dIrNs / dBcNs) << "x\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file    NoopPlugin.cpp
+ * @brief   Plugin whose NOP command does nothing — isolates the interpreter
+ *          dispatch cost in bench_bytecode_dispatch
+ */
+
+#include "uSharedConfig.hpp"
+#include "IPlugin.hpp"
+#include "IPluginDataTypes.hpp"
+#include "PluginOperations.hpp"
+#include "PluginExport.hpp"
+#include "uLogger.hpp"
+
+#include <string>
+
+#ifdef LT_HDR
+    #undef LT_HDR
+#endif
+#ifdef LOG_HDR
+    #undef LOG_HDR
+#endif
+#define LT_HDR     "NOOP        |"
+#define LOG_HDR    LOG_STRING(LT_HDR)
+
+
+class NoopPlugin : public PluginInterface
+{
+public:
+
+    NoopPlugin() : m_strVersion("1.0.0.0")
+    {
+        m_mapCmds.insert(std::make_pair("NOP", &NoopPlugin::m_Noop_NOP));
+        generic_build_table<NoopPlugin>(m_mapCmds, m_vCmds);
+    }
+
+    bool isInitialized( void ) const                { return m_bIsInitialized; }
+    bool isEnabled( void ) const                    { return m_bIsEnabled; }
+    bool setParams( const PluginDataSet *psSetParams )
+    {
+        return generic_setparams<NoopPlugin>(this, psSetParams, &m_bIsFaultTolerant, &m_bIsPrivileged);
+    }
+    void getParams( PluginDataGet *psGetParams ) const
+    {
+        generic_getparams<NoopPlugin>(this, psGetParams);
+    }
+    bool doDispatch( const std::string& strCmd, const std::string& strParams ) const
+    {
+        return generic_dispatch<NoopPlugin>(this, strCmd, strParams);
+    }
+    size_t resolveCommand( const std::string& strCmd ) const
+    {
+        return generic_resolve_command<NoopPlugin>(this, strCmd);
+    }
+    bool doDispatchById( size_t szCmdId, const std::string& strParams ) const
+    {
+        return generic_dispatch_by_id<NoopPlugin>(this, szCmdId, strParams);
+    }
+    const PluginCommandsMap<NoopPlugin> *getMap( void ) const { return &m_mapCmds; }
+    const PluginCommandsTable<NoopPlugin> *getTable( void ) const { return &m_vCmds; }
+    const std::string& getVersion( void ) const     { return m_strVersion; }
+    const std::string& getData( void ) const        { return m_strResultData; }
+    void resetData( void ) const                    { m_strResultData.clear(); }
+    bool doInit( void * )                           { m_bIsInitialized = true; return true; }
+    bool doEnable( void )                           { m_bIsEnabled = true; return true; }
+    void doCleanup( void )                          { m_bIsInitialized = false; m_bIsEnabled = false; }
+    bool isFaultTolerant( void ) const              { return m_bIsFaultTolerant; }
+    bool isPrivileged( void ) const                 { return m_bIsPrivileged; }
+
+private:
+
+    bool m_Noop_NOP( const std::string &args ) const
+    {
+        m_strResultData = args;
+        return true;
+    }
+
+    PluginCommandsMap<NoopPlugin> m_mapCmds;
+    PluginCommandsTable<NoopPlugin> m_vCmds;
+    std::string m_strVersion;
+    mutable std::string m_strResultData;
+    bool m_bIsInitialized   = false;
+    bool m_bIsEnabled       = false;
+    bool m_bIsFaultTolerant = false;
+    bool m_bIsPrivileged    = false;
+};
+
+
+extern "C"
+{
+    EXPORTED NoopPlugin* pluginEntry()
+    {
+        return new NoopPlugin();
+    }
+
+    EXPORTED void pluginExit( NoopPlugin *ptrPlugin )
+    {
+        delete ptrPlugin;
+    }
+}
@@ -0,0 +1,149 @@
+/**
+ * @file    Bench_CommScriptCache.cpp
+ * @brief   Loading a comm script repeatedly, as a UART.SCRIPT in a REPEAT loop does:
+ *          read + validate every time vs. a lookup in the CommScriptCache of uCommScriptCache.hpp
+ *
+ * The entries loaded from the cache are first checked against the ones of a fresh
+ * validation, then the script is modified and the cache must miss; the benchmark
+ * fails if either check does not hold.
+ *
+ * Build with -DUSCRIPT_BUILD_BENCHMARKS=ON and run:
+ *     bench_comm_script_cache [script lines] [loads]
+ */
+
+#include "uCommScriptCache.hpp"
+#include "uCommScriptCommandValidator.hpp"
+#include "uCommScriptValidator.hpp"
+#include "uScriptReader.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////
+//                      GENERATED SCRIPT                         //
+///////////////////////////////////////////////////////////////////
+
+// the kinds of lines found in device bring-up scripts
+static void writeScript(const std::string& strPath, size_t szLines, const char *pstrTail)
+{
+    std::ofstream file(strPath, std::ios::trunc);
+    file << "USER := root\n"
+         << "ACK  := 79\n";
+
+    for (size_t i = 0; i < szLines; ++i) {
+        switch (i % 6) {
+            case 0:  file << "> \"AT+CSQ\\r\\n\" | R\"\\+CSQ: \\d+,\\d+\\r\\n\\r\\nOK\\r\\n\"\n"; break;
+            case 1:  file << "> \"cat /proc/version\\n\" | R\".*Linux version [0-9]+\\.[0-9]+.*\"\n"; break;
+            case 2:  file << "> H\"7F00" << std::setw(4) << std::setfill('0') << std::hex << i << std::dec << "\" | H\"$ACK\"\n"; break;
+            case 3:  file << "< T\"login: \" | \"$USER\\n\"\n"; break;
+            case 4:  file << "> \"uname -a\\n\" | X\"23200A\"\n"; break;
+            default: file << "! 1 ms\n"; break;
+        }
+    }
+    file << pstrTail;
+}
+
+static bool loadUncached(const std::string& strPath, CommCommandsType& sEntries)
+{
+    std::vector<ScriptRawLine> vLines;
+    CommScriptValidator validator(std::make_shared<CommScriptCommandValidator>());
+    sEntries = CommCommandsType{};
+    return ScriptReader(strPath).readScript(vLines) && validator.validateScript(vLines, sEntries);
+}
+
+static bool sameEntries(const CommCommandsType& a, const CommCommandsType& b)
+{
+    if ((a.vCommands.size() != b.vCommands.size()) || (a.mapMacros != b.mapMacros)) {
+        return false;
+    }
+    for (size_t i = 0; i < a.vCommands.size(); ++i) {
+        const CommCommand& x = a.vCommands[i];
+        const CommCommand& y = b.vCommands[i];
+        if ((x.direction != y.direction) || (x.values != y.values) || (x.tokens != y.tokens) ||
+            (x.payloads.first.vData != y.payloads.first.vData) || (x.payloads.second.vData != y.payloads.second.vData)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////
+//                         DRIVER                                //
+///////////////////////////////////////////////////////////////////
+
+// script loads per second
+template <typename TWork>
+static double loadsPerSecond(size_t szLoads, TWork&& work)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto t0 = clock::now();
+    for (size_t n = 0; n < szLoads; ++n) {
+        work();
+    }
+    auto t1 = clock::now();
+
+    return static_cast<double>(szLoads) / std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t szLines = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 300U;
+    const size_t szLoads = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 200U;
+
+    const std::string strPath = (std::filesystem::temp_directory_path() / "bench_comm_script_cache.txt").string();
+    writeScript(strPath, szLines, "");
+
+    LOG_INIT(LOG_ERROR, LOG_ERROR, false, false, false);
+
+    // a first load fills the cache
+    CommCommandsType sReference;
+    CommCommandsType sEntries;
+    bool bValid = loadUncached(strPath, sReference);
+    {
+        CommScriptCache cache(strPath);
+        bValid = bValid && !cache.loadScript(sEntries) && cache.storeScript(sReference);
+    }
+
+    const double dUncached = loadsPerSecond(szLoads, [&]() {
+        bValid &= loadUncached(strPath, sEntries);
+    });
+    const double dCached = loadsPerSecond(szLoads, [&]() {
+        CommScriptCache cache(strPath);
+        bValid &= cache.loadScript(sEntries);
+    });
+
+    if (!bValid || !sameEntries(sEntries, sReference)) {
+        std::cerr << "cached entries differ from a fresh validation\n";
+        std::remove(strPath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    // a modified script must be read and validated again
+    writeScript(strPath, szLines, "> \"reboot\\n\"\n");
+    const bool bStale = CommScriptCache(strPath).loadScript(sEntries);
+    std::remove(strPath.c_str());
+    if (bStale) {
+        std::cerr << "modified script loaded from the cache\n";
+        return EXIT_FAILURE;
+    }
+
+    const CommScriptCache::Stats sStats = CommScriptCache::stats();
+    std::cout << "script      : " << (sReference.vCommands.size()) << " commands, " << szLoads << " loads\n"
+              << "cache       : " << sStats.uHits << " hits, " << sStats.uMisses << " misses, " << sStats.uEvictions << " evictions\n"
+              << std::fixed << std::setprecision(0)
+              << "uncached    : " << std::setw(10) << dUncached << " loads/s\n"
+              << "cached      : " << std::setw(10) << dCached << " loads/s\n"
+              << std::setprecision(1)
+              << "speedup     : " << std::setw(10) << (dCached / dUncached) << "x\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file    Bench_FileTransfer.cpp
+ * @brief   F"..." transfers of a firmware-sized image over a simulated link through
+ *          CommScriptCommandInterpreter::sendFile() / receiveToFile() (mmap reader,
+ *          threaded chunk writer), measured against the speed of the link itself
+ *
+ * The link is a driver taking a fixed time per byte, so a transfer whose file I/O
+ * overlaps the device I/O runs close to the link speed. The bytes sent and the
+ * file received are compared with the image, the benchmark fails if either differs.
+ *
+ * Build with -DUSCRIPT_BUILD_BENCHMARKS=ON and run:
+ *     bench_file_transfer [image size in MiB] [link MB/s] [chunk size]
+ */
+
+#include "ICommDriver.hpp"
+#include "uCommScriptCommandValidator.hpp"
+#include "uCommScriptCommandInterpreter.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////
+//                       SIMULATED LINK                          //
+///////////////////////////////////////////////////////////////////
+
+class LinkDriver : public ICommDriver
+{
+    public:
+
+        LinkDriver(const std::vector<uint8_t>& vSource, double dBytesPerSecond)
+            : m_vSource(vSource), m_dBytesPerSecond(dBytesPerSecond)
+        {}
+
+        bool is_open() const override { return true; }
+
+        ReadResult tout_read(uint32_t, std::span<uint8_t> buffer, const ReadOptions&) const override
+        {
+            ReadResult result;
+            const size_t szBytes = std::min(buffer.size(), m_vSource.size() - m_szReadPos);
+            transferTime(szBytes);
+            std::copy_n(m_vSource.begin() + m_szReadPos, szBytes, buffer.begin());
+            m_szReadPos += szBytes;
+            result.bytes_read = szBytes;
+            result.status = (szBytes > 0) ? Status::SUCCESS : Status::READ_TIMEOUT;
+            return result;
+        }
+
+        WriteResult tout_write(uint32_t, std::span<const uint8_t> buffer) const override
+        {
+            transferTime(buffer.size());
+            m_vSent.insert(m_vSent.end(), buffer.begin(), buffer.end());
+            return {Status::SUCCESS, buffer.size()};
+        }
+
+        void rewind() const
+        {
+            m_szReadPos = 0;
+            m_vSent.clear();
+        }
+
+        const std::vector<uint8_t>& sent() const { return m_vSent; }
+
+    private:
+
+        void transferTime(size_t szBytes) const
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double>(static_cast<double>(szBytes) / m_dBytesPerSecond));
+        }
+
+        const std::vector<uint8_t>& m_vSource;
+        double m_dBytesPerSecond;
+        mutable size_t m_szReadPos = 0;
+        mutable std::vector<uint8_t> m_vSent;
+};
+
+///////////////////////////////////////////////////////////////////
+//                         DRIVER                                //
+///////////////////////////////////////////////////////////////////
+
+// megabytes per second of the transfer
+template <typename TWork>
+static double megabytesPerSecond(size_t szBytes, TWork&& work, bool& bValid)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto t0 = clock::now();
+    bValid &= work();
+    auto t1 = clock::now();
+
+    return static_cast<double>(szBytes) / 1e6 / std::chrono::duration<double>(t1 - t0).count();
+}
+
+static bool fileEquals(const std::string& strPath, const std::vector<uint8_t>& vImage)
+{
+    std::ifstream file(strPath, std::ios::binary);
+    const std::vector<uint8_t> vData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return vData == vImage;
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t szImage = ((argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 16U) * 1024U * 1024U;
+    const double dLink   = ((argc > 2) ? std::strtod(argv[2], nullptr) : 40.0) * 1e6;
+    const size_t szChunk = std::max<size_t>((argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 65536U, 1U);
+
+    std::vector<uint8_t> vImage(szImage);
+    std::mt19937 rng(0x5EED);
+    for (auto& uByte : vImage) {
+        uByte = static_cast<uint8_t>(rng());
+    }
+
+    const auto tmp = std::filesystem::temp_directory_path();
+    const std::string strImage = (tmp / "bench_file_transfer_image.bin").string();
+    const std::string strDump  = (tmp / "bench_file_transfer_dump.bin").string();
+    {
+        std::ofstream image(strImage, std::ios::binary);
+        image.write(reinterpret_cast<const char*>(vImage.data()), static_cast<std::streamsize>(vImage.size()));
+        std::ofstream dump(strDump, std::ios::binary);
+        dump << "-"; // the validator expects an existing, non empty file
+    }
+
+    LOG_INIT(LOG_ERROR, LOG_ERROR, false, false, false);
+
+    auto shpDriver = std::make_shared<LinkDriver>(vImage, dLink);
+    CommScriptCommandInterpreter<LinkDriver> interpreter(shpDriver, 4096, 1000);
+    CommScriptCommandValidator validator;
+    CommCommand sSend;
+    CommCommand sReceive;
+    bool bValid = validator.validateCommand(1, "> F\"" + strImage + "," + std::to_string(szChunk) + "\"", sSend) &&
+                  validator.validateCommand(2, "< F\"" + strDump + "," + std::to_string(szImage) + "," + std::to_string(szChunk) + "\"", sReceive);
+
+    double dSend = 0.0, dRecv = 0.0;
+    if (bValid) {
+        shpDriver->rewind();
+        dSend = megabytesPerSecond(szImage, [&]() { return interpreter.interpretCommand(sSend, true); }, bValid);
+        bValid &= (shpDriver->sent() == vImage);
+
+        shpDriver->rewind();
+        dRecv = megabytesPerSecond(szImage, [&]() { return interpreter.interpretCommand(sReceive, true); }, bValid);
+        bValid &= fileEquals(strDump, vImage);
+    }
+
+    std::remove(strImage.c_str());
+    std::remove(strDump.c_str());
+
+    if (!bValid) {
+        std::cerr << "transferred data differs from the image\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "image       : " << (szImage / (1024U * 1024U)) << " MiB, chunks of " << szChunk << " bytes\n"
+              << std::fixed << std::setprecision(1)
+              << "link        : " << (dLink / 1e6) << " MB/s\n"
+              << "send        : " << dSend << " MB/s (" << (100.0 * dSend * 1e6 / dLink) << "% of the link)\n"
+              << "receive     : " << dRecv << " MB/s (" << (100.0 * dRecv * 1e6 / dLink) << "% of the link)\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file    Bench_Hexlify.cpp
+ * @brief   Hex encode / decode / validate throughput of every kernel set of uHexSimd.hpp
+ *          the CPU supports, on a firmware-sized image
+ *
+ * The kernels are checked against a reference by the hex_simd test; here every set must
+ * round trip the image, the benchmark fails otherwise.
+ *
+ * Build with -DUSCRIPT_BUILD_BENCHMARKS=ON and run:
+ *     bench_hexlify [image size in MiB]
+ */
+
+#include "uHexlify.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+using hexutils::simd::Isa;
+using hexutils::simd::Kernels;
+
+///////////////////////////////////////////////////////////////////
+//                         DRIVER                                //
+///////////////////////////////////////////////////////////////////
+
+// megabytes of binary data per second, best of a few rounds
+template <typename TWork>
+static double megabytesPerSecond(size_t szBytes, TWork&& work)
+{
+    using clock = std::chrono::steady_clock;
+    double dBest = 0.0;
+
+    for (int iRound = 0; iRound < 5; ++iRound) {
+        auto t0 = clock::now();
+        work();
+        auto t1 = clock::now();
+        dBest = std::max(dBest, static_cast<double>(szBytes) / 1e6 / std::chrono::duration<double>(t1 - t0).count());
+    }
+
+    return dBest;
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t szImage = ((argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 16U) * 1024U * 1024U;
+
+    std::vector<uint8_t> vImage(szImage);
+    std::mt19937 rng(0x5EED);
+    for (auto& uByte : vImage) {
+        uByte = static_cast<uint8_t>(rng());
+    }
+
+    std::vector<const Kernels*> vKernels;
+    for (Isa isa : {Isa::Scalar, Isa::Sse2, Isa::Avx2, Isa::Neon}) {
+        if (const Kernels *pKernels = hexutils::simd::kernelsFor(isa)) {
+            vKernels.push_back(pKernels);
+        }
+    }
+
+    std::string strHex(2 * szImage, '\0');
+    std::vector<uint8_t> vDecoded(szImage);
+    bool bValid = true;
+
+    std::cout << "image       : " << (szImage / (1024U * 1024U)) << " MiB\n"
+              << "selected    : " << hexutils::simd::kernels().name << "\n"
+              << "kernels       encode MB/s  decode MB/s  validate MB/s\n"
+              << std::fixed << std::setprecision(0);
+
+    for (const Kernels *pKernels : vKernels) {
+        const double dEncode = megabytesPerSecond(szImage, [&]() {
+            pKernels->encode(vImage.data(), szImage, strHex.data(), true);
+        });
+        const double dDecode = megabytesPerSecond(szImage, [&]() {
+            bValid &= pKernels->decode(strHex.data(), szImage, vDecoded.data());
+        });
+        const double dValidate = megabytesPerSecond(szImage, [&]() {
+            bValid &= pKernels->validate(strHex.data(), strHex.size());
+        });
+
+        bValid &= (vDecoded == vImage);
+        std::fill(vDecoded.begin(), vDecoded.end(), uint8_t{0});
+
+        std::cout << std::left << std::setw(12) << pKernels->name << std::right
+                  << std::setw(13) << dEncode << std::setw(13) << dDecode << std::setw(15) << dValidate << "\n";
+    }
+
+    if (!bValid) {
+        std::cerr << "round trip failed\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file    Bench_LogBinary.cpp
+ * @brief   Cost of a logged message: formatted text log file vs. binary log
+ *
+ * Build with -DUSCRIPT_BUILD_BENCHMARKS=ON and run:
+ *     bench_log_binary [iterations]
+ *
+ * Writes bench_log_binary.txt and bench_log_binary.ulb in the working directory.
+ */
+
+#include "uLogger.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#define LT_HDR     "BENCH       |"
+#define LOG_HDR    LOG_STRING(LT_HDR)
+
+int main(int argc, char *argv[])
+{
+    const size_t szIterations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000U;
+
+    const std::string strPlugin  = "SPI";
+    const std::string strCommand = "XFER";
+    const std::string strParams  = "0x9F 3";
+
+    using clock = std::chrono::steady_clock;
+
+    // text: every message formatted and written to the log file, console off
+    LOG_INIT(LOG_FIXED, LOG_VERBOSE, false, false, false);
+    log_local->enableFileLogging("bench_log_binary.txt");
+
+    auto t0 = clock::now();
+    for (size_t n = 0; n < szIterations; ++n) {
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("0042:"); LOG_STRING(strPlugin + "." + strCommand);
+                  LOG_STRING(strParams); LOG_HEX8(n); LOG_UINT32(n));
+    }
+    auto t1 = clock::now();
+
+    // binary: the same messages, only the raw arguments are written
+    LOG_DEINIT();
+    const size_t szBytes = szIterations * 128U + (1024U * 1024U);
+    if (!LOG_BINARY_START("bench_log_binary.ulb", szBytes, LOG_VERBOSE)) {
+        std::cerr << "cannot create bench_log_binary.ulb\n";
+        return EXIT_FAILURE;
+    }
+
+    auto t2 = clock::now();
+    for (size_t n = 0; n < szIterations; ++n) {
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("0042:"); LOG_STRING(strPlugin + "." + strCommand);
+                  LOG_STRING(strParams); LOG_HEX8(n); LOG_UINT32(n));
+    }
+    auto t3 = clock::now();
+    LOG_DEINIT();
+
+    const double dCalls  = static_cast<double>(szIterations);
+    const double dTextNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / dCalls;
+    const double dBinNs  = std::chrono::duration<double, std::nano>(t3 - t2).count() / dCalls;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "messages       : " << szIterations << "\n"
+              << "text log file  : " << dTextNs << " ns/message\n"
+              << "binary log     : " << dBinNs  << " ns/message\n"
+              << "speedup        : " << (dTextNs / ((dBinNs > 0.0) ? dBinNs : 1e-3)) << "x\n";
+
+    return EXIT_SUCCESS;
+}
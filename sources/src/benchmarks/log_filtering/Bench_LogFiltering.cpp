@@ -0,0 +1,66 @@
+/**
+ * @file    Bench_LogFiltering.cpp
+ * @brief   Cost of a filtered log message: level-gated LOG_PRINT vs. building its
+ *          arguments alone, the least a format-then-filter logger pays
+ *
+ * Build with -DUSCRIPT_BUILD_BENCHMARKS=ON and run:
+ *     bench_log_filtering [iterations]
+ */
+
+#include "uLogger.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#define LT_HDR     "BENCH       |"
+#define LOG_HDR    LOG_STRING(LT_HDR)
+
+///////////////////////////////////////////////////////////////////
+//                         DRIVER                                //
+///////////////////////////////////////////////////////////////////
+
+int main(int argc, char *argv[])
+{
+    const size_t szIterations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000U;
+
+    // typical run: INFO on the console, no file; the messages below are VERBOSE
+    LOG_INIT(LOG_INFO, LOG_INFO, false, false, false);
+
+    const std::string strPlugin  = "UART";
+    const std::string strCommand = "WRITE";
+    const std::string strParams  = "0x55AA 16";
+    const std::string strValue   = "0x1234";
+
+    using clock = std::chrono::steady_clock;
+
+    size_t szBuilt = 0;
+    auto t0 = clock::now();
+    for (size_t n = 0; n < szIterations; ++n) {
+        const std::string strArgs = strPlugin + "." + strCommand + " " + strParams;
+        szBuilt += strArgs.size() + strValue.size() + (n & 1U);
+    }
+    auto t1 = clock::now();
+
+    for (size_t n = 0; n < szIterations; ++n) {
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("0042:");
+                  LOG_STRING(strPlugin + "." + strCommand + " " + strParams);
+                  LOG_STRING("VAR["); LOG_STRING(strValue); LOG_STRING("]");
+                  LOG_HEX8(n); LOG_UINT32(n));
+    }
+    auto t2 = clock::now();
+
+    const double dCalls   = static_cast<double>(szIterations);
+    const double dArgsNs  = std::chrono::duration<double, std::nano>(t1 - t0).count() / dCalls;
+    const double dGatedNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / dCalls;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "filtered calls : " << szIterations << " (" << szBuilt << " argument bytes)\n"
+              << "arguments only : " << dArgsNs  << " ns/call\n"
+              << "level-gated    : " << dGatedNs << " ns/call\n"
+              << "ratio          : " << (dArgsNs / ((dGatedNs > 0.0) ? dGatedNs : 1e-3)) << "x\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file    Bench_LogTimestamp.cpp
+ * @brief   Lines per second built with the cached wall clock and the relative
+ *          time stamp of the logger, against lines built without a time stamp
+ *
+ * The difference to the lines without a time stamp is the cost of one stamp.
+ *
+ * Build with -DUSCRIPT_BUILD_BENCHMARKS=ON and run:
+ *     bench_log_timestamp [lines]
+ */
+
+#include "uLogger.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+///////////////////////////////////////////////////////////////////
+//                         DRIVER                                //
+///////////////////////////////////////////////////////////////////
+
+static const char kMessage[] = "UART        | 0042: UART.WRITE 0x55AA 16";
+
+// builds szLines log lines the way print() does; returns lines per second
+template <typename TStamp>
+static double linesPerSecond(size_t szLines, TStamp&& stamp, size_t& szChecksum)
+{
+    using clock = std::chrono::steady_clock;
+    std::string strLine;
+
+    auto t0 = clock::now();
+    for (size_t n = 0; n < szLines; ++n) {
+        strLine.clear();
+        stamp(strLine);
+        strLine.append(toString(LOG_INFO));
+        strLine.append(" | ");
+        strLine.append(kMessage);
+        strLine.push_back('\n');
+        szChecksum += strLine.size();
+    }
+    auto t1 = clock::now();
+
+    return static_cast<double>(szLines) / std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t szLines = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000U;
+    size_t szChecksum = 0;
+
+    LogBuffer wallLogger;
+    LogBuffer relativeLogger;
+    relativeLogger.setRelativeTime(true);
+
+    const double dBare = linesPerSecond(szLines, [](std::string&) {}, szChecksum);
+
+    const double dWall = linesPerSecond(szLines, [&wallLogger](std::string& strLine) {
+        char buffer[LogBuffer::TIMESTAMP_SIZE];
+        strLine.append(buffer, wallLogger.formatTimestamp(buffer));
+    }, szChecksum);
+
+    const double dRelative = linesPerSecond(szLines, [&relativeLogger](std::string& strLine) {
+        char buffer[LogBuffer::TIMESTAMP_SIZE];
+        strLine.append(buffer, relativeLogger.formatTimestamp(buffer));
+    }, szChecksum);
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "lines           : " << szLines << "\n"
+              << "no time stamp   : " << dBare     << " lines/s\n"
+              << "cached wall     : " << dWall     << " lines/s\n"
+              << "relative        : " << dRelative << " lines/s\n"
+              << std::setprecision(1)
+              << "stamp (wall)    : " << (1e9 / dWall - 1e9 / dBare)     << " ns\n"
+              << "stamp (relative): " << (1e9 / dRelative - 1e9 / dBare) << " ns\n"
+              << "(checksum " << szChecksum << ")\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file    Bench_MacroExpansion.cpp
+ * @brief   Per-expansion cost of a compiled macro template
+ *
+ * The expanded text is checked first, the benchmark fails if it differs; the
+ * expansion semantics themselves are pinned by Test_MacroTemplate.
+ *
+ * Build with -DUSCRIPT_BUILD_BENCHMARKS=ON and run:
+ *     bench_macro_expansion [iterations]
+ */
+
+#include "uScriptMacroTemplate.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////
+//                       FIXTURE                                 //
+///////////////////////////////////////////////////////////////////
+
+static const std::unordered_map<std::string, std::string> g_mapVars = {
+    {"ADDR",    "0x4000"},
+    {"LEN",     "16"},
+    {"PORT",    "/dev/ttyUSB0"},
+    {"BAUD",    "115200"},
+    {"i",       "2"},
+    {"counter", "41"},
+};
+
+static const std::unordered_map<std::string, std::vector<std::string>> g_mapArrays = {
+    {"REGS", {"0x00", "0x04", "0x08", "0x0C"}},
+};
+
+static const std::vector<std::pair<std::string, std::string>> g_vTemplates = {
+    {"write $ADDR $LEN",                        "write 0x4000 16"},
+    {"open $PORT $BAUD 8N1",                    "open /dev/ttyUSB0 115200 8N1"},
+    {"$counter + 1",                            "41 + 1"},
+    {"read $REGS.$i 4",                         "read 0x08 4"},
+    {"plain text without any macro reference",  "plain text without any macro reference"},
+    {"$ADDR:$LEN:$PORT:$BAUD:$counter",         "0x4000:16:/dev/ttyUSB0:115200:41"},
+};
+
+
+static const std::string* resolveName(const std::string& strName)
+{
+    auto it = g_mapVars.find(strName);
+    return (it != g_mapVars.end()) ? &it->second : nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////
+//                         DRIVER                                //
+///////////////////////////////////////////////////////////////////
+
+int main(int argc, char *argv[])
+{
+    const size_t szIterations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000U;
+
+    std::vector<MacroTemplate> vCompiled;
+    for (const auto& [strTpl, strExpected] : g_vTemplates) {
+        vCompiled.push_back(umacro::compileMacroTemplate(strTpl));
+    }
+
+    auto resolve = [](const std::string& strName, uint32_t) {
+        return resolveName(strName);
+    };
+
+    auto element = [](const std::string& strArray, uint32_t, const std::string *pIndex) -> std::pair<bool, const std::string*> {
+        auto arrIt = g_mapArrays.find(strArray);
+        if (arrIt == g_mapArrays.end()) {
+            return {false, nullptr};
+        }
+        if (pIndex == nullptr) {
+            return {true, nullptr};
+        }
+        size_t idx = static_cast<size_t>(std::stoull(*pIndex));
+        return {true, (idx < arrIt->second.size()) ? &arrIt->second[idx] : nullptr};
+    };
+
+    // sanity: the expanded text must be the expected one
+    std::string strOut;
+    for (size_t i = 0; i < g_vTemplates.size(); ++i) {
+        umacro::expandMacroTemplate(vCompiled[i], strOut, resolve, element);
+        if (strOut != g_vTemplates[i].second) {
+            std::cerr << "mismatch: [" << strOut << "] != [" << g_vTemplates[i].second << "]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    using clock = std::chrono::steady_clock;
+    size_t szSink = 0;
+
+    auto t1 = clock::now();
+    for (size_t n = 0; n < szIterations; ++n) {
+        for (const auto& sTpl : vCompiled) {
+            umacro::expandMacroTemplate(sTpl, strOut, resolve, element);
+            szSink += strOut.size();
+        }
+    }
+    auto t2 = clock::now();
+
+    const double dExpansions = static_cast<double>(szIterations * g_vTemplates.size());
+    const double dCompiledNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / dExpansions;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "expansions     : " << static_cast<size_t>(dExpansions) << "\n"
+              << "compiled tpl   : " << dCompiledNs << " ns/expansion\n"
+              << "(sink " << szSink << ")\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file    Bench_RegexStream.cpp
+ * @brief   Regex receive of a response arriving in chunks: std::regex_match applied to the
+ *          bytes received so far after every chunk vs. the byte DFA of uStreamRegex.hpp
+ *
+ * The DFA of every pattern is first checked against std::regex_match on generated responses
+ * (matching ones, truncated ones and ones with a byte changed); the benchmark fails if any
+ * result differs.
+ *
+ * Build with -DUSCRIPT_BUILD_BENCHMARKS=ON and run:
+ *     bench_regex_stream [responses] [chunk size]
+ */
+
+#include "uStreamRegex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+struct Case {
+    const char *pattern;
+    const char *response;
+};
+
+// patterns of the kind found in comm scripts, with a response matching each
+static const Case kCases[] = {
+    {"OK.*\\r\\n",                                   "OK ready\r\n"},
+    {"HTTP/1\\.[01] 200 .*",                         "HTTP/1.1 200 OK"},
+    {"[0-9]{1,3}\\.[0-9]{1,3}",                      "192.168"},
+    {".*Boot v[0-9]+\\.[0-9]+.*",                    "U-Boot SPL 2023.04 Boot v3.1 (Jan 01 2024 - 00:00:00)"},
+    {"\\+CSQ: \\d+,\\d+\\r\\n\\r\\nOK\\r\\n",        "+CSQ: 21,99\r\n\r\nOK\r\n"},
+    {"(?:OK|ERROR)\\r\\n",                           "ERROR\r\n"},
+    {"[0-9A-F]{2}(?: [0-9A-F]{2}){15}\\r\\n",        "00 11 22 33 44 55 66 77 88 99 AA BB CC DD EE FF\r\n"},
+    {"\\s*ver(sion)?:\\s*\\w+(\\.\\w+)*\\s*",         "  version: 4.19.0_rc2 \r\n"},
+};
+
+///////////////////////////////////////////////////////////////////
+//                  CHECK AGAINST std::regex_match               //
+///////////////////////////////////////////////////////////////////
+
+static bool checkDfa(const uregex::ByteDfa& dfa, const std::regex& re, const Case& sCase, std::mt19937& rng)
+{
+    const std::string strBase(sCase.response);
+
+    for (int i = 0; i < 2000; ++i) {
+        std::string strInput = strBase;
+        switch (i % 4) {
+            case 0: break;
+            case 1: strInput.resize(rng() % (strBase.size() + 1)); break;
+            case 2: strInput[rng() % strInput.size()] = static_cast<char>(rng()); break;
+            default: strInput.push_back(static_cast<char>(rng())); break;
+        }
+
+        uint32_t uState = dfa.start();
+        const bool bDfa = (uregex::MatchState::MATCH == dfa.run(uState, std::span<const uint8_t>(
+                              reinterpret_cast<const uint8_t*>(strInput.data()), strInput.size())));
+        if (bDfa != std::regex_match(strInput, re)) {
+            std::cerr << sCase.pattern << ": DFA and std::regex differ on \"" << strInput << "\"\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////
+//                         DRIVER                                //
+///////////////////////////////////////////////////////////////////
+
+// responses per second, the response being fed in chunks of szChunk bytes
+static double responsesPerSecond(size_t szResponses, size_t szChunk, const std::string& strResponse,
+                                 const uregex::ByteDfa *pDfa, const std::regex *pRegex, size_t& szMatched)
+{
+    using clock = std::chrono::steady_clock;
+    std::span<const uint8_t> response(reinterpret_cast<const uint8_t*>(strResponse.data()), strResponse.size());
+
+    auto t0 = clock::now();
+    for (size_t n = 0; n < szResponses; ++n) {
+        uregex::StreamMatcher matcher(pDfa, pRegex);
+        uregex::MatchState state = uregex::MatchState::PARTIAL;
+        for (size_t szPos = 0; (szPos < response.size()) && (uregex::MatchState::NO_MATCH != state); szPos += szChunk) {
+            state = matcher.feed(response.subspan(szPos, std::min(szChunk, response.size() - szPos)));
+        }
+        szMatched += (uregex::MatchState::MATCH == state) ? 1U : 0U;
+    }
+    auto t1 = clock::now();
+
+    return static_cast<double>(szResponses) / std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t szResponses = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 20000U;
+    const size_t szChunk     = std::max<size_t>((argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 4U, 1U);
+
+    std::mt19937 rng(0x5EED);
+    size_t szMatched = 0;
+
+    std::cout << "responses   : " << szResponses << ", chunks of " << szChunk << " bytes\n"
+              << "states  std::regex resp/s  DFA resp/s  speedup  pattern\n"
+              << std::fixed;
+
+    for (const auto& sCase : kCases) {
+        const std::regex re(sCase.pattern, std::regex::ECMAScript | std::regex::optimize);
+        const auto dfa = uregex::ByteDfa::compile(sCase.pattern);
+        if (!dfa) {
+            std::cerr << sCase.pattern << ": outside the DFA subset\n";
+            return EXIT_FAILURE;
+        }
+        if (!checkDfa(*dfa, re, sCase, rng)) {
+            return EXIT_FAILURE;
+        }
+
+        const std::string strResponse(sCase.response);
+        const double dRegex = responsesPerSecond(szResponses, szChunk, strResponse, nullptr, &re, szMatched);
+        const double dDfa   = responsesPerSecond(szResponses, szChunk, strResponse, &*dfa, nullptr, szMatched);
+
+        std::cout << std::setw(6) << dfa->stateCount()
+                  << std::setprecision(0) << std::setw(20) << dRegex << std::setw(12) << dDfa
+                  << std::setprecision(1) << std::setw(8) << (dDfa / dRegex) << "x  " << sCase.pattern << "\n";
+    }
+
+    if (szMatched != 2 * szResponses * std::size(kCases)) {
+        std::cerr << "a response did not match its pattern\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -5,6 +5,9 @@
 // configuration
 #define    SCRIPT_DEFAULT                               "script.txt"
 #define    SCRIPT_INI_CONFIG                            "uscript.ini"
+#define    SCRIPT_PROFILE_REPORT_DEFAULT                "uscript_profile"
+#define    SCRIPT_TRACE_FILE_DEFAULT                    "uscript_trace.json"
+#define    SCRIPT_LOG_BINARY_FILE_DEFAULT               "uscript_log.ulb"
 
 
 // comments
@@ -50,16 +53,37 @@
 #define    COMMON_INI_SECTION_NAME                      "COMMON"
 #define    SCRIPT_INI_SECTION_NAME                      "SCRIPT"
 #define    SCRIPT_INI_CMD_EXEC_DELAY                    "CMD_EXEC_DELAY"
+#define    SCRIPT_INI_BYTECODE_EXEC                     "BYTECODE_EXEC"
+#define    SCRIPT_INI_CACHE_ENABLE                      "CACHE_ENABLED"
+#define    SCRIPT_INI_CACHE_DIR                         "CACHE_DIR"
+#define    SCRIPT_INI_PARALLEL_PLUGIN_INIT              "PARALLEL_PLUGIN_INIT"
+#define    SCRIPT_INI_DELAY_SPIN_US                     "DELAY_SPIN_US"
+#define    SCRIPT_INI_PROFILE                           "PROFILE"
+#define    SCRIPT_INI_PROFILE_REPORT                    "PROFILE_REPORT"
+#define    SCRIPT_INI_TRACE                             "TRACE"
+#define    SCRIPT_INI_TRACE_FILE                        "TRACE_FILE"
 #define    SCRIPT_INI_LOG_SEVERITY_CONSOLE              "LOG_SEVERITY_CONSOLE"
 #define    SCRIPT_INI_LOG_SEVERITY_FILE                 "LOG_SEVERITY_FILE"
 #define    SCRIPT_INI_INCLUDE_DATE                      "LOG_INCLUDE_DATE"
+#define    SCRIPT_INI_LOG_RELATIVE_TIME                 "LOG_RELATIVE_TIME"
 #define    SCRIPT_INI_LOG_CONSOLE_COLORED               "LOG_CONSOLE_COLORED"
 #define    SCRIPT_INI_ENABLE_LOG_TO_FILE                "LOG_FILE_ENABLED"
+#define    SCRIPT_INI_LOG_ASYNC                         "LOG_ASYNC"
+#define    SCRIPT_INI_LOG_ASYNC_QUEUE                   "LOG_ASYNC_QUEUE"
+#define    SCRIPT_INI_LOG_ASYNC_OVERFLOW                "LOG_ASYNC_OVERFLOW"
+#define    SCRIPT_INI_LOG_ASYNC_FLUSH_MS                "LOG_ASYNC_FLUSH_MS"
+#define    SCRIPT_INI_LOG_ASYNC_CRASH_FLUSH             "LOG_ASYNC_CRASH_FLUSH"
+#define    SCRIPT_INI_LOG_BINARY                        "LOG_BINARY"
+#define    SCRIPT_INI_LOG_BINARY_FILE                   "LOG_BINARY_FILE"
+#define    SCRIPT_INI_LOG_BINARY_SIZE_MB                "LOG_BINARY_SIZE_MB"
+#define    SCRIPT_INI_LOG_SEVERITY_BINARY               "LOG_SEVERITY_BINARY"
 
 
 // common plugin related keywords in the ini file
 #define    PLUGIN_INI_FAULT_TOLERANT                    "FAULT_TOLERANT"
 #define    PLUGIN_INI_PRIVILEGED                        "PRIVILEGED"
+#define    PLUGIN_INI_SCRIPT_CACHE                      "SCRIPT_CACHE"
+#define    PLUGIN_INI_SCRIPT_WINDOW                     "SCRIPT_WINDOW"
 
 // char separators
 #define    CHAR_SEPARATOR_PIPE                          '|'
@@ -92,6 +116,8 @@
 #define    PLUGIN_DEFAULT_FILEREAD_CHUNKSIZE            1024U
 #define    PLUGIN_DEFAULT_RECEIVE_SIZE                  1024U
 #define    PLUGIN_SCRIPT_DEFAULT_CMDS_DELAY                0U
+#define    PLUGIN_DEFAULT_SCRIPT_CACHE_ENTRIES          16U
+#define    PLUGIN_SCRIPT_DEFAULT_WINDOW                 1U
 
 // intervals
 #define    PLUGIN_DEFAULT_UARTMON_POLLING_INTERVAL       100U
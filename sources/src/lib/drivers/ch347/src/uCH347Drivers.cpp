@@ -23,6 +23,7 @@
 #include "uCH347I2c.hpp"
 #include "uCH347Gpio.hpp"
 #include "uCH347Jtag.hpp"
+#include "uTrace.hpp"
 
 #include <cstring>
 #include <cassert>
@@ -125,6 +126,7 @@ ReadResult CH347SPI::tout_read(uint32_t /*u32ReadTimeout*/,
                                std::span<uint8_t>  buffer,
                                const ReadOptions&  options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "CH347SPI read");
     /* SPI WriteRead is only meaningful for exact-length transfers */
     if (options.mode != ReadMode::Exact)
         return { Status::INVALID_PARAM, 0, false };
@@ -141,6 +143,7 @@ ReadResult CH347SPI::tout_read(uint32_t /*u32ReadTimeout*/,
 WriteResult CH347SPI::tout_write(uint32_t /*u32WriteTimeout*/,
                                  std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "CH347SPI write");
     return tout_write_ex(buffer, m_xferOpts);
 }
 
@@ -230,6 +233,7 @@ ReadResult CH347I2C::tout_read(uint32_t /*u32ReadTimeout*/,
                                std::span<uint8_t>  buffer,
                                const ReadOptions&  options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "CH347I2C read");
     if (options.mode != ReadMode::Exact)
         return { Status::INVALID_PARAM, 0, false };
 
@@ -243,6 +247,7 @@ ReadResult CH347I2C::tout_read(uint32_t /*u32ReadTimeout*/,
 WriteResult CH347I2C::tout_write(uint32_t /*u32WriteTimeout*/,
                                  std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "CH347I2C write");
     /* Pure write: no read phase.
      * buffer[0] must be (devAddr << 1) | 0  (caller's responsibility). */
     std::vector<uint8_t> tmp(buffer.begin(), buffer.end());
@@ -334,6 +339,7 @@ ReadResult CH347GPIO::tout_read(uint32_t /*u32ReadTimeout*/,
                                 std::span<uint8_t> buffer,
                                 const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "CH347GPIO read");
     if (options.mode != ReadMode::Exact)
         return { Status::INVALID_PARAM, 0, false };
 
@@ -354,6 +360,7 @@ ReadResult CH347GPIO::tout_read(uint32_t /*u32ReadTimeout*/,
 WriteResult CH347GPIO::tout_write(uint32_t /*u32WriteTimeout*/,
                                   std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "CH347GPIO write");
     if (buffer.size() < GPIO_BUFFER_SIZE)
         return { Status::INVALID_PARAM, 0u };
 
@@ -441,6 +448,7 @@ ReadResult CH347JTAG::tout_read(uint32_t /*u32ReadTimeout*/,
                                 std::span<uint8_t> buffer,
                                 const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "CH347JTAG read");
     if (options.mode != ReadMode::Exact)
         return { Status::INVALID_PARAM, 0, false };
 
@@ -457,6 +465,7 @@ ReadResult CH347JTAG::tout_read(uint32_t /*u32ReadTimeout*/,
 WriteResult CH347JTAG::tout_write(uint32_t /*u32WriteTimeout*/,
                                   std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "CH347JTAG write");
     Status s = write_register(m_lastReg, buffer);
     return { s, s == Status::SUCCESS ? buffer.size() : 0u };
 }
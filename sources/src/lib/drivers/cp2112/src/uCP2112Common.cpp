@@ -1,5 +1,6 @@
 #include "uCP2112.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <algorithm>
 #include <vector>
@@ -72,6 +73,7 @@ CP2112::ReadResult CP2112::tout_read(uint32_t u32ReadTimeout,
                                      std::span<uint8_t> buffer,
                                      const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "CP2112 read");
     ReadResult result;
 
     if (!is_open()) {
@@ -200,6 +202,7 @@ CP2112::ReadResult CP2112::tout_read(uint32_t u32ReadTimeout,
 CP2112::WriteResult CP2112::tout_write(uint32_t u32WriteTimeout,
                                        std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "CP2112 write");
     WriteResult result;
 
     if (!is_open()) {
@@ -1,6 +1,7 @@
 #include "FT2232Base.hpp"
 #include "uFT2232I2C.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <algorithm>
 #include <vector>
@@ -80,6 +81,7 @@ FT2232I2C::ReadResult FT2232I2C::tout_read(uint32_t u32ReadTimeout,
                                             std::span<uint8_t> buffer,
                                             const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT2232I2C read");
     ReadResult result;
 
     if (!is_open()) {
@@ -190,6 +192,7 @@ FT2232I2C::ReadResult FT2232I2C::tout_read(uint32_t u32ReadTimeout,
 FT2232I2C::WriteResult FT2232I2C::tout_write(uint32_t u32WriteTimeout,
                                               std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT2232I2C write");
     WriteResult result;
 
     if (!is_open()) {
@@ -1,6 +1,7 @@
 #include "FT2232Base.hpp"
 #include "uFT2232SPI.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <algorithm>
 #include <vector>
@@ -71,6 +72,7 @@ FT2232SPI::Status FT2232SPI::close()
 FT2232SPI::WriteResult FT2232SPI::tout_write(uint32_t u32WriteTimeout,
                                               std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT2232SPI write");
     WriteResult result;
     (void)u32WriteTimeout;
 
@@ -94,6 +96,7 @@ FT2232SPI::ReadResult FT2232SPI::tout_read(uint32_t u32ReadTimeout,
                                             std::span<uint8_t> buffer,
                                             const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT2232SPI read");
     ReadResult result;
 
     if (!is_open()) { result.status = Status::PORT_ACCESS; return result; }
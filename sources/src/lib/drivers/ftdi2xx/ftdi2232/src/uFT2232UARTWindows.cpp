@@ -17,6 +17,7 @@
 #include "uFT2232UART.hpp"
 #include "FT2232Base.hpp"   // FT2232_VID / FT2232D_PID constants
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <ftd2xx.h>
 
@@ -176,6 +177,7 @@ FT2232UART::Status FT2232UART::close()
 FT2232UART::WriteResult FT2232UART::tout_write(uint32_t                 u32WriteTimeout,
                                                 std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT2232UART write");
     WriteResult result;
 
     if (!m_hDevice) { result.status = Status::PORT_ACCESS; return result; }
@@ -222,6 +224,7 @@ FT2232UART::ReadResult FT2232UART::tout_read(uint32_t           u32ReadTimeout,
                                               std::span<uint8_t> buffer,
                                               const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT2232UART read");
     ReadResult result;
 
     if (!m_hDevice) { result.status = Status::PORT_ACCESS; return result; }
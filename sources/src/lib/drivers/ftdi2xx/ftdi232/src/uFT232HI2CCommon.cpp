@@ -7,6 +7,7 @@
 
 #include "uFT232HI2C.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <vector>
 #include <array>
@@ -294,6 +295,7 @@ FT232HI2C::WriteResult
 FT232HI2C::tout_write(uint32_t u32WriteTimeout,
                        std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT232HI2C write");
     WriteResult r;
     r.bytes_written = 0;
     size_t written  = 0;
@@ -307,6 +309,7 @@ FT232HI2C::tout_read(uint32_t u32ReadTimeout,
                       std::span<uint8_t> buffer,
                       const ReadOptions& /*options*/) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT232HI2C read");
     ReadResult r;
     r.bytes_read = 0;
     size_t got   = 0;
@@ -10,6 +10,7 @@
 
 #include "uFT232HSPI.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <vector>
 #include <cstring>
@@ -229,6 +230,7 @@ FT232HSPI::WriteResult
 FT232HSPI::tout_write(uint32_t /*u32WriteTimeout*/,
                        std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT232HSPI write");
     WriteResult r;
     r.status        = Status::RETVAL_NOT_SET;
     r.bytes_written = 0;
@@ -248,6 +250,7 @@ FT232HSPI::tout_read(uint32_t u32ReadTimeout,
                       std::span<uint8_t> buffer,
                       const ReadOptions& /*options*/) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT232HSPI read");
     ReadResult r;
     r.status     = Status::RETVAL_NOT_SET;
     r.bytes_read = 0;
@@ -11,6 +11,7 @@
 #include "uFT232HUART.hpp"
 #include "FT232HBase.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <ftd2xx.h>
 
@@ -159,6 +160,7 @@ FT232HUART::Status FT232HUART::close()
 FT232HUART::WriteResult FT232HUART::tout_write(uint32_t                 u32WriteTimeout,
                                                 std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT232HUART write");
     WriteResult result;
     if (!m_hDevice) { result.status = Status::PORT_ACCESS; return result; }
     if (buffer.empty()) { result.status = Status::SUCCESS; result.bytes_written = 0; return result; }
@@ -196,6 +198,7 @@ FT232HUART::ReadResult FT232HUART::tout_read(uint32_t           u32ReadTimeout,
                                               std::span<uint8_t> buffer,
                                               const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT232HUART read");
     ReadResult result;
     if (!m_hDevice) { result.status = Status::PORT_ACCESS; return result; }
     if (buffer.empty()) { result.status = Status::SUCCESS; result.bytes_read = 0; return result; }
@@ -1,6 +1,7 @@
 #include "FT245Base.hpp"
 #include "uFT245Sync.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <algorithm>
 #include <vector>
@@ -56,6 +57,7 @@ FT245Sync::Status FT245Sync::close()
 FT245Sync::WriteResult FT245Sync::tout_write(uint32_t u32WriteTimeout,
                                               std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT245Sync write");
     WriteResult result;
 
     if (!is_open()) {
@@ -104,6 +106,7 @@ FT245Sync::ReadResult FT245Sync::tout_read(uint32_t u32ReadTimeout,
                                             std::span<uint8_t> buffer,
                                             const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT245Sync read");
     ReadResult result;
 
     if (!is_open()) {
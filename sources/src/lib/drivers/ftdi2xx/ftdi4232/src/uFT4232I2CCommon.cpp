@@ -6,6 +6,7 @@
 #include "FT4232Base.hpp"
 #include "uFT4232I2C.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <algorithm>
 #include <vector>
@@ -116,6 +117,7 @@ FT4232I2C::ReadResult FT4232I2C::tout_read(uint32_t u32ReadTimeout,
                                             std::span<uint8_t> buffer,
                                             const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT4232I2C read");
     ReadResult result;
 
     if (!is_open()) {
@@ -244,6 +246,7 @@ FT4232I2C::ReadResult FT4232I2C::tout_read(uint32_t u32ReadTimeout,
 FT4232I2C::WriteResult FT4232I2C::tout_write(uint32_t u32WriteTimeout,
                                               std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT4232I2C write");
     WriteResult result;
 
     if (!is_open()) {
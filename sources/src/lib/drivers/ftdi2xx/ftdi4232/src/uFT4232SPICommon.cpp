@@ -6,6 +6,7 @@
 #include "FT4232Base.hpp"
 #include "uFT4232SPI.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <algorithm>
 #include <vector>
@@ -117,6 +118,7 @@ FT4232SPI::Status FT4232SPI::close()
 FT4232SPI::WriteResult FT4232SPI::tout_write(uint32_t u32WriteTimeout,
                                               std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT4232SPI write");
     WriteResult result;
     (void)u32WriteTimeout; // write is synchronous at the MPSSE level
 
@@ -151,6 +153,7 @@ FT4232SPI::ReadResult FT4232SPI::tout_read(uint32_t u32ReadTimeout,
                                             std::span<uint8_t> buffer,
                                             const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT4232SPI read");
     ReadResult result;
 
     if (!is_open()) {
@@ -11,6 +11,7 @@
 #include "uFT4232UART.hpp"
 #include "FT4232Base.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <ftd2xx.h>
 
@@ -165,6 +166,7 @@ FT4232UART::Status FT4232UART::close()
 FT4232UART::WriteResult FT4232UART::tout_write(uint32_t                 u32WriteTimeout,
                                                 std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "FT4232UART write");
     WriteResult result;
     if (!m_hDevice) { result.status = Status::PORT_ACCESS; return result; }
     if (buffer.empty()) { result.status = Status::SUCCESS; result.bytes_written = 0; return result; }
@@ -202,6 +204,7 @@ FT4232UART::ReadResult FT4232UART::tout_read(uint32_t           u32ReadTimeout,
                                               std::span<uint8_t> buffer,
                                               const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "FT4232UART read");
     ReadResult result;
     if (!m_hDevice) { result.status = Status::PORT_ACCESS; return result; }
     if (buffer.empty()) { result.status = Status::SUCCESS; result.bytes_read = 0; return result; }
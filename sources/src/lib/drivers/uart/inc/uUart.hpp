@@ -70,12 +70,12 @@ class UART : public ICommDriver
         // Legacy internal methods (kept for implementation compatibility)
         Status timeout_read (uint32_t u32ReadTimeout, std::span<uint8_t> buffer, size_t& szBytesRead) const;
         Status timeout_read_until (uint32_t u32ReadTimeout, std::span<uint8_t> buffer, uint8_t cDelimiter, size_t& szBytesRead) const;
-        Status timeout_wait_for_token (uint32_t u32ReadTimeout, std::span<const uint8_t> token, bool useBuffer) const;
+        Status timeout_wait_for_token (uint32_t u32ReadTimeout, std::span<const uint8_t> token, std::span<const int> tokenLps, bool useBuffer) const;
         Status timeout_write (uint32_t u32WriteTimeouts, std::span<const uint8_t> buffer, size_t& szBytesWritten) const;
 
         Status purge (bool bInput, bool bOutput) const;
         Status setup (uint32_t u32Speed) const;
-        Status kmp_stream_match (std::span<const uint8_t> token, const std::vector<int>& viLps, uint32_t u32Timeout, bool bReturnOnTimeout, bool useBuffer) const;
+        Status kmp_stream_match (std::span<const uint8_t> token, std::span<const int> viLps, uint32_t u32Timeout, bool bReturnOnTimeout, bool useBuffer) const;
         void   build_kmp_table (std::span<const uint8_t> pattern, size_t szLength, std::vector<int>& viLps) const;
 
 #ifndef _WIN32
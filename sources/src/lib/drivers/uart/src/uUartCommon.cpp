@@ -1,5 +1,6 @@
 #include "uUart.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
 
 #include <array>
 
@@ -32,6 +33,7 @@ bool UART::is_open() const
 UART::ReadResult UART::tout_read(uint32_t u32ReadTimeout, std::span<uint8_t> buffer, 
                             const ReadOptions& options) const
 {
+    UTRACE_SCOPE(utrace::Category::READ, "UART read");
     std::lock_guard<std::mutex> lock(m_mutex);
     ReadResult result;
     
@@ -54,7 +56,7 @@ UART::ReadResult UART::tout_read(uint32_t u32ReadTimeout, std::span<uint8_t> buf
         }
         
         case ReadMode::UntilToken: {
-            result.status = timeout_wait_for_token(u32ReadTimeout, options.token, options.use_buffer);
+            result.status = timeout_wait_for_token(u32ReadTimeout, options.token, options.token_lps, options.use_buffer);
             result.bytes_read = 0;  // Token search doesn't fill user buffer
             result.found_terminator = (result.status == Status::SUCCESS);
             (void)purge(true, false);
@@ -74,6 +76,7 @@ UART::ReadResult UART::tout_read(uint32_t u32ReadTimeout, std::span<uint8_t> buf
 
 UART::WriteResult UART::tout_write(uint32_t u32WriteTimeout, std::span<const uint8_t> buffer) const
 {
+    UTRACE_SCOPE(utrace::Category::WRITE, "UART write");
     std::lock_guard<std::mutex> lock(m_mutex);
     WriteResult result;
     size_t bytes_written = 0;
@@ -89,7 +92,7 @@ UART::WriteResult UART::tout_write(uint32_t u32WriteTimeout, std::span<const uin
 // PRIVATE LEGACY IMPLEMENTATION (INTERNAL USE ONLY)
 // ============================================================================
 
-UART::Status UART::timeout_wait_for_token (uint32_t u32ReadTimeout, std::span<const uint8_t> token, bool useBuffer) const
+UART::Status UART::timeout_wait_for_token (uint32_t u32ReadTimeout, std::span<const uint8_t> token, std::span<const int> tokenLps, bool useBuffer) const
 {
     size_t szTokenLength = token.size();
     if (token.empty() || szTokenLength == 0 || szTokenLength >= UART_MAX_BUFLENGTH) {
@@ -100,6 +103,11 @@ UART::Status UART::timeout_wait_for_token (uint32_t u32ReadTimeout, std::span<co
     uint32_t u32Timeout = (u32ReadTimeout == 0) ? UART_READ_DEFAULT_TIMEOUT : u32ReadTimeout;
     bool bReturnOnTimeout = (u32ReadTimeout != 0);
 
+    // use the failure table precomputed by the caller when there is one
+    if (tokenLps.size() == szTokenLength) {
+        return kmp_stream_match(token, tokenLps, u32Timeout, bReturnOnTimeout, useBuffer);
+    }
+
     std::vector<int> viLps;
     build_kmp_table(token, szTokenLength, viLps);
 
@@ -127,7 +135,7 @@ void UART::build_kmp_table (std::span<const uint8_t> pattern, size_t szLength, s
 }
 
 
-UART::Status UART::kmp_stream_match (std::span<const uint8_t> token, const std::vector<int>& viLps, uint32_t u32Timeout, bool bReturnOnTimeout, bool useBuffer) const
+UART::Status UART::kmp_stream_match (std::span<const uint8_t> token, std::span<const int> viLps, uint32_t u32Timeout, bool bReturnOnTimeout, bool useBuffer) const
 {
     uint8_t Buffer[UART_MAX_BUFLENGTH] = {0};
     uint32_t u32Matched = 0;
@@ -4,9 +4,13 @@
 #include "uSharedConfig.hpp"
 #include "uBoolEvaluator.hpp"
 #include "uLogger.hpp"
+#include "uTrace.hpp"
+#include "IPlugin.hpp"
 
 #include <string>
 #include <map>
+#include <vector>
+#include <utility>
 
 
 
@@ -48,11 +52,61 @@ template <typename T>
 using PluginCommandsMap = std::map <const std::string, MFP<T>>;
 
 
+/**
+ * \brief template based definition of the table containg the pair <cmd_name(string), cmd_function_pointer>
+ *        indexed by the command id returned by generic_resolve_command
+ */
+template <typename T>
+using PluginCommandsTable = std::vector <std::pair<std::string, MFP<T>>>;
+
+
 ///////////////////////////////////////////////////////////////////
 //                 PUBLIC INTERFACES DEFINITIONS                 //
 ///////////////////////////////////////////////////////////////////
 
 
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * \brief template based execution of an already looked-up command (shared by both dispatch flavours),
+ *        the only place where the fault tolerant mode overrides a failure
+ * \param[in] pOwner pointer to the template type used to access the class private members
+ * \param[in] strCmd name of the command (used for logging only)
+ * \param[in] pfnCmd pointer to the command handler, nullptr if the command is not supported
+ * \param[in] strParams string containing the arguments list as space separated string
+ * \return true if processing succeeded, false otherwise
+*/
+/*--------------------------------------------------------------------------------------------------------*/
+
+template <typename T>
+bool generic_execute( const T *pOwner, const std::string& strCmd, MFP<T> pfnCmd, const std::string& strParams )
+{
+    bool bRetVal = false;
+    bool bIsInitialized = pOwner->isInitialized();
+    bool bIsFaultTolerant = pOwner->isFaultTolerant();
+
+    if (nullptr == pfnCmd) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Command"); LOG_STRING(strCmd); LOG_STRING("not supported by plugin"));
+    } else if ((true == bIsInitialized) || (true == bIsFaultTolerant)) { // if either initialized or fault tolerant execute the command
+        if (false == bIsInitialized) {
+            LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING(strCmd); LOG_STRING(": Plugin not initialized but in fault tolerant mode -> run accepted"));
+        }
+        // execute the command passing to it the arguments resulted in the split above
+        bRetVal = (pOwner->*pfnCmd)(strParams);
+    } else {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Plugin not initialized!"));
+    }
+
+    // in fault tolerant mode override the result and let it continue
+    if ((false == bRetVal) && (true == bIsFaultTolerant)) {
+        LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING(strCmd); LOG_STRING(": Failed but continue [fault-tolerant mode]"));
+        bRetVal = true;
+    }
+
+    return bRetVal;
+
+}
+
+
 /*--------------------------------------------------------------------------------------------------------*/
 /**
  * \brief template based generic doDispatch implementation
@@ -65,44 +119,83 @@ using PluginCommandsMap = std::map <const std::string, MFP<T>>;
 template <typename T>
 bool generic_dispatch( const T *pOwner, const std::string& strCmd, const std::string& strParams )
 {
-    bool bRetVal = true;
-
     // search the command in the plugin's map
     typename PluginCommandsMap<T>::const_iterator itPlugin = pOwner->getMap()->find(strCmd);
 
-    // check if the command is supported by the plugin
-    if (itPlugin != pOwner->getMap()->end() ) {
-        bool bIsInitialized = pOwner->isInitialized();
-        bool bIsFaultTolerant = pOwner->isFaultTolerant();
+    return generic_execute<T>(pOwner, strCmd, (itPlugin != pOwner->getMap()->end()) ? itPlugin->second : nullptr, strParams);
 
-        // if either initialized or fault tolerant execute the command
-        if ((true == bIsInitialized) || (true == bIsFaultTolerant)) {
-            if (false == bIsInitialized) {
-                LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING(strCmd); LOG_STRING(": Plugin not initialized but in fault tolerant mode -> run accepted"));
-            }
-            // execute the command passing to it the arguments resulted in the split above
-            bRetVal = (pOwner->*itPlugin->second)(strParams);
-            // if fault tolerant then return true even if failed
-            if ((false == bRetVal) && (true == bIsFaultTolerant)) {
-                LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING(strCmd); LOG_STRING(": Execution failed but in fault tolerant mode -> continue"));
-                bRetVal = true;
-            }
-        } else {
-            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Plugin not initialized!"));
-            bRetVal = false;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * \brief template based generic build of the command table used by the id based dispatch
+ * \note to be called by the plugin constructor once the commands map is filled
+ * \param[in] mapCmds the plugin commands map
+ * \param[out] vCmds the plugin commands table, one entry per command of the map
+ * \return void
+*/
+/*--------------------------------------------------------------------------------------------------------*/
+
+template <typename T>
+void generic_build_table( const PluginCommandsMap<T>& mapCmds, PluginCommandsTable<T>& vCmds )
+{
+    vCmds.clear();
+    vCmds.reserve(mapCmds.size());
+
+    for (const auto& cmd : mapCmds) {
+        vCmds.emplace_back(cmd.first, cmd.second);
+    }
+
+}
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * \brief template based generic resolveCommand implementation
+ * \param[in] pOwner pointer to the template type used to access the class private members
+ * \param[in] strCmd name of the command to resolve
+ * \return command id (index in the plugin commands table), or PluginInterface::kInvalidCommandId
+ *         if the command is not supported
+*/
+/*--------------------------------------------------------------------------------------------------------*/
+
+template <typename T>
+size_t generic_resolve_command( const T *pOwner, const std::string& strCmd )
+{
+    const PluginCommandsTable<T>& vCmds = *pOwner->getTable();
+
+    for (size_t szCmdId = 0; szCmdId < vCmds.size(); ++szCmdId) {
+        if (vCmds[szCmdId].first == strCmd) {
+            return szCmdId;
         }
-    } else {
-        bRetVal = false;
-        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Command"); LOG_STRING(strCmd); LOG_STRING("not supported by plugin"));
     }
 
-    // in fault tolerant mode override the result and let it continue
-    if ((false == bRetVal) && (pOwner->isFaultTolerant())) {
-        bRetVal = true;
-        LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Failed but continue [fault-tolerant mode]"));
+    return PluginInterface::kInvalidCommandId;
+
+}
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * \brief template based generic doDispatchById implementation
+ * \param[in] pOwner pointer to the template type used to access the class private members
+ * \param[in] szCmdId command id returned by generic_resolve_command for the same plugin instance
+ * \param[in] strParams string containing the arguments list as space separated string
+ * \return true if processing succeeded, false otherwise
+*/
+/*--------------------------------------------------------------------------------------------------------*/
+
+template <typename T>
+bool generic_dispatch_by_id( const T *pOwner, size_t szCmdId, const std::string& strParams )
+{
+    const PluginCommandsTable<T>& vCmds = *pOwner->getTable();
+
+    if (szCmdId < vCmds.size()) {
+        return generic_execute<T>(pOwner, vCmds[szCmdId].first, vCmds[szCmdId].second, strParams);
     }
 
-    return bRetVal;
+    return generic_execute<T>(pOwner, "#" + std::to_string(szCmdId), nullptr, strParams);
 
 }
 
@@ -145,6 +238,7 @@ bool generic_setparams ( const T *pOwner, const PluginDataSet *psSetParams, bool
     bool bRetVal = true;
 
     setLogger(psSetParams->shpLogger);
+    utrace::setTracer(psSetParams->shpTracer);
 
     if (!psSetParams->mapSettings.empty()) {
         do {
@@ -95,14 +95,39 @@
  *   power       := postfix  ('**' unary)*              right-assoc
  *   postfix     := primary  (implicit_mul)*
  *   primary     := number | identifier_or_func | '(' expr ')'
+ *
+ * ─────────────────────────────────────────────────────────────────────────────
+ * COMPILED PROGRAMS
+ * ─────────────────────────────────────────────────────────────────────────────
+ *   The parser does not evaluate while parsing: it emits a postfix (RPN)
+ *   CalcProgram which is then run on a small value stack.  evaluate() is
+ *   compile() + run(), so a caller evaluating the same expression repeatedly
+ *   can compile once and only call run():
+ *
+ *       CalcProgram prog = Calculator::compile("$0 * 2 + offset", true);
+ *       double holes[] = { 21.0 };
+ *       double r = Calculator::run(prog, vars, holes);      // 42 + offset
+ *
+ *   - Variables are referenced by name index; run() binds each name to its
+ *     entry in the variable map on first use (map nodes are stable), so
+ *     later runs neither hash nor allocate.
+ *   - With bAllowHoles, "$<n>" is a primary that reads pHoles[n] at run time
+ *     (used for $macro values substituted by the caller).
+ *   - && / || and ?: evaluate all of their operands, in source order, as
+ *     the recursive-descent evaluation always did (no short-circuit).
+ *   - Parse errors are thrown by compile(), evaluation errors by run().
  */
 
 #include <cmath>
 #include <cctype>
+#include <cerrno>
+#include <cstdlib>
 #include <cstdint>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI   3.14159265358979323846
@@ -111,6 +136,48 @@
 #define M_E    2.71828182845904523536
 #endif
 
+// -----------------------------------------------------------------------------
+// Compiled expression (see COMPILED PROGRAMS above)
+// -----------------------------------------------------------------------------
+struct CalcProgram
+{
+    enum class Op : uint8_t
+    {
+        CONST, HOLE, LOAD, STORE,                       // uArg: constant / hole / name index
+        NEG, NOT, BNOT,                                 // unary
+        ADD, SUB, MUL, DIV, FDIV, MOD, POW,             // arithmetic
+        SHL, SHR, BAND, BXOR, BOR,                      // bitwise
+        EQ, NE, LT, LE, GT, GE, LAND, LOR,              // comparison / logical
+        SELECT,                                         // cond ? a : b
+        FUNC                                            // uArg: Func
+    };
+
+    enum class Func : uint8_t
+    {
+        SIN, COS, TAN, ASIN, ACOS, ATAN, SINH, COSH, TANH,
+        SQRT, CBRT, EXP, EXP2, LOG, LOG2, LOG10,
+        ABS, CEIL, FLOOR, ROUND, TRUNC, SIGN,
+        POW, ATAN2, MIN, MAX, HYPOT, FMOD, LOG_B
+    };
+
+    struct Instr
+    {
+        Op       eOp  = Op::CONST;
+        uint32_t uArg = 0U;
+    };
+
+    std::vector<Instr>       vCode;
+    std::vector<double>      vConsts;
+    std::vector<std::string> vNames;        // variable names referenced by LOAD / STORE
+    size_t                   szMaxDepth = 0U;
+    size_t                   szNrHoles  = 0U;
+
+    // run-time binding of vNames to entries of the variable map
+    mutable std::vector<double*> vpBound;
+    mutable const void          *pBoundVars = nullptr;
+};
+
+
 class Calculator
 {
 public:
@@ -118,40 +185,246 @@ public:
     // Public API
     // -------------------------------------------------------------------------
 
+    using VarMap = std::unordered_map<std::string, double>;
+
     // vars is a persistent map shared across multiple Calculator invocations
     // so that assigned variables survive between calls.
-    Calculator(const std::string& expr,
-               std::unordered_map<std::string, double>& vars)
-        : m_expr(expr), m_pos(0), m_vars(vars)
+    Calculator(const std::string& expr, VarMap& vars)
+        : m_expr(expr), m_pos(0), m_pVars(&vars)
     {
-        // Built-in constants (only set if not already defined by the user)
-        m_vars.try_emplace("pi",  M_PI);
-        m_vars.try_emplace("e",   M_E);
-        m_vars.try_emplace("tau", 2.0 * M_PI);
-        m_vars.try_emplace("phi", 1.6180339887498948482);   // golden ratio
-        m_vars.try_emplace("inf", std::numeric_limits<double>::infinity());
-        m_vars.try_emplace("nan", std::numeric_limits<double>::quiet_NaN());
+        seedConstants(vars);
     }
 
     // Evaluate the expression and return the result.
     // Throws std::runtime_error on any parse or domain error.
     double evaluate()
     {
-        m_pos = 0;
-        double result = parseAssignment();
+        compileInto(m_prog);
+        return run(m_prog, *m_pVars);
+    }
+
+    // Built-in constants (only set if not already defined by the user)
+    static void seedConstants(VarMap& vars)
+    {
+        vars.try_emplace("pi",  M_PI);
+        vars.try_emplace("e",   M_E);
+        vars.try_emplace("tau", 2.0 * M_PI);
+        vars.try_emplace("phi", 1.6180339887498948482);   // golden ratio
+        vars.try_emplace("inf", std::numeric_limits<double>::infinity());
+        vars.try_emplace("nan", std::numeric_limits<double>::quiet_NaN());
+    }
+
+    // Parse a complete unsigned numeric literal exactly like the number rule
+    // of the grammar (decimal / scientific, 0x, 0b, 0o and legacy 0NNN octal).
+    // Returns false if psz holds anything else or the value is out of range;
+    // does not allocate.
+    static bool parseLiteral(const char *psz, double& value) noexcept
+    {
+        const char *p = psz;
+        auto isOct = [](char c) { return c >= '0' && c <= '7'; };
+        auto isDig = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+
+        if (p[0] == '0' && p[1] != '\0') {
+            int base = 0;
+            const char *start  = p + 2;
+            const char *digits = start;
+            if      (p[1] == 'b' || p[1] == 'B') { base = 2;  while (*digits == '0' || *digits == '1') ++digits; }
+            else if (p[1] == 'x' || p[1] == 'X') { base = 16; while (std::isxdigit(static_cast<unsigned char>(*digits))) ++digits; }
+            else if (p[1] == 'o' || p[1] == 'O') { base = 8;  while (isOct(*digits)) ++digits; }
+            else if (isOct(p[1])) {
+                // legacy octal, unless the digits continue as a decimal float
+                start = digits = p + 1;
+                while (isOct(*digits)) ++digits;
+                if (*digits != '8' && *digits != '9' && *digits != '.' && *digits != 'e' && *digits != 'E')
+                    base = 8;
+            }
+            if (base != 0) {
+                if (digits == start || *digits != '\0') return false;
+                errno = 0;
+                unsigned long long u = std::strtoull(start, nullptr, base);
+                if (errno == ERANGE) return false;
+                value = static_cast<double>(u);
+                return true;
+            }
+        }
+
+        // decimal integer / float, optional exponent
+        while (isDig(*p) || *p == '.') ++p;
+        if (p == psz) return false;
+        if (*p == 'e' || *p == 'E') {
+            const char *q = p + 1;
+            if (*q == '+' || *q == '-') ++q;
+            if (isDig(*q)) {
+                while (isDig(*q)) ++q;
+                p = q;
+            }
+        }
+        if (*p != '\0') return false;
+
+        errno = 0;
+        char *pEnd = nullptr;
+        value = std::strtod(psz, &pEnd);
+        return (pEnd != psz) && (errno != ERANGE);
+    }
+
+    // Parse expr into a reusable program.  With bAllowHoles "$<n>" denotes
+    // the n-th caller-supplied value.  Throws std::runtime_error on parse errors.
+    static CalcProgram compile(const std::string& expr, bool bAllowHoles = false)
+    {
+        Calculator calc(expr, bAllowHoles);
+        CalcProgram prog;
+        calc.compileInto(prog);
+        return prog;
+    }
+
+    // Run a compiled program against vars (constants must already be seeded).
+    // pHoles must provide prog.szNrHoles values.  Throws std::runtime_error on
+    // domain errors and undefined variables.  Does not allocate once every
+    // referenced variable has been bound.
+    static double run(const CalcProgram& prog, VarMap& vars, const double *pHoles = nullptr)
+    {
+        using Op = CalcProgram::Op;
+
+        if (prog.pBoundVars != &vars) {
+            prog.vpBound.assign(prog.vNames.size(), nullptr);
+            prog.pBoundVars = &vars;
+        }
+
+        constexpr size_t kLocalDepth = 32U;
+        double aLocal[kLocalDepth];
+        std::vector<double> vHeap;
+        double *st = aLocal;
+        if (prog.szMaxDepth > kLocalDepth) {
+            vHeap.resize(prog.szMaxDepth);
+            st = vHeap.data();
+        }
+        size_t sp = 0;   // number of values on the stack
+
+        for (const auto& ins : prog.vCode) {
+            switch (ins.eOp) {
+                case Op::CONST: st[sp++] = prog.vConsts[ins.uArg]; break;
+                case Op::HOLE:  st[sp++] = pHoles[ins.uArg];       break;
+
+                case Op::LOAD: {
+                    double *&pVar = prog.vpBound[ins.uArg];
+                    if (nullptr == pVar) {
+                        auto it = vars.find(prog.vNames[ins.uArg]);
+                        if (it == vars.end())
+                            throw std::runtime_error("Undefined variable: " + prog.vNames[ins.uArg]);
+                        pVar = &it->second;
+                    }
+                    st[sp++] = *pVar;
+                    break;
+                }
+                case Op::STORE: {
+                    double *&pVar = prog.vpBound[ins.uArg];
+                    if (nullptr == pVar) {
+                        pVar = &vars[prog.vNames[ins.uArg]];
+                    }
+                    *pVar = st[sp - 1];   // the assigned value stays on the stack
+                    break;
+                }
+
+                case Op::NEG:  st[sp - 1] = -st[sp - 1];                                    break;
+                case Op::NOT:  st[sp - 1] = (st[sp - 1] == 0.0) ? 1.0 : 0.0;                break;
+                case Op::BNOT: st[sp - 1] = static_cast<double>(~toInt(st[sp - 1]));        break;
+
+                case Op::SELECT: {
+                    sp -= 2;
+                    st[sp - 1] = (st[sp - 1] != 0.0) ? st[sp] : st[sp + 1];
+                    break;
+                }
+
+                case Op::FUNC: {
+                    const auto eFunc = static_cast<CalcProgram::Func>(ins.uArg);
+                    if (isBinary(eFunc)) {
+                        --sp;
+                        st[sp - 1] = callFunction(eFunc, st[sp - 1], st[sp]);
+                    } else {
+                        st[sp - 1] = callFunction(eFunc, st[sp - 1], 0.0);
+                    }
+                    break;
+                }
+
+                default: {
+                    --sp;
+                    st[sp - 1] = binaryOp(ins.eOp, st[sp - 1], st[sp]);
+                    break;
+                }
+            }
+        }
+
+        return st[0];
+    }
+
+private:
+    std::string  m_expr;
+    size_t       m_pos;
+    VarMap      *m_pVars       = nullptr;   // nullptr when only compiling
+    bool         m_bAllowHoles = false;
+    CalcProgram  m_prog;
+
+    // program being emitted and its simulated stack depth
+    CalcProgram *m_pOut   = nullptr;
+    size_t       m_szDepth = 0U;
+
+    Calculator(const std::string& expr, bool bAllowHoles)
+        : m_expr(expr), m_pos(0), m_bAllowHoles(bAllowHoles)
+    {}
+
+    void compileInto(CalcProgram& prog)
+    {
+        prog      = CalcProgram{};
+        m_pOut    = &prog;
+        m_szDepth = 0U;
+        m_pos     = 0;
+        parseAssignment();
         skipWhitespace();
         if (m_pos < m_expr.size()) {
             throw std::runtime_error(
                 std::string("Unexpected token at position ") +
                 std::to_string(m_pos) + ": '" + m_expr[m_pos] + "'");
         }
-        return result;
+        m_pOut = nullptr;
     }
 
-private:
-    std::string m_expr;
-    size_t      m_pos;
-    std::unordered_map<std::string, double>& m_vars;
+    // ─────────────────────────────────────────────────────────────────────────
+    // Emitters
+    // ─────────────────────────────────────────────────────────────────────────
+
+    void emit(CalcProgram::Op eOp, uint32_t uArg, int iStackDelta)
+    {
+        m_pOut->vCode.push_back({eOp, uArg});
+        m_szDepth = static_cast<size_t>(static_cast<long long>(m_szDepth) + iStackDelta);
+        if (m_szDepth > m_pOut->szMaxDepth) {
+            m_pOut->szMaxDepth = m_szDepth;
+        }
+    }
+
+    void emitOp(CalcProgram::Op eOp)        // binary operator: pops 2, pushes 1
+    {
+        emit(eOp, 0U, -1);
+    }
+
+    void emitUnary(CalcProgram::Op eOp)     // pops 1, pushes 1
+    {
+        emit(eOp, 0U, 0);
+    }
+
+    void emitConst(double v)
+    {
+        m_pOut->vConsts.push_back(v);
+        emit(CalcProgram::Op::CONST, static_cast<uint32_t>(m_pOut->vConsts.size() - 1U), +1);
+    }
+
+    uint32_t nameIndex(const std::string& name)
+    {
+        for (size_t i = 0; i < m_pOut->vNames.size(); ++i) {
+            if (m_pOut->vNames[i] == name) return static_cast<uint32_t>(i);
+        }
+        m_pOut->vNames.push_back(name);
+        return static_cast<uint32_t>(m_pOut->vNames.size() - 1U);
+    }
 
     // ─────────────────────────────────────────────────────────────────────────
     // Utilities
@@ -204,13 +477,126 @@ private:
         return static_cast<int64_t>(v);
     }
 
+    // ─────────────────────────────────────────────────────────────────────────
+    // Run-time operators
+    // ─────────────────────────────────────────────────────────────────────────
+
+    static double binaryOp(CalcProgram::Op eOp, double lhs, double rhs)
+    {
+        using Op = CalcProgram::Op;
+
+        switch (eOp) {
+            case Op::ADD:  return lhs + rhs;
+            case Op::SUB:  return lhs - rhs;
+            case Op::MUL:  return lhs * rhs;
+            case Op::DIV:
+                if (rhs == 0.0)
+                    throw std::runtime_error("Division by zero");
+                return lhs / rhs;
+            case Op::FDIV:
+                if (rhs == 0.0)
+                    throw std::runtime_error("Floor division by zero");
+                return std::floor(lhs / rhs);
+            case Op::MOD:
+                if (rhs == 0.0)
+                    throw std::runtime_error("Modulo by zero");
+                return std::fmod(lhs, rhs);
+            case Op::POW:  return std::pow(lhs, rhs);
+            case Op::SHL:  return static_cast<double>(toInt(lhs) << toInt(rhs));
+            case Op::SHR:  return static_cast<double>(toInt(lhs) >> toInt(rhs));
+            case Op::BAND: return static_cast<double>(toInt(lhs) & toInt(rhs));
+            case Op::BXOR: return static_cast<double>(toInt(lhs) ^ toInt(rhs));
+            case Op::BOR:  return static_cast<double>(toInt(lhs) | toInt(rhs));
+            case Op::EQ:   return (lhs == rhs) ? 1.0 : 0.0;
+            case Op::NE:   return (lhs != rhs) ? 1.0 : 0.0;
+            case Op::LT:   return (lhs <  rhs) ? 1.0 : 0.0;
+            case Op::LE:   return (lhs <= rhs) ? 1.0 : 0.0;
+            case Op::GT:   return (lhs >  rhs) ? 1.0 : 0.0;
+            case Op::GE:   return (lhs >= rhs) ? 1.0 : 0.0;
+            case Op::LAND: return ((lhs != 0.0) && (rhs != 0.0)) ? 1.0 : 0.0;
+            case Op::LOR:  return ((lhs != 0.0) || (rhs != 0.0)) ? 1.0 : 0.0;
+            default:
+                throw std::runtime_error("Invalid operator in compiled expression");
+        }
+    }
+
+    static bool isBinary(CalcProgram::Func eFunc)
+    {
+        return eFunc >= CalcProgram::Func::POW;
+    }
+
+    static double callFunction(CalcProgram::Func eFunc, double a, double b)
+    {
+        using F = CalcProgram::Func;
+
+        switch (eFunc) {
+            // Trigonometric
+            case F::SIN:   return std::sin(a);
+            case F::COS:   return std::cos(a);
+            case F::TAN:   return std::tan(a);
+            case F::ASIN:
+                if (a < -1.0 || a > 1.0) throw std::runtime_error("asin: domain error (|x| > 1)");
+                return std::asin(a);
+            case F::ACOS:
+                if (a < -1.0 || a > 1.0) throw std::runtime_error("acos: domain error (|x| > 1)");
+                return std::acos(a);
+            case F::ATAN:  return std::atan(a);
+            case F::SINH:  return std::sinh(a);
+            case F::COSH:  return std::cosh(a);
+            case F::TANH:  return std::tanh(a);
+
+            // Exponential / logarithmic
+            case F::SQRT:
+                if (a < 0.0) throw std::runtime_error("sqrt: domain error (negative argument)");
+                return std::sqrt(a);
+            case F::CBRT:  return std::cbrt(a);
+            case F::EXP:   return std::exp(a);
+            case F::EXP2:  return std::exp2(a);
+            case F::LOG:
+                if (a <= 0.0) throw std::runtime_error("log: domain error (argument <= 0)");
+                return std::log(a);
+            case F::LOG2:
+                if (a <= 0.0) throw std::runtime_error("log2: domain error (argument <= 0)");
+                return std::log2(a);
+            case F::LOG10:
+                if (a <= 0.0) throw std::runtime_error("log10: domain error (argument <= 0)");
+                return std::log10(a);
+
+            // Rounding
+            case F::ABS:   return std::abs(a);
+            case F::CEIL:  return std::ceil(a);
+            case F::FLOOR: return std::floor(a);
+            case F::ROUND: return std::round(a);
+            case F::TRUNC: return std::trunc(a);
+
+            // Sign
+            case F::SIGN:  return (a > 0.0) ? 1.0 : (a < 0.0) ? -1.0 : 0.0;
+
+            // Two-argument functions
+            case F::POW:   return std::pow(a, b);
+            case F::ATAN2: return std::atan2(a, b);
+            case F::MIN:   return std::min(a, b);
+            case F::MAX:   return std::max(a, b);
+            case F::HYPOT: return std::hypot(a, b);
+            case F::FMOD:
+                if (b == 0.0) throw std::runtime_error("fmod: second argument is zero");
+                return std::fmod(a, b);
+            case F::LOG_B:
+                // log_b(value, base) = log(value) / log(base)
+                if (a <= 0.0) throw std::runtime_error("log_b: value must be > 0");
+                if (b <= 0.0 || b == 1.0) throw std::runtime_error("log_b: base must be > 0 and != 1");
+                return std::log(a) / std::log(b);
+        }
+        throw std::runtime_error("Invalid function in compiled expression");
+    }
+
     // ─────────────────────────────────────────────────────────────────────────
     // Grammar rules  (see header comment for full precedence table)
     // ─────────────────────────────────────────────────────────────────────────
 
     // assignment := ternary [ '=' assignment ]   (right-associative)
     // F2: Only treat '=' as assignment when NOT preceded/followed by '='/'!'/'<'/'>'
-    double parseAssignment()
+    void parseAssignment()
     {
         // Snapshot position to rewind if needed
         size_t savedPos = m_pos;
@@ -221,7 +607,6 @@ private:
         if (m_pos < m_expr.size() && (std::isalpha(static_cast<unsigned char>(m_expr[m_pos]))
                                        || m_expr[m_pos] == '_'))
         {
-            size_t nameStart = m_pos;
             std::string name;
             while (m_pos < m_expr.size() &&
                    (std::isalnum(static_cast<unsigned char>(m_expr[m_pos])) ||
@@ -236,75 +621,72 @@ private:
                 (m_pos + 1 >= m_expr.size() || m_expr[m_pos + 1] != '='))
             {
                 ++m_pos; // consume '='
-                double value = parseAssignment(); // right-associative
-                m_vars[name] = value;
-                return value;
+                parseAssignment(); // right-associative
+                emit(CalcProgram::Op::STORE, nameIndex(name), 0);
+                return;
             }
 
             // Not an assignment — rewind and parse as a normal expression
             m_pos = savedPos;
         }
 
-        return parseTernary();
+        parseTernary();
     }
 
     // ternary := logical_or [ '?' expr ':' expr ]
-    double parseTernary()
+    void parseTernary()
     {
-        double cond = parseLogicalOr();
+        parseLogicalOr();
         skipWhitespace();
         if (m_pos < m_expr.size() && m_expr[m_pos] == '?') {
             ++m_pos;
-            double vtrue  = parseAssignment();
+            parseAssignment();
             expect(':', "in ternary operator");
-            double vfalse = parseAssignment();
-            return (cond != 0.0) ? vtrue : vfalse;
+            parseAssignment();
+            emit(CalcProgram::Op::SELECT, 0U, -2);
         }
-        return cond;
     }
 
     // logical_or := logical_and ( '||' logical_and )*
-    double parseLogicalOr()
+    void parseLogicalOr()
     {
-        double lhs = parseLogicalAnd();
+        parseLogicalAnd();
         while (true) {
             skipWhitespace();
             if (m_pos + 1 < m_expr.size() &&
                 m_expr[m_pos] == '|' && m_expr[m_pos + 1] == '|')
             {
                 m_pos += 2;
-                double rhs = parseLogicalAnd();
-                lhs = ((lhs != 0.0) || (rhs != 0.0)) ? 1.0 : 0.0;
+                parseLogicalAnd();
+                emitOp(CalcProgram::Op::LOR);
             } else {
                 break;
             }
         }
-        return lhs;
     }
 
     // logical_and := bitwise_or ( '&&' bitwise_or )*
-    double parseLogicalAnd()
+    void parseLogicalAnd()
     {
-        double lhs = parseBitwiseOr();
+        parseBitwiseOr();
         while (true) {
             skipWhitespace();
             if (m_pos + 1 < m_expr.size() &&
                 m_expr[m_pos] == '&' && m_expr[m_pos + 1] == '&')
             {
                 m_pos += 2;
-                double rhs = parseBitwiseOr();
-                lhs = ((lhs != 0.0) && (rhs != 0.0)) ? 1.0 : 0.0;
+                parseBitwiseOr();
+                emitOp(CalcProgram::Op::LAND);
             } else {
                 break;
             }
         }
-        return lhs;
     }
 
     // bitwise_or := bitwise_xor ( '|' bitwise_xor )*
-    double parseBitwiseOr()
+    void parseBitwiseOr()
     {
-        double lhs = parseBitwiseXor();
+        parseBitwiseXor();
         while (true) {
             skipWhitespace();
             // Single '|' not followed by '|'
@@ -312,38 +694,36 @@ private:
                 (m_pos + 1 >= m_expr.size() || m_expr[m_pos + 1] != '|'))
             {
                 ++m_pos;
-                double rhs = parseBitwiseXor();
-                lhs = static_cast<double>(toInt(lhs) | toInt(rhs));
+                parseBitwiseXor();
+                emitOp(CalcProgram::Op::BOR);
             } else {
                 break;
             }
         }
-        return lhs;
     }
 
     // bitwise_xor := bitwise_and ( '^' bitwise_and )*
     // N5: '^' means XOR; power is '**'
-    double parseBitwiseXor()
+    void parseBitwiseXor()
     {
-        double lhs = parseBitwiseAnd();
+        parseBitwiseAnd();
         while (true) {
             skipWhitespace();
             if (m_pos < m_expr.size() && m_expr[m_pos] == '^')
             {
                 ++m_pos;
-                double rhs = parseBitwiseAnd();
-                lhs = static_cast<double>(toInt(lhs) ^ toInt(rhs));
+                parseBitwiseAnd();
+                emitOp(CalcProgram::Op::BXOR);
             } else {
                 break;
             }
         }
-        return lhs;
     }
 
     // bitwise_and := equality ( '&' equality )*
-    double parseBitwiseAnd()
+    void parseBitwiseAnd()
     {
-        double lhs = parseEquality();
+        parseEquality();
         while (true) {
             skipWhitespace();
             // Single '&' not followed by '&'
@@ -351,114 +731,111 @@ private:
                 (m_pos + 1 >= m_expr.size() || m_expr[m_pos + 1] != '&'))
             {
                 ++m_pos;
-                double rhs = parseEquality();
-                lhs = static_cast<double>(toInt(lhs) & toInt(rhs));
+                parseEquality();
+                emitOp(CalcProgram::Op::BAND);
             } else {
                 break;
             }
         }
-        return lhs;
     }
 
     // equality := relational ( ('=='|'!=') relational )*
-    double parseEquality()
+    void parseEquality()
     {
-        double lhs = parseRelational();
+        parseRelational();
         while (true) {
             skipWhitespace();
             if (m_pos + 1 < m_expr.size() &&
                 m_expr[m_pos] == '=' && m_expr[m_pos + 1] == '=')
             {
                 m_pos += 2;
-                double rhs = parseRelational();
-                lhs = (lhs == rhs) ? 1.0 : 0.0;
+                parseRelational();
+                emitOp(CalcProgram::Op::EQ);
             }
             else if (m_pos + 1 < m_expr.size() &&
                      m_expr[m_pos] == '!' && m_expr[m_pos + 1] == '=')
             {
                 m_pos += 2;
-                double rhs = parseRelational();
-                lhs = (lhs != rhs) ? 1.0 : 0.0;
+                parseRelational();
+                emitOp(CalcProgram::Op::NE);
             }
             else {
                 break;
             }
         }
-        return lhs;
     }
 
     // relational := shift ( ('<'|'<='|'>'|'>=') shift )*
-    double parseRelational()
+    void parseRelational()
     {
-        double lhs = parseShift();
+        using Op = CalcProgram::Op;
+
+        parseShift();
         while (true) {
             skipWhitespace();
             if (m_pos < m_expr.size()) {
                 char c = m_expr[m_pos];
                 char c2 = (m_pos + 1 < m_expr.size()) ? m_expr[m_pos + 1] : '\0';
 
-                if (c == '<' && c2 == '=') { m_pos += 2; double r = parseShift(); lhs = (lhs <= r) ? 1.0 : 0.0; }
-                else if (c == '>' && c2 == '=') { m_pos += 2; double r = parseShift(); lhs = (lhs >= r) ? 1.0 : 0.0; }
-                else if (c == '<' && c2 != '<') { ++m_pos;    double r = parseShift(); lhs = (lhs <  r) ? 1.0 : 0.0; }
-                else if (c == '>' && c2 != '>') { ++m_pos;    double r = parseShift(); lhs = (lhs >  r) ? 1.0 : 0.0; }
+                if (c == '<' && c2 == '=') { m_pos += 2; parseShift(); emitOp(Op::LE); }
+                else if (c == '>' && c2 == '=') { m_pos += 2; parseShift(); emitOp(Op::GE); }
+                else if (c == '<' && c2 != '<') { ++m_pos;    parseShift(); emitOp(Op::LT); }
+                else if (c == '>' && c2 != '>') { ++m_pos;    parseShift(); emitOp(Op::GT); }
                 else break;
             } else {
                 break;
             }
         }
-        return lhs;
     }
 
     // shift := additive ( ('<<'|'>>') additive )*
-    double parseShift()
+    void parseShift()
     {
-        double lhs = parseAdditive();
+        parseAdditive();
         while (true) {
             skipWhitespace();
             if (m_pos + 1 < m_expr.size() &&
                 m_expr[m_pos] == '<' && m_expr[m_pos + 1] == '<')
             {
                 m_pos += 2;
-                double rhs = parseAdditive();
-                lhs = static_cast<double>(toInt(lhs) << toInt(rhs));
+                parseAdditive();
+                emitOp(CalcProgram::Op::SHL);
             }
             else if (m_pos + 1 < m_expr.size() &&
                      m_expr[m_pos] == '>' && m_expr[m_pos + 1] == '>')
             {
                 m_pos += 2;
-                double rhs = parseAdditive();
-                lhs = static_cast<double>(toInt(lhs) >> toInt(rhs));
+                parseAdditive();
+                emitOp(CalcProgram::Op::SHR);
             }
             else {
                 break;
             }
         }
-        return lhs;
     }
 
     // additive := term ( ('+'|'-') term )*
-    double parseAdditive()
+    void parseAdditive()
     {
-        double lhs = parseTerm();
+        parseTerm();
         while (true) {
             skipWhitespace();
             if (m_pos < m_expr.size() &&
                 (m_expr[m_pos] == '+' || m_expr[m_pos] == '-'))
             {
                 char op = m_expr[m_pos++];
-                double rhs = parseTerm();
-                lhs = (op == '+') ? lhs + rhs : lhs - rhs;
+                parseTerm();
+                emitOp((op == '+') ? CalcProgram::Op::ADD : CalcProgram::Op::SUB);
             } else {
                 break;
             }
         }
-        return lhs;
     }
 
     // term := unary ( ('*'|'/'|'//'|'%') unary )*
-    double parseTerm()
+    void parseTerm()
     {
-        double lhs = parseUnary();
+        parseUnary();
         while (true) {
             skipWhitespace();
             if (m_pos < m_expr.size()) {
@@ -467,67 +844,51 @@ private:
                     m_expr[m_pos] == '/' && m_expr[m_pos + 1] == '/')
                 {
                     m_pos += 2;
-                    double rhs = parseUnary();
-                    if (rhs == 0.0)
-                        throw std::runtime_error("Floor division by zero");
-                    lhs = std::floor(lhs / rhs);
-                }
-                else if (m_expr[m_pos] == '*') { ++m_pos; lhs *= parseUnary(); }
-                else if (m_expr[m_pos] == '/') {
-                    ++m_pos;
-                    double rhs = parseUnary();
-                    if (rhs == 0.0)
-                        throw std::runtime_error("Division by zero");
-                    lhs /= rhs;
-                }
-                else if (m_expr[m_pos] == '%') {
-                    ++m_pos;
-                    double rhs = parseUnary();
-                    if (rhs == 0.0)
-                        throw std::runtime_error("Modulo by zero");
-                    lhs = std::fmod(lhs, rhs);
+                    parseUnary();
+                    emitOp(CalcProgram::Op::FDIV);
                 }
+                else if (m_expr[m_pos] == '*') { ++m_pos; parseUnary(); emitOp(CalcProgram::Op::MUL); }
+                else if (m_expr[m_pos] == '/') { ++m_pos; parseUnary(); emitOp(CalcProgram::Op::DIV); }
+                else if (m_expr[m_pos] == '%') { ++m_pos; parseUnary(); emitOp(CalcProgram::Op::MOD); }
                 else { break; }
             } else {
                 break;
             }
         }
-        return lhs;
     }
 
     // unary := ('+' | '-' | '!' | '~') unary  |  power
-    double parseUnary()
+    void parseUnary()
     {
         skipWhitespace();
         if (m_pos < m_expr.size()) {
-            if (m_expr[m_pos] == '+') { ++m_pos; return  parseUnary(); }
-            if (m_expr[m_pos] == '-') { ++m_pos; return -parseUnary(); }
-            if (m_expr[m_pos] == '!') { ++m_pos; return (parseUnary() == 0.0) ? 1.0 : 0.0; }
-            if (m_expr[m_pos] == '~') { ++m_pos; return static_cast<double>(~toInt(parseUnary())); }
+            if (m_expr[m_pos] == '+') { ++m_pos; parseUnary(); return; }
+            if (m_expr[m_pos] == '-') { ++m_pos; parseUnary(); emitUnary(CalcProgram::Op::NEG);  return; }
+            if (m_expr[m_pos] == '!') { ++m_pos; parseUnary(); emitUnary(CalcProgram::Op::NOT);  return; }
+            if (m_expr[m_pos] == '~') { ++m_pos; parseUnary(); emitUnary(CalcProgram::Op::BNOT); return; }
         }
-        return parsePower();
+        parsePower();
     }
 
     // power := primary ('**' unary)*  right-associative
-    double parsePower()
+    void parsePower()
     {
-        double base = parseImplicitMul();
+        parseImplicitMul();
         skipWhitespace();
         if (m_pos + 1 < m_expr.size() &&
             m_expr[m_pos] == '*' && m_expr[m_pos + 1] == '*')
         {
             m_pos += 2;
-            double exp = parseUnary(); // right-assoc → recurse into unary
-            return std::pow(base, exp);
+            parseUnary(); // right-assoc → recurse into unary
+            emitOp(CalcProgram::Op::POW);
         }
-        return base;
     }
 
     // implicit_mul := primary (primary)*
     // Handles: 2pi   3(x+1)   (a+b)(a-b)
-    double parseImplicitMul()
+    void parseImplicitMul()
     {
-        double result = parsePrimary();
+        parsePrimary();
         while (true) {
             skipWhitespace();
             if (m_pos >= m_expr.size()) break;
@@ -538,16 +899,16 @@ private:
                 std::isalpha(static_cast<unsigned char>(c)) ||
                 c == '_')
             {
-                result *= parsePrimary();
+                parsePrimary();
+                emitOp(CalcProgram::Op::MUL);
             } else {
                 break;
             }
         }
-        return result;
     }
 
-    // primary := number | identifier_or_func | '(' expr ')'
-    double parsePrimary()
+    // primary := number | identifier_or_func | '(' expr ')' | hole
+    void parsePrimary()
     {
         skipWhitespace();
         if (m_pos >= m_expr.size())
@@ -555,20 +916,43 @@ private:
 
         if (m_expr[m_pos] == '(') {
             ++m_pos;
-            double result = parseAssignment();
+            parseAssignment();
             expect(')', "closing sub-expression");
-            return result;
+            return;
         }
 
         if (std::isalpha(static_cast<unsigned char>(m_expr[m_pos])) ||
             m_expr[m_pos] == '_')
         {
-            return parseFunctionOrVariable();
+            parseFunctionOrVariable();
+            return;
+        }
+
+        if (m_bAllowHoles && m_expr[m_pos] == '$') {
+            parseHole();
+            return;
         }
 
-        return parseNumber();
+        emitConst(parseNumber());
     }
 
+    // hole := '$' digits   (compile() with bAllowHoles only)
+    void parseHole()
+    {
+        size_t start = ++m_pos;
+        uint32_t idx = 0U;
+        while (m_pos < m_expr.size() &&
+               std::isdigit(static_cast<unsigned char>(m_expr[m_pos])))
+            idx = idx * 10U + static_cast<uint32_t>(m_expr[m_pos++] - '0');
+        if (m_pos == start)
+            throw std::runtime_error(
+                std::string("Expected hole index at position ") + std::to_string(m_pos));
+        if (idx + 1U > m_pOut->szNrHoles)
+            m_pOut->szNrHoles = idx + 1U;
+        emit(CalcProgram::Op::HOLE, idx, +1);
+    }
+
+
     // ─────────────────────────────────────────────────────────────────────────
     // Number parser — F3: supports scientific notation, unary sign handled
     // by parseUnary so parseNumber only handles the unsigned numeric literal.
@@ -699,11 +1083,14 @@ private:
         return std::stod(m_expr.substr(start, m_pos - start));
     }
 
+    // ─────────────────────────────────────────────────────────────────────────
+    // Identifier, variable, and function dispatch
+
     // ─────────────────────────────────────────────────────────────────────────
     // Identifier, variable, and function dispatch
     // F4: variable names allow alphanumeric + '_' (digits allowed after first char)
     // ─────────────────────────────────────────────────────────────────────────
-    double parseFunctionOrVariable()
+    void parseFunctionOrVariable()
     {
         std::string name;
         while (m_pos < m_expr.size() &&
@@ -718,142 +1105,62 @@ private:
         // Function call
         if (m_pos < m_expr.size() && m_expr[m_pos] == '(') {
             ++m_pos;
-            return dispatchFunction(name);
+            dispatchFunction(name);
+            return;
         }
 
-        // Variable / constant lookup
-        auto it = m_vars.find(name);
-        if (it != m_vars.end())
-            return it->second;
-
-        throw std::runtime_error("Undefined variable: " + name);
+        // Variable / constant lookup (resolved when the program runs)
+        emit(CalcProgram::Op::LOAD, nameIndex(name), +1);
     }
 
     // ─────────────────────────────────────────────────────────────────────────
     // Function dispatch — single-arg and two-arg
     // ─────────────────────────────────────────────────────────────────────────
-    double dispatchFunction(const std::string& name)
+    void dispatchFunction(const std::string& name)
     {
-        // Helper: read first argument (already past the opening '(')
-        auto readArg = [&]() -> double {
-            double v = parseAssignment();
-            skipWhitespace();
-            return v;
+        using F = CalcProgram::Func;
+
+        struct FuncEntry { const char *pszName; F eFunc; };
+        static const FuncEntry aFuncs[] = {
+            // Trigonometric
+            {"sin", F::SIN}, {"cos", F::COS}, {"tan", F::TAN},
+            {"asin", F::ASIN}, {"acos", F::ACOS}, {"atan", F::ATAN},
+            {"sinh", F::SINH}, {"cosh", F::COSH}, {"tanh", F::TANH},
+            // Exponential / logarithmic
+            {"sqrt", F::SQRT}, {"cbrt", F::CBRT}, {"exp", F::EXP}, {"exp2", F::EXP2},
+            {"log", F::LOG}, {"log2", F::LOG2}, {"log10", F::LOG10},
+            // Rounding
+            {"abs", F::ABS}, {"ceil", F::CEIL}, {"floor", F::FLOOR},
+            {"round", F::ROUND}, {"trunc", F::TRUNC},
+            // Sign
+            {"sign", F::SIGN},
+            // Two-argument functions
+            {"pow", F::POW}, {"atan2", F::ATAN2}, {"min", F::MIN}, {"max", F::MAX},
+            {"hypot", F::HYPOT}, {"fmod", F::FMOD}, {"log_b", F::LOG_B}
         };
 
-        // Helper: expect comma
-        auto comma = [&]() {
+        const FuncEntry *pEntry = nullptr;
+        for (const auto& entry : aFuncs) {
+            if (name == entry.pszName) { pEntry = &entry; break; }
+        }
+        if (nullptr == pEntry)
+            throw std::runtime_error("Unknown function: " + name);
+
+        // first argument (already past the opening '(')
+        parseAssignment();
+        skipWhitespace();
+
+        if (isBinary(pEntry->eFunc)) {
             expect(',', ("in function '" + name + "'").c_str());
             skipWhitespace();
-        };
-
-        // Helper: close paren
-        auto close = [&]() {
+            parseAssignment();
+            skipWhitespace();
             expect(')', ("closing '" + name + "()'").c_str());
-        };
-
-        // ── Single-argument functions ──────────────────────────────────────
-
-        // Trigonometric
-        if (name == "sin")   { double a = readArg(); close(); return std::sin(a); }
-        if (name == "cos")   { double a = readArg(); close(); return std::cos(a); }
-        if (name == "tan")   { double a = readArg(); close(); return std::tan(a); }
-        if (name == "asin")  {
-            double a = readArg(); close();
-            if (a < -1.0 || a > 1.0) throw std::runtime_error("asin: domain error (|x| > 1)");
-            return std::asin(a);
-        }
-        if (name == "acos")  {
-            double a = readArg(); close();
-            if (a < -1.0 || a > 1.0) throw std::runtime_error("acos: domain error (|x| > 1)");
-            return std::acos(a);
-        }
-        if (name == "atan")  { double a = readArg(); close(); return std::atan(a); }
-        if (name == "sinh")  { double a = readArg(); close(); return std::sinh(a); }
-        if (name == "cosh")  { double a = readArg(); close(); return std::cosh(a); }
-        if (name == "tanh")  { double a = readArg(); close(); return std::tanh(a); }
-
-        // Exponential / logarithmic
-        if (name == "sqrt")  {
-            double a = readArg(); close();
-            if (a < 0.0) throw std::runtime_error("sqrt: domain error (negative argument)");
-            return std::sqrt(a);
-        }
-        if (name == "cbrt")  { double a = readArg(); close(); return std::cbrt(a); }
-        if (name == "exp")   { double a = readArg(); close(); return std::exp(a); }
-        if (name == "exp2")  { double a = readArg(); close(); return std::exp2(a); }
-        if (name == "log")   {
-            double a = readArg(); close();
-            if (a <= 0.0) throw std::runtime_error("log: domain error (argument <= 0)");
-            return std::log(a);
-        }
-        if (name == "log2")  {
-            double a = readArg(); close();
-            if (a <= 0.0) throw std::runtime_error("log2: domain error (argument <= 0)");
-            return std::log2(a);
-        }
-        if (name == "log10") {
-            double a = readArg(); close();
-            if (a <= 0.0) throw std::runtime_error("log10: domain error (argument <= 0)");
-            return std::log10(a);
-        }
-
-        // Rounding
-        if (name == "abs")   { double a = readArg(); close(); return std::abs(a); }
-        if (name == "ceil")  { double a = readArg(); close(); return std::ceil(a); }
-        if (name == "floor") { double a = readArg(); close(); return std::floor(a); }
-        if (name == "round") { double a = readArg(); close(); return std::round(a); }
-        if (name == "trunc") { double a = readArg(); close(); return std::trunc(a); }
-
-        // Sign
-        if (name == "sign")  {
-            double a = readArg(); close();
-            return (a > 0.0) ? 1.0 : (a < 0.0) ? -1.0 : 0.0;
-        }
-
-        // ── Two-argument functions ─────────────────────────────────────────
-
-        if (name == "pow") {
-            double base = readArg(); comma();
-            double exp  = readArg(); close();
-            return std::pow(base, exp);
-        }
-        if (name == "atan2") {
-            double y = readArg(); comma();
-            double x = readArg(); close();
-            return std::atan2(y, x);
-        }
-        if (name == "min") {
-            double a = readArg(); comma();
-            double b = readArg(); close();
-            return std::min(a, b);
-        }
-        if (name == "max") {
-            double a = readArg(); comma();
-            double b = readArg(); close();
-            return std::max(a, b);
-        }
-        if (name == "hypot") {
-            double a = readArg(); comma();
-            double b = readArg(); close();
-            return std::hypot(a, b);
-        }
-        if (name == "fmod") {
-            double a = readArg(); comma();
-            double b = readArg(); close();
-            if (b == 0.0) throw std::runtime_error("fmod: second argument is zero");
-            return std::fmod(a, b);
-        }
-        if (name == "log_b") {
-            // log_b(value, base) = log(value) / log(base)
-            double v = readArg(); comma();
-            double b = readArg(); close();
-            if (v <= 0.0) throw std::runtime_error("log_b: value must be > 0");
-            if (b <= 0.0 || b == 1.0) throw std::runtime_error("log_b: base must be > 0 and != 1");
-            return std::log(v) / std::log(b);
-        }
-
-        throw std::runtime_error("Unknown function: " + name);
+            emit(CalcProgram::Op::FUNC, static_cast<uint32_t>(pEntry->eFunc), -1);
+        } else {
+            expect(')', ("closing '" + name + "()'").c_str());
+            emit(CalcProgram::Op::FUNC, static_cast<uint32_t>(pEntry->eFunc), 0);
+        }
     }
 };
 
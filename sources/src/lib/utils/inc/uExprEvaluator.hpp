@@ -67,6 +67,26 @@
  *
  *   REPEAT loop UNTIL EVAL $done == TRUE
  *   REPEAT loop UNTIL EVAL $i >= $max && $ok == TRUE
+ *
+ * ─────────────────────────────────────────────────────────────────────────────
+ * COMPILED EXPRESSIONS
+ * ─────────────────────────────────────────────────────────────────────────────
+ *
+ *   compile() parses an expression once into an EvalProgram: the atom list
+ *   with operators resolved and constant operands pre-parsed.  A word of the
+ *   form $<n> is a hole, filled at run time with the caller's n-th value:
+ *
+ *       EvalProgram prog;
+ *       EvalExprEvaluator::compile("$0 >= 10 && $1 == TRUE", prog);
+ *       const std::string* holes[] = { &count, &flag };
+ *       if (EvalExprEvaluator::canRun(prog, holes))
+ *           ok = EvalExprEvaluator{}.run(prog, holes, result);
+ *
+ *   run() gives the same result and log lines as evaluate() on the text
+ *   with the holes substituted.  canRun() is false when a value would change
+ *   the structure of that text (empty, contains whitespace, ...); evaluate
+ *   the substituted text instead.  compile() fails, without logging, for
+ *   anything evaluate() would reject while parsing.
  */
 
 #include "uLogger.hpp"
@@ -76,7 +96,10 @@
 #include <string>
 #include <string_view>
 #include <vector>
+#include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +120,43 @@
 //                     IMPLEMENTATION                            //
 ///////////////////////////////////////////////////////////////////
 
+// -----------------------------------------------------------------------------
+// Compiled EVAL expression (see COMPILED EXPRESSIONS above)
+// -----------------------------------------------------------------------------
+struct EvalProgram
+{
+    static constexpr uint32_t kNoHole = std::numeric_limits<uint32_t>::max();
+
+    struct Operand {
+        uint32_t    uHole = kNoHole;    // hole index, kNoHole for a constant word
+        std::string strText;            // constant word
+        // constant word, pre-parsed
+        bool        bIsBool = false;    // type inference flags
+        bool        bIsNum  = false;
+        bool        bIsVer  = false;
+        bool        bNumOk  = false;  double dNum = 0.0;
+        bool        bVerOk  = false;  VectorValidator::VersionParts sVer;
+        bool        bBoolOk = false;  bool   bBool = false;
+    };
+
+    struct Atom {
+        Operand       sLhs;
+        Operand       sRhs;
+        std::string   strOp;                        // operator without :TYPE
+        bool          bTyped    = false;            // explicit :TYPE given
+        eValidateType eType     = eValidateType::STRING;
+        ComparisonOp  eStrOp    = ComparisonOp::UNKNOWN;   // strOp for STRING
+        ComparisonOp  eNumOp    = ComparisonOp::UNKNOWN;   // strOp for the other types
+        bool          bBoolOnly = false;            // lone TRUE / FALSE / !TRUE / !FALSE
+        bool          bOr       = false;            // joined to the previous atom by ||
+    };
+
+    std::vector<Atom> vAtoms;
+    size_t            szNrHoles  = 0U;
+    uint32_t          uFirstHole = kNoHole;         // hole that is the first word
+};
+
+
 class EvalExprEvaluator
 {
 public:
@@ -124,6 +184,118 @@ public:
         }
     }
 
+    // -----------------------------------------------------------------------
+    // compile()
+    //
+    // Parse expr (without the "EVAL " prefix) into prog, following exactly
+    // the grammar walk of m_parseCompound.  Returns false, without logging,
+    // if the expression is malformed or a hole sits where a value would
+    // decide the structure (operator, connector, type hint).
+    // -----------------------------------------------------------------------
+    static bool compile(const std::string& expr, EvalProgram& prog)
+    {
+        prog = EvalProgram{};
+        std::string_view sv(expr);
+
+        {
+            std::string_view peek  = sv;
+            std::string_view first = m_nextWord(peek);
+            if (first == "EVAL") {
+                sv = peek;
+            } else {
+                // a hole holding "EVAL" would be skipped: see canRun()
+                m_holeIndex(first, prog.uFirstHole);
+            }
+        }
+
+        bool bOr = false;
+        while (true) {
+            EvalProgram::Atom atom;
+            atom.bOr = bOr;
+            if (!m_compileAtom(sv, atom, prog)) return false;
+            prog.vAtoms.push_back(std::move(atom));
+
+            std::string_view saved = sv;
+            std::string_view token = m_nextWord(sv);
+            uint32_t uHole = EvalProgram::kNoHole;
+            if (m_holeIndex(token, uHole)) return false;   // could be a connector
+            if (token == "&&" || token == "||") {
+                bOr = (token == "||");
+            } else {
+                sv = saved;     // evaluate() ignores what follows the last atom
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------
+    // canRun()
+    //
+    // True when substituting ppHoles[0 .. szNrHoles) into the expression text
+    // keeps the structure prog was compiled from.
+    // -----------------------------------------------------------------------
+    static bool canRun(const EvalProgram& prog, const std::string* const* ppHoles) noexcept
+    {
+        for (size_t i = 0; i < prog.szNrHoles; ++i) {
+            const std::string& v = *ppHoles[i];
+            if (v.empty()) return false;
+            for (char c : v) {
+                if (std::isspace(static_cast<unsigned char>(c))) return false;
+            }
+        }
+
+        if (prog.uFirstHole != EvalProgram::kNoHole && *ppHoles[prog.uFirstHole] == "EVAL") {
+            return false;
+        }
+
+        for (const auto& atom : prog.vAtoms) {
+            if (atom.bBoolOnly && atom.sLhs.uHole != EvalProgram::kNoHole &&
+                !m_isBoolLiteral(*ppHoles[atom.sLhs.uHole])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------
+    // run()
+    //
+    // Evaluate a compiled expression (canRun() must hold).  Same return
+    // value, result and log lines as evaluate() on the substituted text.
+    // -----------------------------------------------------------------------
+    bool run(const EvalProgram& prog, const std::string* const* ppHoles, bool& result) const
+    {
+        try {
+            bool bAny = false;      // value of the || chain so far
+            bool bAll = false;      // value of the current && chain
+            for (size_t i = 0; i < prog.vAtoms.size(); ++i) {
+                const auto& atom = prog.vAtoms[i];
+                bool bAtom = false;
+                if (!m_runAtom(atom, ppHoles, bAtom)) return false;
+
+                if (i == 0) {
+                    bAll = bAtom;
+                } else if (atom.bOr) {
+                    bAny = bAny || bAll;
+                    bAll = bAtom;
+                } else {
+                    bAll = bAll && bAtom;
+                }
+            }
+            result = bAny || bAll;
+            return true;
+        } catch (const std::exception& ex) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("EVAL exception:"); LOG_STRING(ex.what()));
+            return false;
+        } catch (...) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("EVAL unknown exception"));
+            return false;
+        }
+    }
+
 private:
 
     // ─────────────────────────────────────────────────────────────────────
@@ -393,6 +565,212 @@ private:
         return true;
     }
 
+    // ─────────────────────────────────────────────────────────────────────
+    // Compiled form
+    // ─────────────────────────────────────────────────────────────────────
+
+    // "$<n>" → n
+    static bool m_holeIndex(std::string_view word, uint32_t& uHole)
+    {
+        if (word.size() < 2 || word[0] != '$' || word.size() > 10) return false;
+        uint32_t n = 0;
+        for (size_t i = 1; i < word.size(); ++i) {
+            if (!std::isdigit(static_cast<unsigned char>(word[i]))) return false;
+            n = (n * 10U) + static_cast<uint32_t>(word[i] - '0');
+        }
+        uHole = n;
+        return true;
+    }
+
+    static void m_compileOperand(std::string_view word, EvalProgram::Operand& op, EvalProgram& prog)
+    {
+        if (m_holeIndex(word, op.uHole)) {
+            prog.szNrHoles = std::max<size_t>(prog.szNrHoles, op.uHole + 1U);
+            return;
+        }
+        op.strText = std::string(word);
+        op.bIsBool = m_isBoolLiteral(word);
+        op.bIsNum  = m_isNumericLiteral(word);
+        op.bIsVer  = m_isVersionLiteral(word);
+        op.bNumOk  = VectorValidator::tryParseDouble(op.strText, op.dNum);
+        op.bVerOk  = VectorValidator::tryParseVersion(op.strText, op.sVer);
+        op.bBoolOk = VectorValidator::tryParseBool(op.strText, op.bBool);
+    }
+
+    // Mirror of m_parseAtom, building the atom instead of evaluating it.
+    static bool m_compileAtom(std::string_view& sv, EvalProgram::Atom& atom, EvalProgram& prog)
+    {
+        uint32_t uHole = EvalProgram::kNoHole;
+
+        std::string_view word1 = m_nextWord(sv);
+        if (word1.empty()) return false;
+        m_compileOperand(word1, atom.sLhs, prog);
+
+        std::string_view svAfterWord1 = sv;
+        std::string_view word2 = m_nextWord(sv);
+        if (m_holeIndex(word2, uHole)) return false;
+
+        if (word2.empty() || word2 == "&&" || word2 == "||") {
+            sv = svAfterWord1;
+            atom.bBoolOnly = true;
+            if (atom.sLhs.uHole != EvalProgram::kNoHole) return true;   // checked by canRun()
+            // BoolExprEvaluator only accepts the upper-case forms
+            const std::string& w = atom.sLhs.strText;
+            if      (w == "TRUE"  || w == "!FALSE") atom.sLhs.bBool = true;
+            else if (w == "FALSE" || w == "!TRUE")  atom.sLhs.bBool = false;
+            else return false;
+            return true;
+        }
+
+        std::string opRaw(word2);
+        std::string typeSuffix;
+        auto colon = opRaw.find(':');
+        if (colon != std::string::npos) {
+            typeSuffix = opRaw.substr(colon + 1);
+            opRaw      = opRaw.substr(0, colon);
+        }
+        atom.strOp = opRaw;
+
+        std::string_view word3 = m_nextWord(sv);
+        if (word3.empty()) return false;
+        m_compileOperand(word3, atom.sRhs, prog);
+
+        auto isTypeKeyword = [](std::string_view w) {
+            return w == "STR" || w == "NUM" || w == "VER" || w == "BOOL";
+        };
+
+        if (typeSuffix.empty()) {
+            std::string_view svSaved = sv;
+            std::string_view word4   = m_nextWord(sv);
+            if (m_holeIndex(word4, uHole)) return false;
+
+            if (!word4.empty() && word4[0] == ':') {
+                std::string_view candidate = word4.substr(1);
+                if (candidate.empty()) {
+                    std::string_view word5 = m_nextWord(sv);
+                    if (m_holeIndex(word5, uHole)) return false;
+                    if (isTypeKeyword(word5)) {
+                        typeSuffix = std::string(word5);
+                    } else {
+                        sv = svSaved;
+                    }
+                } else if (isTypeKeyword(candidate)) {
+                    typeSuffix = std::string(candidate);
+                } else {
+                    sv = svSaved;
+                }
+            } else {
+                sv = svSaved;
+            }
+        }
+
+        if (!typeSuffix.empty()) {
+            if (!isTypeKeyword(typeSuffix)) return false;   // evaluate() throws
+            atom.bTyped = true;
+            atom.eType  = m_typeFromSuffix(typeSuffix);
+        }
+
+        atom.eStrOp = VectorValidator::parseRule(atom.strOp, eValidateType::STRING);
+        atom.eNumOp = VectorValidator::parseRule(atom.strOp, eValidateType::NUMBER);
+        return true;
+    }
+
+    // Type inference flags of an operand: pre-computed for constants.
+    static void m_operandFlags(const EvalProgram::Operand& op, const std::string& v,
+                               bool& bIsBool, bool& bIsNum, bool& bIsVer)
+    {
+        if (op.uHole == EvalProgram::kNoHole) {
+            bIsBool = op.bIsBool; bIsNum = op.bIsNum; bIsVer = op.bIsVer;
+        } else {
+            bIsBool = m_isBoolLiteral(v); bIsNum = m_isNumericLiteral(v); bIsVer = m_isVersionLiteral(v);
+        }
+    }
+
+    bool m_runAtom(const EvalProgram::Atom& atom, const std::string* const* ppHoles, bool& result) const
+    {
+        const bool bLhsHole = (atom.sLhs.uHole != EvalProgram::kNoHole);
+        const std::string& lhs = bLhsHole ? *ppHoles[atom.sLhs.uHole] : atom.sLhs.strText;
+
+        if (atom.bBoolOnly) {
+            if (!bLhsHole) {
+                result = atom.sLhs.bBool;
+                return true;
+            }
+            if      (lhs == "TRUE"  || lhs == "!FALSE") result = true;
+            else if (lhs == "FALSE" || lhs == "!TRUE")  result = false;
+            else return BoolExprEvaluator{}.evaluate(lhs, result);
+            return true;
+        }
+
+        const bool bRhsHole = (atom.sRhs.uHole != EvalProgram::kNoHole);
+        const std::string& rhs = bRhsHole ? *ppHoles[atom.sRhs.uHole] : atom.sRhs.strText;
+
+        eValidateType type = atom.eType;
+        if (!atom.bTyped) {
+            bool lb, ln, lv, rb, rn, rv;
+            m_operandFlags(atom.sLhs, lhs, lb, ln, lv);
+            m_operandFlags(atom.sRhs, rhs, rb, rn, rv);
+            if (lb || rb)       type = eValidateType::BOOLEAN;
+            else if (ln && rn)  type = eValidateType::NUMBER;
+            else if (lv || rv)  type = eValidateType::VERSION;
+            else                type = eValidateType::STRING;
+        }
+
+        const ComparisonOp op = (type == eValidateType::STRING) ? atom.eStrOp : atom.eNumOp;
+        bool bDone = false;
+
+        if (op != ComparisonOp::UNKNOWN) {
+            switch (type) {
+                case eValidateType::STRING: {
+                    result = (op == ComparisonOp::EQ) ? (lhs == rhs) : (lhs != rhs);
+                    bDone  = true;
+                    break;
+                }
+                case eValidateType::NUMBER: {
+                    double a = atom.sLhs.dNum, b = atom.sRhs.dNum;
+                    const bool bA = bLhsHole ? VectorValidator::tryParseDouble(lhs, a) : atom.sLhs.bNumOk;
+                    const bool bB = bRhsHole ? VectorValidator::tryParseDouble(rhs, b) : atom.sRhs.bNumOk;
+                    if (bA && bB) {
+                        result = VectorValidator::applyComparison(a, b, op);
+                        bDone  = true;
+                    }
+                    break;
+                }
+                case eValidateType::VERSION: {
+                    VectorValidator::VersionParts va, vb;
+                    const bool bA = bLhsHole ? VectorValidator::tryParseVersion(lhs, va) : atom.sLhs.bVerOk;
+                    const bool bB = bRhsHole ? VectorValidator::tryParseVersion(rhs, vb) : atom.sRhs.bVerOk;
+                    if (bA && bB) {
+                        const int cmp = VectorValidator::compareVersionParts(bLhsHole ? va : atom.sLhs.sVer,
+                                                                             bRhsHole ? vb : atom.sRhs.sVer);
+                        result = VectorValidator::applyComparison(cmp, 0, op);
+                        bDone  = true;
+                    }
+                    break;
+                }
+                case eValidateType::BOOLEAN: {
+                    bool a = atom.sLhs.bBool, b = atom.sRhs.bBool;
+                    const bool bA = bLhsHole ? VectorValidator::tryParseBool(lhs, a) : atom.sLhs.bBoolOk;
+                    const bool bB = bRhsHole ? VectorValidator::tryParseBool(rhs, b) : atom.sRhs.bBoolOk;
+                    if (bA && bB && (op == ComparisonOp::EQ || op == ComparisonOp::NE)) {
+                        result = (op == ComparisonOp::EQ) ? (a == b) : (a != b);
+                        bDone  = true;
+                    }
+                    break;
+                }
+            }
+        }
+
+        if (!bDone) {
+            // unknown rule or a value the parsers reject: the validator logs it
+            result = VectorValidator{}.validate({lhs}, {rhs}, atom.strOp, type);
+        } else if (!result) {
+            VectorValidator::logMismatch(0, lhs, rhs);
+        }
+
+        return true;
+    }
+
     // ─────────────────────────────────────────────────────────────────────
     // Compound expression parser  (|| / && with standard C precedence)
     //
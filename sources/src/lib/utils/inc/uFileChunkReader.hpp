@@ -153,6 +153,9 @@ class FileChunkReader
                 return false;
             }
 
+            // chunks are consumed front to back: let the kernel read ahead
+            (void)posix_madvise(mapped, size, POSIX_MADV_SEQUENTIAL);
+
             const uint8_t* ptr = static_cast<const uint8_t*>(mapped);
             for (std::size_t offset = 0; offset < size; offset += chunkSize) {
                 std::size_t len = std::min(chunkSize, size - offset);
@@ -0,0 +1,211 @@
+#ifndef UFILE_CHUNKWRITER_H
+#define UFILE_CHUNKWRITER_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            CLASS DEFINITION                                 //
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace ufile
+{
+
+/**
+ * @brief Writes chunks to a file on a dedicated I/O thread
+ *
+ * The producer (typically a device read loop) fills a free buffer returned by
+ * acquire() and hands it over with commit(); the writer thread writes it to the
+ * file and returns it to the free list. With two or more buffers the next device
+ * read proceeds while the previous chunk is on its way to the disk.
+ *
+ * Usage:
+ *     FileChunkWriter writer(chunkSize);
+ *     if (writer.open(path)) {
+ *         while (...) { auto buf = writer.acquire(); ...fill...; writer.commit(n); }
+ *         bool ok = writer.close();
+ *     }
+ *
+ * A write error stops the writer: acquire() then returns an empty span and
+ * close() returns false. acquire()/commit() must be called from a single thread.
+ */
+class FileChunkWriter
+{
+    public:
+
+        explicit FileChunkWriter(std::size_t szChunkSize, std::size_t szBuffers = 3)
+            : m_vBuffers(std::max<std::size_t>(szBuffers, 2U), std::vector<uint8_t>(szChunkSize))
+        {}
+
+        ~FileChunkWriter()
+        {
+            close();
+        }
+
+        FileChunkWriter(const FileChunkWriter&) = delete;
+        FileChunkWriter& operator=(const FileChunkWriter&) = delete;
+
+        /**
+         * @brief Create / truncate the file and start the writer thread
+         */
+        bool open(const std::string& filename)
+        {
+            if (m_thread.joinable() || m_vBuffers.front().empty()) {
+                return false;
+            }
+
+            m_file.open(filename, std::ios::binary | std::ios::trunc);
+            if (!m_file) {
+                return false;
+            }
+
+            m_qFree.clear();
+            m_qFull.clear();
+            for (std::size_t i = 0; i < m_vBuffers.size(); ++i) {
+                m_qFree.push_back(i);
+            }
+            m_bStop = false;
+            m_bFailed = false;
+            m_u64Written = 0U;
+
+            m_thread = std::thread([this]() { writerLoop(); });
+            return true;
+
+        } /* open() */
+
+        /**
+         * @brief Wait for a free buffer of chunk size
+         * @return the buffer to fill, empty if the writer failed or is not running
+         */
+        std::span<uint8_t> acquire()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cvFree.wait(lock, [this]() { return !m_qFree.empty() || m_bFailed || !m_thread.joinable(); });
+
+            if (m_bFailed || !m_thread.joinable()) {
+                return {};
+            }
+
+            m_iCurrent = m_qFree.front();
+            m_qFree.pop_front();
+            return std::span<uint8_t>(m_vBuffers[m_iCurrent]);
+
+        } /* acquire() */
+
+        /**
+         * @brief Queue the first szBytes of the acquired buffer for writing
+         */
+        void commit(std::size_t szBytes)
+        {
+            if (SIZE_MAX == m_iCurrent) {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (0U == szBytes) {
+                    m_qFree.push_back(m_iCurrent);
+                } else {
+                    m_qFull.emplace_back(m_iCurrent, std::min(szBytes, m_vBuffers[m_iCurrent].size()));
+                }
+            }
+            m_iCurrent = SIZE_MAX;
+            m_cvFull.notify_one();
+
+        } /* commit() */
+
+        /**
+         * @brief Write the queued chunks, stop the thread and close the file
+         * @return true if every chunk was written
+         */
+        bool close()
+        {
+            if (m_thread.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_bStop = true;
+                }
+                m_cvFull.notify_one();
+                m_thread.join();
+            }
+
+            if (m_file.is_open()) {
+                m_file.close();
+                if (m_file.fail()) {
+                    m_bFailed = true;
+                }
+            }
+
+            return !m_bFailed;
+
+        } /* close() */
+
+        /**
+         * @brief Bytes written to the file so far
+         */
+        uint64_t bytesWritten() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_u64Written;
+        }
+
+    private:
+
+        void writerLoop()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while (true) {
+                m_cvFull.wait(lock, [this]() { return !m_qFull.empty() || m_bStop; });
+                if (m_qFull.empty()) {
+                    break; // stop requested, everything written
+                }
+
+                const auto [iBuffer, szBytes] = m_qFull.front();
+                m_qFull.pop_front();
+                const bool bFailed = m_bFailed;
+
+                lock.unlock();
+                const bool bOk = !bFailed && static_cast<bool>(m_file.write(reinterpret_cast<const char*>(m_vBuffers[iBuffer].data()),
+                                                                            static_cast<std::streamsize>(szBytes)));
+                lock.lock();
+
+                if (bOk) {
+                    m_u64Written += szBytes;
+                } else {
+                    m_bFailed = true;
+                }
+                m_qFree.push_back(iBuffer);
+                m_cvFree.notify_one();
+            }
+
+        } /* writerLoop() */
+
+        std::vector<std::vector<uint8_t>> m_vBuffers;
+        std::deque<std::size_t> m_qFree;
+        std::deque<std::pair<std::size_t, std::size_t>> m_qFull;
+        std::size_t m_iCurrent = SIZE_MAX;
+
+        std::ofstream m_file;
+        std::thread m_thread;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cvFree;
+        std::condition_variable m_cvFull;
+        bool m_bStop = false;
+        bool m_bFailed = false;
+        uint64_t m_u64Written = 0U;
+};
+
+} // namespace ufile
+
+#endif // UFILE_CHUNKWRITER_H
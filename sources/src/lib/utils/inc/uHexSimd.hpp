@@ -0,0 +1,502 @@
+#ifndef UHEXSIMD_HPP
+#define UHEXSIMD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * Vector kernels are compiled in for the target architecture unless HEXUTILS_NO_SIMD is defined:
+ *  - x86 / x86-64 : SSE2 (baseline of x86-64) and AVX2, the latter only used if the CPU supports it
+ *  - AArch64      : NEON (always present)
+ * The kernel set is chosen once, at the first call, see hexutils::simd::kernels().
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#if !defined(HEXUTILS_NO_SIMD)
+    #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+            #define HEXUTILS_SIMD_SSE2
+        #endif
+        #if defined(__GNUC__) || defined(__clang__)
+            #define HEXUTILS_SIMD_AVX2
+            #define HEXUTILS_TARGET_AVX2 __attribute__((target("avx2")))
+        #elif defined(_MSC_VER)
+            #define HEXUTILS_SIMD_AVX2
+            #define HEXUTILS_TARGET_AVX2
+            #include <intrin.h>
+        #endif
+        #include <immintrin.h>
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #define HEXUTILS_SIMD_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace hexutils::simd
+ * @brief Bulk hex encode / decode / validate kernels (scalar and vectorized) with runtime dispatch.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+namespace hexutils::simd
+{
+
+/**
+ * @brief Instruction sets a kernel set can be built for
+ */
+enum class Isa : uint8_t {
+    Scalar,
+    Sse2,
+    Avx2,
+    Neon
+};
+
+/**
+ * @brief One implementation of the three bulk operations
+ *
+ * encode   : szBytes bytes from pIn to 2 * szBytes hex digits at pOut (not terminated)
+ * decode   : 2 * szBytes hex digits from pIn to szBytes bytes at pOut; false if a digit is invalid,
+ *            pOut is then undefined
+ * validate : true if all szChars characters at pIn are hex digits
+ */
+struct Kernels {
+    Isa         isa;
+    const char *name;
+    void (*encode)(const uint8_t *pIn, size_t szBytes, char *pOut, bool bUppercase) noexcept;
+    bool (*decode)(const char *pIn, size_t szBytes, uint8_t *pOut) noexcept;
+    bool (*validate)(const char *pIn, size_t szChars) noexcept;
+};
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace internal
+ * @brief Lookup tables and the kernels of every instruction set
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+namespace internal
+{
+
+constexpr char g_digitsUpper[] = "0123456789ABCDEF";
+constexpr char g_digitsLower[] = "0123456789abcdef";
+
+// marks a character that is not a hex digit in g_nibbles
+constexpr uint8_t INVALID_NIBBLE = 0x80U;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Builds the table of the two hex digits of every byte value
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+constexpr std::array<char, 512> makePairs(const char *digits) noexcept
+{
+    std::array<char, 512> pairs {};
+    for (size_t i = 0; i < 256; ++i) {
+        pairs[2 * i]     = digits[i >> 4];
+        pairs[2 * i + 1] = digits[i & 0xF];
+    }
+    return pairs;
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Builds the table of the nibble value of every character, INVALID_NIBBLE if not a hex digit
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+constexpr std::array<uint8_t, 256> makeNibbles() noexcept
+{
+    std::array<uint8_t, 256> nibbles {};
+    for (size_t i = 0; i < 256; ++i) {
+        if (i >= '0' && i <= '9') {
+            nibbles[i] = static_cast<uint8_t>(i - '0');
+        } else if (i >= 'A' && i <= 'F') {
+            nibbles[i] = static_cast<uint8_t>(i - 'A' + 10);
+        } else if (i >= 'a' && i <= 'f') {
+            nibbles[i] = static_cast<uint8_t>(i - 'a' + 10);
+        } else {
+            nibbles[i] = INVALID_NIBBLE;
+        }
+    }
+    return nibbles;
+}
+
+inline constexpr std::array<char, 512>   g_pairsUpper = makePairs(g_digitsUpper);
+inline constexpr std::array<char, 512>   g_pairsLower = makePairs(g_digitsLower);
+inline constexpr std::array<uint8_t, 256> g_nibbles   = makeNibbles();
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ *                                        SCALAR
+ * Table driven and branch free, also finishes the tails of the vector kernels
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void encodeScalar(const uint8_t *pIn, size_t szBytes, char *pOut, bool bUppercase) noexcept
+{
+    const char *pPairs = bUppercase ? g_pairsUpper.data() : g_pairsLower.data();
+
+    for (size_t i = 0; i < szBytes; ++i) {
+        std::memcpy(pOut + 2 * i, pPairs + 2 * pIn[i], 2);
+    }
+}
+
+inline bool decodeScalar(const char *pIn, size_t szBytes, uint8_t *pOut) noexcept
+{
+    uint8_t uBad = 0;
+
+    for (size_t i = 0; i < szBytes; ++i) {
+        const uint8_t uHigh = g_nibbles[static_cast<uint8_t>(pIn[2 * i])];
+        const uint8_t uLow  = g_nibbles[static_cast<uint8_t>(pIn[2 * i + 1])];
+        uBad |= static_cast<uint8_t>(uHigh | uLow);
+        pOut[i] = static_cast<uint8_t>((uHigh << 4) | uLow);
+    }
+
+    return (0 == (uBad & INVALID_NIBBLE));
+}
+
+inline bool validateScalar(const char *pIn, size_t szChars) noexcept
+{
+    uint8_t uBad = 0;
+
+    for (size_t i = 0; i < szChars; ++i) {
+        uBad |= g_nibbles[static_cast<uint8_t>(pIn[i])];
+    }
+
+    return (0 == (uBad & INVALID_NIBBLE));
+}
+
+
+#if defined(HEXUTILS_SIMD_SSE2)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ *                                        SSE2
+ * No byte shuffle before SSSE3: digits are computed arithmetically, 16 bytes per step
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+// nibbles (0..15) to ASCII, alpha holds the distance from '9' + 1 to the first letter
+inline __m128i sse2NibblesToAscii(__m128i nibbles, __m128i alpha) noexcept
+{
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), alpha);
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+// ASCII to nibbles, clears lanes of ok holding a character that is not a hex digit
+inline __m128i sse2AsciiToNibbles(__m128i chars, __m128i& ok) noexcept
+{
+    const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    const __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                        _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    ok = _mm_and_si128(ok, _mm_or_si128(digit, alpha));
+    return _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+                        _mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+// 16 chars as nibble pairs to 8 bytes, one per 16 bit lane
+inline __m128i sse2JoinNibbles(__m128i nibbles) noexcept
+{
+    const __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+    return _mm_or_si128(high, _mm_srli_epi16(nibbles, 8));
+}
+
+inline void encodeSse2(const uint8_t *pIn, size_t szBytes, char *pOut, bool bUppercase) noexcept
+{
+    const __m128i mask  = _mm_set1_epi8(0x0F);
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>((bUppercase ? 'A' : 'a') - '0' - 10));
+    size_t i = 0;
+
+    for (; i + 16 <= szBytes; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+        const __m128i high  = sse2NibblesToAscii(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask), alpha);
+        const __m128i low   = sse2NibblesToAscii(_mm_and_si128(bytes, mask), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + 2 * i),      _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+
+    encodeScalar(pIn + i, szBytes - i, pOut + 2 * i, bUppercase);
+}
+
+inline bool decodeSse2(const char *pIn, size_t szBytes, uint8_t *pOut) noexcept
+{
+    __m128i ok = _mm_set1_epi8(-1);
+    size_t i = 0;
+
+    for (; i + 16 <= szBytes; i += 16) {
+        const __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + 2 * i));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + 2 * i + 16));
+        const __m128i bytes  = _mm_packus_epi16(sse2JoinNibbles(sse2AsciiToNibbles(first, ok)),
+                                                sse2JoinNibbles(sse2AsciiToNibbles(second, ok)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), bytes);
+    }
+
+    return (0xFFFF == _mm_movemask_epi8(ok)) && decodeScalar(pIn + 2 * i, szBytes - i, pOut + i);
+}
+
+inline bool validateSse2(const char *pIn, size_t szChars) noexcept
+{
+    __m128i ok = _mm_set1_epi8(-1);
+    size_t i = 0;
+
+    for (; i + 16 <= szChars; i += 16) {
+        (void)sse2AsciiToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i)), ok);
+    }
+
+    return (0xFFFF == _mm_movemask_epi8(ok)) && validateScalar(pIn + i, szChars - i);
+}
+
+#endif // HEXUTILS_SIMD_SSE2
+
+
+#if defined(HEXUTILS_SIMD_AVX2)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ *                                        AVX2
+ * Compiled for AVX2 whatever the build flags are, only selected when the CPU supports it
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+HEXUTILS_TARGET_AVX2 inline __m256i avx2AsciiToNibbles(__m256i chars, __m256i& ok) noexcept
+{
+    const __m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+    const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+    const __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+    ok = _mm256_and_si256(ok, _mm256_or_si256(digit, alpha));
+    return _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(chars, _mm256_set1_epi8('0'))),
+                           _mm256_and_si256(alpha, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+}
+
+HEXUTILS_TARGET_AVX2 inline void encodeAvx2(const uint8_t *pIn, size_t szBytes, char *pOut, bool bUppercase) noexcept
+{
+    const __m256i lut  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                                         bUppercase ? g_digitsUpper : g_digitsLower)));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 32 <= szBytes; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn + i));
+        const __m256i high  = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+        const __m256i low   = _mm256_shuffle_epi8(lut, _mm256_and_si256(bytes, mask));
+        // the unpacks interleave within the 128 bit lanes, the permutes put the lanes back in order
+        const __m256i first = _mm256_unpacklo_epi8(high, low);
+        const __m256i last  = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + 2 * i),      _mm256_permute2x128_si256(first, last, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + 2 * i + 32), _mm256_permute2x128_si256(first, last, 0x31));
+    }
+
+    encodeScalar(pIn + i, szBytes - i, pOut + 2 * i, bUppercase);
+}
+
+HEXUTILS_TARGET_AVX2 inline bool decodeAvx2(const char *pIn, size_t szBytes, uint8_t *pOut) noexcept
+{
+    // weights of the high and the low nibble of every pair
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    __m256i ok = _mm256_set1_epi8(-1);
+    size_t i = 0;
+
+    for (; i + 32 <= szBytes; i += 32) {
+        const __m256i first  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn + 2 * i));
+        const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn + 2 * i + 32));
+        const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(avx2AsciiToNibbles(first, ok), weights),
+                                                   _mm256_maddubs_epi16(avx2AsciiToNibbles(second, ok), weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+
+    return (-1 == _mm256_movemask_epi8(ok)) && decodeScalar(pIn + 2 * i, szBytes - i, pOut + i);
+}
+
+HEXUTILS_TARGET_AVX2 inline bool validateAvx2(const char *pIn, size_t szChars) noexcept
+{
+    __m256i ok = _mm256_set1_epi8(-1);
+    size_t i = 0;
+
+    for (; i + 32 <= szChars; i += 32) {
+        (void)avx2AsciiToNibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn + i)), ok);
+    }
+
+    return (-1 == _mm256_movemask_epi8(ok)) && validateScalar(pIn + i, szChars - i);
+}
+
+#endif // HEXUTILS_SIMD_AVX2
+
+
+#if defined(HEXUTILS_SIMD_NEON)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ *                                        NEON
+ * The structured loads / stores (vld2q / vst2q) split and interleave the digit pairs
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline uint8x16_t neonAsciiToNibbles(uint8x16_t chars, uint8x16_t& ok) noexcept
+{
+    const uint8x16_t digit   = vsubq_u8(chars, vdupq_n_u8('0'));
+    const uint8x16_t alpha   = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t isDigit = vcltq_u8(digit, vdupq_n_u8(10));
+    const uint8x16_t isAlpha = vcltq_u8(alpha, vdupq_n_u8(6));
+    ok = vandq_u8(ok, vorrq_u8(isDigit, isAlpha));
+    return vbslq_u8(isDigit, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+}
+
+inline void encodeNeon(const uint8_t *pIn, size_t szBytes, char *pOut, bool bUppercase) noexcept
+{
+    const uint8x16_t lut  = vld1q_u8(reinterpret_cast<const uint8_t*>(bUppercase ? g_digitsUpper : g_digitsLower));
+    const uint8x16_t mask = vdupq_n_u8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= szBytes; i += 16) {
+        const uint8x16_t bytes = vld1q_u8(pIn + i);
+        uint8x16x2_t digits;
+        digits.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(bytes, 4));
+        digits.val[1] = vqtbl1q_u8(lut, vandq_u8(bytes, mask));
+        vst2q_u8(reinterpret_cast<uint8_t*>(pOut + 2 * i), digits);
+    }
+
+    encodeScalar(pIn + i, szBytes - i, pOut + 2 * i, bUppercase);
+}
+
+inline bool decodeNeon(const char *pIn, size_t szBytes, uint8_t *pOut) noexcept
+{
+    uint8x16_t ok = vdupq_n_u8(0xFF);
+    size_t i = 0;
+
+    for (; i + 16 <= szBytes; i += 16) {
+        const uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t*>(pIn + 2 * i));
+        const uint8x16_t high = neonAsciiToNibbles(chars.val[0], ok);
+        const uint8x16_t low  = neonAsciiToNibbles(chars.val[1], ok);
+        vst1q_u8(pOut + i, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+
+    return (0xFF == vminvq_u8(ok)) && decodeScalar(pIn + 2 * i, szBytes - i, pOut + i);
+}
+
+inline bool validateNeon(const char *pIn, size_t szChars) noexcept
+{
+    uint8x16_t ok = vdupq_n_u8(0xFF);
+    size_t i = 0;
+
+    for (; i + 16 <= szChars; i += 16) {
+        (void)neonAsciiToNibbles(vld1q_u8(reinterpret_cast<const uint8_t*>(pIn + i)), ok);
+    }
+
+    return (0xFF == vminvq_u8(ok)) && validateScalar(pIn + i, szChars - i);
+}
+
+#endif // HEXUTILS_SIMD_NEON
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief True if the running CPU (and OS) supports AVX2
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+inline bool cpuHasAvx2() noexcept
+{
+#if defined(HEXUTILS_SIMD_AVX2)
+  #if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) {
+        return false;
+    }
+    // AVX and OSXSAVE, then the OS must save the YMM registers
+    __cpuid(regs, 1);
+    if ((regs[2] & 0x18000000) != 0x18000000) {
+        return false;
+    }
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(regs, 7, 0);
+    return (0 != (regs[1] & (1 << 5)));
+  #else
+    __builtin_cpu_init();
+    return (0 != __builtin_cpu_supports("avx2"));
+  #endif
+#else
+    return false;
+#endif
+
+} /* cpuHasAvx2() */
+
+} /* namespace internal */
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Kernel set of an instruction set
+ * @param isa The instruction set
+ * @return nullptr if the kernels are not compiled in or the CPU does not support them
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+[[nodiscard]] inline const Kernels* kernelsFor(Isa isa) noexcept
+{
+    static constexpr Kernels scalar {Isa::Scalar, "scalar", internal::encodeScalar, internal::decodeScalar, internal::validateScalar};
+
+    switch (isa) {
+        case Isa::Scalar:
+            return &scalar;
+
+#if defined(HEXUTILS_SIMD_SSE2)
+        case Isa::Sse2: {
+            static constexpr Kernels sse2 {Isa::Sse2, "sse2", internal::encodeSse2, internal::decodeSse2, internal::validateSse2};
+            return &sse2;
+        }
+#endif
+
+#if defined(HEXUTILS_SIMD_AVX2)
+        case Isa::Avx2: {
+            static constexpr Kernels avx2 {Isa::Avx2, "avx2", internal::encodeAvx2, internal::decodeAvx2, internal::validateAvx2};
+            static const bool bSupported = internal::cpuHasAvx2();
+            return bSupported ? &avx2 : nullptr;
+        }
+#endif
+
+#if defined(HEXUTILS_SIMD_NEON)
+        case Isa::Neon: {
+            static constexpr Kernels neon {Isa::Neon, "neon", internal::encodeNeon, internal::decodeNeon, internal::validateNeon};
+            return &neon;
+        }
+#endif
+
+        default:
+            return nullptr;
+    }
+
+} /* kernelsFor() */
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The fastest kernel set the running CPU supports, selected at the first call
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+[[nodiscard]] inline const Kernels& kernels() noexcept
+{
+    static const Kernels& selected = []() -> const Kernels& {
+        for (Isa isa : {Isa::Avx2, Isa::Neon, Isa::Sse2}) {
+            if (const Kernels *pKernels = kernelsFor(isa)) {
+                return *pKernels;
+            }
+        }
+        return *kernelsFor(Isa::Scalar);
+    }();
+
+    return selected;
+
+} /* kernels() */
+
+} /* namespace hexutils::simd */
+
+#endif // UHEXSIMD_HPP
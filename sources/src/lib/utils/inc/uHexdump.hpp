@@ -2,6 +2,7 @@
 #define U_HEXDUMPUTILS_H
 
 #include "uFlagParser.hpp"
+#include "uHexSimd.hpp"
 #include "uLogger.hpp"
 
 #include <cstdint>
@@ -143,16 +144,24 @@ namespace internal
             result += HexDumpConfig::HEX_COLOR;
         }
         
-        char hexBuf[4] = {0}; // "XX " or "XX"
-        for (size_t j = 0; j < bytesPerLine; ++j) {
-            if (j < lineLen) {
-                byteToHex(data[lineStart + j], hexBuf);
-                hexBuf[2] = config.showSpaces ? ' ' : '\0';
-                result.append(hexBuf, config.showSpaces ? 3 : 2);
+        // the digits of (up to 96 bytes of) the line at once, then spread out when spaced
+        char hexBuf[2 * 96];
+        for (size_t j = 0; j < lineLen; j += 96) {
+            const size_t chunk = std::min(lineLen - j, size_t(96));
+            simd::kernels().encode(data.data() + lineStart + j, chunk, hexBuf, true);
+
+            if (config.showSpaces) {
+                for (size_t k = 0; k < chunk; ++k) {
+                    result.append(hexBuf + 2 * k, 2);
+                    result.push_back(' ');
+                }
             } else {
-                result.append(config.showSpaces ? "   " : "  ");
+                result.append(hexBuf, 2 * chunk);
             }
         }
+        for (size_t j = lineLen; j < bytesPerLine; ++j) {
+            result.append(config.showSpaces ? "   " : "  ");
+        }
         
         if (config.useColors) {
             result += HexDumpConfig::RESET_COLOR;
@@ -501,6 +510,10 @@ inline void logHexdump( LogLevel                 level,
                         size_t                   bytesPerLine = 16,
                         size_t                   offset       = 0)
 {
+    if (!LOG_ENABLED(level)) {
+        return;  // filtered: do not build the lines
+    }
+
     LOG_PRINT(level, LOG_HDR; LOG_STRING(caption));
 
     if (data.empty()) {
@@ -1,6 +1,8 @@
 #ifndef UHEXLIFYUTILS_HPP
 #define UHEXLIFYUTILS_HPP
 
+#include "uHexSimd.hpp"
+
 #include <vector>
 #include <string>
 #include <string_view>
@@ -121,7 +123,7 @@ constexpr char g_hexDigitsLower[] = "0123456789abcdef";
     }
 
     // Check all characters are valid hex digits
-    return std::all_of(input.begin(), input.end(), internal::is_hex_char);
+    return simd::kernels().validate(input.data(), input.size());
 }
 
 
@@ -145,16 +147,9 @@ constexpr char g_hexDigitsLower[] = "0123456789abcdef";
     }
 
     count = std::min(count, input.size() - offset);
-    std::string result;
-    result.reserve(count * 2);
-
-    const char* hexDigits = uppercase ? internal::g_hexDigitsUpper : internal::g_hexDigitsLower;
+    std::string result(count * 2, '\0');
 
-    for (size_t i = 0; i < count; ++i) {
-        uint8_t byte = input[offset + i];
-        result.push_back(hexDigits[(byte >> 4) & 0xF]);
-        result.push_back(hexDigits[byte & 0xF]);
-    }
+    simd::kernels().encode(input.data() + offset, count, result.data(), uppercase);
 
     return result;
 }
@@ -197,18 +192,10 @@ constexpr char g_hexDigitsLower[] = "0123456789abcdef";
         return std::nullopt;
     }
 
-    std::vector<uint8_t> result;
-    result.reserve(hex.size() / 2);
+    std::vector<uint8_t> result(hex.size() / 2);
 
-    for (size_t i = 0; i < hex.size(); i += 2) {
-        int high = internal::hex_char_to_nibble(hex[i]);
-        int low = internal::hex_char_to_nibble(hex[i + 1]);
-        
-        if (high < 0 || low < 0) {
-            return std::nullopt;
-        }
-        
-        result.push_back(static_cast<uint8_t>((high << 4) | low));
+    if (!simd::kernels().decode(hex.data(), result.size(), result.data())) {
+        return std::nullopt;
     }
 
     return result;
@@ -317,11 +304,8 @@ template<typename T>
         }
     } else {
         // Native byte order - direct conversion
-        for (size_t i = 0; i < byteCount; ++i) {
-            uint8_t byte = bytePtr[i];
-            out.push_back(hexDigits[(byte >> 4) & 0xF]);
-            out.push_back(hexDigits[byte & 0xF]);
-        }
+        out.resize(2 + byteCount * 2);
+        simd::kernels().encode(bytePtr, byteCount, out.data() + 2, uppercase);
     }
 
     return out;
@@ -390,18 +374,10 @@ template<typename T>
     }
 
     // Convert hex to bytes
-    std::vector<uint8_t> bytes;
-    bytes.reserve(byteCount);
-    
-    for (size_t i = 0; i < byteCount; ++i) {
-        int high = internal::hex_char_to_nibble(hex[2 + 2 * i]);
-        int low = internal::hex_char_to_nibble(hex[2 + 2 * i + 1]);
-        
-        if (high < 0 || low < 0) {
-            return std::nullopt;
-        }
-        
-        bytes.push_back(static_cast<uint8_t>((high << 4) | low));
+    std::vector<uint8_t> bytes(byteCount);
+
+    if (!simd::kernels().decode(hex.data() + 2, byteCount, bytes.data())) {
+        return std::nullopt;
     }
 
     // Handle endianness conversion
@@ -461,6 +437,12 @@ template<typename T>
         return "";
     }
 
+    if (separator.empty()) {
+        std::string result(input.size() * 2, '\0');
+        simd::kernels().encode(input.data(), input.size(), result.data(), uppercase);
+        return result;
+    }
+
     const char* hexDigits = uppercase ? internal::g_hexDigitsUpper : internal::g_hexDigitsLower;
     
     std::string result;
@@ -162,6 +162,31 @@ public:
     } /* getNumFromIni() */
 
 
+    // -------------------------------------------------------------------------
+    //  getStringFromIni()
+    //  Looks up 'key' in the active section and returns its raw value.
+    //  On missing key the caller-supplied default in 'value' is preserved and
+    //  false is returned.
+    // -------------------------------------------------------------------------
+    bool getStringFromIni(std::string_view key, std::string& value) noexcept
+    {
+        const std::string strKey(key);
+
+        if (m_mapSettings.count(strKey) == 0)
+        {
+            LOG_PRINT(LOG_WARNING, LOG_HDR;
+                      LOG_STRING("Missing ini value for:");
+                      LOG_STRING(key);
+                      LOG_STRING(": using default value"));
+            return false;
+        }
+
+        value = m_mapSettings.at(strKey);
+        return true;
+
+    } /* getStringFromIni() */
+
+
     // -------------------------------------------------------------------------
     //  Accessors
     // -------------------------------------------------------------------------
@@ -0,0 +1,416 @@
+#ifndef ULOGBINARY_H
+#define ULOGBINARY_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+#if defined(__linux__)
+    #include <sys/syscall.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////
+//                        BINARY (DEFERRED FORMAT) LOG                         //
+/////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * File layout, native byte order of the writer:
+ *
+ *   FileHeader | record | record | ...
+ *
+ * Every record starts 8-byte aligned with a RecordHeader, followed by its
+ * payload and padding. A SITE record names the source location of a
+ * LOG_PRINT call site once per file; the MESSAGE records refer to it by id
+ * and carry the raw, typed arguments of the message. The size of a record
+ * is stored last, so a record with size 0 ends the log (not completed, or
+ * the file was full).
+ */
+
+namespace ulogbin
+{
+
+inline constexpr char     MAGIC[8] = { 'U', 'L', 'O', 'G', 'B', 'I', 'N', '1' };
+inline constexpr uint32_t VERSION  = 1U;
+
+/**
+ * @brief Kind of a record.
+ */
+enum class RecordKind : uint8_t {
+    SITE    = 1,    /**< payload: source file name, tid: line */
+    MESSAGE = 2     /**< payload: encoded arguments */
+};
+
+/**
+ * @brief Type tag of an encoded argument; each renders like the matching
+ *        LogBuffer::append() / appendHex() overload.
+ */
+enum class ArgType : uint8_t {
+    STR = 1,        /**< u16 length + bytes */
+    CHAR,           /**< 1 byte */
+    BOOL,           /**< 1 byte */
+    INT,            /**< int64 */
+    UINT,           /**< uint64 */
+    REAL,           /**< double */
+    PTR,            /**< uint64 */
+    HEX8,           /**< uint64, 2 digits */
+    HEX16,          /**< uint64, 4 digits */
+    HEX32,          /**< uint64, 8 digits */
+    HEX64,          /**< uint64, 16 digits */
+    HEX             /**< uint64, no padding */
+};
+
+struct FileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t capacity;          /**< bytes available for records */
+    uint64_t used;              /**< bytes of records, 0 until the file is closed */
+    uint64_t dropped;           /**< messages that did not fit, set when the file is closed */
+    int64_t  wallOriginUs;      /**< system clock at open, us since the epoch */
+    int64_t  steadyOriginNs;    /**< steady clock at open */
+};
+static_assert(sizeof(FileHeader) == 56);
+
+struct RecordHeader {
+    uint32_t size;              /**< whole record with padding, stored last */
+    uint8_t  kind;              /**< RecordKind */
+    uint8_t  level;             /**< LogLevel of the message */
+    uint16_t site;              /**< call site id, 0: unknown */
+    uint32_t tid;               /**< MESSAGE: thread number, SITE: line */
+    uint32_t length;            /**< payload bytes */
+    int64_t  timeNs;            /**< MESSAGE: steady clock, ns after steadyOriginNs */
+};
+static_assert(sizeof(RecordHeader) == 24);
+
+[[nodiscard]] constexpr size_t recordSize(size_t szPayload) noexcept
+{
+    return (sizeof(RecordHeader) + szPayload + 7U) & ~static_cast<size_t>(7U);
+}
+
+
+/**
+ * @brief Id of the calling thread as shown by the system (the same in the
+ *        executable and in the plugin libraries).
+ */
+inline uint32_t currentThreadId() noexcept
+{
+#if defined(_WIN32)
+    return static_cast<uint32_t>(::GetCurrentThreadId());
+#elif defined(__linux__)
+    return static_cast<uint32_t>(::syscall(SYS_gettid));
+#else
+    return static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+}
+
+
+/**
+ * @brief Appends the text of encoded arguments, exactly as the text logger
+ *        formats them (each value followed by a space).
+ * @return false if the payload is malformed (the text decoded so far is kept).
+ */
+inline bool decodeArgs(const char* pPayload, size_t szLength, std::string& strOut)
+{
+    char szBuf[64];
+    size_t szPos = 0;
+
+    auto read = [&](void* pDst, size_t szBytes) -> bool {
+        if (szPos + szBytes > szLength) {
+            return false;
+        }
+        std::memcpy(pDst, pPayload + szPos, szBytes);
+        szPos += szBytes;
+        return true;
+    };
+
+    while (szPos < szLength) {
+        const auto eType = static_cast<ArgType>(static_cast<uint8_t>(pPayload[szPos++]));
+        int iWritten = 0;
+
+        switch (eType) {
+            case ArgType::STR: {
+                uint16_t uLen = 0;
+                if (!read(&uLen, sizeof(uLen)) || (szPos + uLen > szLength)) {
+                    return false;
+                }
+                strOut.append(pPayload + szPos, uLen);
+                strOut.push_back(' ');
+                szPos += uLen;
+                continue;
+            }
+            case ArgType::CHAR:
+            case ArgType::BOOL: {
+                char c = 0;
+                if (!read(&c, sizeof(c))) {
+                    return false;
+                }
+                if (eType == ArgType::CHAR) {
+                    strOut.push_back(c);
+                    strOut.push_back(' ');
+                } else {
+                    strOut.append((0 != c) ? "true " : "false ");
+                }
+                continue;
+            }
+            case ArgType::INT: {
+                int64_t iValue = 0;
+                if (!read(&iValue, sizeof(iValue))) {
+                    return false;
+                }
+                iWritten = std::snprintf(szBuf, sizeof(szBuf), "%lld ", static_cast<long long>(iValue));
+                break;
+            }
+            case ArgType::REAL: {
+                double dValue = 0.0;
+                if (!read(&dValue, sizeof(dValue))) {
+                    return false;
+                }
+                iWritten = std::snprintf(szBuf, sizeof(szBuf), "%.8f ", dValue);
+                break;
+            }
+            case ArgType::UINT:
+            case ArgType::PTR:
+            case ArgType::HEX8:
+            case ArgType::HEX16:
+            case ArgType::HEX32:
+            case ArgType::HEX64:
+            case ArgType::HEX: {
+                uint64_t uValue = 0;
+                if (!read(&uValue, sizeof(uValue))) {
+                    return false;
+                }
+                const auto ullValue = static_cast<unsigned long long>(uValue);
+                switch (eType) {
+                    case ArgType::UINT:  iWritten = std::snprintf(szBuf, sizeof(szBuf), "%llu ", ullValue); break;
+                    case ArgType::PTR:   iWritten = std::snprintf(szBuf, sizeof(szBuf), "%p ", reinterpret_cast<void*>(static_cast<uintptr_t>(uValue))); break;
+                    case ArgType::HEX8:  iWritten = std::snprintf(szBuf, sizeof(szBuf), "0x%02llX ", ullValue); break;
+                    case ArgType::HEX16: iWritten = std::snprintf(szBuf, sizeof(szBuf), "0x%04llX ", ullValue); break;
+                    case ArgType::HEX32: iWritten = std::snprintf(szBuf, sizeof(szBuf), "0x%08llX ", ullValue); break;
+                    case ArgType::HEX64: iWritten = std::snprintf(szBuf, sizeof(szBuf), "0x%016llX ", ullValue); break;
+                    default:             iWritten = std::snprintf(szBuf, sizeof(szBuf), "0x%llX ", ullValue); break;
+                }
+                break;
+            }
+            default:
+                return false;
+        }
+
+        if (iWritten > 0) {
+            strOut.append(szBuf, std::min(static_cast<size_t>(iWritten), sizeof(szBuf) - 1U));
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief Fixed size log file mapped into memory. Writers reserve their
+ *        record with one atomic add and fill it in place, no lock and no
+ *        system call; the pages reach the file even if the process crashes.
+ *        Once full, further records are counted as dropped.
+ *
+ * close() must not overlap with write(): the logger keeps writers out
+ * before closing (see LogBuffer::stopBinary()).
+ */
+class MappedLog
+{
+public:
+
+    MappedLog() = default;
+    MappedLog(const MappedLog&) = delete;
+    MappedLog& operator=(const MappedLog&) = delete;
+
+    ~MappedLog() { close(); }
+
+    /**
+     * @brief Creates (truncates) the file and maps szCapacity bytes of records.
+     */
+    bool open(const std::string& strPath, size_t szCapacity)
+    {
+        close();
+
+        const size_t szFileSize = sizeof(FileHeader) + (szCapacity & ~static_cast<size_t>(7U));
+        if (szFileSize <= sizeof(FileHeader)) {
+            return false;
+        }
+
+#if defined(_WIN32)
+        m_hFile = ::CreateFileA(strPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_hFile == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER liSize;
+        liSize.QuadPart = static_cast<LONGLONG>(szFileSize);
+        m_hMap = ::CreateFileMappingA(m_hFile, nullptr, PAGE_READWRITE,
+                                      static_cast<DWORD>(liSize.HighPart), liSize.LowPart, nullptr);
+        if (nullptr != m_hMap) {
+            m_pBase = static_cast<char*>(::MapViewOfFile(m_hMap, FILE_MAP_WRITE, 0, 0, szFileSize));
+        }
+#elif defined(__unix__) || defined(__APPLE__)
+        m_iFd = ::open(strPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m_iFd < 0) {
+            return false;
+        }
+        if (0 == ::ftruncate(m_iFd, static_cast<off_t>(szFileSize))) {
+            // pre-faulted, the first message on every page would pay for the fault
+#if defined(MAP_POPULATE)
+            const int iFlags = MAP_SHARED | MAP_POPULATE;
+#else
+            const int iFlags = MAP_SHARED;
+#endif
+            void *pMap = ::mmap(nullptr, szFileSize, PROT_READ | PROT_WRITE, iFlags, m_iFd, 0);
+            m_pBase = (pMap != MAP_FAILED) ? static_cast<char*>(pMap) : nullptr;
+        }
+#endif
+        if (nullptr == m_pBase) {
+            close();
+            return false;
+        }
+
+        m_szMapped = szFileSize;
+        m_szCapacity = szFileSize - sizeof(FileHeader);
+        m_uNext.store(0U);
+        m_uDropped.store(0U);
+        m_iSteadyOriginNs = steadyNs();
+
+        FileHeader sHeader {};
+        std::memcpy(sHeader.magic, MAGIC, sizeof(MAGIC));
+        sHeader.version = VERSION;
+        sHeader.headerSize = sizeof(FileHeader);
+        sHeader.capacity = m_szCapacity;
+        sHeader.wallOriginUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch()).count();
+        sHeader.steadyOriginNs = m_iSteadyOriginNs;
+        std::memcpy(m_pBase, &sHeader, sizeof(sHeader));
+        return true;
+    }
+
+    /**
+     * @brief Completes the header, unmaps and cuts the file to the records written.
+     */
+    void close() noexcept
+    {
+        const uint64_t uUsed = std::min<uint64_t>(m_uNext.load(), m_szCapacity);
+
+        if (nullptr != m_pBase) {
+            auto *pHeader = reinterpret_cast<FileHeader*>(m_pBase);
+            pHeader->used = uUsed;
+            pHeader->dropped = m_uDropped.load();
+        }
+
+#if defined(_WIN32)
+        if (nullptr != m_pBase) {
+            ::FlushViewOfFile(m_pBase, 0);
+            ::UnmapViewOfFile(m_pBase);
+        }
+        if (nullptr != m_hMap) {
+            ::CloseHandle(m_hMap);
+        }
+        if (m_hFile != INVALID_HANDLE_VALUE) {
+            if (nullptr != m_pBase) {
+                LARGE_INTEGER liSize;
+                liSize.QuadPart = static_cast<LONGLONG>(sizeof(FileHeader) + uUsed);
+                ::SetFilePointerEx(m_hFile, liSize, nullptr, FILE_BEGIN);
+                ::SetEndOfFile(m_hFile);
+            }
+            ::CloseHandle(m_hFile);
+        }
+        m_hMap = nullptr;
+        m_hFile = INVALID_HANDLE_VALUE;
+#elif defined(__unix__) || defined(__APPLE__)
+        if (nullptr != m_pBase) {
+            ::munmap(m_pBase, m_szMapped);
+        }
+        if (m_iFd >= 0) {
+            if (nullptr != m_pBase) {
+                (void)!::ftruncate(m_iFd, static_cast<off_t>(sizeof(FileHeader) + uUsed));
+            }
+            ::close(m_iFd);
+        }
+        m_iFd = -1;
+#endif
+        m_pBase = nullptr;
+        m_szMapped = 0;
+        m_szCapacity = 0;
+        m_uNext.store(0U);
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return nullptr != m_pBase; }
+
+    [[nodiscard]] uint64_t dropped() const noexcept { return m_uDropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Time stamp of a record, ns after the origin in the header.
+     */
+    [[nodiscard]] int64_t now() const noexcept { return steadyNs() - m_iSteadyOriginNs; }
+
+    /**
+     * @brief Writes one record; false (counted as dropped) if it does not fit.
+     */
+    bool write(RecordKind eKind, uint8_t uLevel, uint16_t uSite, uint32_t uTid, int64_t iTimeNs,
+               const void* pPayload, size_t szLength) noexcept
+    {
+        const size_t szRecord = recordSize(szLength);
+        const uint64_t uOffset = m_uNext.fetch_add(szRecord, std::memory_order_relaxed);
+        if (uOffset + szRecord > m_szCapacity) {
+            m_uDropped.fetch_add(1U, std::memory_order_relaxed);
+            return false;
+        }
+
+        char *pRecord = m_pBase + sizeof(FileHeader) + uOffset;
+        RecordHeader sHeader {0U, static_cast<uint8_t>(eKind), uLevel, uSite, uTid,
+                              static_cast<uint32_t>(szLength), iTimeNs};
+        std::memcpy(pRecord + sizeof(uint32_t), reinterpret_cast<const char*>(&sHeader) + sizeof(uint32_t),
+                    sizeof(sHeader) - sizeof(uint32_t));
+        if (szLength > 0U) {
+            std::memcpy(pRecord + sizeof(RecordHeader), pPayload, szLength);
+        }
+        std::atomic_ref<uint32_t>(*reinterpret_cast<uint32_t*>(pRecord))
+            .store(static_cast<uint32_t>(szRecord), std::memory_order_release);
+        return true;
+    }
+
+private:
+
+    static int64_t steadyNs() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    char                  *m_pBase = nullptr;
+    size_t                 m_szMapped = 0;
+    size_t                 m_szCapacity = 0;
+    std::atomic<uint64_t>  m_uNext {0};         /**< next free offset after the header */
+    std::atomic<uint64_t>  m_uDropped {0};
+    int64_t                m_iSteadyOriginNs = 0;
+#if defined(_WIN32)
+    HANDLE                 m_hFile = INVALID_HANDLE_VALUE;
+    HANDLE                 m_hMap = nullptr;
+#else
+    int                    m_iFd = -1;
+#endif
+};
+
+} // namespace ulogbin
+
+#endif // ULOGBINARY_H
@@ -1,6 +1,7 @@
 #ifndef ULOGGER_H
 #define ULOGGER_H
 
+#include <cerrno>
 #include <cstdio>
 #include <cstdint>
 #include <cstring>
@@ -14,10 +15,28 @@
 #include <fstream>
 #include <mutex>
 #include <memory>
+#include <new>
 #include <concepts>
 #include <array>
 #include <filesystem>
 #include <optional>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <condition_variable>
+#include <csignal>
+#include <charconv>
+
+#include "uLogBinary.hpp"
+
+#if defined(_WIN32)
+    #include <io.h>
+    #include <fcntl.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
 
 /**
  * @brief Enumeration for log levels.
@@ -43,6 +62,29 @@ inline constexpr auto LOG_FIXED   = LogLevel::EC_FIXED;        /**< Fixed log le
 inline constexpr auto LOG_EMPTY   = LogLevel::EC_EMPTY;        /**< Empty log level constant. */
 
 
+/**
+ * @brief Lowest level compiled in (0 = LOG_VERBOSE ... 6 = LOG_FIXED).
+ *        LOG_PRINT calls below it are removed by the compiler, arguments
+ *        included; LOG_EMPTY is always kept.
+ */
+#ifndef ULOGGER_COMPILE_MIN_LEVEL
+#define ULOGGER_COMPILE_MIN_LEVEL        0
+#endif
+
+/**
+ * @brief Checks a level against ULOGGER_COMPILE_MIN_LEVEL.
+ */
+[[nodiscard]] constexpr bool isLogLevelCompiled(LogLevel level) noexcept
+{
+#if ULOGGER_COMPILE_MIN_LEVEL > 0
+    return (level == LOG_EMPTY) || (static_cast<int>(level) >= ULOGGER_COMPILE_MIN_LEVEL);
+#else
+    (void)level;
+    return true;
+#endif
+}
+
+
 /**
  * @brief Default logger settings 
  */
@@ -51,6 +93,38 @@ inline constexpr auto LOG_EMPTY   = LogLevel::EC_EMPTY;        /**< Empty log le
 #define LOGGER_DEFAULT_ENABLE_FILELOG    false
 #define LOGGER_DEFAULT_INCLUDE_DATE      false
 #define LOGGER_DEFAULT_USE_COLORS        true
+#define LOGGER_DEFAULT_RELATIVE_TIME     false
+
+/**
+ * @brief Default settings of the asynchronous mode (LogBuffer::startAsync).
+ */
+#define LOGGER_DEFAULT_ASYNC_QUEUE       8192
+#define LOGGER_DEFAULT_ASYNC_FLUSH_MS    50
+
+/**
+ * @brief Default settings of the binary mode (LogBuffer::startBinary).
+ */
+#define LOGGER_DEFAULT_BINARY_SIZE       (64U * 1024U * 1024U)
+#define LOGGER_DEFAULT_BINARY_SEVERITY   LOG_VERBOSE
+
+/**
+ * @brief What the asynchronous logger does with a message when its queue is full.
+ */
+enum class LogOverflow : uint8_t {
+    BLOCK,             /**< Wait until the writer thread made room. */
+    DROP_OLDEST,       /**< Discard the oldest queued message. */
+    DROP_NEWEST        /**< Discard the new message; the writer reports the count. */
+};
+
+/**
+ * @brief Conversion from the .ini spelling to LogOverflow
+ */
+inline std::optional<LogOverflow> string2logoverflow(std::string_view sv) {
+    if (sv == "BLOCK")       return LogOverflow::BLOCK;
+    if (sv == "DROP_OLDEST") return LogOverflow::DROP_OLDEST;
+    if (sv == "DROP_NEWEST") return LogOverflow::DROP_NEWEST;
+    return std::nullopt;
+}
 
 using ConsoleLogLevel = LogLevel;                           /**< Console log level threshold. */
 using FileLogLevel    = LogLevel;                           /**< File log level threshold. */
@@ -140,6 +214,19 @@ namespace log_concepts {
     }
 }
 
+/**
+ * @brief Source location of a LOG_PRINT call site. LOG_PRINT keeps one as a
+ *        static, so the binary log refers to the location by a small id.
+ */
+struct LogSite
+{
+    const char* file;                                               /**< __FILE__ of the call site. */
+    uint32_t line;                                                  /**< __LINE__ of the call site. */
+    std::atomic<uint32_t> key {0};                                  /**< Binary session << 16 | site id, 0: not registered. */
+
+    constexpr LogSite(const char* pFile, uint32_t uLine) noexcept : file(pFile), line(uLine) {}
+};
+
 /**
  * @brief Structure for log buffer with optimized performance and safety.
  */
@@ -148,27 +235,374 @@ struct LogBuffer
     static constexpr size_t BUFFER_SIZE = 1024;                     /**< Buffer size constant. */
     static constexpr const char* RESET_COLOR = "\033[0m";
 
-    char buffer[BUFFER_SIZE] {};                                    /**< Buffer for storing log messages. */
-    size_t size = 0;                                                /**< Size of the log message in the buffer. */
-    LogLevel currentLevel = LOG_INFO;                               /**< Current log level. */
+    /**
+     * @brief Staging area of the message being built by LOG_PRINT; one per
+     *        thread, so threads build their messages without a lock.
+     */
+    struct Stage
+    {
+        char buffer[BUFFER_SIZE] {};                                /**< Buffer for storing log messages. */
+        size_t size = 0;                                            /**< Size of the log message in the buffer. */
+        LogLevel currentLevel = LOG_INFO;                           /**< Current log level. */
+        bool binary = false;                                        /**< Buffer holds encoded arguments (binary mode). */
+        LogSite* site = nullptr;                                    /**< Call site of the message, if known. */
+    };
+
+    /**
+     * @brief A formatted message held back by a capture.
+     */
+    struct Record
+    {
+        LogLevel level = LOG_INFO;                                  /**< Level of the message. */
+        std::string text;                                           /**< Formatted line (raw content for LOG_EMPTY). */
+    };
+
+    /**
+     * @brief Bounded lock-free multi-producer queue of records (sequence
+     *        numbered slots). Producers may also pop, to drop the oldest.
+     */
+    class RecordRing
+    {
+    public:
+
+        explicit RecordRing(size_t capacity)
+        {
+            size_t pow2 = 2U;
+            while (pow2 < capacity) {
+                pow2 <<= 1U;
+            }
+            mask = pow2 - 1U;
+            slots = std::make_unique<Slot[]>(pow2);
+            for (size_t i = 0; i < pow2; ++i) {
+                slots[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Queues a record; false (record untouched) if the ring is full.
+         */
+        bool push(Record& record) noexcept
+        {
+            size_t pos = tail.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = slots[pos & mask];
+                const size_t seq = slot.seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+                if (diff == 0) {
+                    if (tail.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+                        slot.record = std::move(record);
+                        slot.seq.store(pos + 1U, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Takes the oldest record; false if the ring is empty.
+         */
+        bool pop(Record& record) noexcept
+        {
+            size_t pos = head.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = slots[pos & mask];
+                const size_t seq = slot.seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1U));
+                if (diff == 0) {
+                    if (head.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+                        record = std::move(slot.record);
+                        slot.seq.store(pos + mask + 1U, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            const size_t pos = head.load(std::memory_order_seq_cst);
+            return slots[pos & mask].seq.load(std::memory_order_seq_cst) != (pos + 1U);
+        }
+
+        /**
+         * @brief Calls fn for the queued records, oldest first, without taking
+         *        them; stops at the first slot not filled yet. Only reads the
+         *        ring (used by the crash flush).
+         */
+        template <typename Fn>
+        void peek(Fn&& fn) const noexcept
+        {
+            const size_t first = head.load(std::memory_order_acquire);
+            for (size_t pos = first; (pos - first) <= mask; ++pos) {
+                const Slot& slot = slots[pos & mask];
+                if (slot.seq.load(std::memory_order_acquire) != (pos + 1U)) {
+                    break;
+                }
+                fn(slot.record);
+            }
+        }
+
+    private:
+
+        struct Slot
+        {
+            std::atomic<size_t> seq {0};
+            Record record;
+        };
+
+        size_t mask = 0;
+        std::unique_ptr<Slot[]> slots;
+        alignas(64) std::atomic<size_t> head {0};
+        alignas(64) std::atomic<size_t> tail {0};
+    };
+
+    /**
+     * @brief Per-thread capture, see beginCapture().
+     */
+    struct Capture
+    {
+        std::thread::id threadId;                                   /**< Capturing thread. */
+        std::vector<Record> vRecords;                               /**< Messages printed while capturing. */
+    };
+
+    /**
+     * @brief State of the calling thread: its staging area and its capture,
+     *        cached for the capture list generation it was looked up in.
+     */
+    struct ThreadState
+    {
+        Stage stage;                                                /**< Staging area of the thread. */
+        const LogBuffer* owner = nullptr;                           /**< Logger the cached capture belongs to. */
+        size_t generation = 0;                                      /**< captureGeneration of the cached lookup. */
+        Capture* capture = nullptr;                                 /**< Cached capture of the thread (nullptr: none). */
+        uint32_t tid = 0;                                           /**< Thread id written to the binary log (0: not read yet). */
+    };
 
     LogLevel consoleThreshold = LOGGER_DEFAULT_CONSOLE_SEVERITY;    /**< Console log level threshold. */
     LogLevel fileThreshold = LOGGER_DEFAULT_LOGFILE_SEVERITY;       /**< File log level threshold. */
     bool fileLoggingEnabled = LOGGER_DEFAULT_ENABLE_FILELOG;        /**< Flag indicating if file logging is enabled. */
     bool useColors = LOGGER_DEFAULT_USE_COLORS;                     /**< Flag indicating if colors are used in console logging. */
     bool includeDate = LOGGER_DEFAULT_INCLUDE_DATE;                 /**< Flag indicating if date is included in log messages. */
+    bool relativeTime = LOGGER_DEFAULT_RELATIVE_TIME;               /**< Time stamps are seconds since timeOrigin (steady clock). */
+    std::chrono::steady_clock::time_point timeOrigin = std::chrono::steady_clock::now(); /**< Origin of the relative time stamps. */
+
+    std::atomic<LogLevel> enabledLevel {std::min(LOGGER_DEFAULT_CONSOLE_SEVERITY, LOGGER_DEFAULT_LOGFILE_SEVERITY)}; /**< Lowest level written anywhere. */
 
     std::ofstream logFile;                                          /**< File stream for logging to a file. */
     std::mutex logMutex;                                            /**< Mutex for synchronizing log access. */
 
+    static constexpr size_t ASYNC_BATCH = 256;                      /**< Records written per batch by the writer thread. */
+    static constexpr size_t ASYNC_FLUSH_BYTES = 64 * 1024;          /**< Unflushed output that forces a flush. */
+
+    std::unique_ptr<RecordRing> asyncRing;                          /**< Queue of the asynchronous mode (kept once created). */
+    std::atomic<bool> asyncActive {false};                          /**< Messages go through asyncRing. */
+    std::atomic<bool> asyncStop {false};                            /**< Writer thread asked to drain and exit. */
+    std::atomic<bool> asyncWriterIdle {false};                      /**< Writer thread waits for records. */
+    std::atomic<bool> asyncFlushRequest {false};                    /**< flushAsync() is waiting. */
+    std::atomic<size_t> asyncPushed {0};                            /**< Records queued. */
+    std::atomic<size_t> asyncTaken {0};                             /**< Records written or dropped from the queue. */
+    std::atomic<size_t> asyncFlushed {0};                           /**< asyncTaken at the last flush. */
+    std::atomic<size_t> asyncDropped {0};                           /**< Records dropped, not reported yet. */
+    LogOverflow asyncOverflow = LogOverflow::BLOCK;                 /**< Policy when asyncRing is full. */
+    std::chrono::milliseconds asyncFlushInterval {LOGGER_DEFAULT_ASYNC_FLUSH_MS}; /**< Longest time output stays unflushed. */
+    std::mutex asyncMutex;                                          /**< Guards the idle wait of the writer thread. */
+    std::condition_variable asyncWake;                              /**< Wakes the writer thread. */
+    std::thread asyncWriter;                                        /**< Writer thread of the asynchronous mode. */
+
+    static constexpr size_t CRASH_BUFFER_SIZE = 16 * 1024;          /**< Output buffer of the crash flush. */
+    std::unique_ptr<char[]> crashBuffer;                            /**< Allocated by enableCrashFlush(), used in signal context. */
+    std::atomic<bool> crashFlushEnabled {false};                    /**< enableCrashFlush() was called. */
+    std::atomic<int> crashFileFd {-1};                              /**< Log file opened for the crash flush (-1: none). */
+    std::string logFileName;                                        /**< Name of the open log file. */
+
+    ulogbin::MappedLog binaryLog;                                   /**< File of the binary mode. */
+    std::atomic<bool> binaryActive {false};                         /**< Messages are written to binaryLog. */
+    std::atomic<size_t> binaryWriters {0};                          /**< Threads writing to binaryLog right now. */
+    LogLevel binaryThreshold = LOGGER_DEFAULT_BINARY_SEVERITY;      /**< Binary log level threshold. */
+    uint32_t binarySession = 0;                                     /**< Changed by every startBinary(), invalidates the site ids. */
+    uint32_t binaryNextSite = 1;                                    /**< Next free site id of the session. */
+    std::mutex binaryMutex;                                         /**< Guards the site registration. */
+    std::mutex binaryControlMutex;                                  /**< Serializes startBinary() / stopBinary(). */
+
+    std::mutex captureMutex;                                        /**< Mutex for the capture list. */
+    std::atomic<size_t> captureCount {0};                           /**< Number of active captures (fast path when 0). */
+    std::atomic<size_t> captureGeneration {1};                      /**< Changed by every beginCapture() / endCapture(). */
+    std::vector<std::unique_ptr<Capture>> vCaptures;                /**< Active captures. */
+
+
+    /**
+     * @brief Gets the capture of the calling thread.
+     * @return The capture, or nullptr if the thread is not capturing.
+     */
+    [[nodiscard]] Capture* findCapture() noexcept
+    {
+        if (0U == captureCount.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        // the list is searched only after it changed: the code of the
+        // executable and of each plugin library has its own thread state,
+        // the thread id finds the capture begun in any of them
+        ThreadState& ts = threadState();
+        if ((ts.owner == this) && (ts.generation == captureGeneration.load(std::memory_order_acquire))) {
+            return ts.capture;
+        }
+
+        const std::thread::id threadId = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(captureMutex);
+        ts.owner = this;
+        ts.generation = captureGeneration.load(std::memory_order_relaxed);
+        ts.capture = nullptr;
+        for (auto& upCapture : vCaptures) {
+            if (upCapture->threadId == threadId) {
+                ts.capture = upCapture.get();
+                break;
+            }
+        }
+        return ts.capture;
+    }
+
+
+    /**
+     * @brief Gets the state of the calling thread.
+     */
+    [[nodiscard]] static ThreadState& threadState() noexcept
+    {
+        thread_local ThreadState ts;
+        return ts;
+    }
+
+
+    /**
+     * @brief Gets the staging area of the calling thread.
+     */
+    [[nodiscard]] static Stage& stage() noexcept
+    {
+        return threadState().stage;
+    }
+
+
+    /**
+     * @brief Starts capturing the messages printed by the calling thread.
+     *
+     * Until endCapture() print() stores the messages of the thread instead
+     * of writing them out. The owner replays the records in a fixed order to
+     * keep the output of concurrent threads deterministic.
+     */
+    void beginCapture()
+    {
+        auto upCapture = std::make_unique<Capture>();
+        upCapture->threadId = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> lock(captureMutex);
+        vCaptures.push_back(std::move(upCapture));
+        captureCount.fetch_add(1U, std::memory_order_release);
+        captureGeneration.fetch_add(1U, std::memory_order_release);
+    }
+
+
+    /**
+     * @brief Stops the capture of the calling thread.
+     * @return The messages printed since beginCapture(), in order.
+     */
+    std::vector<Record> endCapture()
+    {
+        const std::thread::id threadId = std::this_thread::get_id();
+        std::vector<Record> vRecords;
+
+        std::lock_guard<std::mutex> lock(captureMutex);
+        for (auto it = vCaptures.begin(); it != vCaptures.end(); ++it) {
+            if ((*it)->threadId == threadId) {
+                vRecords = std::move((*it)->vRecords);
+                vCaptures.erase(it);
+                captureCount.fetch_sub(1U, std::memory_order_release);
+                captureGeneration.fetch_add(1U, std::memory_order_release);
+                break;
+            }
+        }
+        return vRecords;
+    }
+
+
+    /**
+     * @brief Writes out captured messages.
+     * @param vRecords The records returned by endCapture().
+     */
+    void replay(const std::vector<Record>& vRecords)
+    {
+        if (asyncActive.load(std::memory_order_acquire)) {
+            for (const auto& record : vRecords) {
+                Record copy = record;
+                pushAsync(copy);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(logMutex);
+        for (const auto& record : vRecords) {
+            if (record.level == LOG_EMPTY) {
+                emitEmpty(record.text.c_str());
+            } else {
+                emit(record.level, record.text);
+            }
+        }
+    }
+
+    /**
+     * @brief Checks if a message of the given level would be written at all
+     *        (console, file or binary log). Lock free, tested by LOG_PRINT
+     *        before any argument is formatted.
+     * @param level The level of the message.
+     */
+    [[nodiscard]] bool isEnabled(LogLevel level) const noexcept
+    {
+        return (level == LOG_EMPTY) || (level >= enabledLevel.load(std::memory_order_relaxed));
+    }
+
+
+    /**
+     * @brief Checks if a message of the given level goes to the console or
+     *        to the log file.
+     * @param level The level of the message.
+     */
+    [[nodiscard]] bool isTextEnabled(LogLevel level) const noexcept
+    {
+        return (level == LOG_EMPTY) || (level >= consoleThreshold) || (fileLoggingEnabled && (level >= fileThreshold));
+    }
+
+
+    /**
+     * @brief Recomputes enabledLevel after a change of the thresholds, of
+     *        the file logging state or of the binary mode.
+     */
+    void updateEnabledLevel() noexcept
+    {
+        LogLevel level = fileLoggingEnabled ? std::min(consoleThreshold, fileThreshold) : consoleThreshold;
+        if (binaryActive.load()) {
+            level = std::min(level, binaryThreshold);
+        }
+        enabledLevel.store(level, std::memory_order_relaxed);
+    }
+
     /**
      * @brief Resets the log buffer.
      */
     void reset() noexcept
     {
-        size = 0;
-        buffer[0] = '\0';
-        currentLevel = LOG_INFO;
+        Stage& st = stage();
+        st.size = 0;
+        st.buffer[0] = '\0';
+        st.currentLevel = LOG_INFO;
+        st.binary = false;
+        st.site = nullptr;
     }
 
 
@@ -177,9 +611,9 @@ struct LogBuffer
      * @param needed Amount of space needed
      * @return true if space available, false otherwise
      */
-    [[nodiscard]] constexpr bool hasSpace(size_t needed) const noexcept
+    [[nodiscard]] static bool hasSpace(size_t needed) noexcept
     {
-        return (size + needed) < BUFFER_SIZE;
+        return (stage().size + needed) < BUFFER_SIZE;
     }
 
 
@@ -190,29 +624,66 @@ struct LogBuffer
     template<typename... Args>
     size_t appendSafe(const char* format, Args... args) noexcept
     {
-        if (size >= BUFFER_SIZE) return 0;
+        Stage& st = stage();
+        if (st.size >= BUFFER_SIZE) return 0;
         
-        int written = std::snprintf(buffer + size, BUFFER_SIZE - size, format, args...);
+        int written = std::snprintf(st.buffer + st.size, BUFFER_SIZE - st.size, format, args...);
         if (written < 0) return 0;
         
         size_t actual = static_cast<size_t>(written);
-        if (size + actual >= BUFFER_SIZE) {
+        if (st.size + actual >= BUFFER_SIZE) {
             // Truncation occurred
-            actual = BUFFER_SIZE - size - 1;
-            buffer[BUFFER_SIZE - 1] = '\0';
+            actual = BUFFER_SIZE - st.size - 1;
+            st.buffer[BUFFER_SIZE - 1] = '\0';
         }
         
-        size += actual;
+        st.size += actual;
         return actual;
     }
 
 
+    /**
+     * @brief Binary mode: appends a type tag and the raw bytes of a value.
+     *        A value that does not fit is dropped, like truncated text.
+     */
+    static void encode(ulogbin::ArgType type, const void* data, size_t size) noexcept
+    {
+        Stage& st = stage();
+        if (st.size + 1U + size > BUFFER_SIZE) return;
+
+        st.buffer[st.size++] = static_cast<char>(type);
+        std::memcpy(st.buffer + st.size, data, size);
+        st.size += size;
+    }
+
+
+    /**
+     * @brief Binary mode: appends a string (copied, truncated to the space left).
+     */
+    static void encodeString(const char* text, size_t length) noexcept
+    {
+        Stage& st = stage();
+        if (st.size + 1U + sizeof(uint16_t) > BUFFER_SIZE) return;
+
+        const auto size = static_cast<uint16_t>(std::min(length, BUFFER_SIZE - st.size - 1U - sizeof(uint16_t)));
+        st.buffer[st.size++] = static_cast<char>(ulogbin::ArgType::STR);
+        std::memcpy(st.buffer + st.size, &size, sizeof(size));
+        st.size += sizeof(size);
+        std::memcpy(st.buffer + st.size, text, size);
+        st.size += size;
+    }
+
+
     /**
      * @brief Appends a single character to the log buffer.
      * @param c The character to append.
      */
     void append(char c) noexcept
     {
+        if (stage().binary) {
+            encode(ulogbin::ArgType::CHAR, &c, sizeof(c));
+            return;
+        }
         appendSafe("%c ", c);
     }
 
@@ -224,6 +695,10 @@ struct LogBuffer
     void append(const char* text) noexcept
     {
         if (text != nullptr) {
+            if (stage().binary) {
+                encodeString(text, std::strlen(text));
+                return;
+            }
             appendSafe("%s ", text);
         }
     }
@@ -247,17 +722,22 @@ struct LogBuffer
      */
     void append(std::string_view text_view) noexcept
     {
-        if (text_view.empty() || size >= BUFFER_SIZE) return;
+        Stage& st = stage();
+        if (text_view.empty() || st.size >= BUFFER_SIZE) return;
+        if (st.binary) {
+            encodeString(text_view.data(), text_view.size());
+            return;
+        }
 
         // Direct copy for string_view to avoid allocation
-        size_t available = BUFFER_SIZE - size - 2; // -2 for space and null terminator
+        size_t available = BUFFER_SIZE - st.size - 2; // -2 for space and null terminator
         size_t toCopy = std::min(text_view.size(), available);
         
         if (toCopy > 0) {
-            std::memcpy(buffer + size, text_view.data(), toCopy);
-            size += toCopy;
-            buffer[size++] = ' ';
-            buffer[size] = '\0';
+            std::memcpy(st.buffer + st.size, text_view.data(), toCopy);
+            st.size += toCopy;
+            st.buffer[st.size++] = ' ';
+            st.buffer[st.size] = '\0';
         }
     }
 
@@ -270,6 +750,10 @@ struct LogBuffer
     template<size_t N>
     void append(const char (&text)[N]) noexcept
     {
+        if (stage().binary) {
+            encodeString(text, strnlen(text, N));
+            return;
+        }
         appendSafe("%.*s ", static_cast<int>(strnlen(text, N)), text);
     }
 
@@ -295,6 +779,11 @@ struct LogBuffer
      */
     void append(bool value) noexcept
     {
+        if (stage().binary) {
+            const char raw = value ? 1 : 0;
+            encode(ulogbin::ArgType::BOOL, &raw, sizeof(raw));
+            return;
+        }
         appendSafe("%s ", value ? "true" : "false");
     }
 
@@ -307,6 +796,17 @@ struct LogBuffer
     template<log_concepts::Integral T>
     void append(T value) noexcept
     {
+        if (stage().binary) {
+            if constexpr (std::is_signed_v<T>) {
+                const auto raw = static_cast<int64_t>(value);
+                encode(ulogbin::ArgType::INT, &raw, sizeof(raw));
+            } else {
+                const auto raw = static_cast<uint64_t>(value);
+                encode(ulogbin::ArgType::UINT, &raw, sizeof(raw));
+            }
+            return;
+        }
+
         if constexpr (std::is_same_v<T, int8_t>) {
             appendSafe("%d ", static_cast<int>(value));
         } else if constexpr (std::is_same_v<T, uint8_t>) {
@@ -341,6 +841,24 @@ struct LogBuffer
     template<log_concepts::Integral T>
     void appendHex(T value) noexcept
     {
+        if (stage().binary) {
+            const auto raw = static_cast<uint64_t>(static_cast<unsigned long long>(value));
+            if constexpr (std::is_same_v<T, uint8_t>) {
+                encode(ulogbin::ArgType::HEX8, &raw, sizeof(raw));
+            } else if constexpr (std::is_same_v<T, uint16_t>) {
+                encode(ulogbin::ArgType::HEX16, &raw, sizeof(raw));
+            } else if constexpr (std::is_same_v<T, uint32_t> || std::is_same_v<T, unsigned int>) {
+                encode(ulogbin::ArgType::HEX32, &raw, sizeof(raw));
+            } else if constexpr (std::is_same_v<T, uint64_t>) {
+                encode(ulogbin::ArgType::HEX64, &raw, sizeof(raw));
+            } else if constexpr (std::is_same_v<T, size_t>) {
+                encode((sizeof(size_t) == 8) ? ulogbin::ArgType::HEX64 : ulogbin::ArgType::HEX32, &raw, sizeof(raw));
+            } else {
+                encode(ulogbin::ArgType::HEX, &raw, sizeof(raw));
+            }
+            return;
+        }
+
         if constexpr (std::is_same_v<T, uint8_t>) {
             appendSafe("0x%02X ", static_cast<unsigned>(value));
         } else if constexpr (std::is_same_v<T, uint16_t>) {
@@ -370,6 +888,11 @@ struct LogBuffer
     template<log_concepts::FloatingPoint T>
     void append(T value) noexcept
     {
+        if (stage().binary) {
+            const auto raw = static_cast<double>(value);
+            encode(ulogbin::ArgType::REAL, &raw, sizeof(raw));
+            return;
+        }
         appendSafe("%.8f ", static_cast<double>(value));
     }
 
@@ -382,41 +905,165 @@ struct LogBuffer
     template<log_concepts::Pointer T>
     void append(T ptr) noexcept
     {
+        if (stage().binary) {
+            const auto raw = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+            encode(ulogbin::ArgType::PTR, &raw, sizeof(raw));
+            return;
+        }
         appendSafe("%p ", static_cast<const void*>(ptr));
     }
 
 
+    static constexpr size_t TIMESTAMP_SIZE = 40;                    /**< Room for any time stamp prefix. */
+
     /**
-     * @brief Gets the current timestamp (cached for performance).
-     * @return The current timestamp as a string.
+     * @brief Writes value as exactly width decimal digits (zero padded).
      */
-    [[nodiscard]] std::string getTimestamp() const
+    static char* writeDigits(char* out, uint64_t value, size_t width) noexcept
     {
-        using namespace std::chrono;
-        auto now = system_clock::now();
-        auto duration = now.time_since_epoch();
-        auto micros = duration_cast<microseconds>(duration) % 1'000'000;
+        char digits[20];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        const auto length = static_cast<size_t>(result.ptr - digits);
+        for (size_t i = length; i < width; ++i) {
+            *out++ = '0';
+        }
+        std::memcpy(out, digits, length);
+        return out + length;
+    }
 
-        std::time_t t = system_clock::to_time_t(now);
-        std::tm tm;
+
+    /**
+     * @brief Writes the wall clock prefix "[YYYY-MM-DD ]HH:MM:SS.uuuuuu | ".
+     *        The date and time part is formatted only when the second
+     *        changes (cached per thread), the microseconds are appended as
+     *        digits.
+     * @param wallUs Microseconds since the epoch.
+     * @param date Include the date.
+     * @param out At least TIMESTAMP_SIZE chars, not terminated.
+     * @return Number of chars written.
+     */
+    static size_t formatWallTimestamp(int64_t wallUs, bool date, char* out) noexcept
+    {
+        struct Cache {
+            int64_t second = -1;
+            bool date = false;
+            size_t size = 0;
+            char prefix[TIMESTAMP_SIZE] {};
+        };
+        thread_local Cache cache;
+
+        const int64_t second = wallUs / 1'000'000;
+        if ((cache.second != second) || (cache.date != date)) {
+            const auto t = static_cast<std::time_t>(second);
+            std::tm tm {};
 #ifdef _WIN32
-        localtime_s(&tm, &t);
+            localtime_s(&tm, &t);
 #else
-        localtime_r(&t, &tm);
+            localtime_r(&t, &tm);
 #endif
+            cache.size = std::strftime(cache.prefix, sizeof(cache.prefix), date ? "%Y-%m-%d %H:%M:%S" : "%H:%M:%S", &tm);
+            cache.second = second;
+            cache.date = date;
+        }
 
-        // Pre-allocate string with estimated size
-        std::ostringstream oss;
-        oss.imbue(std::locale::classic()); // Use C locale for consistent formatting
-        
-        if (includeDate) {
-            oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+        std::memcpy(out, cache.prefix, cache.size);
+        char* p = out + cache.size;
+        *p++ = '.';
+        p = writeDigits(p, static_cast<uint64_t>(wallUs % 1'000'000), 6);
+        std::memcpy(p, " | ", 3);
+        return static_cast<size_t>(p + 3 - out);
+    }
+
+
+    /**
+     * @brief Writes the relative prefix "+SSSSS.uuuuuu | " (seconds since
+     *        the origin, at least five digits).
+     * @param elapsedNs Nanoseconds since the origin.
+     * @param out At least TIMESTAMP_SIZE chars, not terminated.
+     * @return Number of chars written.
+     */
+    static size_t formatRelativeTimestamp(int64_t elapsedNs, char* out) noexcept
+    {
+        const uint64_t us = (elapsedNs > 0) ? static_cast<uint64_t>(elapsedNs / 1000) : 0U;
+        char* p = out;
+        *p++ = '+';
+        p = writeDigits(p, us / 1'000'000U, 5);
+        *p++ = '.';
+        p = writeDigits(p, us % 1'000'000U, 6);
+        std::memcpy(p, " | ", 3);
+        return static_cast<size_t>(p + 3 - out);
+    }
+
+
+    /**
+     * @brief Writes the time stamp prefix of a message printed now.
+     * @param out At least TIMESTAMP_SIZE chars, not terminated.
+     * @return Number of chars written.
+     */
+    size_t formatTimestamp(char* out) const noexcept
+    {
+        using namespace std::chrono;
+        if (relativeTime) {
+            return formatRelativeTimestamp(duration_cast<nanoseconds>(steady_clock::now() - timeOrigin).count(), out);
+        }
+        return formatWallTimestamp(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count(),
+                                   includeDate, out);
+    }
+
+
+    /**
+     * @brief Gets the current timestamp.
+     * @return The current timestamp as a string.
+     */
+    [[nodiscard]] std::string getTimestamp() const
+    {
+        char buffer[TIMESTAMP_SIZE];
+        return std::string(buffer, formatTimestamp(buffer));
+    }
+
+
+    /**
+     * @brief Writes a LOG_EMPTY line (raw content, no prefix). Expects logMutex held.
+     * @param content The line to write.
+     */
+    void emitEmpty(const char* content)
+    {
+        if (useColors) {
+            std::printf("%s%s\n%s", getColor(LOG_EMPTY), content, RESET_COLOR);
         } else {
-            oss << std::put_time(&tm, "%H:%M:%S");
+            std::printf("%s\n", content);
+        }
+        std::fflush(stdout);
+        if (fileLoggingEnabled && logFile.is_open()) {
+            logFile << content << '\n';
+            logFile.flush();
+        }
+    }
+
+
+    /**
+     * @brief Writes a formatted message to console and file. Expects logMutex held.
+     * @param level The level of the message.
+     * @param fullMessage The message with timestamp and level prefix.
+     */
+    void emit(LogLevel level, const std::string& fullMessage)
+    {
+        // Console output
+        if (level >= consoleThreshold) {
+            if (useColors) {
+                // More efficient: print with color codes in one call
+                std::printf("%s%s%s", getColor(level), fullMessage.c_str(), RESET_COLOR);
+            } else {
+                std::fputs(fullMessage.c_str(), stdout);
+            }
+            std::fflush(stdout); // Ensure immediate output
+        }
+
+        // File output
+        if (fileLoggingEnabled && level >= fileThreshold && logFile.is_open()) {
+            logFile.write(fullMessage.data(), fullMessage.size());
+            logFile.flush();
         }
-        oss << '.' << std::setfill('0') << std::setw(6) << micros.count() << " | ";
-        
-        return oss.str();
     }
 
 
@@ -425,76 +1072,648 @@ struct LogBuffer
      */
     void print()
     {
+        Stage& st = stage();
+
+        // binary mode: the record is written as is; the text is rendered
+        // only if the console or the log file takes the message
+        if (st.binary) {
+            writeBinary(st);
+            if (!isTextEnabled(st.currentLevel)) {
+                reset();
+                return;
+            }
+            std::string text;
+            ulogbin::decodeArgs(st.buffer, st.size, text);
+            st.size = std::min(text.size(), BUFFER_SIZE - 1);
+            std::memcpy(st.buffer, text.data(), st.size);
+            st.buffer[st.size] = '\0';
+            st.binary = false;
+        }
+
+        Capture* pCapture = findCapture();
+
         // LOG_EMPTY: bypass timestamp/severity prefix entirely.
         // Prints the raw buffer content followed by a newline, or just a blank
         // line when the buffer is empty (i.e. called with an empty string).
-        if (currentLevel == LOG_EMPTY) {
-            std::lock_guard<std::mutex> lock(logMutex);
-            const char* content = (size > 0) ? buffer : "";
-            if (useColors) {
-                std::printf("%s%s\n%s", getColor(LOG_EMPTY), content, RESET_COLOR);
+        if (st.currentLevel == LOG_EMPTY) {
+            const char* content = (st.size > 0) ? st.buffer : "";
+            if (nullptr != pCapture) {
+                pCapture->vRecords.push_back({LOG_EMPTY, content});
+            } else if (asyncActive.load(std::memory_order_acquire)) {
+                Record record {LOG_EMPTY, content};
+                pushAsync(record);
             } else {
-                std::printf("%s\n", content);
-            }
-            std::fflush(stdout);
-            if (fileLoggingEnabled && logFile.is_open()) {
-                logFile << content << '\n';
-                logFile.flush();
+                std::lock_guard<std::mutex> lock(logMutex);
+                emitEmpty(content);
             }
             reset();
             return;
         }
 
-        if (size == 0) {
+        if ((st.size == 0) || !isTextEnabled(st.currentLevel)) {
             reset();
             return;
         }
 
-        std::lock_guard<std::mutex> lock(logMutex);
-        
         // Build the message once
-        std::string timestamp = getTimestamp();
-        const char* levelStr = toString(currentLevel);
+        char timestamp[TIMESTAMP_SIZE];
+        const size_t timestampSize = formatTimestamp(timestamp);
+        const char* levelStr = toString(st.currentLevel);
         
         // Pre-calculate total size to avoid reallocations
-        size_t totalSize = timestamp.size() + std::strlen(levelStr) + 3 + size + 1; // " | " + buffer + "\n"
+        size_t totalSize = timestampSize + std::strlen(levelStr) + 3 + st.size + 1; // " | " + buffer + "\n"
         std::string fullMessage;
         fullMessage.reserve(totalSize);
         
-        fullMessage.append(timestamp);
+        fullMessage.append(timestamp, timestampSize);
         fullMessage.append(levelStr);
         fullMessage.append(" | ");
-        fullMessage.append(buffer, size);
+        fullMessage.append(st.buffer, st.size);
         fullMessage.push_back('\n');
 
-        // Console output
-        if (currentLevel >= consoleThreshold) {
-            if (useColors) {
-                // More efficient: print with color codes in one call
-                std::printf("%s%s%s", getColor(currentLevel), fullMessage.c_str(), RESET_COLOR);
+        if (nullptr != pCapture) {
+            pCapture->vRecords.push_back({st.currentLevel, std::move(fullMessage)});
+        } else if (asyncActive.load(std::memory_order_acquire)) {
+            Record record {st.currentLevel, std::move(fullMessage)};
+            pushAsync(record);
+        } else {
+            std::lock_guard<std::mutex> lock(logMutex);
+            emit(st.currentLevel, fullMessage);
+        }
+
+        reset();
+    }
+
+
+    /**
+     * @brief Switches to the asynchronous mode: print() queues the formatted
+     *        messages and a writer thread writes them to console and file in
+     *        batches, flushing when ASYNC_FLUSH_BYTES are pending or
+     *        flushInterval has passed. Queued messages are written out by
+     *        stopAsync(), at destruction and, if enabled, on the fatal signals
+     *        (see enableCrashFlush()).
+     * @param capacity Queue size, rounded up to a power of two. The queue of
+     *                 the first call is kept by later calls.
+     * @param overflow What to do when the queue is full.
+     * @param flushInterval Longest time output stays unflushed.
+     * @return false if the writer thread could not be started (the logger
+     *         stays synchronous).
+     */
+    bool startAsync(size_t capacity = LOGGER_DEFAULT_ASYNC_QUEUE,
+                    LogOverflow overflow = LogOverflow::BLOCK,
+                    std::chrono::milliseconds flushInterval = std::chrono::milliseconds(LOGGER_DEFAULT_ASYNC_FLUSH_MS))
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        if (asyncWriter.joinable()) {
+            return true;
+        }
+
+        try {
+            if (!asyncRing) {
+                asyncRing = std::make_unique<RecordRing>(std::max<size_t>(capacity, 2U));
+            }
+            asyncOverflow = overflow;
+            asyncFlushInterval = std::max(flushInterval, std::chrono::milliseconds(1));
+            asyncStop.store(false);
+            asyncWriter = std::thread(&LogBuffer::asyncWriterLoop, this);
+        } catch (const std::exception&) {
+            return false;
+        }
+
+        asyncActive.store(true, std::memory_order_release);
+        if (crashFlushEnabled.load()) {
+            installCrashFlush(this);
+        }
+        return true;
+    }
+
+
+    /**
+     * @brief Opt-in: while the asynchronous mode runs, SIGSEGV, SIGABRT,
+     *        SIGBUS, SIGFPE and SIGILL write the queued messages out before
+     *        the process ends. The handler neither allocates nor locks nor
+     *        takes records from the queue: it copies the queued text through
+     *        a buffer allocated here and writes it with write(2) to the
+     *        console and to the log file. Messages the writer thread already
+     *        took from the queue but did not write are lost.
+     * @return false if the buffer could not be allocated.
+     */
+    bool enableCrashFlush()
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        if (!crashBuffer) {
+            crashBuffer.reset(new (std::nothrow) char[CRASH_BUFFER_SIZE]);
+            if (!crashBuffer) {
+                return false;
+            }
+        }
+
+        crashFlushEnabled.store(true);
+        {
+            std::lock_guard<std::mutex> logLock(logMutex);
+            openCrashFile();
+        }
+        if (asyncWriter.joinable()) {
+            installCrashFlush(this);
+        }
+        return true;
+    }
+
+
+    /**
+     * @brief Removes the signal handlers of enableCrashFlush().
+     */
+    void disableCrashFlush()
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        crashFlushEnabled.store(false);
+        installCrashFlush(nullptr);
+
+        std::lock_guard<std::mutex> logLock(logMutex);
+        closeCrashFile();
+    }
+
+
+    /**
+     * @brief Writes out the queued messages, stops the writer thread and goes
+     *        back to the synchronous mode.
+     */
+    void stopAsync()
+    {
+        std::unique_lock<std::mutex> lock(asyncMutex);
+        if (!asyncWriter.joinable()) {
+            return;
+        }
+        asyncActive.store(false, std::memory_order_release);
+        asyncStop.store(true);
+        asyncWake.notify_one();
+        std::thread writer = std::move(asyncWriter);
+        lock.unlock();
+
+        writer.join();
+        installCrashFlush(nullptr);
+
+        // messages of producers that saw the asynchronous mode just before it ended
+        Record record;
+        std::lock_guard<std::mutex> logLock(logMutex);
+        while (asyncRing->pop(record)) {
+            if (record.level == LOG_EMPTY) {
+                emitEmpty(record.text.c_str());
             } else {
-                std::fputs(fullMessage.c_str(), stdout);
+                emit(record.level, record.text);
             }
-            std::fflush(stdout); // Ensure immediate output
         }
+    }
 
-        // File output
-        if (fileLoggingEnabled && currentLevel >= fileThreshold && logFile.is_open()) {
-            logFile.write(fullMessage.data(), fullMessage.size());
-            logFile.flush();
+
+    /**
+     * @brief Blocks until the messages queued so far are written and flushed.
+     */
+    void flushAsync()
+    {
+        const size_t target = asyncPushed.load();
+        while (asyncActive.load(std::memory_order_acquire) && (asyncFlushed.load() < target)) {
+            asyncFlushRequest.store(true);
+            wakeWriter();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
+    }
 
-        reset();
+
+    /**
+     * @brief Queues a message according to the overflow policy.
+     */
+    void pushAsync(Record& record) noexcept
+    {
+        for (;;) {
+            if (asyncRing->push(record)) {
+                asyncPushed.fetch_add(1U);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (asyncWriterIdle.load()) {
+                    wakeWriter();
+                }
+                return;
+            }
+
+            switch (asyncOverflow) {
+                case LogOverflow::DROP_NEWEST:
+                    asyncDropped.fetch_add(1U);
+                    return;
+                case LogOverflow::DROP_OLDEST: {
+                    Record oldest;
+                    if (asyncRing->pop(oldest)) {
+                        asyncTaken.fetch_add(1U);
+                        asyncDropped.fetch_add(1U);
+                    }
+                    break;
+                }
+                case LogOverflow::BLOCK:
+                default:
+                    wakeWriter();
+                    std::this_thread::yield();
+                    break;
+            }
+        }
+    }
+
+
+    /**
+     * @brief Wakes the writer thread.
+     */
+    void wakeWriter() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(asyncMutex);
+        }
+        asyncWake.notify_one();
+    }
+
+
+    /**
+     * @brief Body of the writer thread: takes the records in batches, writes
+     *        each batch with one call per output and flushes by size or time.
+     */
+    void asyncWriterLoop()
+    {
+        using clock = std::chrono::steady_clock;
+
+        std::string console;
+        std::string file;
+        console.reserve(ASYNC_FLUSH_BYTES);
+        file.reserve(ASYNC_FLUSH_BYTES);
+
+        Record record;
+        size_t unflushedBytes = 0;
+        auto lastFlush = clock::now();
+
+        for (;;) {
+            size_t taken = 0;
+            while ((taken < ASYNC_BATCH) && asyncRing->pop(record)) {
+                formatRecord(record, console, file);
+                ++taken;
+            }
+            if (const size_t dropped = asyncDropped.exchange(0U); dropped > 0U) {
+                Record warning {LOG_WARNING, getTimestamp() + toString(LOG_WARNING) + " | Logger queue full, messages dropped: " +
+                                             std::to_string(dropped) + "\n"};
+                formatRecord(warning, console, file);
+            }
+
+            if (!console.empty() || !file.empty()) {
+                std::lock_guard<std::mutex> lock(logMutex);
+                std::fwrite(console.data(), 1U, console.size(), stdout);
+                if (fileLoggingEnabled && logFile.is_open()) {
+                    logFile.write(file.data(), static_cast<std::streamsize>(file.size()));
+                }
+                unflushedBytes += console.size() + file.size();
+                console.clear();
+                file.clear();
+            }
+            asyncTaken.fetch_add(taken);
+
+            const bool stopping = asyncStop.load() && asyncRing->empty();
+            const auto now = clock::now();
+            if ((unflushedBytes >= ASYNC_FLUSH_BYTES) || (now - lastFlush >= asyncFlushInterval) ||
+                asyncFlushRequest.exchange(false) || stopping) {
+                if (unflushedBytes > 0U) {
+                    std::lock_guard<std::mutex> lock(logMutex);
+                    std::fflush(stdout);
+                    if (logFile.is_open()) {
+                        logFile.flush();
+                    }
+                }
+                unflushedBytes = 0;
+                lastFlush = now;
+                asyncFlushed.store(asyncTaken.load());
+            }
+
+            if (stopping) {
+                break;
+            }
+            if (taken > 0U) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(asyncMutex);
+            asyncWriterIdle.store(true);
+            if (asyncRing->empty() && !asyncStop.load() && !asyncFlushRequest.load()) {
+                asyncWake.wait_for(lock, (unflushedBytes > 0U) ? (lastFlush + asyncFlushInterval - now) : asyncFlushInterval);
+            }
+            asyncWriterIdle.store(false);
+        }
+    }
+
+
+    /**
+     * @brief Appends a record to the console / file batches, with the
+     *        filtering and colouring of emit() and emitEmpty().
+     */
+    void formatRecord(const Record& record, std::string& console, std::string& file) const
+    {
+        const bool bEmpty = (record.level == LOG_EMPTY);
+        if (bEmpty || (record.level >= consoleThreshold)) {
+            if (useColors) {
+                console.append(getColor(record.level));
+            }
+            console.append(record.text);
+            if (bEmpty) {
+                console.push_back('\n');
+            }
+            if (useColors) {
+                console.append(RESET_COLOR);
+            }
+        }
+        if (fileLoggingEnabled && (bEmpty || (record.level >= fileThreshold))) {
+            file.append(record.text);
+            if (bEmpty) {
+                file.push_back('\n');
+            }
+        }
+    }
+
+
+    /**
+     * @brief Best-effort output of the queued messages from a signal handler:
+     *        the process is going down, the writer thread may never run again.
+     *        Async-signal-safe: memcpy into crashBuffer and write(2) only.
+     */
+    void crashFlush() const noexcept
+    {
+        if (!asyncRing || !crashBuffer) {
+            return;
+        }
+
+#if defined(_WIN32)
+        crashWrite(_fileno(stdout), true);
+#else
+        crashWrite(STDOUT_FILENO, true);
+#endif
+        if (const int fd = crashFileFd.load(); fd >= 0) {
+            crashWrite(fd, false);
+        }
+    }
+
+
+    /**
+     * @brief Writes the queued records taken by one output (console or file)
+     *        to fd, with the filtering and colouring of formatRecord().
+     */
+    void crashWrite(int fd, bool console) const noexcept
+    {
+        char* const buffer = crashBuffer.get();
+        size_t used = 0;
+
+        auto flush = [&]() {
+            size_t done = 0;
+            while (done < used) {
+#if defined(_WIN32)
+                const int written = _write(fd, buffer + done, static_cast<unsigned int>(used - done));
+#else
+                const ssize_t written = ::write(fd, buffer + done, used - done);
+                if ((written < 0) && (errno == EINTR)) {
+                    continue;
+                }
+#endif
+                if (written <= 0) {
+                    break;
+                }
+                done += static_cast<size_t>(written);
+            }
+            used = 0;
+        };
+
+        auto put = [&](const char* data, size_t size) {
+            while (size > 0U) {
+                if (used == CRASH_BUFFER_SIZE) {
+                    flush();
+                }
+                const size_t chunk = std::min(size, CRASH_BUFFER_SIZE - used);
+                std::memcpy(buffer + used, data, chunk);
+                used += chunk;
+                data += chunk;
+                size -= chunk;
+            }
+        };
+
+        asyncRing->peek([&](const Record& record) {
+            const bool bEmpty = (record.level == LOG_EMPTY);
+            if (!bEmpty && (record.level < (console ? consoleThreshold : fileThreshold))) {
+                return;
+            }
+            const bool bColor = console && useColors;
+            if (bColor) {
+                put(getColor(record.level), std::strlen(getColor(record.level)));
+            }
+            put(record.text.data(), record.text.size());
+            if (bEmpty) {
+                put("\n", 1U);
+            }
+            if (bColor) {
+                put(RESET_COLOR, std::strlen(RESET_COLOR));
+            }
+        });
+        flush();
+    }
+
+
+    /**
+     * @brief Opens the log file a second time, for the crash flush
+     *        (logMutex held).
+     */
+    void openCrashFile() noexcept
+    {
+        closeCrashFile();
+        if (!crashFlushEnabled.load() || !fileLoggingEnabled || !logFile.is_open() || logFileName.empty()) {
+            return;
+        }
+#if defined(_WIN32)
+        crashFileFd.store(_open(logFileName.c_str(), _O_WRONLY | _O_APPEND | _O_BINARY));
+#else
+        crashFileFd.store(::open(logFileName.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC));
+#endif
+    }
+
+
+    /**
+     * @brief Closes the descriptor of openCrashFile() (logMutex held).
+     */
+    void closeCrashFile() noexcept
+    {
+        if (const int fd = crashFileFd.exchange(-1); fd >= 0) {
+#if defined(_WIN32)
+            _close(fd);
+#else
+            ::close(fd);
+#endif
+        }
+    }
+
+
+    /**
+     * @brief Points the fatal signal handlers at the logger to flush
+     *        (nullptr: restore the previous handlers).
+     */
+    static void installCrashFlush(LogBuffer* pLogger) noexcept
+    {
+        static constexpr int kSignals[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#if defined(SIGBUS)
+                                            SIGBUS,
+#endif
+                                          };
+        using Handler = void (*)(int);
+        static Handler prevHandlers[std::size(kSignals)] {};
+        static std::atomic<LogBuffer*> pTarget {nullptr};
+
+        struct Local {
+            static void restore() noexcept
+            {
+                for (size_t i = 0; i < std::size(kSignals); ++i) {
+                    std::signal(kSignals[i], ((prevHandlers[i] != SIG_ERR) && (prevHandlers[i] != nullptr)) ? prevHandlers[i] : SIG_DFL);
+                }
+            }
+
+            static void onSignal(int sig)
+            {
+                // previous handlers first: a fault while flushing ends the process
+                LogBuffer* p = pTarget.exchange(nullptr);
+                restore();
+                if (nullptr != p) {
+                    p->crashFlush();
+                }
+                std::raise(sig);
+            }
+        };
+
+        LogBuffer* pPrevious = pTarget.exchange(pLogger);
+        if ((nullptr != pLogger) && (nullptr == pPrevious)) {
+            for (size_t i = 0; i < std::size(kSignals); ++i) {
+                prevHandlers[i] = std::signal(kSignals[i], &Local::onSignal);
+            }
+        } else if ((nullptr == pLogger) && (nullptr != pPrevious)) {
+            Local::restore();
+        }
+    }
+
+
+    /**
+     * @brief Switches to the binary mode: messages at or above threshold are
+     *        written to a memory mapped file as a call site id, a time stamp
+     *        and the raw arguments; nothing is formatted unless the console
+     *        or the log file takes the message too. The file is rendered to
+     *        text by the ulogdecode tool.
+     * @param filename The file, created or truncated.
+     * @param capacity Bytes of records the file holds; once full further
+     *                 messages are dropped and counted.
+     * @param threshold Lowest level written to the file.
+     * @return false if the file could not be created and mapped.
+     */
+    bool startBinary(const std::string& filename,
+                     size_t capacity = LOGGER_DEFAULT_BINARY_SIZE,
+                     LogLevel threshold = LOGGER_DEFAULT_BINARY_SEVERITY)
+    {
+        stopBinary();
+
+        std::lock_guard<std::mutex> lock(binaryControlMutex);
+        if (!binaryLog.open(filename, capacity)) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> siteLock(binaryMutex);
+            binarySession = (binarySession % 0xFFFFU) + 1U;
+            binaryNextSite = 1U;
+        }
+        binaryThreshold = threshold;
+        binaryActive.store(true);
+        updateEnabledLevel();
+        return true;
+    }
+
+
+    /**
+     * @brief Ends the binary mode: waits for the threads writing a record,
+     *        then completes and closes the file.
+     */
+    void stopBinary()
+    {
+        uint64_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(binaryControlMutex);
+            if (!binaryActive.exchange(false)) {
+                return;
+            }
+            updateEnabledLevel();
+            while (binaryWriters.load() != 0U) {
+                std::this_thread::yield();
+            }
+            dropped = binaryLog.dropped();
+            binaryLog.close();
+        }
+
+        if (dropped > 0U) {
+            setLevel(LOG_WARNING);
+            append("Binary log full, messages dropped:");
+            append(dropped);
+            print();
+        }
+    }
+
+
+    /**
+     * @brief Writes the staged message to the binary log.
+     */
+    void writeBinary(const Stage& st) noexcept
+    {
+        binaryWriters.fetch_add(1U);
+        if (binaryActive.load()) {
+            ThreadState& ts = threadState();
+            if (0U == ts.tid) {
+                ts.tid = ulogbin::currentThreadId();
+            }
+            const uint16_t site = (nullptr != st.site) ? binarySiteId(*st.site) : 0U;
+            binaryLog.write(ulogbin::RecordKind::MESSAGE, static_cast<uint8_t>(st.currentLevel), site, ts.tid,
+                            binaryLog.now(), st.buffer, st.size);
+        }
+        binaryWriters.fetch_sub(1U);
+    }
+
+
+    /**
+     * @brief Gets the id of a call site in the current binary log; the
+     *        first message of a site writes its location to the log.
+     * @return The id, 0 once the 16 bit ids are used up.
+     */
+    uint16_t binarySiteId(LogSite& site) noexcept
+    {
+        uint32_t key = site.key.load(std::memory_order_acquire);
+        if ((key >> 16U) == binarySession) {
+            return static_cast<uint16_t>(key & 0xFFFFU);
+        }
+
+        std::lock_guard<std::mutex> lock(binaryMutex);
+        key = site.key.load(std::memory_order_relaxed);
+        if ((key >> 16U) == binarySession) {
+            return static_cast<uint16_t>(key & 0xFFFFU);
+        }
+        uint16_t id = 0;
+        if (binaryNextSite <= 0xFFFFU) {
+            id = static_cast<uint16_t>(binaryNextSite++);
+            binaryLog.write(ulogbin::RecordKind::SITE, 0U, id, site.line, binaryLog.now(), site.file, std::strlen(site.file));
+        }
+        site.key.store((binarySession << 16U) | id, std::memory_order_release);
+        return id;
     }
 
 
     /**
      * @brief Sets the current log level.
      * @param level The log level to set.
+     * @param site The call site of the message (LOG_PRINT), if known.
      */
-    void setLevel(LogLevel level) noexcept
+    void setLevel(LogLevel level, LogSite* site = nullptr) noexcept
     {
-        currentLevel = level;
+        Stage& st = stage();
+        st.currentLevel = level;
+        st.site = site;
+        st.binary = binaryActive.load(std::memory_order_acquire) && (level >= binaryThreshold);
     }
 
 
@@ -505,6 +1724,7 @@ struct LogBuffer
     void setConsoleThreshold(LogLevel level) noexcept
     {
         consoleThreshold = level;
+        updateEnabledLevel();
     }
 
 
@@ -515,6 +1735,7 @@ struct LogBuffer
     void setFileThreshold(LogLevel level) noexcept
     {
         fileThreshold = level;
+        updateEnabledLevel();
     }
 
     /**
@@ -535,6 +1756,16 @@ struct LogBuffer
         includeDate = value;
     }
 
+    /**
+     * @brief Sets relative time stamps: seconds since the logger was
+     *        created, from the steady clock, instead of the time of day
+     * @param value The boolean value to set.
+     */
+    void setRelativeTime(bool value) noexcept
+    {
+        relativeTime = value;
+    }
+
 
     /**
      * @brief Enables file logging with optional custom filename.
@@ -569,6 +1800,9 @@ struct LogBuffer
 
         logFile.open(actualFilename, std::ios::out | std::ios::app);
         fileLoggingEnabled = logFile.is_open();
+        logFileName = fileLoggingEnabled ? actualFilename : std::string();
+        openCrashFile();
+        updateEnabledLevel();
         
         return fileLoggingEnabled;
     }
@@ -586,6 +1820,9 @@ struct LogBuffer
             logFile.close();
         }
         fileLoggingEnabled = false;
+        logFileName.clear();
+        closeCrashFile();
+        updateEnabledLevel();
     }
 
 
@@ -603,6 +1840,9 @@ struct LogBuffer
      */
     ~LogBuffer()
     {
+        stopBinary();
+        stopAsync();
+        disableCrashFlush();
         disableFileLogging();
     }
 };
@@ -667,16 +1907,30 @@ inline void log_separator(const char* color = "\033[95m") noexcept
 #define LOG_SEP()               log_separator()
 #define LOG_SEPARATOR(COLOR)    log_separator(COLOR)
 
+/**
+ * @brief Checks if a message of the given severity would be written; for
+ *        call sites preparing the arguments of LOG_PRINT beforehand.
+ */
+#define LOG_ENABLED(SEVERITY)   (isLogLevelCompiled(SEVERITY) && log_local->isEnabled(SEVERITY))
+
 /**
  * @brief Macro for printing a log message with a specified severity.
+ *        The arguments are evaluated only if the message is written: a
+ *        filtered message costs one threshold test, one below
+ *        ULOGGER_COMPILE_MIN_LEVEL is not compiled at all. The static
+ *        LogSite names the call site in the binary log.
  * @param SEVERITY The severity level of the log message.
  * @param ... The log message to print.
  */
 #define LOG_PRINT(SEVERITY, ...)  \
                     do { \
-                        log_local->setLevel(SEVERITY); \
-                        __VA_ARGS__ \
-                        log_local->print(); \
+                        const LogLevel ulogLevel_ = (SEVERITY); \
+                        if (isLogLevelCompiled(ulogLevel_) && log_local->isEnabled(ulogLevel_)) { \
+                            static constinit LogSite ulogSite_ {__FILE__, __LINE__}; \
+                            log_local->setLevel(ulogLevel_, &ulogSite_); \
+                            __VA_ARGS__ \
+                            log_local->print(); \
+                        } \
                     } while(0)
 
 
@@ -706,7 +1960,44 @@ inline void log_separator(const char* color = "\033[95m") noexcept
  * @brief Macro for deinitializing the logger.
  */
 #define LOG_DEINIT() \
-                    log_local->disableFileLogging()
+                    do { \
+                        log_local->stopBinary(); \
+                        log_local->stopAsync(); \
+                        log_local->disableCrashFlush(); \
+                        log_local->disableFileLogging(); \
+                    } while(0)
+
+
+/**
+ * @brief Macros for switching the asynchronous mode on and off.
+ * @param QUEUE Queue size (messages).
+ * @param OVERFLOW_POLICY LogOverflow applied when the queue is full.
+ * @param FLUSH_MS Longest time output stays unflushed, in milliseconds.
+ */
+#define LOG_ASYNC_START(QUEUE, OVERFLOW_POLICY, FLUSH_MS) \
+                    log_local->startAsync((QUEUE), (OVERFLOW_POLICY), std::chrono::milliseconds(FLUSH_MS))
+
+#define LOG_ASYNC_STOP() \
+                    log_local->stopAsync()
+
+/**
+ * @brief Macro for the opt-in output of the queued messages on the fatal signals.
+ */
+#define LOG_ASYNC_CRASH_FLUSH() \
+                    log_local->enableCrashFlush()
+
+
+/**
+ * @brief Macros for switching the binary mode on and off.
+ * @param FILENAME The binary log file.
+ * @param SIZE Bytes of records the file holds.
+ * @param SEVERITY Lowest level written to the file.
+ */
+#define LOG_BINARY_START(FILENAME, SIZE, SEVERITY) \
+                    log_local->startBinary((FILENAME), (SIZE), (SEVERITY))
+
+#define LOG_BINARY_STOP() \
+                    log_local->stopBinary()
 
 
 #endif // ULOGGER_H
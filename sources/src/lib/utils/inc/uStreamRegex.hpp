@@ -0,0 +1,806 @@
+#ifndef U_STREAM_REGEX_HPP
+#define U_STREAM_REGEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <regex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace uregex
+ * @brief Incremental (streaming) full match of ECMAScript patterns over received bytes
+ *
+ * Patterns within the supported subset are compiled to a byte level DFA:
+ *   literals, escapes (\t \n \r \f \v \0 \xHH \d \D \w \W \s \S and escaped punctuation), '.',
+ *   bracket classes with ranges and negation, groups ( ) and (?: ), alternation '|',
+ *   quantifiers * + ? {n} {n,} {n,m} (greedy or lazy), '^' as first and '$' as last character.
+ * Everything else (back references, assertions, word boundaries, non ASCII bytes, ...) is left
+ * to std::regex, see StreamMatcher.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+namespace uregex
+{
+
+/**
+ * @brief Result of the bytes fed so far
+ */
+enum class MatchState : uint8_t
+{
+    PARTIAL,   ///< No full match yet, more bytes may complete it
+    MATCH,     ///< The bytes received so far match the whole pattern
+    NO_MATCH   ///< No continuation of the bytes received so far can match
+};
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace internal
+ * @brief Pattern parser building a Thompson NFA
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+namespace internal
+{
+
+using ByteSet = std::bitset<256>;
+
+constexpr size_t MAX_NFA_NODES  = 16384;
+constexpr size_t MAX_DFA_STATES = 2048;
+constexpr int    MAX_REPEAT     = 1000;
+
+struct NfaNode
+{
+    ByteSet          set;       ///< Bytes of the edge to next
+    int              next = -1; ///< Target of the byte edge, -1 if none
+    std::vector<int> eps;       ///< Epsilon edges
+};
+
+struct Fragment
+{
+    int start;
+    int end;
+};
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Recursive descent parser of the supported subset; any construct outside it fails the parse
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+class Parser
+{
+    public:
+
+        explicit Parser(std::string_view pattern, std::vector<NfaNode>& nodes)
+            : m_pattern(pattern)
+            , m_end(pattern.size())
+            , m_nodes(nodes)
+        {}
+
+        bool parse(Fragment& frag)
+        {
+            /* anchors are implicit for a full match */
+            if ((m_pos < m_end) && (m_pattern[m_pos] == '^')) {
+                ++m_pos;
+            }
+            if ((m_end > m_pos) && (m_pattern[m_end - 1] == '$') && !isEscaped(m_end - 1)) {
+                --m_end;
+            }
+
+            return parseAlternation(frag) && (m_pos == m_end);
+        }
+
+    private:
+
+        std::string_view      m_pattern;
+        size_t                m_pos = 0;
+        size_t                m_end;
+        std::vector<NfaNode>& m_nodes;
+
+        bool isEscaped(size_t pos) const
+        {
+            size_t szSlashes = 0;
+            while ((pos > 0) && (m_pattern[--pos] == '\\')) {
+                ++szSlashes;
+            }
+            return (szSlashes % 2) != 0;
+        }
+
+        bool atEnd() const { return m_pos >= m_end; }
+        char peek() const { return m_pattern[m_pos]; }
+
+        int newNode()
+        {
+            m_nodes.emplace_back();
+            return static_cast<int>(m_nodes.size() - 1);
+        }
+
+        bool full() const { return m_nodes.size() > MAX_NFA_NODES; }
+
+        Fragment edge(const ByteSet& set)
+        {
+            const int s = newNode();
+            const int e = newNode();
+            m_nodes[s].set  = set;
+            m_nodes[s].next = e;
+            return {s, e};
+        }
+
+        Fragment empty()
+        {
+            const int s = newNode();
+            return {s, s};
+        }
+
+        Fragment concat(Fragment a, Fragment b)
+        {
+            m_nodes[a.end].eps.push_back(b.start);
+            return {a.start, b.end};
+        }
+
+        Fragment alternate(Fragment a, Fragment b)
+        {
+            const int s = newNode();
+            const int e = newNode();
+            m_nodes[s].eps = {a.start, b.start};
+            m_nodes[a.end].eps.push_back(e);
+            m_nodes[b.end].eps.push_back(e);
+            return {s, e};
+        }
+
+        Fragment optional(Fragment a)
+        {
+            const int s = newNode();
+            const int e = newNode();
+            m_nodes[s].eps = {a.start, e};
+            m_nodes[a.end].eps.push_back(e);
+            return {s, e};
+        }
+
+        Fragment star(Fragment a)
+        {
+            const int s = newNode();
+            const int e = newNode();
+            m_nodes[s].eps = {a.start, e};
+            m_nodes[a.end].eps.push_back(a.start);
+            m_nodes[a.end].eps.push_back(e);
+            return {s, e};
+        }
+
+        Fragment plus(Fragment a)
+        {
+            const int e = newNode();
+            m_nodes[a.end].eps.push_back(a.start);
+            m_nodes[a.end].eps.push_back(e);
+            return {a.start, e};
+        }
+
+        /* alternation := sequence ('|' sequence)* */
+        bool parseAlternation(Fragment& frag)
+        {
+            if (!parseSequence(frag)) {
+                return false;
+            }
+            while (!atEnd() && (peek() == '|')) {
+                ++m_pos;
+                Fragment next;
+                if (!parseSequence(next)) {
+                    return false;
+                }
+                frag = alternate(frag, next);
+            }
+            return !full();
+        }
+
+        /* sequence := quantified* */
+        bool parseSequence(Fragment& frag)
+        {
+            frag = empty();
+            while (!atEnd() && (peek() != '|') && (peek() != ')')) {
+                Fragment next;
+                if (!parseQuantified(next)) {
+                    return false;
+                }
+                frag = concat(frag, next);
+                if (full()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /* quantified := atom ('*' | '+' | '?' | '{n}' | '{n,}' | '{n,m}') '?'? */
+        bool parseQuantified(Fragment& frag)
+        {
+            const size_t szAtomBegin = m_pos;
+            if (!parseAtom(frag)) {
+                return false;
+            }
+            const size_t szAtomEnd = m_pos;
+
+            if (atEnd()) {
+                return true;
+            }
+
+            int iMin = 1;
+            int iMax = 1;
+            switch (peek()) {
+                case '*': iMin = 0; iMax = -1; ++m_pos; break;
+                case '+': iMin = 1; iMax = -1; ++m_pos; break;
+                case '?': iMin = 0; iMax = 1;  ++m_pos; break;
+                case '{':
+                    if (!parseBraces(iMin, iMax)) {
+                        return false;
+                    }
+                    break;
+                default:
+                    return true;
+            }
+
+            /* lazy and greedy quantifiers accept the same full matches */
+            if (!atEnd() && (peek() == '?')) {
+                ++m_pos;
+            }
+            if (!atEnd() && ((peek() == '*') || (peek() == '+') || (peek() == '{'))) {
+                return false;
+            }
+
+            const size_t szResume = m_pos;
+            bool bRetVal = repeat(szAtomBegin, szAtomEnd, iMin, iMax, frag);
+            m_pos = szResume;
+            return bRetVal;
+        }
+
+        bool parseNumber(int& iValue)
+        {
+            const size_t szBegin = m_pos;
+            iValue = 0;
+            while (!atEnd() && (peek() >= '0') && (peek() <= '9')) {
+                iValue = iValue * 10 + (peek() - '0');
+                if (iValue > MAX_REPEAT) {
+                    return false;
+                }
+                ++m_pos;
+            }
+            return m_pos != szBegin;
+        }
+
+        bool parseBraces(int& iMin, int& iMax)
+        {
+            ++m_pos; // '{'
+            if (!parseNumber(iMin)) {
+                return false;
+            }
+            iMax = iMin;
+            if (!atEnd() && (peek() == ',')) {
+                ++m_pos;
+                iMax = -1;
+                if (!atEnd() && (peek() != '}') && !parseNumber(iMax)) {
+                    return false;
+                }
+            }
+            if (atEnd() || (peek() != '}') || ((iMax >= 0) && (iMax < iMin))) {
+                return false;
+            }
+            ++m_pos;
+            return true;
+        }
+
+        /* copies of the quantified atom are built by parsing it again */
+        bool repeat(size_t szAtomBegin, size_t szAtomEnd, int iMin, int iMax, Fragment& frag)
+        {
+            Fragment first = frag;
+            bool bFirstUsed = false;
+
+            auto copy = [&](Fragment& out) -> bool {
+                if (!bFirstUsed) {
+                    bFirstUsed = true;
+                    out = first;
+                    return true;
+                }
+                m_pos = szAtomBegin;
+                return parseAtom(out) && (m_pos == szAtomEnd) && !full();
+            };
+
+            frag = empty();
+            Fragment part;
+
+            for (int i = 0; i < iMin; ++i) {
+                if (!copy(part)) {
+                    return false;
+                }
+                frag = concat(frag, part);
+            }
+
+            if (iMax < 0) {
+                if (!copy(part)) {
+                    return false;
+                }
+                frag = concat(frag, star(part));
+            } else {
+                for (int i = iMin; i < iMax; ++i) {
+                    if (!copy(part)) {
+                        return false;
+                    }
+                    frag = concat(frag, optional(part));
+                }
+            }
+
+            return !full();
+        }
+
+        /* atom := '(' ('?:')? alternation ')' | '[' class ']' | '.' | '\' escape | literal */
+        bool parseAtom(Fragment& frag)
+        {
+            const char ch = peek();
+            ByteSet set;
+
+            switch (ch) {
+                case '(':
+                    ++m_pos;
+                    if (!atEnd() && (peek() == '?')) {
+                        if ((m_pos + 1 >= m_end) || (m_pattern[m_pos + 1] != ':')) {
+                            return false; // assertions
+                        }
+                        m_pos += 2;
+                    }
+                    if (!parseAlternation(frag) || atEnd() || (peek() != ')')) {
+                        return false;
+                    }
+                    ++m_pos;
+                    return true;
+
+                case '[':
+                    ++m_pos;
+                    if (!parseClass(set)) {
+                        return false;
+                    }
+                    break;
+
+                case '.':
+                    ++m_pos;
+                    set.set();
+                    set.reset('\n');
+                    set.reset('\r');
+                    break;
+
+                case '\\':
+                    ++m_pos;
+                    if (atEnd() || !parseEscape(set, false)) {
+                        return false;
+                    }
+                    break;
+
+                case '^': case '$': case '*': case '+': case '?':
+                case '{': case '}': case ']': case ')': case '|':
+                    return false;
+
+                default:
+                    if (static_cast<unsigned char>(ch) >= 0x80) {
+                        return false;
+                    }
+                    ++m_pos;
+                    set.set(static_cast<unsigned char>(ch));
+                    break;
+            }
+
+            frag = edge(set);
+            return true;
+        }
+
+        static ByteSet rangeSet(unsigned char lo, unsigned char hi)
+        {
+            ByteSet set;
+            for (unsigned int c = lo; c <= hi; ++c) {
+                set.set(c);
+            }
+            return set;
+        }
+
+        static ByteSet wordSet()
+        {
+            ByteSet set = rangeSet('0', '9') | rangeSet('A', 'Z') | rangeSet('a', 'z');
+            set.set('_');
+            return set;
+        }
+
+        static ByteSet spaceSet()
+        {
+            ByteSet set;
+            for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+                set.set(static_cast<unsigned char>(c));
+            }
+            return set;
+        }
+
+        static int hexValue(char c)
+        {
+            if ((c >= '0') && (c <= '9')) return c - '0';
+            if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+            if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+            return -1;
+        }
+
+        /* escape after '\'; bSingle only accepts escapes standing for one byte (range ends) */
+        bool parseEscape(ByteSet& set, bool bSingle)
+        {
+            const char ch = peek();
+            ++m_pos;
+
+            switch (ch) {
+                case 'd': set = rangeSet('0', '9');  return !bSingle;
+                case 'D': set = ~rangeSet('0', '9'); return !bSingle;
+                case 'w': set = wordSet();           return !bSingle;
+                case 'W': set = ~wordSet();          return !bSingle;
+                case 's': set = spaceSet();          return !bSingle;
+                case 'S': set = ~spaceSet();         return !bSingle;
+                case 't': set.set('\t'); return true;
+                case 'n': set.set('\n'); return true;
+                case 'r': set.set('\r'); return true;
+                case 'f': set.set('\f'); return true;
+                case 'v': set.set('\v'); return true;
+                case '0':
+                    if (!atEnd() && (peek() >= '0') && (peek() <= '9')) {
+                        return false;
+                    }
+                    set.set(0);
+                    return true;
+                case 'x': {
+                    if (m_pos + 2 > m_end) {
+                        return false;
+                    }
+                    const int hi = hexValue(m_pattern[m_pos]);
+                    const int lo = hexValue(m_pattern[m_pos + 1]);
+                    if ((hi < 0) || (lo < 0) || (hi >= 8)) {
+                        return false;
+                    }
+                    m_pos += 2;
+                    set.set(static_cast<size_t>((hi << 4) | lo));
+                    return true;
+                }
+                default:
+                    /* escaped punctuation stands for itself, letters and digits have meanings not supported here */
+                    if ((static_cast<unsigned char>(ch) >= 0x80) || std::isalnum(static_cast<unsigned char>(ch))) {
+                        return false;
+                    }
+                    set.set(static_cast<unsigned char>(ch));
+                    return true;
+            }
+        }
+
+        /* one class member that can be a range end: a byte or a single byte escape */
+        bool parseClassByte(unsigned char& uByte, bool& bIsSet, ByteSet& set)
+        {
+            const char ch = peek();
+            bIsSet = false;
+
+            if (ch == '\\') {
+                ++m_pos;
+                if (atEnd() || (peek() == 'b')) {
+                    return false;
+                }
+                if (!parseEscape(set, false)) {
+                    return false;
+                }
+                bIsSet = (set.count() != 1);
+                if (!bIsSet) {
+                    for (size_t c = 0; c < 256; ++c) {
+                        if (set.test(c)) {
+                            uByte = static_cast<unsigned char>(c);
+                        }
+                    }
+                }
+                return true;
+            }
+
+            if ((ch == '[') || (static_cast<unsigned char>(ch) >= 0x80)) {
+                return false; // POSIX classes, collating elements
+            }
+            ++m_pos;
+            uByte = static_cast<unsigned char>(ch);
+            return true;
+        }
+
+        /* class := '^'? member+ ']' with member := byte ('-' byte)? | class escape */
+        bool parseClass(ByteSet& set)
+        {
+            bool bNegate = false;
+            if (!atEnd() && (peek() == '^')) {
+                bNegate = true;
+                ++m_pos;
+            }
+            if (atEnd() || (peek() == ']')) {
+                return false; // [] and [^] are not portable
+            }
+
+            while (!atEnd() && (peek() != ']')) {
+                unsigned char uLow = 0;
+                bool bIsSet = false;
+                ByteSet member;
+
+                if (!parseClassByte(uLow, bIsSet, member)) {
+                    return false;
+                }
+                if (bIsSet) {
+                    set |= member;
+                    if (!atEnd() && (peek() == '-') && (m_pos + 1 < m_end) && (m_pattern[m_pos + 1] != ']')) {
+                        return false; // range from a class escape
+                    }
+                    continue;
+                }
+
+                if (!atEnd() && (peek() == '-') && (m_pos + 1 < m_end) && (m_pattern[m_pos + 1] != ']')) {
+                    ++m_pos;
+                    unsigned char uHigh = 0;
+                    ByteSet high;
+                    if (!parseClassByte(uHigh, bIsSet, high) || bIsSet || (uHigh < uLow)) {
+                        return false;
+                    }
+                    set |= rangeSet(uLow, uHigh);
+                } else {
+                    set.set(uLow);
+                }
+            }
+
+            if (atEnd()) {
+                return false;
+            }
+            ++m_pos; // ']'
+
+            if (bNegate) {
+                set.flip();
+            }
+            return true;
+        }
+
+}; /* class Parser */
+
+} /* namespace internal */
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Deterministic automaton of a pattern over bytes, state 0 is the dead state
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+class ByteDfa
+{
+    public:
+
+        static constexpr uint32_t DEAD = 0;
+
+        /**
+         * @brief Compile a pattern of the supported subset
+         * @param pattern ECMAScript pattern
+         * @return the automaton, std::nullopt if the pattern is outside the subset or too large
+         */
+        static std::optional<ByteDfa> compile(std::string_view pattern)
+        {
+            std::vector<internal::NfaNode> vNodes;
+            vNodes.reserve(64);
+            internal::Fragment frag {};
+
+            internal::Parser parser(pattern, vNodes);
+            if (!parser.parse(frag)) {
+                return std::nullopt;
+            }
+
+            ByteDfa dfa;
+            dfa.buildClasses(vNodes);
+            if (!dfa.buildStates(vNodes, frag)) {
+                return std::nullopt;
+            }
+            return dfa;
+        }
+
+        uint32_t start() const noexcept { return m_uStart; }
+
+        uint32_t step(uint32_t uState, uint8_t uByte) const noexcept
+        {
+            return m_vTransitions[uState * m_szClasses + m_aClassOf[uByte]];
+        }
+
+        bool isAccepting(uint32_t uState) const noexcept { return 0 != m_vAccepting[uState]; }
+
+        size_t stateCount() const noexcept { return m_vAccepting.size(); }
+
+        /**
+         * @brief True if some byte leads uState to a live state, i.e. a match could still grow
+         */
+        bool canExtend(uint32_t uState) const noexcept
+        {
+            const uint32_t *pRow = m_vTransitions.data() + uState * m_szClasses;
+            return std::any_of(pRow, pRow + m_szClasses, [](uint32_t uNext) { return DEAD != uNext; });
+        }
+
+        /**
+         * @brief Advance uState over data, stops early in the dead state
+         */
+        MatchState run(uint32_t& uState, std::span<const uint8_t> data) const noexcept
+        {
+            for (uint8_t uByte : data) {
+                uState = step(uState, uByte);
+                if (DEAD == uState) {
+                    return MatchState::NO_MATCH;
+                }
+            }
+            return isAccepting(uState) ? MatchState::MATCH : MatchState::PARTIAL;
+        }
+
+    private:
+
+        std::array<uint8_t, 256> m_aClassOf {};
+        size_t                   m_szClasses = 1;
+        std::vector<uint32_t>    m_vTransitions;
+        std::vector<uint8_t>     m_vAccepting;
+        uint32_t                 m_uStart = DEAD;
+
+        /* partitions the bytes into classes no edge of the NFA distinguishes */
+        void buildClasses(const std::vector<internal::NfaNode>& vNodes)
+        {
+            m_aClassOf.fill(0);
+            m_szClasses = 1;
+
+            for (const auto& node : vNodes) {
+                if (node.next < 0) {
+                    continue;
+                }
+                std::map<std::pair<uint8_t, bool>, uint8_t> mSplit;
+                std::array<uint8_t, 256> aNext {};
+                for (size_t c = 0; c < 256; ++c) {
+                    auto key = std::make_pair(m_aClassOf[c], node.set.test(c));
+                    auto it = mSplit.try_emplace(key, static_cast<uint8_t>(mSplit.size())).first;
+                    aNext[c] = it->second;
+                }
+                m_aClassOf = aNext;
+                m_szClasses = mSplit.size();
+            }
+        }
+
+        /* epsilon closure, keeping only the nodes with a byte edge and the accepting node */
+        static std::vector<int> closure(const std::vector<internal::NfaNode>& vNodes, std::vector<int> vStack, int iAccept)
+        {
+            std::vector<bool> vSeen(vNodes.size(), false);
+            std::vector<int> vResult;
+
+            while (!vStack.empty()) {
+                const int n = vStack.back();
+                vStack.pop_back();
+                if (vSeen[n]) {
+                    continue;
+                }
+                vSeen[n] = true;
+                if ((vNodes[n].next >= 0) || (n == iAccept)) {
+                    vResult.push_back(n);
+                }
+                for (int e : vNodes[n].eps) {
+                    vStack.push_back(e);
+                }
+            }
+
+            std::sort(vResult.begin(), vResult.end());
+            return vResult;
+        }
+
+        /* subset construction */
+        bool buildStates(const std::vector<internal::NfaNode>& vNodes, internal::Fragment frag)
+        {
+            std::array<uint8_t, 256> aRepresentative {};
+            for (size_t c = 256; c-- > 0; ) {
+                aRepresentative[m_aClassOf[c]] = static_cast<uint8_t>(c);
+            }
+
+            std::vector<std::vector<int>> vStates {{}};
+            std::map<std::vector<int>, uint32_t> mIndex {{{}, DEAD}};
+
+            auto lookup = [&](std::vector<int>&& vSet, uint32_t& uState) -> bool {
+                auto it = mIndex.find(vSet);
+                if (it != mIndex.end()) {
+                    uState = it->second;
+                    return true;
+                }
+                if (vStates.size() >= internal::MAX_DFA_STATES) {
+                    return false;
+                }
+                uState = static_cast<uint32_t>(vStates.size());
+                mIndex.emplace(vSet, uState);
+                vStates.push_back(std::move(vSet));
+                return true;
+            };
+
+            if (!lookup(closure(vNodes, {frag.start}, frag.end), m_uStart)) {
+                return false;
+            }
+
+            for (size_t s = 0; s < vStates.size(); ++s) {
+                m_vTransitions.resize((s + 1) * m_szClasses, DEAD);
+                for (size_t c = 0; c < m_szClasses; ++c) {
+                    const uint8_t uByte = aRepresentative[c];
+                    std::vector<int> vMove;
+                    for (int n : vStates[s]) {
+                        if ((vNodes[n].next >= 0) && vNodes[n].set.test(uByte)) {
+                            vMove.push_back(vNodes[n].next);
+                        }
+                    }
+                    uint32_t uTarget = DEAD;
+                    if (!vMove.empty() && !lookup(closure(vNodes, std::move(vMove), frag.end), uTarget)) {
+                        return false;
+                    }
+                    m_vTransitions[s * m_szClasses + c] = uTarget;
+                }
+            }
+
+            m_vAccepting.resize(vStates.size(), 0);
+            for (size_t s = 0; s < vStates.size(); ++s) {
+                m_vAccepting[s] = std::binary_search(vStates[s].begin(), vStates[s].end(), frag.end) ? 1 : 0;
+            }
+            return true;
+        }
+
+}; /* class ByteDfa */
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Full match of a pattern against bytes fed as they are received
+ *
+ * Runs the DFA when the pattern has one; otherwise the received bytes are accumulated and
+ * std::regex_match is applied after every feed (a mismatch is then never detected early).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+class StreamMatcher
+{
+    public:
+
+        StreamMatcher(const ByteDfa *pDfa, const std::regex *pRegex)
+            : m_pDfa(pDfa)
+            , m_pRegex(pRegex)
+            , m_uState(pDfa ? pDfa->start() : ByteDfa::DEAD)
+        {}
+
+        /**
+         * @brief Feed the next received bytes
+         * @return the state of all the bytes fed so far
+         */
+        MatchState feed(std::span<const uint8_t> data)
+        {
+            if (nullptr != m_pDfa) {
+                return (ByteDfa::DEAD == m_uState) ? MatchState::NO_MATCH : m_pDfa->run(m_uState, data);
+            }
+            if (nullptr == m_pRegex) {
+                return MatchState::NO_MATCH;
+            }
+            m_strReceived.append(data.begin(), data.end());
+            return std::regex_match(m_strReceived, *m_pRegex) ? MatchState::MATCH : MatchState::PARTIAL;
+        }
+
+        /**
+         * @brief True if more bytes may still match (always the case for std::regex patterns)
+         */
+        bool canExtend() const noexcept
+        {
+            return (nullptr == m_pDfa) || ((ByteDfa::DEAD != m_uState) && m_pDfa->canExtend(m_uState));
+        }
+
+        bool isStreaming() const noexcept { return nullptr != m_pDfa; }
+
+    private:
+
+        const ByteDfa     *m_pDfa;
+        const std::regex  *m_pRegex;
+        uint32_t           m_uState;
+        std::string        m_strReceived;
+
+}; /* class StreamMatcher */
+
+} /* namespace uregex */
+
+#endif // U_STREAM_REGEX_HPP
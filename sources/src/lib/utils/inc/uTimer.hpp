@@ -3,11 +3,21 @@
 
 #include "uLogger.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <string>
 #include <thread>
 #include <vector>
 #include <optional>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__linux__)
+    #include <cerrno>
+    #include <time.h>
+#endif
 
 /////////////////////////////////////////////////////////////////////////////////
 //                            LOCAL DEFINITIONS                                //
@@ -294,6 +304,111 @@ inline void delay_seconds(size_t seconds)
     }
 }
 
+// Monotonic time in nanoseconds: the clock of the absolute-deadline sleeps
+inline int64_t monotonic_ns()
+{
+#if defined(__linux__)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Sleep until an absolute monotonic deadline.  The kernel sleep (Linux:
+// clock_nanosleep with TIMER_ABSTIME, so no error accumulates across calls)
+// ends spin_ns early and the rest is busy-waited, which trades CPU time for
+// accuracy below the scheduler wake-up latency.
+// Returns how late the call returned (ns, >= 0).
+inline int64_t sleep_until_ns(int64_t deadline_ns, int64_t spin_ns = 0)
+{
+    const int64_t wake_ns = deadline_ns - spin_ns;
+
+    if (monotonic_ns() < wake_ns) {
+#if defined(__linux__)
+        struct timespec ts;
+        ts.tv_sec  = static_cast<time_t>(wake_ns / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(wake_ns % 1000000000LL);
+        while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr)) {
+        }
+#else
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(wake_ns)));
+#endif
+    }
+
+    int64_t now_ns = monotonic_ns();
+    while (now_ns < deadline_ns) {
+        now_ns = monotonic_ns();
+    }
+
+    return now_ns - deadline_ns;
+}
+
+// Lateness statistics of a series of deadline waits (ns)
+class JitterStats
+{
+public:
+    void add(int64_t late_ns)
+    {
+        min_ns_ = (count_ == 0) ? late_ns : std::min(min_ns_, late_ns);
+        max_ns_ = (count_ == 0) ? late_ns : std::max(max_ns_, late_ns);
+        sum_ += static_cast<double>(late_ns);
+        sum_sq_ += static_cast<double>(late_ns) * static_cast<double>(late_ns);
+        ++count_;
+    }
+
+    void merge(const JitterStats& other)
+    {
+        if (other.count_ == 0) {
+            return;
+        }
+        min_ns_ = (count_ == 0) ? other.min_ns_ : std::min(min_ns_, other.min_ns_);
+        max_ns_ = (count_ == 0) ? other.max_ns_ : std::max(max_ns_, other.max_ns_);
+        sum_ += other.sum_;
+        sum_sq_ += other.sum_sq_;
+        count_ += other.count_;
+    }
+
+    size_t count() const { return count_; }
+    int64_t min_ns() const { return min_ns_; }
+    int64_t max_ns() const { return max_ns_; }
+
+    double mean_ns() const
+    {
+        return (count_ == 0) ? 0.0 : sum_ / static_cast<double>(count_);
+    }
+
+    double stddev_ns() const
+    {
+        if (count_ < 2) {
+            return 0.0;
+        }
+        const double mean = mean_ns();
+        const double var = sum_sq_ / static_cast<double>(count_) - mean * mean;
+        return (var > 0.0) ? std::sqrt(var) : 0.0;
+    }
+
+    // "n: N late us min/avg/max/stddev: a / b / c / d"
+    std::string to_string() const
+    {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1)
+            << "n: " << count_ << " late us min/avg/max/stddev: "
+            << static_cast<double>(min_ns_) / 1000.0 << " / " << mean_ns() / 1000.0 << " / "
+            << static_cast<double>(max_ns_) / 1000.0 << " / " << stddev_ns() / 1000.0;
+        return oss.str();
+    }
+
+private:
+    size_t count_ = 0;
+    int64_t min_ns_ = 0;
+    int64_t max_ns_ = 0;
+    double sum_ = 0.0;
+    double sum_sq_ = 0.0;
+};
+
 // Get current timestamp as string
 inline std::string current_timestamp()
 {
@@ -0,0 +1,317 @@
+#ifndef UTRACE_HPP
+#define UTRACE_HPP
+
+#include "uTimer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                         EXECUTION TIMELINE TRACING                          //
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace utrace
+{
+
+/**
+ * @brief Kind of a traced span, shown as the event category in the viewer.
+ */
+enum class Category : uint8_t {
+    NODE,       /**< one executed script line */
+    DISPATCH,   /**< plugin command dispatch */
+    READ,       /**< driver tout_read */
+    WRITE,      /**< driver tout_write */
+    DELAY,      /**< DELAY / PERIOD / DELAY_UNTIL and inter-command waits */
+    CACHE,      /**< lookup of a validated script in a cache */
+    COUNT
+};
+
+inline const char* category_name(Category eCat) noexcept
+{
+    static constexpr const char *kNames[] = { "node", "dispatch", "read", "write", "delay", "cache" };
+    static_assert(std::size(kNames) == static_cast<size_t>(Category::COUNT));
+    return (eCat < Category::COUNT) ? kNames[static_cast<size_t>(eCat)] : "other";
+}
+
+/**
+ * @brief One completed span.  The name is copied (truncated), so events never
+ *        refer to memory of a script, a plugin or a driver.
+ */
+struct Event {
+    int64_t  iStartNs;
+    int64_t  iDurNs;
+    Category eCat;
+    char     szName[47];
+};
+static_assert(sizeof(Event) == 64, "one event per cache line");
+
+/**
+ * @brief Events of one thread.  Only the owning thread writes; once full the
+ *        oldest events are overwritten.
+ */
+struct ThreadRing {
+    explicit ThreadRing(size_t szCapacity, uint32_t uId)
+        : vEvents(szCapacity), uTid(uId), threadId(std::this_thread::get_id())
+    {}
+
+    std::vector<Event>    vEvents;          /**< capacity is a power of two */
+    std::atomic<uint64_t> uHead{0U};        /**< number of events ever written */
+    uint32_t              uTid;
+    std::thread::id       threadId;
+    std::string           strName;
+};
+
+class TraceSession;
+
+/**
+ * @brief Session of the process (and of the plugins it was handed to, see
+ *        PluginDataSet::shpTracer); nullptr while tracing is not configured.
+ */
+inline std::shared_ptr<TraceSession> trace_local;
+
+[[nodiscard]] inline std::shared_ptr<TraceSession> getTracer() noexcept
+{
+    return trace_local;
+}
+
+inline void setTracer(std::shared_ptr<TraceSession> tracer) noexcept
+{
+    if (tracer) {
+        trace_local = std::move(tracer);
+    }
+}
+
+/**
+ * @brief Collects spans into lock-free per-thread rings while active and
+ *        writes them in the Chrome trace event format (chrome://tracing,
+ *        https://ui.perfetto.dev).
+ *
+ * A thread registers itself (under a mutex) with its first event; after
+ * that recording an event is a few stores into its own ring.  The ring is
+ * found by thread id, so the code of the executable and of the plugin
+ * libraries (each with its own thread_local cache) share the ring of a thread.  write() is
+ * meant to run once the traced threads are idle: a thread still recording
+ * may overwrite an event while it is being copied.
+ */
+class TraceSession
+{
+public:
+
+    explicit TraceSession(size_t szEventsPerThread = (1U << 16))
+        : m_szCapacity(round_up_pow2(szEventsPerThread))
+        , m_iSerial(utime::monotonic_ns())
+        , m_iOriginNs(m_iSerial)
+    {}
+
+    TraceSession(const TraceSession&) = delete;
+    TraceSession& operator=(const TraceSession&) = delete;
+
+    void start() noexcept
+    {
+        m_iOriginNs = utime::monotonic_ns();
+        m_bActive.store(true, std::memory_order_release);
+    }
+
+    void stop() noexcept { m_bActive.store(false, std::memory_order_release); }
+
+    bool active() const noexcept { return m_bActive.load(std::memory_order_relaxed); }
+
+    void record(Category eCat, std::string_view svName, int64_t iStartNs, int64_t iEndNs) noexcept
+    {
+        ThreadRing *pRing = ring();
+        if (nullptr == pRing) {
+            return;
+        }
+        const uint64_t uHead = pRing->uHead.load(std::memory_order_relaxed);
+        Event& sEvent = pRing->vEvents[uHead & (m_szCapacity - 1U)];
+        const size_t szLen = std::min(svName.size(), sizeof(sEvent.szName) - 1U);
+        sEvent.iStartNs = iStartNs;
+        sEvent.iDurNs   = iEndNs - iStartNs;
+        sEvent.eCat     = eCat;
+        std::memcpy(sEvent.szName, svName.data(), szLen);
+        sEvent.szName[szLen] = '\0';
+        pRing->uHead.store(uHead + 1U, std::memory_order_release);
+    }
+
+    /**
+     * @brief Name shown for the calling thread in the viewer.
+     */
+    void name_thread(std::string_view svName)
+    {
+        if (ThreadRing *pRing = ring()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            pRing->strName = svName;
+        }
+    }
+
+    /**
+     * @brief Write every event still held by the rings; returns false if the
+     *        file could not be written.  szDropped counts the overwritten events.
+     */
+    bool write(const std::string& strPath, size_t& szEvents, size_t& szDropped) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::ofstream ofs(strPath);
+        char szBuf[160];
+        bool bFirst = true;
+
+        szEvents  = 0U;
+        szDropped = 0U;
+        ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        for (const auto& upRing : m_vRings) {
+            const std::string strThread = upRing->strName.empty()
+                                            ? ("thread " + std::to_string(upRing->uTid)) : upRing->strName;
+            std::snprintf(szBuf, sizeof(szBuf),
+                          "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                          static_cast<unsigned>(upRing->uTid));
+            ofs << (bFirst ? "\n" : ",\n") << szBuf << escape(strThread) << "\"}}";
+            bFirst = false;
+
+            const uint64_t uHead  = upRing->uHead.load(std::memory_order_acquire);
+            const uint64_t uFirst = (uHead > m_szCapacity) ? (uHead - m_szCapacity) : 0U;
+            szDropped += static_cast<size_t>(uFirst);
+
+            for (uint64_t u = uFirst; u < uHead; ++u) {
+                const Event& sEvent = upRing->vEvents[u & (m_szCapacity - 1U)];
+                std::snprintf(szBuf, sizeof(szBuf),
+                              "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"cat\":\"%s\",\"name\":\"",
+                              static_cast<unsigned>(upRing->uTid),
+                              static_cast<double>(sEvent.iStartNs - m_iOriginNs) / 1000.0,
+                              static_cast<double>(sEvent.iDurNs) / 1000.0,
+                              category_name(sEvent.eCat));
+                ofs << ",\n" << szBuf << escape(sEvent.szName) << "\"}";
+                ++szEvents;
+            }
+        }
+
+        ofs << "\n]}\n";
+        return ofs.good();
+    }
+
+private:
+
+    /**
+     * @brief Ring of the calling thread, registered on first use; nullptr
+     *        while inactive or when the ring cannot be allocated.
+     */
+    ThreadRing* ring() noexcept
+    {
+        struct Cache {
+            const TraceSession *pSession = nullptr;
+            int64_t             iSerial  = 0;
+            ThreadRing         *pRing    = nullptr;
+        };
+        thread_local Cache tlCache;
+
+        if (!active()) {
+            return nullptr;
+        }
+        if ((tlCache.pSession == this) && (tlCache.iSerial == m_iSerial)) {
+            return tlCache.pRing;
+        }
+
+        try {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const auto it = std::find_if(m_vRings.begin(), m_vRings.end(), [](const auto& upRing) {
+                return upRing->threadId == std::this_thread::get_id();
+            });
+            if (it != m_vRings.end()) {
+                tlCache = Cache{this, m_iSerial, it->get()};
+            } else {
+                m_vRings.push_back(std::make_unique<ThreadRing>(m_szCapacity, static_cast<uint32_t>(m_vRings.size() + 1U)));
+                tlCache = Cache{this, m_iSerial, m_vRings.back().get()};
+            }
+        } catch (...) {
+            return nullptr;
+        }
+        return tlCache.pRing;
+    }
+
+    static size_t round_up_pow2(size_t szValue) noexcept
+    {
+        size_t szPow2 = 1U;
+        while (szPow2 < szValue) {
+            szPow2 <<= 1U;
+        }
+        return szPow2;
+    }
+
+    static std::string escape(std::string_view svIn)
+    {
+        std::string strOut;
+        strOut.reserve(svIn.size());
+        for (const char c : svIn) {
+            if ((c == '"') || (c == '\\')) {
+                strOut += '\\';
+                strOut += c;
+            } else if (static_cast<unsigned char>(c) < 0x20U) {
+                strOut += ' ';
+            } else {
+                strOut += c;
+            }
+        }
+        return strOut;
+    }
+
+    const size_t                              m_szCapacity;
+    const int64_t                             m_iSerial;    /**< tells sessions apart in the thread caches */
+    int64_t                                   m_iOriginNs;  /**< ts 0 of the trace */
+    std::atomic<bool>                         m_bActive{false};
+    mutable std::mutex                        m_mutex;
+    std::vector<std::unique_ptr<ThreadRing>>  m_vRings;
+};
+
+/**
+ * @brief Records its own lifetime as one span of the process session.
+ *        Costs a pointer and a flag test while tracing is off.
+ */
+class Scope
+{
+public:
+
+    Scope(Category eCat, std::string_view svName) noexcept
+        : m_pSession((trace_local && trace_local->active()) ? trace_local.get() : nullptr)
+        , m_eCat(eCat)
+        , m_svName(svName)
+        , m_iStartNs(m_pSession ? utime::monotonic_ns() : 0)
+    {}
+
+    ~Scope()
+    {
+        if (m_pSession) {
+            m_pSession->record(m_eCat, m_svName, m_iStartNs, utime::monotonic_ns());
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+
+    TraceSession     *m_pSession;
+    Category          m_eCat;
+    std::string_view  m_svName;
+    int64_t           m_iStartNs;
+};
+
+} // namespace utrace
+
+#define UTRACE_CONCAT_(a, b)    a##b
+#define UTRACE_CONCAT(a, b)     UTRACE_CONCAT_(a, b)
+
+/** @brief Trace the enclosing block: UTRACE_SCOPE(utrace::Category::READ, "UART read"); */
+#define UTRACE_SCOPE(CAT, NAME) utrace::Scope UTRACE_CONCAT(utrace_scope_, __LINE__)((CAT), (NAME))
+
+#endif // UTRACE_HPP
@@ -8,6 +8,8 @@
 #include <vector>
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdlib>
 #include <stdexcept>
 #include <unordered_map>
 
@@ -82,16 +84,138 @@ public:
         // Compare each element
         for (size_t i = 0; i < v1.size(); ++i) {
             if (!compare(v1[i], v2[i], op, type)) {
-                LOG_PRINT(LOG_WARNING, LOG_HDR; 
-                         LOG_STRING("Validation failed at index "); LOG_SIZET(i); 
-                         LOG_STRING(": '"); LOG_STRING(v1[i]); 
-                         LOG_STRING("' vs '"); LOG_STRING(v2[i]); LOG_STRING("'"));
+                logMismatch(i, v1[i], v2[i]);
                 return false;
             }
         }
         return true;
     }
 
+    // ── Scalar building blocks ────────────────────────────────────────────
+    // Used by callers that resolve the rule and pre-parse constant operands
+    // once (compiled EVAL expressions).  The tryParse* functions accept
+    // exactly the values the corresponding parsers below accept without
+    // throwing or warning; for anything else they return false and the
+    // caller falls back to validate() to get the same result and log lines.
+
+    struct VersionParts {
+        static constexpr size_t kMaxParts = 8U;
+        int    aPart[kMaxParts] = {};
+        size_t szCount = 0U;
+    };
+
+    static ComparisonOp parseRule(const std::string& rule, eValidateType type)
+    {
+        std::string_view sv(rule);
+        while (!sv.empty() && (sv.front() == ' ' || sv.front() == '\t')) {
+            sv.remove_prefix(1);
+        }
+
+        while (!sv.empty() && (sv.back()  == ' ' || sv.back()  == '\t')) {
+            sv.remove_suffix(1);
+        }
+
+        // Build a temporary std::string only when the map lookup actually needs it.
+        const std::string trimmed(sv);
+
+        if (type == eValidateType::STRING) {
+            auto it = stringRules().find(trimmed);
+            return (it != stringRules().end()) ? it->second : ComparisonOp::UNKNOWN;
+        } else {
+            auto it = numericRules().find(trimmed);
+            return (it != numericRules().end()) ? it->second : ComparisonOp::UNKNOWN;
+        }
+    }
+
+    static bool tryParseDouble(const std::string& s, double& value) noexcept
+    {
+        if (s.empty()) return false;
+
+        const char* begin = s.c_str();
+        char* end = nullptr;
+        errno = 0;
+        value = std::strtod(begin, &end);
+        if (end == begin || errno == ERANGE) return false;
+
+        while (*end != '\0' && std::isspace(static_cast<unsigned char>(*end))) ++end;
+        return end == begin + s.size();
+    }
+
+    static bool tryParseVersion(const std::string& v, VersionParts& parts) noexcept
+    {
+        parts.szCount = 0U;
+        if (v.empty()) {
+            parts.aPart[parts.szCount++] = 0;
+            return true;
+        }
+
+        const char* p   = v.data();
+        const char* end = p + v.size();
+
+        while (p <= end) {
+            const char* dot = p;
+            while (dot < end && *dot != '.') ++dot;
+
+            if (parts.szCount == VersionParts::kMaxParts) return false;
+            if ((dot - p) > 9) return false;     // may not fit an int
+
+            int iValue = 0;
+            for (const char* c = p; c < dot; ++c) {
+                if (!std::isdigit(static_cast<unsigned char>(*c))) return false;
+                iValue = (iValue * 10) + (*c - '0');
+            }
+            parts.aPart[parts.szCount++] = iValue;
+            p = dot + 1;
+        }
+
+        return true;
+    }
+
+    static bool tryParseBool(const std::string& val, bool& value) noexcept
+    {
+        if (iequal(val,"true",4)  || iequal(val,"1",1) ||
+            iequal(val,"yes",3)   || iequal(val,"on",2)  || iequal(val,"!false",6)) { value = true;  return true; }
+        if (iequal(val,"false",5) || iequal(val,"0",1) ||
+            iequal(val,"no",2)    || iequal(val,"off",3) || iequal(val,"!true",5))  { value = false; return true; }
+        return false;
+    }
+
+    // Three-way comparison of two parsed versions (missing parts are 0).
+    static int compareVersionParts(const VersionParts& a, const VersionParts& b) noexcept
+    {
+        const size_t maxSize = std::max(a.szCount, b.szCount);
+        for (size_t i = 0; i < maxSize; ++i) {
+            const int va = (i < a.szCount) ? a.aPart[i] : 0;
+            const int vb = (i < b.szCount) ? b.aPart[i] : 0;
+            if (va < vb) return -1;
+            if (va > vb) return 1;
+        }
+        return 0;
+    }
+
+    // Generic comparison application
+    template<typename T>
+    static bool applyComparison(T a, T b, ComparisonOp op)
+    {
+        switch (op) {
+            case ComparisonOp::EQ: return a == b;
+            case ComparisonOp::NE: return a != b;
+            case ComparisonOp::LT: return a <  b;
+            case ComparisonOp::LE: return a <= b;
+            case ComparisonOp::GT: return a >  b;
+            case ComparisonOp::GE: return a >= b;
+            default:               return false;
+        }
+    }
+
+    static void logMismatch(size_t i, const std::string& a, const std::string& b)
+    {
+        LOG_PRINT(LOG_WARNING, LOG_HDR; 
+                 LOG_STRING("Validation failed at index "); LOG_SIZET(i); 
+                 LOG_STRING(": '"); LOG_STRING(a); 
+                 LOG_STRING("' vs '"); LOG_STRING(b); LOG_STRING("'"));
+    }
+
 private:
 
     // ── O1: Rule maps are process-wide singletons ─────────────────────────
@@ -118,29 +242,6 @@ private:
         return m;
     }
 
-    ComparisonOp parseRule(const std::string& rule, eValidateType type) const
-    {
-        std::string_view sv(rule);
-        while (!sv.empty() && (sv.front() == ' ' || sv.front() == '\t')) {
-            sv.remove_prefix(1);
-        }
-
-        while (!sv.empty() && (sv.back()  == ' ' || sv.back()  == '\t')) {
-            sv.remove_suffix(1);
-        }
-
-        // Build a temporary std::string only when the map lookup actually needs it.
-        const std::string trimmed(sv);
-
-        if (type == eValidateType::STRING) {
-            auto it = stringRules().find(trimmed);
-            return (it != stringRules().end()) ? it->second : ComparisonOp::UNKNOWN;
-        } else {
-            auto it = numericRules().find(trimmed);
-            return (it != numericRules().end()) ? it->second : ComparisonOp::UNKNOWN;
-        }
-    }
-
     bool compare(const std::string& a, const std::string& b, 
                  ComparisonOp op, eValidateType type) const
     {
@@ -248,21 +349,6 @@ private:
         return (op == ComparisonOp::EQ) ? (ba == bb) : (ba != bb);
     }
 
-    // Generic comparison application
-    template<typename T>
-    bool applyComparison(T a, T b, ComparisonOp op) const
-    {
-        switch (op) {
-            case ComparisonOp::EQ: return a == b;
-            case ComparisonOp::NE: return a != b;
-            case ComparisonOp::LT: return a <  b;
-            case ComparisonOp::LE: return a <= b;
-            case ComparisonOp::GT: return a >  b;
-            case ComparisonOp::GE: return a >= b;
-            default:               return false;
-        }
-    }
-
     std::vector<int> parseVersion(const std::string& v) const
     {
         if (v.empty()) {
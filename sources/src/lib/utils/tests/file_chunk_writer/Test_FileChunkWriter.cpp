@@ -0,0 +1,117 @@
+/**
+ * @file    Test_FileChunkWriter.cpp
+ * @brief   ufile::FileChunkWriter (uFileChunkWriter.hpp): chunks committed shorter
+ *          than the buffer, empty commits, more chunks than buffers and a failing
+ *          file system
+ */
+
+#include "uFileChunkWriter.hpp"
+#include "uTestCheck.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static std::vector<uint8_t> readFile(const std::string& strPath)
+{
+    std::ifstream file(strPath, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+// commit the given lengths, chunk i filled with the byte value i
+static bool writeChunks(ufile::FileChunkWriter& writer, const std::vector<size_t>& vLengths, std::vector<uint8_t>& vExpected)
+{
+    for (size_t i = 0; i < vLengths.size(); ++i) {
+        std::span<uint8_t> buffer = writer.acquire();
+        if (buffer.empty()) {
+            return false;
+        }
+        const size_t szBytes = std::min(vLengths[i], buffer.size());
+        std::memset(buffer.data(), static_cast<int>(i & 0xFFU), szBytes);
+        vExpected.insert(vExpected.end(), szBytes, static_cast<uint8_t>(i & 0xFFU));
+        writer.commit(vLengths[i]);
+    }
+    return true;
+}
+
+int main()
+{
+    const std::string strPath = (std::filesystem::temp_directory_path() / "test_file_chunk_writer.bin").string();
+
+    // short, empty and full chunks, in order, through two buffers
+    {
+        ufile::FileChunkWriter writer(64U, 2U);
+        std::vector<uint8_t> vExpected;
+        UTEST_CHECK(writer.open(strPath));
+        UTEST_CHECK(writeChunks(writer, {1U, 64U, 0U, 17U, 63U, 0U, 64U, 5U}, vExpected));
+        UTEST_CHECK(writer.close());
+        UTEST_CHECK(writer.bytesWritten() == vExpected.size());
+        UTEST_CHECK(readFile(strPath) == vExpected);
+    }
+
+    // a commit longer than the buffer is clipped to it
+    {
+        ufile::FileChunkWriter writer(8U);
+        std::vector<uint8_t> vExpected;
+        UTEST_CHECK(writer.open(strPath));
+        UTEST_CHECK(writeChunks(writer, {100U, 3U}, vExpected));
+        UTEST_CHECK(writer.close());
+        UTEST_CHECK(readFile(strPath) == vExpected);
+        UTEST_CHECK(vExpected.size() == 11U);
+    }
+
+    // many more chunks than buffers, the producer waits for the writer
+    {
+        ufile::FileChunkWriter writer(4096U, 3U);
+        std::vector<uint8_t> vExpected;
+        std::vector<size_t> vLengths;
+        for (size_t i = 0; i < 500U; ++i) {
+            vLengths.push_back((i * 37U) % 4097U);
+        }
+        UTEST_CHECK(writer.open(strPath));
+        UTEST_CHECK(writeChunks(writer, vLengths, vExpected));
+        UTEST_CHECK(writer.close());
+        UTEST_CHECK(readFile(strPath) == vExpected);
+    }
+
+    // reopened: the file is truncated, the counter restarts
+    {
+        ufile::FileChunkWriter writer(16U);
+        std::vector<uint8_t> vExpected;
+        UTEST_CHECK(writer.open(strPath));
+        UTEST_CHECK(writeChunks(writer, {16U, 16U}, vExpected));
+        UTEST_CHECK(writer.close());
+        vExpected.clear();
+        UTEST_CHECK(writer.open(strPath));
+        UTEST_CHECK(writeChunks(writer, {2U}, vExpected));
+        UTEST_CHECK(writer.close());
+        UTEST_CHECK(writer.bytesWritten() == 2U);
+        UTEST_CHECK(readFile(strPath) == vExpected);
+    }
+
+    // no chunk without a running writer
+    {
+        ufile::FileChunkWriter writer(16U);
+        UTEST_CHECK(writer.acquire().empty());
+        UTEST_CHECK(!writer.open((std::filesystem::temp_directory_path() / "no_such_dir" / "x.bin").string()));
+        UTEST_CHECK(writer.acquire().empty());
+    }
+
+    // a full device: the failure is reported, by acquire() or at the latest by close()
+    if (std::filesystem::exists("/dev/full")) {
+        ufile::FileChunkWriter writer(1U << 16U, 2U);
+        std::vector<uint8_t> vExpected;
+        UTEST_CHECK(writer.open("/dev/full"));
+        writeChunks(writer, std::vector<size_t>(64U, 1U << 16U), vExpected);
+        UTEST_CHECK(!writer.close());
+        UTEST_CHECK(writer.bytesWritten() < vExpected.size());
+    }
+
+    std::remove(strPath.c_str());
+
+    return utest::result("file_chunk_writer");
+}
@@ -0,0 +1,179 @@
+/**
+ * @file    Test_HexSimd.cpp
+ * @brief   Kernel sets of uHexSimd.hpp against a per-character reference: every length
+ *          up to a few vector widths (odd ones included), buffers at every alignment,
+ *          both cases, mixed case input and invalid digits at every position
+ */
+
+#include "uHexSimd.hpp"
+#include "uTestCheck.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using hexutils::simd::Isa;
+using hexutils::simd::Kernels;
+
+///////////////////////////////////////////////////////////////////
+//                    PER-CHARACTER REFERENCE                    //
+///////////////////////////////////////////////////////////////////
+
+static std::string refEncode(const uint8_t *pIn, size_t szBytes, bool bUppercase)
+{
+    const char *pstrDigits = bUppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string strOut;
+    for (size_t i = 0; i < szBytes; ++i) {
+        strOut.push_back(pstrDigits[pIn[i] >> 4]);
+        strOut.push_back(pstrDigits[pIn[i] & 0x0F]);
+    }
+    return strOut;
+}
+
+static int refNibble(char c)
+{
+    if ((c >= '0') && (c <= '9')) return c - '0';
+    if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+    return -1;
+}
+
+static bool refDecode(const char *pIn, size_t szBytes, std::vector<uint8_t>& vOut)
+{
+    vOut.clear();
+    for (size_t i = 0; i < szBytes; ++i) {
+        const int iHigh = refNibble(pIn[2 * i]);
+        const int iLow = refNibble(pIn[2 * i + 1]);
+        if ((iHigh < 0) || (iLow < 0)) {
+            return false;
+        }
+        vOut.push_back(static_cast<uint8_t>((iHigh << 4) | iLow));
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////
+//                           CHECKS                              //
+///////////////////////////////////////////////////////////////////
+
+static constexpr size_t kMaxLength = 140U;   // above 4 AVX2 vectors of input
+static constexpr size_t kAlignments = 32U;
+
+static void checkEncodeDecode(const Kernels& sKernels, const std::vector<uint8_t>& vData)
+{
+    std::vector<char> vHex(2 * (kMaxLength + kAlignments) + 1U);
+    std::vector<uint8_t> vOut(kMaxLength + kAlignments + 1U);
+
+    for (size_t szLen = 0; szLen <= kMaxLength; ++szLen) {
+        for (size_t szAlign = 0; szAlign < kAlignments; ++szAlign) {
+            for (bool bUpper : {true, false}) {
+                const uint8_t *pIn = vData.data() + szAlign;
+                const std::string strExpected = refEncode(pIn, szLen, bUpper);
+
+                // output also misaligned, a guard byte after it
+                char *pHex = vHex.data() + (szAlign ^ 7U);
+                pHex[2 * szLen] = '#';
+                sKernels.encode(pIn, szLen, pHex, bUpper);
+                if (!UTEST_CHECK(std::string(pHex, 2 * szLen) == strExpected) || !UTEST_CHECK('#' == pHex[2 * szLen])) {
+                    std::cerr << sKernels.name << ": encode, length " << szLen << " alignment " << szAlign << "\n";
+                    return;
+                }
+
+                uint8_t *pOut = vOut.data() + ((szAlign + 3U) % kAlignments);
+                pOut[szLen] = 0xA5;
+                if (!UTEST_CHECK(sKernels.validate(pHex, 2 * szLen)) || !UTEST_CHECK(sKernels.decode(pHex, szLen, pOut)) ||
+                    !UTEST_CHECK(std::equal(pOut, pOut + szLen, pIn)) || !UTEST_CHECK(0xA5 == pOut[szLen])) {
+                    std::cerr << sKernels.name << ": decode, length " << szLen << " alignment " << szAlign << "\n";
+                    return;
+                }
+            }
+        }
+    }
+}
+
+static void checkAllBytes(const Kernels& sKernels)
+{
+    std::vector<uint8_t> vBytes(256U);
+    for (size_t i = 0; i < vBytes.size(); ++i) {
+        vBytes[i] = static_cast<uint8_t>(i);
+    }
+
+    for (bool bUpper : {true, false}) {
+        std::string strHex(2 * vBytes.size(), '\0');
+        std::vector<uint8_t> vOut(vBytes.size());
+        sKernels.encode(vBytes.data(), vBytes.size(), strHex.data(), bUpper);
+        UTEST_CHECK(strHex == refEncode(vBytes.data(), vBytes.size(), bUpper));
+        UTEST_CHECK(sKernels.decode(strHex.data(), vBytes.size(), vOut.data()) && (vOut == vBytes));
+    }
+}
+
+static void checkMixedCase(const Kernels& sKernels, const std::vector<uint8_t>& vData)
+{
+    // alternate the case of every letter
+    std::string strHex = refEncode(vData.data(), kMaxLength, true);
+    for (size_t i = 0; i < strHex.size(); i += 2) {
+        if ((strHex[i] >= 'A') && (strHex[i] <= 'F')) {
+            strHex[i] = static_cast<char>(strHex[i] - 'A' + 'a');
+        }
+    }
+
+    std::vector<uint8_t> vExpected;
+    std::vector<uint8_t> vOut(kMaxLength);
+    UTEST_CHECK(refDecode(strHex.data(), kMaxLength, vExpected));
+    UTEST_CHECK(sKernels.validate(strHex.data(), strHex.size()));
+    UTEST_CHECK(sKernels.decode(strHex.data(), kMaxLength, vOut.data()) && (vOut == vExpected));
+}
+
+static void checkInvalid(const Kernels& sKernels, const std::vector<uint8_t>& vData)
+{
+    // characters around the hex ranges, and ones mapped into them by a case fold or a sign extension
+    static const char kInvalid[] = {'/', ':', '@', 'G', '`', 'g', ' ', '\0', '\x10', '\x19', '\xB0', '\xC1', '\xE6', '\xFF'};
+
+    std::vector<uint8_t> vOut(kMaxLength);
+    for (size_t szLen : {1U, 7U, 8U, 15U, 16U, 17U, 31U, 32U, 33U, 63U, 65U}) {
+        const std::string strHex = refEncode(vData.data(), szLen, false);
+        for (size_t szPos = 0; szPos < strHex.size(); ++szPos) {
+            for (char cInvalid : kInvalid) {
+                std::string strBad = strHex;
+                strBad[szPos] = cInvalid;
+                if (!UTEST_CHECK(!sKernels.validate(strBad.data(), strBad.size())) ||
+                    !UTEST_CHECK(!sKernels.decode(strBad.data(), szLen, vOut.data()))) {
+                    std::cerr << sKernels.name << ": invalid digit accepted, length " << szLen << " position " << szPos << "\n";
+                    return;
+                }
+            }
+        }
+    }
+
+    // an odd number of characters is validated per character
+    UTEST_CHECK(sKernels.validate("abc", 3U));
+    UTEST_CHECK(!sKernels.validate("abx", 3U));
+}
+
+int main()
+{
+    std::vector<uint8_t> vData(kMaxLength + kAlignments);
+    uint32_t u32State = 0x12345678U;
+    for (auto& uByte : vData) {
+        u32State = u32State * 1664525U + 1013904223U;
+        uByte = static_cast<uint8_t>(u32State >> 24);
+    }
+
+    size_t szSets = 0;
+    for (Isa isa : {Isa::Scalar, Isa::Sse2, Isa::Avx2, Isa::Neon}) {
+        if (const Kernels *pKernels = hexutils::simd::kernelsFor(isa)) {
+            std::cout << "kernels: " << pKernels->name << "\n";
+            checkEncodeDecode(*pKernels, vData);
+            checkAllBytes(*pKernels);
+            checkMixedCase(*pKernels, vData);
+            checkInvalid(*pKernels, vData);
+            ++szSets;
+        }
+    }
+    UTEST_CHECK(szSets > 0U);
+    UTEST_CHECK(nullptr != hexutils::simd::kernelsFor(hexutils::simd::kernels().isa));
+
+    return utest::result("hex_simd");
+}
@@ -0,0 +1,47 @@
+#ifndef UTEST_CHECK_HPP
+#define UTEST_CHECK_HPP
+
+#include <cstdlib>
+#include <iostream>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                      MINIMAL CHECKS FOR THE Test_*.cpp                      //
+/////////////////////////////////////////////////////////////////////////////////
+
+// A test program runs its checks from main() and returns utest::result():
+// every failed check is reported with its location, the exit code tells
+// ctest whether all of them held.
+
+namespace utest
+{
+
+inline int& failures() noexcept
+{
+    static int iFailures = 0;
+    return iFailures;
+}
+
+inline bool check(bool bCondition, const char *pstrExpr, const char *pstrFile, int iLine)
+{
+    if (!bCondition) {
+        ++failures();
+        std::cerr << pstrFile << ":" << iLine << ": check failed: " << pstrExpr << "\n";
+    }
+    return bCondition;
+}
+
+inline int result(const char *pstrName)
+{
+    if (failures() != 0) {
+        std::cerr << pstrName << ": " << failures() << " check(s) failed\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << pstrName << ": ok\n";
+    return EXIT_SUCCESS;
+}
+
+} // namespace utest
+
+#define UTEST_CHECK(EXPR)  utest::check(static_cast<bool>(EXPR), #EXPR, __FILE__, __LINE__)
+
+#endif // UTEST_CHECK_HPP
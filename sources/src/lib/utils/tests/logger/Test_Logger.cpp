@@ -0,0 +1,169 @@
+/**
+ * @file    Test_Logger.cpp
+ * @brief   LogBuffer (uLogger.hpp): level gating before the arguments are formatted,
+ *          the record ring of the asynchronous mode and the accounting of the
+ *          messages dropped by DROP_NEWEST / DROP_OLDEST
+ */
+
+#include "uLogger.hpp"
+#include "uTestCheck.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#define LT_HDR     "TEST_LOG    |"
+#define LOG_HDR    LOG_STRING(LT_HDR)
+
+static int s_iEvaluated = 0;
+
+static int evaluated()
+{
+    return ++s_iEvaluated;
+}
+
+// a fresh logger writing only to the given file
+static void useFreshLogger(const std::string& strFile)
+{
+    setLogger(std::make_shared<LogBuffer>());
+    LOG_INIT(LOG_FIXED, LOG_VERBOSE, false, false, false);
+    if (!strFile.empty()) {
+        std::remove(strFile.c_str());
+        log_local->enableFileLogging(strFile);
+    }
+}
+
+static void testLevelGating()
+{
+    useFreshLogger("");
+    log_local->setConsoleThreshold(LOG_INFO);
+
+    UTEST_CHECK(!log_local->isEnabled(LOG_DEBUG));
+    UTEST_CHECK(log_local->isEnabled(LOG_INFO));
+    UTEST_CHECK(log_local->isEnabled(LOG_EMPTY));
+    UTEST_CHECK(!LOG_ENABLED(LOG_VERBOSE));
+    UTEST_CHECK(LOG_ENABLED(LOG_ERROR));
+
+    // the arguments of a filtered message are never evaluated
+    s_iEvaluated = 0;
+    LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_INT(evaluated()));
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_INT(evaluated()));
+    UTEST_CHECK(0 == s_iEvaluated);
+
+    log_local->setConsoleThreshold(LOG_FIXED);
+    UTEST_CHECK(!LOG_ENABLED(LOG_ERROR));
+    log_local->setFileThreshold(LOG_DEBUG);
+    UTEST_CHECK(!LOG_ENABLED(LOG_ERROR)); // no log file: the file threshold does not count
+}
+
+static void testRecordRing()
+{
+    LogBuffer::RecordRing ring(3); // rounded up to 4
+    LogBuffer::Record record;
+
+    for (int i = 0; i < 4; ++i) {
+        record = {LOG_INFO, std::to_string(i)};
+        UTEST_CHECK(ring.push(record));
+    }
+    record = {LOG_INFO, "4"};
+    UTEST_CHECK(!ring.push(record));
+    UTEST_CHECK("4" == record.text); // a rejected record is left untouched
+
+    // peek reads in place, oldest first
+    std::string strPeeked;
+    ring.peek([&](const LogBuffer::Record& r) { strPeeked += r.text; });
+    UTEST_CHECK("0123" == strPeeked);
+
+    for (int i = 0; i < 4; ++i) {
+        UTEST_CHECK(ring.pop(record) && (std::to_string(i) == record.text));
+    }
+    UTEST_CHECK(ring.empty() && !ring.pop(record));
+
+    // wraps around
+    for (int i = 0; i < 10; ++i) {
+        record = {LOG_INFO, std::to_string(i)};
+        UTEST_CHECK(ring.push(record));
+        UTEST_CHECK(ring.pop(record) && (std::to_string(i) == record.text));
+    }
+}
+
+// messages written to the file, messages reported as dropped, and whether the first / last one was written
+static void countLines(const std::string& strFile, size_t szTotal, size_t& szWritten, size_t& szDropped, bool& bFirst, bool& bLast)
+{
+    static const std::string strDropped = "messages dropped: ";
+    static const std::string strMsg = "| msg ";
+    std::ifstream file(strFile);
+    std::string strLine;
+
+    szWritten = szDropped = 0U;
+    bFirst = bLast = false;
+    while (std::getline(file, strLine)) {
+        if (const size_t pos = strLine.find(strDropped); pos != std::string::npos) {
+            szDropped += std::stoull(strLine.substr(pos + strDropped.size()));
+        } else if (const size_t pos = strLine.find(strMsg); pos != std::string::npos) {
+            const size_t szIndex = std::stoull(strLine.substr(pos + strMsg.size()));
+            ++szWritten;
+            bFirst |= (0U == szIndex);
+            bLast |= ((szTotal - 1U) == szIndex);
+        }
+    }
+}
+
+static void testOverflow(LogOverflow overflow)
+{
+    static constexpr size_t kMessages = 20000U;
+    const std::string strFile = (std::filesystem::temp_directory_path() / "test_logger_overflow.txt").string();
+
+    useFreshLogger(strFile);
+    UTEST_CHECK(LOG_ASYNC_START(4, overflow, 1000));
+    for (size_t i = 0; i < kMessages; ++i) {
+        LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING("msg"); LOG_SIZET(i));
+    }
+    LOG_DEINIT();
+
+    size_t szWritten = 0U, szDropped = 0U;
+    bool bFirst = false, bLast = false;
+    countLines(strFile, kMessages, szWritten, szDropped, bFirst, bLast);
+    std::remove(strFile.c_str());
+
+    // every message is either written or counted as dropped
+    UTEST_CHECK(kMessages == szWritten + szDropped);
+    if (LogOverflow::DROP_NEWEST == overflow) {
+        UTEST_CHECK(bFirst);  // the queue was empty for the first one
+    } else {
+        UTEST_CHECK(bLast);   // the newest is never the one dropped
+    }
+}
+
+static void testBlock()
+{
+    static constexpr size_t kMessages = 20000U;
+    const std::string strFile = (std::filesystem::temp_directory_path() / "test_logger_block.txt").string();
+
+    useFreshLogger(strFile);
+    UTEST_CHECK(LOG_ASYNC_START(4, LogOverflow::BLOCK, 1000));
+    for (size_t i = 0; i < kMessages; ++i) {
+        LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING("msg"); LOG_SIZET(i));
+    }
+    LOG_DEINIT();
+
+    size_t szWritten = 0U, szDropped = 0U;
+    bool bFirst = false, bLast = false;
+    countLines(strFile, kMessages, szWritten, szDropped, bFirst, bLast);
+    std::remove(strFile.c_str());
+
+    UTEST_CHECK((kMessages == szWritten) && (0U == szDropped) && bFirst && bLast);
+}
+
+int main()
+{
+    testLevelGating();
+    testRecordRing();
+    testOverflow(LogOverflow::DROP_NEWEST);
+    testOverflow(LogOverflow::DROP_OLDEST);
+    testBlock();
+
+    return utest::result("logger");
+}
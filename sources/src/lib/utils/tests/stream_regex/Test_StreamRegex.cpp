@@ -0,0 +1,158 @@
+/**
+ * @file    Test_StreamRegex.cpp
+ * @brief   uregex::StreamMatcher (uStreamRegex.hpp): responses fed in chunks split at every
+ *          position, byte by byte and at random, must give after every chunk the result of
+ *          std::regex_match on the bytes received so far; early mismatches and the std::regex
+ *          fallback
+ */
+
+#include "uStreamRegex.hpp"
+#include "uTestCheck.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+struct Case {
+    const char *pattern;
+    const char *response;
+};
+
+// patterns of the kind found in comm scripts, with a response matching each
+static const Case kCases[] = {
+    {"OK.*\\r\\n",                                   "OK ready\r\n"},
+    {"^HTTP/1\\.[01] 200 .*$",                       "HTTP/1.1 200 OK"},
+    {"[0-9]{1,3}\\.[0-9]{1,3}",                      "192.168"},
+    {".*Boot v[0-9]+\\.[0-9]+.*",                    "U-Boot SPL 2023.04 Boot v3.1 (Jan 01 2024)"},
+    {"\\+CSQ: \\d+,\\d+\\r\\n\\r\\nOK\\r\\n",        "+CSQ: 21,99\r\n\r\nOK\r\n"},
+    {"(?:OK|ERROR)\\r\\n",                           "ERROR\r\n"},
+    {"[0-9A-F]{2}(?: [0-9A-F]{2}){3}\\r\\n",         "0A 1B 2C 3D\r\n"},
+    {"\\s*ver(sion)?:\\s*\\w+(\\.\\w+)*\\s*",         "  version: 4.19.0_rc2 \r\n"},
+    {"login: .*?\\$ ",                               "login: root@dev:~$ "},
+    {"[^\\r\\n]+\\r\\n[\\x30-\\x39]+",               "id\r\n0042"},
+    {"[\\t -\\x2F]{2}",                              "\t/"},
+};
+
+// feeds strResponse in the chunks ending at vCuts, checks every intermediate result
+static bool feedInChunks(const uregex::ByteDfa *pDfa, const std::regex& re, const std::string& strResponse,
+                         const std::vector<size_t>& vCuts)
+{
+    uregex::StreamMatcher matcher(pDfa, &re);
+    size_t szBegin = 0;
+
+    for (size_t szEnd : vCuts) {
+        const auto *pData = reinterpret_cast<const uint8_t*>(strResponse.data());
+        const uregex::MatchState state = matcher.feed(std::span<const uint8_t>(pData + szBegin, szEnd - szBegin));
+        const bool bExpected = std::regex_match(strResponse.begin(), strResponse.begin() + static_cast<std::ptrdiff_t>(szEnd), re);
+
+        // the prefix of a matching response is never a dead end
+        if (!UTEST_CHECK((uregex::MatchState::MATCH == state) == bExpected) ||
+            !UTEST_CHECK(uregex::MatchState::NO_MATCH != state)) {
+            return false;
+        }
+        szBegin = szEnd;
+    }
+    return true;
+}
+
+static void checkSplits(const Case& sCase, std::mt19937& rng)
+{
+    const std::regex re(sCase.pattern);
+    const std::optional<uregex::ByteDfa> dfa = uregex::ByteDfa::compile(sCase.pattern);
+    const std::string strResponse(sCase.response);
+    const size_t szSize = strResponse.size();
+
+    if (!UTEST_CHECK(dfa.has_value())) {
+        std::cerr << "not compiled: " << sCase.pattern << "\n";
+        return;
+    }
+
+    for (const uregex::ByteDfa *pDfa : {&*dfa, static_cast<const uregex::ByteDfa*>(nullptr)}) {
+        bool bOk = feedInChunks(pDfa, re, strResponse, {szSize});
+
+        // two chunks, split at every position (empty chunks included)
+        for (size_t szCut = 0; bOk && (szCut <= szSize); ++szCut) {
+            bOk = feedInChunks(pDfa, re, strResponse, {szCut, szSize});
+        }
+
+        // byte by byte
+        std::vector<size_t> vCuts;
+        for (size_t szEnd = 1; szEnd <= szSize; ++szEnd) {
+            vCuts.push_back(szEnd);
+        }
+        bOk = bOk && feedInChunks(pDfa, re, strResponse, vCuts);
+
+        // random chunk sizes
+        for (int iRound = 0; bOk && (iRound < 50); ++iRound) {
+            vCuts.clear();
+            for (size_t szEnd = 0; szEnd < szSize; ) {
+                szEnd = std::min(szSize, szEnd + 1U + (rng() % 5U));
+                vCuts.push_back(szEnd);
+            }
+            bOk = feedInChunks(pDfa, re, strResponse, vCuts);
+        }
+
+        if (!bOk) {
+            std::cerr << (pDfa ? "dfa" : "std::regex") << ": " << sCase.pattern << "\n";
+        }
+    }
+}
+
+static uregex::MatchState feedString(uregex::StreamMatcher& matcher, const std::string& strData)
+{
+    return matcher.feed(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(strData.data()), strData.size()));
+}
+
+static void checkMismatch()
+{
+    const std::regex re("OK\\r\\n");
+    const std::optional<uregex::ByteDfa> dfa = uregex::ByteDfa::compile("OK\\r\\n");
+    UTEST_CHECK(dfa.has_value());
+
+    // detected at the first wrong byte and kept
+    uregex::StreamMatcher matcher(&*dfa, &re);
+    UTEST_CHECK(uregex::MatchState::PARTIAL == feedString(matcher, "O"));
+    UTEST_CHECK(matcher.canExtend());
+    UTEST_CHECK(uregex::MatchState::NO_MATCH == feedString(matcher, "X"));
+    UTEST_CHECK(!matcher.canExtend());
+    UTEST_CHECK(uregex::MatchState::NO_MATCH == feedString(matcher, "K\r\n"));
+
+    // a full match that no longer bytes can extend
+    uregex::StreamMatcher complete(&*dfa, &re);
+    UTEST_CHECK(uregex::MatchState::PARTIAL == feedString(complete, "OK\r"));
+    UTEST_CHECK(uregex::MatchState::MATCH == feedString(complete, "\n"));
+    UTEST_CHECK(!complete.canExtend());
+}
+
+static void checkFallback()
+{
+    // back references are left to std::regex, the received bytes are accumulated
+    static const char kPattern[] = "(\\w+)=\\1";
+    const std::regex re(kPattern);
+    UTEST_CHECK(!uregex::ByteDfa::compile(kPattern).has_value());
+
+    uregex::StreamMatcher matcher(nullptr, &re);
+    UTEST_CHECK(!matcher.isStreaming());
+    UTEST_CHECK(uregex::MatchState::PARTIAL == feedString(matcher, "ab"));
+    UTEST_CHECK(uregex::MatchState::PARTIAL == feedString(matcher, "c=a"));
+    UTEST_CHECK(uregex::MatchState::MATCH == feedString(matcher, "bc"));
+
+    uregex::StreamMatcher none(nullptr, nullptr);
+    UTEST_CHECK(uregex::MatchState::NO_MATCH == feedString(none, "abc"));
+}
+
+int main()
+{
+    std::mt19937 rng(0x5EED);
+
+    for (const Case& sCase : kCases) {
+        checkSplits(sCase, rng);
+    }
+    checkMismatch();
+    checkFallback();
+
+    return utest::result("stream_regex");
+}
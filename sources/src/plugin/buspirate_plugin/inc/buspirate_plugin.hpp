@@ -95,6 +95,7 @@ class BuspiratePlugin: public PluginInterface
             #define BUSPIRATE_PLUGIN_CMD_RECORD(a) m_mapCmds.insert( std::make_pair(std::string(#a), &BuspiratePlugin::m_Buspirate_##a ));
             BUSPIRATE_PLUGIN_COMMANDS_CONFIG_TABLE_CMDS
             #undef BUSPIRATE_PLUGIN_CMD_RECORD
+            generic_build_table<BuspiratePlugin>(m_mapCmds, m_vCmds);
 
 // MODES
             #define MODE_CMD_RECORD(a,b,c,d) { mode_s sTmp = {b, c, std::string(#d)}; m_mapModes.insert(std::make_pair(#a, sTmp)); }
@@ -210,6 +211,22 @@ class BuspiratePlugin: public PluginInterface
             return generic_dispatch<BuspiratePlugin>(this, strCmd, strParams);
         }
 
+        /**
+          * \brief resolve a command name once for id based dispatch
+        */
+        size_t resolveCommand( const std::string& strCmd ) const
+        {
+            return generic_resolve_command<BuspiratePlugin>(this, strCmd);
+        }
+
+        /**
+          * \brief dispatch a command pre-resolved by resolveCommand
+        */
+        bool doDispatchById( size_t szCmdId, const std::string& strParams ) const
+        {
+            return generic_dispatch_by_id<BuspiratePlugin>(this, szCmdId, strParams);
+        }
+
         /**
           * \brief get a pointer to the plugin map
         */
@@ -218,6 +235,14 @@ class BuspiratePlugin: public PluginInterface
             return &m_mapCmds;
         }
 
+        /**
+          * \brief get a pointer to the plugin commands table
+        */
+        const PluginCommandsTable<BuspiratePlugin> *getTable(void) const
+        {
+            return &m_vCmds;
+        }
+
         /**
           * \brief get the plugin version
         */
@@ -286,6 +311,14 @@ class BuspiratePlugin: public PluginInterface
             return false;
         }
 
+        /**
+          * \brief init / enable only touch the own serial port
+        */
+        bool isConcurrentInitSafe ( void ) const
+        {
+            return true;
+        }
+
         ModuleCommandsMap<BuspiratePlugin> *getModuleCmdsMap (const std::string& strModule) const;
         ModuleSpeedMap *getModuleSpeedsMap (const std::string& strModule) const;
         bool generic_uart_send_receive (std::span<const uint8_t> request, std::span<uint8_t> response = std::span<uint8_t>{}, std::span<const uint8_t> expected = std::span<const uint8_t>{}, bool strictCompare = true) const;
@@ -326,6 +359,11 @@ class BuspiratePlugin: public PluginInterface
         */
         PluginCommandsMap<BuspiratePlugin> m_mapCmds;
 
+        /**
+          * \brief table of the commands indexed by the id returned by resolveCommand
+        */
+        PluginCommandsTable<BuspiratePlugin> m_vCmds;
+
         /**
           * \brief plugin version
         */
@@ -1,6 +1,7 @@
 
 #include "buspirate_plugin.hpp"
 #include "buspirate_generic.hpp"
+#include "uCommScriptClient.hpp"
 
 #include "uUart.hpp"
 #include "uNumeric.hpp"
@@ -516,6 +517,10 @@ bool BuspiratePlugin::m_LocalSetParams( const PluginDataSet *psSetParams)
                 LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("ScriptDelay :"); LOG_UINT32(m_sIniValues.u32ScriptDelay));
             }
 
+            if (false == CommScriptSettings::configure(psSetParams->mapSettings)) {
+                break;
+            }
+
             bRetVal = true;
 
         } while(false);
@@ -109,6 +109,7 @@ public:
             m_mapCmds.insert({#a, &CH347Plugin::m_CH347_##a});
         CH347_PLUGIN_COMMANDS_CONFIG_TABLE
         #undef CH347_PLUGIN_CMD_RECORD
+        generic_build_table<CH347Plugin>(m_mapCmds, m_vCmds);
 
         // SPI 
         #define SPI_CMD_RECORD(a) \
@@ -176,7 +177,16 @@ public:
         return generic_dispatch<CH347Plugin>(this, cmd, params);
     }
 
+    size_t resolveCommand(const std::string& cmd) const {
+        return generic_resolve_command<CH347Plugin>(this, cmd);
+    }
+
+    bool doDispatchById(size_t id, const std::string& params) const {
+        return generic_dispatch_by_id<CH347Plugin>(this, id, params);
+    }
+
     const PluginCommandsMap<CH347Plugin>* getMap() const { return &m_mapCmds; }
+    const PluginCommandsTable<CH347Plugin>* getTable() const { return &m_vCmds; }
 
     const std::string& getVersion() const { return m_strVersion; }
     const std::string& getData()    const { return m_strResultData; }
@@ -301,6 +311,7 @@ private:
     mutable std::unique_ptr<CH347JTAG> m_pJTAG;
 
     PluginCommandsMap<CH347Plugin>   m_mapCmds;
+    PluginCommandsTable<CH347Plugin> m_vCmds;
     SpeedsMapsMap                    m_mapSpeedsMaps;
     CommandsMapsMap<CH347Plugin>     m_mapCommandsMaps;
 
@@ -10,6 +10,7 @@
  */
 
 #include "ch347_plugin.hpp"
+#include "uCommScriptClient.hpp"
 
 #include "uNumeric.hpp"
 #include "uLogger.hpp"
@@ -248,6 +249,8 @@ bool CH347Plugin::m_LocalSetParams(const PluginDataSet* ps)
     getU32  (READ_TIMEOUT,     m_sIniValues.u32ReadTimeout);
     getU32  (SCRIPT_DELAY,     m_sIniValues.u32ScriptDelay);
 
+    ok &= CommScriptSettings::configure(m);
+
     if (!ok)
         LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("One or more config values failed to parse"));
 
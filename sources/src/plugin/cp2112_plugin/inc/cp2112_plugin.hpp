@@ -92,6 +92,7 @@ public:
             m_mapCmds.insert({#a, &CP2112Plugin::m_CP2112_##a});
         CP2112_PLUGIN_COMMANDS_CONFIG_TABLE
         #undef CP2112_PLUGIN_CMD_RECORD
+        generic_build_table<CP2112Plugin>(m_mapCmds, m_vCmds);
 
         // I2C 
         #define I2C_CMD_RECORD(a) \
@@ -139,7 +140,16 @@ public:
         return generic_dispatch<CP2112Plugin>(this, cmd, params);
     }
 
+    size_t resolveCommand(const std::string& cmd) const {
+        return generic_resolve_command<CP2112Plugin>(this, cmd);
+    }
+
+    bool doDispatchById(size_t id, const std::string& params) const {
+        return generic_dispatch_by_id<CP2112Plugin>(this, id, params);
+    }
+
     const PluginCommandsMap<CP2112Plugin>* getMap() const { return &m_mapCmds; }
+    const PluginCommandsTable<CP2112Plugin>* getTable() const { return &m_vCmds; }
 
     const std::string& getVersion() const { return m_strVersion; }
     const std::string& getData()    const { return m_strResultData; }
@@ -238,6 +248,7 @@ private:
     mutable std::unique_ptr<CP2112Gpio> m_pGPIO;
 
     PluginCommandsMap<CP2112Plugin>   m_mapCmds;
+    PluginCommandsTable<CP2112Plugin> m_vCmds;
     SpeedsMapsMap                     m_mapSpeedsMaps;
     CommandsMapsMap<CP2112Plugin>     m_mapCommandsMaps;
 
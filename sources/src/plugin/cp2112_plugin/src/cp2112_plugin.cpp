@@ -7,6 +7,7 @@
  */
 
 #include "cp2112_plugin.hpp"
+#include "uCommScriptClient.hpp"
 
 #include "uNumeric.hpp"
 #include "uLogger.hpp"
@@ -346,6 +347,8 @@ bool CP2112Plugin::m_LocalSetParams(const PluginDataSet* ps)
     getU32  (READ_TIMEOUT,    m_sIniValues.u32ReadTimeout);
     getU32  (SCRIPT_DELAY,    m_sIniValues.u32ScriptDelay);
 
+    ok &= CommScriptSettings::configure(m);
+
     if (!ok) {
         LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("One or more config values failed to parse"));
     }
@@ -97,6 +97,7 @@ public:
             m_mapCmds.insert({#a, &FT2232Plugin::m_FT2232_##a});
         FT2232_PLUGIN_COMMANDS_CONFIG_TABLE
         #undef FT2_PLUGIN_CMD_RECORD
+        generic_build_table<FT2232Plugin>(m_mapCmds, m_vCmds);
 
         // SPI 
         #define SPI_CMD_RECORD(a) \
@@ -168,7 +169,16 @@ public:
         return generic_dispatch<FT2232Plugin>(this, cmd, params);
     }
 
+    size_t resolveCommand(const std::string& cmd) const {
+        return generic_resolve_command<FT2232Plugin>(this, cmd);
+    }
+
+    bool doDispatchById(size_t id, const std::string& params) const {
+        return generic_dispatch_by_id<FT2232Plugin>(this, id, params);
+    }
+
     const PluginCommandsMap<FT2232Plugin>* getMap() const { return &m_mapCmds; }
+    const PluginCommandsTable<FT2232Plugin>* getTable() const { return &m_vCmds; }
 
     const std::string& getVersion() const { return m_strVersion; }
     const std::string& getData()    const { return m_strResultData; }
@@ -304,6 +314,7 @@ private:
     mutable std::unique_ptr<FT2232UART> m_pUART;
 
     PluginCommandsMap<FT2232Plugin>   m_mapCmds;
+    PluginCommandsTable<FT2232Plugin> m_vCmds;
     SpeedsMapsMap                     m_mapSpeedsMaps;
     CommandsMapsMap<FT2232Plugin>     m_mapCommandsMaps;
 
@@ -9,6 +9,7 @@
  */
 
 #include "ft2232_plugin.hpp"
+#include "uCommScriptClient.hpp"
 
 #include "uNumeric.hpp"
 #include "uLogger.hpp"
@@ -601,6 +602,8 @@ bool FT2232Plugin::m_LocalSetParams(const PluginDataSet* ps)
     getU32  (SCRIPT_DELAY,      m_sIniValues.u32ScriptDelay);
     getU32  (UART_BAUD,         m_sIniValues.u32UartBaudRate);
 
+    ok &= CommScriptSettings::configure(m);
+
     if (!ok)
         LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("One or more config values failed to parse"));
 
@@ -94,6 +94,7 @@ public:
             m_mapCmds.insert({#a, &FT232HPlugin::m_FT232H_##a});
         FT232H_PLUGIN_COMMANDS_CONFIG_TABLE
         #undef FT232H_PLUGIN_CMD_RECORD
+        generic_build_table<FT232HPlugin>(m_mapCmds, m_vCmds);
 
         // SPI 
         #define SPI_CMD_RECORD(a) \
@@ -165,7 +166,16 @@ public:
         return generic_dispatch<FT232HPlugin>(this, cmd, params);
     }
 
+    size_t resolveCommand(const std::string& cmd) const {
+        return generic_resolve_command<FT232HPlugin>(this, cmd);
+    }
+
+    bool doDispatchById(size_t id, const std::string& params) const {
+        return generic_dispatch_by_id<FT232HPlugin>(this, id, params);
+    }
+
     const PluginCommandsMap<FT232HPlugin>* getMap() const { return &m_mapCmds; }
+    const PluginCommandsTable<FT232HPlugin>* getTable() const { return &m_vCmds; }
 
     const std::string& getVersion() const { return m_strVersion; }
     const std::string& getData()    const { return m_strResultData; }
@@ -289,6 +299,7 @@ private:
     mutable std::unique_ptr<FT232HUART> m_pUART;
 
     PluginCommandsMap<FT232HPlugin>   m_mapCmds;
+    PluginCommandsTable<FT232HPlugin> m_vCmds;
     SpeedsMapsMap                     m_mapSpeedsMaps;
     CommandsMapsMap<FT232HPlugin>     m_mapCommandsMaps;
 
@@ -8,6 +8,7 @@
  */
 
 #include "ft232h_plugin.hpp"
+#include "uCommScriptClient.hpp"
 
 #include "uNumeric.hpp"
 #include "uLogger.hpp"
@@ -507,6 +508,8 @@ bool FT232HPlugin::m_LocalSetParams(const PluginDataSet* ps)
     getU32  (SCRIPT_DELAY,    m_sIniValues.u32ScriptDelay);
     getU32  (UART_BAUD,       m_sIniValues.u32UartBaudRate);
 
+    ok &= CommScriptSettings::configure(m);
+
     if (!ok)
         LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("One or more config values failed to parse"));
 
@@ -107,6 +107,7 @@ public:
             m_mapCmds.insert({#a, &FT245Plugin::m_FT245_##a});
         FT245_PLUGIN_COMMANDS_CONFIG_TABLE
         #undef FT245_PLUGIN_CMD_RECORD
+        generic_build_table<FT245Plugin>(m_mapCmds, m_vCmds);
 
         // FIFO 
         #define FIFO_CMD_RECORD(a) \
@@ -151,7 +152,16 @@ public:
         return generic_dispatch<FT245Plugin>(this, cmd, params);
     }
 
+    size_t resolveCommand(const std::string& cmd) const {
+        return generic_resolve_command<FT245Plugin>(this, cmd);
+    }
+
+    bool doDispatchById(size_t id, const std::string& params) const {
+        return generic_dispatch_by_id<FT245Plugin>(this, id, params);
+    }
+
     const PluginCommandsMap<FT245Plugin>* getMap() const { return &m_mapCmds; }
+    const PluginCommandsTable<FT245Plugin>* getTable() const { return &m_vCmds; }
 
     const std::string& getVersion() const { return m_strVersion; }
     const std::string& getData()    const { return m_strResultData; }
@@ -246,6 +256,7 @@ private:
     mutable std::unique_ptr<FT245GPIO>  m_pGPIO;
 
     PluginCommandsMap<FT245Plugin>   m_mapCmds;
+    PluginCommandsTable<FT245Plugin> m_vCmds;
     SpeedsMapsMap                    m_mapSpeedsMaps;
     CommandsMapsMap<FT245Plugin>     m_mapCommandsMaps;
 
@@ -10,6 +10,7 @@
  */
 
 #include "ft245_plugin.hpp"
+#include "uCommScriptClient.hpp"
 
 #include "uNumeric.hpp"
 #include "uLogger.hpp"
@@ -432,6 +433,8 @@ bool FT245Plugin::m_LocalSetParams(const PluginDataSet* ps)
     getU32  (READ_TIMEOUT,       m_sIniValues.u32ReadTimeout);
     getU32  (SCRIPT_DELAY,       m_sIniValues.u32ScriptDelay);
 
+    ok &= CommScriptSettings::configure(m);
+
     if (!ok)
         LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("One or more config values failed to parse"));
 
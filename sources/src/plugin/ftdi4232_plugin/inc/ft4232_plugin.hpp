@@ -106,6 +106,7 @@ public:
             m_mapCmds.insert({#a, &FT4232Plugin::m_FT4232_##a});
         FT4232_PLUGIN_COMMANDS_CONFIG_TABLE
         #undef FT_PLUGIN_CMD_RECORD
+        generic_build_table<FT4232Plugin>(m_mapCmds, m_vCmds);
 
         // SPI subcommand map 
         #define SPI_CMD_RECORD(a) \
@@ -177,10 +178,22 @@ public:
         return generic_dispatch<FT4232Plugin>(this, cmd, params);
     }
 
+    size_t resolveCommand(const std::string& cmd) const {
+        return generic_resolve_command<FT4232Plugin>(this, cmd);
+    }
+
+    bool doDispatchById(size_t id, const std::string& params) const {
+        return generic_dispatch_by_id<FT4232Plugin>(this, id, params);
+    }
+
     const PluginCommandsMap<FT4232Plugin>* getMap() const {
         return &m_mapCmds;
     }
 
+    const PluginCommandsTable<FT4232Plugin>* getTable() const {
+        return &m_vCmds;
+    }
+
     const std::string& getVersion() const { return m_strVersion; }
     const std::string& getData()    const { return m_strResultData; }
     void resetData()                const { m_strResultData.clear(); }
@@ -321,6 +334,7 @@ private:
 
     // Dispatch maps
     PluginCommandsMap<FT4232Plugin>   m_mapCmds;
+    PluginCommandsTable<FT4232Plugin> m_vCmds;
     SpeedsMapsMap                     m_mapSpeedsMaps;
     CommandsMapsMap<FT4232Plugin>     m_mapCommandsMaps;
 
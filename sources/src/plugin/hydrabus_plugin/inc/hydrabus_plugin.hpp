@@ -98,6 +98,7 @@ public:
             m_mapCmds.insert({#a, &HydrabusPlugin::m_Hydrabus_##a});
         HYDRABUS_PLUGIN_COMMANDS_CONFIG_TABLE_CMDS
         #undef HB_PLUGIN_CMD_RECORD
+        generic_build_table<HydrabusPlugin>(m_mapCmds, m_vCmds);
 
         // Mode table 
         #define MODE_CMD_RECORD(a,b,c,d) { \
@@ -198,6 +199,7 @@ public:
     bool isEnabled()       const override { return m_bIsEnabled;       }
     bool isFaultTolerant() const override { return m_bIsFaultTolerant; }
     bool isPrivileged()    const override { return false;               }
+    bool isConcurrentInitSafe() const override { return true;          } // own serial port only
 
     bool setParams(const PluginDataSet* ps) {
         bool ok = generic_setparams<HydrabusPlugin>(this, ps, &m_bIsFaultTolerant, &m_bIsPrivileged);
@@ -212,10 +214,22 @@ public:
         return generic_dispatch<HydrabusPlugin>(this, cmd, params);
     }
 
+    size_t resolveCommand(const std::string& cmd) const {
+        return generic_resolve_command<HydrabusPlugin>(this, cmd);
+    }
+
+    bool doDispatchById(size_t id, const std::string& params) const {
+        return generic_dispatch_by_id<HydrabusPlugin>(this, id, params);
+    }
+
     const PluginCommandsMap<HydrabusPlugin>* getMap() const {
         return &m_mapCmds;
     }
 
+    const PluginCommandsTable<HydrabusPlugin>* getTable() const {
+        return &m_vCmds;
+    }
+
     const std::string& getVersion() const { return m_strVersion; }
     const std::string& getData()    const { return m_strResultData; }
     void resetData()                const { m_strResultData.clear(); }
@@ -394,6 +408,7 @@ private:
 
     // Dispatch maps
     PluginCommandsMap<HydrabusPlugin>             m_mapCmds;
+    PluginCommandsTable<HydrabusPlugin>           m_vCmds;
     ModesMap                                      m_mapModes;
     SpeedsMapsMap                                 m_mapSpeedsMaps;
     CommandsMapsMap<HydrabusPlugin>               m_mapCommandsMaps;
@@ -12,6 +12,7 @@
  */
 
 #include "hydrabus_plugin.hpp"
+#include "uCommScriptClient.hpp"
 
 #include "uNumeric.hpp"
 #include "uLogger.hpp"
@@ -842,6 +843,8 @@ bool HydrabusPlugin::m_LocalSetParams(const PluginDataSet* ps)
     getU32(READ_BUF_SIZE,     m_sIniValues.u32UartReadBufferSize);
     getU32(SCRIPT_DELAY,      m_sIniValues.u32ScriptDelay);
 
+    ok &= CommScriptSettings::configure(m);
+
     if (!ok)
         LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("One or more config values failed to parse"));
 
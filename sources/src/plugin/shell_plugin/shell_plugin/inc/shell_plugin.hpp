@@ -72,6 +72,7 @@ public:
 #define SHELL_PLUGIN_CMD_RECORD(a) m_mapCmds.insert( std::make_pair( #a, &ShellPlugin::m_Shell_##a ));
         SHELL_PLUGIN_COMMANDS_CONFIG_TABLE
 #undef  SHELL_PLUGIN_CMD_RECORD
+        generic_build_table<ShellPlugin>(m_mapCmds, m_vCmds);
     }
 
     /**
@@ -130,6 +131,22 @@ public:
         return generic_dispatch<ShellPlugin>(this, strCmd, strParams);
     }
 
+    /**
+      * \brief resolve a command name once for id based dispatch
+    */
+    size_t resolveCommand( const std::string& strCmd ) const
+    {
+        return generic_resolve_command<ShellPlugin>(this, strCmd);
+    }
+
+    /**
+      * \brief dispatch a command pre-resolved by resolveCommand
+    */
+    bool doDispatchById( size_t szCmdId, const std::string& strParams ) const
+    {
+        return generic_dispatch_by_id<ShellPlugin>(this, szCmdId, strParams);
+    }
+
     /**
       * \brief get a pointer to the plugin map
     */
@@ -138,6 +155,14 @@ public:
         return &m_mapCmds;
     }
 
+    /**
+      * \brief get a pointer to the plugin commands table
+    */
+    const PluginCommandsTable<ShellPlugin> *getTable(void) const
+    {
+        return &m_vCmds;
+    }
+
     /**
       * \brief get the plugin version
     */
@@ -214,6 +239,11 @@ private:
     */
     PluginCommandsMap<ShellPlugin> m_mapCmds;
 
+    /**
+      * \brief table of the commands indexed by the id returned by resolveCommand
+    */
+    PluginCommandsTable<ShellPlugin> m_vCmds;
+
     /**
       * \brief plugin version
     */
@@ -73,6 +73,7 @@ public:
 #define TEMPLATE_PLUGIN_CMD_RECORD(a) m_mapCmds.insert( std::make_pair( #a, &TemplatePlugin::m_Template_##a ));
         TEMPLATE_PLUGIN_COMMANDS_CONFIG_TABLE
 #undef  TEMPLATE_PLUGIN_CMD_RECORD
+        generic_build_table<TemplatePlugin>(m_mapCmds, m_vCmds);
     }
 
     /**
@@ -131,6 +132,22 @@ public:
         return generic_dispatch<TemplatePlugin>(this, strCmd, strParams);
     }
 
+    /**
+      * \brief resolve a command name once for id based dispatch
+    */
+    size_t resolveCommand( const std::string& strCmd ) const
+    {
+        return generic_resolve_command<TemplatePlugin>(this, strCmd);
+    }
+
+    /**
+      * \brief dispatch a command pre-resolved by resolveCommand
+    */
+    bool doDispatchById( size_t szCmdId, const std::string& strParams ) const
+    {
+        return generic_dispatch_by_id<TemplatePlugin>(this, szCmdId, strParams);
+    }
+
     /**
       * \brief get a pointer to the plugin map
     */
@@ -139,6 +156,14 @@ public:
         return &m_mapCmds;
     }
 
+    /**
+      * \brief get a pointer to the plugin commands table
+    */
+    const PluginCommandsTable<TemplatePlugin> *getTable(void) const
+    {
+        return &m_vCmds;
+    }
+
     /**
       * \brief get the plugin version
     */
@@ -215,6 +240,11 @@ private:
     */
     PluginCommandsMap<TemplatePlugin> m_mapCmds;
 
+    /**
+      * \brief table of the commands indexed by the id returned by resolveCommand
+    */
+    PluginCommandsTable<TemplatePlugin> m_vCmds;
+
     /**
       * \brief plugin version
     */
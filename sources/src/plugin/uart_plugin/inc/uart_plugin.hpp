@@ -58,6 +58,7 @@ class UARTPlugin: public PluginInterface
             #define UART_PLUGIN_CMD_RECORD(a) m_mapCmds.insert( std::make_pair( #a, &UARTPlugin::m_UART_##a ));
             UART_PLUGIN_COMMANDS_CONFIG_TABLE
             #undef  UART_PLUGIN_CMD_RECORD
+            generic_build_table<UARTPlugin>(m_mapCmds, m_vCmds);
         }
 
         /**
@@ -116,6 +117,22 @@ class UARTPlugin: public PluginInterface
             return generic_dispatch<UARTPlugin>(this, strCmd, strParams);
         }
 
+        /**
+          * \brief resolve a command name once for id based dispatch
+        */
+        size_t resolveCommand( const std::string& strCmd ) const
+        {
+            return generic_resolve_command<UARTPlugin>(this, strCmd);
+        }
+
+        /**
+          * \brief dispatch a command pre-resolved by resolveCommand
+        */
+        bool doDispatchById( size_t szCmdId, const std::string& strParams ) const
+        {
+            return generic_dispatch_by_id<UARTPlugin>(this, szCmdId, strParams);
+        }
+
         /**
           * \brief get a pointer to the plugin map
         */
@@ -124,6 +141,14 @@ class UARTPlugin: public PluginInterface
             return &m_mapCmds;
         }
 
+        /**
+          * \brief get a pointer to the plugin commands table
+        */
+        const PluginCommandsTable<UARTPlugin> *getTable(void) const
+        {
+            return &m_vCmds;
+        }
+
         /**
           * \brief get the plugin version
         */
@@ -188,6 +213,14 @@ class UARTPlugin: public PluginInterface
         	return m_bIsPrivileged;
         }
 
+        /**
+          * \brief init / enable only touch the own serial port
+        */
+        bool isConcurrentInitSafe (void) const
+        {
+            return true;
+        }
+
         /**
           * \brief get UART port
         */
@@ -258,6 +291,11 @@ class UARTPlugin: public PluginInterface
         */
         PluginCommandsMap<UARTPlugin> m_mapCmds;
 
+        /**
+          * \brief table of the commands indexed by the id returned by resolveCommand
+        */
+        PluginCommandsTable<UARTPlugin> m_vCmds;
+
         /**
           * \brief plugin version
         */
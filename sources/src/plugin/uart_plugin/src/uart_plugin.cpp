@@ -140,8 +140,9 @@ bool UARTPlugin::m_UART_INFO (const std::string &args) const
     LOG_PRINT(LOG_EMPTY, LOG_STRING("       UART.CONFIG p:/dev/ttyUSB0 b:115200 s:2048"));
     LOG_SEP();
     LOG_PRINT(LOG_EMPTY, LOG_STRING("SCRIPT : send commands from a file"));
-    LOG_PRINT(LOG_EMPTY, LOG_STRING("Args : script"));
+    LOG_PRINT(LOG_EMPTY, LOG_STRING("Args : script [delay [window]]"));
     LOG_PRINT(LOG_EMPTY, LOG_STRING("Usage: UART.SCRIPT script.txt"));
+    LOG_PRINT(LOG_EMPTY, LOG_STRING("       UART.SCRIPT flash_blocks.txt 0 8"));
     LOG_PRINT(LOG_EMPTY, LOG_STRING("CMD  : send, receive or both"));
     LOG_SEP();
     LOG_PRINT(LOG_EMPTY, LOG_STRING("Args : direction message"));
@@ -251,7 +252,7 @@ bool UARTPlugin::m_UART_CMD ( const std::string &args) const
   * \brief SCRIPT command implementation;
   *
   * \note Usage example: <br>
-  *       UART.SCRIPT scriptname [|delay]
+  *       UART.SCRIPT scriptname [|delay [|window]]
   *
   * \param[in] filename<string>
   *
@@ -267,7 +268,7 @@ bool UARTPlugin::m_UART_SCRIPT ( const std::string &args) const
 
         // expected to have as parameter the name of the script
         if (true == args.empty()) {
-            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Missing arg(s): scriptpathname [|delay]"));
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Missing arg(s): scriptpathname [|delay [|window]]"));
             break;
         }
 
@@ -275,18 +276,27 @@ bool UARTPlugin::m_UART_SCRIPT ( const std::string &args) const
         ustring::tokenizeSpaceQuotesAware(args, vstrArgs);
         size_t szNrArgs = vstrArgs.size();
 
-        if ((szNrArgs < 1) || (szNrArgs > 2)) {
-            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Expected: scriptpathname [|delay] "));
+        if ((szNrArgs < 1) || (szNrArgs > 3)) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Expected: scriptpathname [|delay [|window]] "));
             break;
         }
 
         size_t szDelay = 0;
-        if (2 == szNrArgs) {
+        if (szNrArgs >= 2) {
             if (false == numeric::str2sizet(vstrArgs[1], szDelay)) {
                 break;
             }
         }
 
+        // number of requests sent ahead of their responses, SCRIPT_WINDOW of the ini file by default
+        size_t szWindow = CommScriptSettings::window();
+        if (3 == szNrArgs) {
+            if ((false == numeric::str2sizet(vstrArgs[2], szWindow)) || (0 == szWindow)) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Invalid window:"); LOG_STRING(vstrArgs[2]));
+                break;
+            }
+        }
+
         std::string strScriptPathName;
         ufile::buildFilePath(m_strArtefactsPath, vstrArgs[0], strScriptPathName);
 
@@ -307,7 +317,8 @@ bool UARTPlugin::m_UART_SCRIPT ( const std::string &args) const
                     shpDriver,
                     m_u32UartReadBufferSize,   // szMaxRecvSize
                     m_u32ReadTimeout,          // u32DefaultTimeout
-                    szDelay                    // szDelay
+                    szDelay,                   // szDelay
+                    szWindow                   // szWindow
                 );
                 bRetVal = client.execute(m_bIsEnabled);
             }
@@ -376,6 +387,10 @@ bool UARTPlugin::m_LocalSetParams( const PluginDataSet *psSetParams)
                 LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("ReadBufSize :"); LOG_UINT32(m_u32UartReadBufferSize));
             }
 
+            if (false == CommScriptSettings::configure(psSetParams->mapSettings)) {
+                break;
+            }
+
             bRetVal = true;
 
         } while(false);
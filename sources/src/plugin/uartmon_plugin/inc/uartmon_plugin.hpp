@@ -51,6 +51,7 @@ class UartmonPlugin: public PluginInterface
             #define UARTMON_PLUGIN_CMD_RECORD(a) m_mapCmds.insert( std::make_pair( #a, &UartmonPlugin::m_Uartmon_##a ));
             UARTMON_PLUGIN_COMMANDS_CONFIG_TABLE
             #undef  UARTMON_PLUGIN_CMD_RECORD
+            generic_build_table<UartmonPlugin>(m_mapCmds, m_vCmds);
         }
 
         ~UartmonPlugin()
@@ -76,7 +77,10 @@ class UartmonPlugin: public PluginInterface
         }
         void getParams( PluginDataGet *psGetParams ) const { generic_getparams<UartmonPlugin>(this, psGetParams); }
         bool doDispatch( const std::string& strCmd, const std::string& strParams ) const { return generic_dispatch<UartmonPlugin>(this, strCmd, strParams); }
+        size_t resolveCommand( const std::string& strCmd ) const { return generic_resolve_command<UartmonPlugin>(this, strCmd); }
+        bool doDispatchById( size_t szCmdId, const std::string& strParams ) const { return generic_dispatch_by_id<UartmonPlugin>(this, szCmdId, strParams); }
         const PluginCommandsMap<UartmonPlugin> *getMap(void) const { return &m_mapCmds; }
+        const PluginCommandsTable<UartmonPlugin> *getTable(void) const { return &m_vCmds; }
         const std::string& getVersion(void) const { return m_strVersion
 ; }
         const std::string& getData(void) const { return m_strResultData; }
@@ -90,6 +94,7 @@ class UartmonPlugin: public PluginInterface
     private:
         bool m_LocalSetParams( const PluginDataSet *psSetParams );
         PluginCommandsMap<UartmonPlugin> m_mapCmds;
+        PluginCommandsTable<UartmonPlugin> m_vCmds;
         std::string m_strVersion
 ;
         mutable std::string m_strResultData;
@@ -0,0 +1,290 @@
+#ifndef U_COMM_SCRIPT_CACHE_HPP
+#define U_COMM_SCRIPT_CACHE_HPP
+
+#include "IScriptCache.hpp"
+#include "uCommScriptDataTypes.hpp"
+
+#include "uSharedConfig.hpp"
+#include "uLogger.hpp"
+#include "uNumeric.hpp"
+#include "uTimer.hpp"
+#include "uTrace.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            LOCAL DEFINITIONS                                //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifdef LT_HDR
+    #undef LT_HDR
+#endif
+#ifdef LOG_HDR
+    #undef LOG_HDR
+#endif
+
+#define LT_HDR     "COMM_SCR_C  |"
+#define LOG_HDR    LOG_STRING(LT_HDR)
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            CLASS DEFINITION                                 //
+/////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief In-memory cache of validated comm scripts
+ *
+ * The entries (commands with their precompiled payloads, macros) are keyed by
+ * the canonical script path and are valid while the file keeps the size and
+ * modification time it had when it was read. The macros of a comm script are
+ * declared in the script itself, so they are covered by the file stamp.
+ *
+ * The store is shared by all the clients built in the same module (a plugin
+ * library or the executable): a script run repeatedly, e.g. from a REPEAT loop
+ * of a core script, is read and validated once. It holds at most capacity()
+ * scripts, the least recently used one is dropped first; a capacity of 0
+ * turns the cache off (see setCapacity() and configure()). Lookups are
+ * recorded in the timeline trace (category "cache") and counted, see stats().
+ */
+class CommScriptCache : public IScriptCache<CommCommandsType>
+{
+    public:
+
+        /**
+         * @brief Lookup counters of the store
+         */
+        struct Stats
+        {
+            uint64_t uHits = 0U;       ///< Scripts loaded from the cache
+            uint64_t uMisses = 0U;     ///< Scripts read and validated
+            uint64_t uEvictions = 0U;  ///< Scripts dropped to stay within the capacity
+            size_t szEntries = 0U;     ///< Scripts cached
+            size_t szCapacity = 0U;    ///< Scripts the store may hold, 0 if the cache is off
+        };
+
+        explicit CommScriptCache(const std::string& strScriptPathName)
+            : m_strScriptPathName(strScriptPathName)
+        {}
+
+        bool loadScript(CommCommandsType& sScriptEntries) override
+        {
+            UTRACE_SCOPE(utrace::Category::CACHE, "comm script lookup");
+
+            Store& store = m_getStore();
+            if (0U == capacity()) {
+                m_bStamped = false;
+                return false;
+            }
+
+            m_bStamped = m_stampScript(m_strKey, m_sStamp);
+            if (!m_bStamped) {
+                store.uMisses.fetch_add(1U, std::memory_order_relaxed);
+                return false;
+            }
+
+            std::shared_ptr<const CommCommandsType> shpEntries;
+            {
+                std::lock_guard<std::mutex> lock(store.mutex);
+                auto it = store.mapEntries.find(m_strKey);
+                if ((it != store.mapEntries.end()) && (it->second.sStamp == m_sStamp)) {
+                    shpEntries = it->second.shpEntries;
+                    store.lstLru.splice(store.lstLru.begin(), store.lstLru, it->second.itLru);
+                }
+            }
+
+            if (!shpEntries) {
+                store.uMisses.fetch_add(1U, std::memory_order_relaxed);
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("Miss:"); LOG_STRING(m_strKey));
+                return false;
+            }
+
+            sScriptEntries = *shpEntries;
+            store.uHits.fetch_add(1U, std::memory_order_relaxed);
+            LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("Hit:"); LOG_STRING(m_strKey);
+                                            LOG_STRING("commands:"); LOG_SIZET(shpEntries->vCommands.size()));
+            return true;
+        }
+
+        bool storeScript(const CommCommandsType& sScriptEntries) override
+        {
+            // the script must not have changed since it was stamped by loadScript
+            std::string strKey;
+            FileStamp sStamp;
+            if (!m_bStamped || !m_stampScript(strKey, sStamp) || !(sStamp == m_sStamp)) {
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("Not cached, script changed:"); LOG_STRING(m_strScriptPathName));
+                return false;
+            }
+
+            Store& store = m_getStore();
+            auto shpEntries = std::make_shared<const CommCommandsType>(sScriptEntries);
+            std::lock_guard<std::mutex> lock(store.mutex);
+            if (0U == store.szCapacity) {
+                return false; // turned off since the lookup
+            }
+
+            auto it = store.mapEntries.find(m_strKey);
+            if (it != store.mapEntries.end()) {
+                it->second.sStamp = m_sStamp;
+                it->second.shpEntries = std::move(shpEntries);
+                store.lstLru.splice(store.lstLru.begin(), store.lstLru, it->second.itLru);
+            } else {
+                store.lstLru.push_front(m_strKey);
+                store.mapEntries.emplace(m_strKey, Entry{m_sStamp, std::move(shpEntries), store.lstLru.begin()});
+                m_evict(store);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Scripts the store of this module may hold, 0 turns the cache off;
+         *        the least recently used scripts beyond it are dropped
+         */
+        static void setCapacity(size_t szCapacity)
+        {
+            Store& store = m_getStore();
+            std::lock_guard<std::mutex> lock(store.mutex);
+            store.szCapacity = szCapacity;
+            m_evict(store);
+        }
+
+        static size_t capacity()
+        {
+            Store& store = m_getStore();
+            std::lock_guard<std::mutex> lock(store.mutex);
+            return store.szCapacity;
+        }
+
+        /**
+         * @brief Applies PLUGIN_INI_SCRIPT_CACHE of the plugin settings, if present
+         * @return false if the value is not a number
+         */
+        static bool configure(const std::unordered_map<std::string, std::string>& mapSettings)
+        {
+            auto it = mapSettings.find(PLUGIN_INI_SCRIPT_CACHE);
+            if (it == mapSettings.end()) {
+                return true;
+            }
+
+            size_t szCapacity = 0U;
+            if (false == numeric::str2sizet(it->second, szCapacity)) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Invalid"); LOG_STRING(PLUGIN_INI_SCRIPT_CACHE); LOG_STRING(it->second));
+                return false;
+            }
+            setCapacity(szCapacity);
+            LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("ScriptCache :"); LOG_SIZET(szCapacity));
+            return true;
+        }
+
+        /**
+         * @brief Counters of the store of this module
+         */
+        static Stats stats()
+        {
+            Store& store = m_getStore();
+            Stats sStats;
+            sStats.uHits = store.uHits.load(std::memory_order_relaxed);
+            sStats.uMisses = store.uMisses.load(std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(store.mutex);
+            sStats.uEvictions = store.uEvictions;
+            sStats.szEntries = store.mapEntries.size();
+            sStats.szCapacity = store.szCapacity;
+            return sStats;
+        }
+
+        /**
+         * @brief Drop all the cached scripts (the counters are kept)
+         */
+        static void clear()
+        {
+            Store& store = m_getStore();
+            std::lock_guard<std::mutex> lock(store.mutex);
+            store.mapEntries.clear();
+            store.lstLru.clear();
+        }
+
+    private:
+
+        struct FileStamp
+        {
+            uint64_t u64Size = 0U;
+            int64_t i64MTime = 0;
+
+            bool operator==(const FileStamp& other) const noexcept
+            {
+                return (u64Size == other.u64Size) && (i64MTime == other.i64MTime);
+            }
+        };
+
+        struct Entry
+        {
+            FileStamp sStamp;
+            std::shared_ptr<const CommCommandsType> shpEntries;
+            std::list<std::string>::iterator itLru;   ///< Position in Store::lstLru
+        };
+
+        struct Store
+        {
+            std::mutex mutex;
+            std::unordered_map<std::string, Entry> mapEntries;
+            std::list<std::string> lstLru;            ///< Keys, most recently used first
+            size_t szCapacity = PLUGIN_DEFAULT_SCRIPT_CACHE_ENTRIES;
+            uint64_t uEvictions = 0U;
+            std::atomic<uint64_t> uHits{0U};
+            std::atomic<uint64_t> uMisses{0U};
+        };
+
+        std::string m_strScriptPathName;
+        std::string m_strKey;
+        FileStamp m_sStamp;
+        bool m_bStamped = false;
+
+        /* canonical path, size and modification time of the script */
+        bool m_stampScript(std::string& strKey, FileStamp& sStamp) const
+        {
+            std::error_code ec;
+            const auto path = std::filesystem::canonical(m_strScriptPathName, ec);
+            if (ec) {
+                return false;
+            }
+            const auto size = std::filesystem::file_size(path, ec);
+            if (ec) {
+                return false;
+            }
+            const auto mtime = std::filesystem::last_write_time(path, ec);
+            if (ec) {
+                return false;
+            }
+
+            strKey = path.string();
+            sStamp.u64Size = static_cast<uint64_t>(size);
+            sStamp.i64MTime = static_cast<int64_t>(mtime.time_since_epoch().count());
+            return true;
+        }
+
+        /* drop the least recently used scripts beyond the capacity (store locked) */
+        static void m_evict(Store& store)
+        {
+            while (store.mapEntries.size() > store.szCapacity) {
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("Evicted:"); LOG_STRING(store.lstLru.back()));
+                store.mapEntries.erase(store.lstLru.back());
+                store.lstLru.pop_back();
+                ++store.uEvictions;
+            }
+        }
+
+        /* store shared by all the instances, lives until the module is unloaded */
+        static Store& m_getStore()
+        {
+            static Store s_store;
+            return s_store;
+        }
+};
+
+#endif // U_COMM_SCRIPT_CACHE_HPP
@@ -0,0 +1,167 @@
+/**
+ * @file    Test_CommScriptCache.cpp
+ * @brief   CommScriptCache (uCommScriptCache.hpp): a script is served from the store until
+ *          its size or modification time changes; the store keeps the most recently used
+ *          scripts within its capacity and a capacity of 0 turns it off
+ */
+
+#include "uCommScriptCache.hpp"
+#include "uTestCheck.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+static void writeFile(const std::string& strPath, const std::string& strText)
+{
+    std::ofstream file(strPath, std::ios::binary | std::ios::trunc);
+    file << strText;
+}
+
+// entries told apart by a macro
+static CommCommandsType entries(const std::string& strTag)
+{
+    CommCommandsType sEntries;
+    sEntries.mapMacros["TAG"] = strTag;
+    return sEntries;
+}
+
+// the lookup misses and the entries are stored
+static bool fill(const std::string& strPath, const std::string& strTag)
+{
+    CommCommandsType sLoaded;
+    CommScriptCache cache(strPath);
+    return !cache.loadScript(sLoaded) && cache.storeScript(entries(strTag));
+}
+
+// the lookup hits with the given entries
+static bool hit(const std::string& strPath, const std::string& strTag)
+{
+    CommCommandsType sLoaded;
+    return CommScriptCache(strPath).loadScript(sLoaded) && (strTag == sLoaded.mapMacros["TAG"]);
+}
+
+static void testInvalidation(const fs::path& dir)
+{
+    const std::string strScript = (dir / "script.txt").string();
+    writeFile(strScript, "> \"AT\\r\\n\" | \"OK\\r\\n\"\n");
+
+    UTEST_CHECK(fill(strScript, "first"));
+    UTEST_CHECK(hit(strScript, "first"));
+    UTEST_CHECK(hit((dir / "." / "script.txt").string(), "first")); // keyed by the canonical path
+
+    // the size changed
+    writeFile(strScript, "> \"ATI\\r\\n\" | \"OK\\r\\n\"\n");
+    UTEST_CHECK(!hit(strScript, "first"));
+    UTEST_CHECK(fill(strScript, "second"));
+    UTEST_CHECK(hit(strScript, "second"));
+
+    // same size, only the modification time changed
+    fs::last_write_time(strScript, fs::last_write_time(strScript) + std::chrono::seconds(10));
+    UTEST_CHECK(!hit(strScript, "second"));
+    UTEST_CHECK(fill(strScript, "third"));
+    UTEST_CHECK(hit(strScript, "third"));
+
+    // changed between the lookup and the store: not cached
+    {
+        CommCommandsType sLoaded;
+        CommScriptCache cache(strScript);
+        fs::last_write_time(strScript, fs::last_write_time(strScript) + std::chrono::seconds(10));
+        UTEST_CHECK(!cache.loadScript(sLoaded));
+        fs::last_write_time(strScript, fs::last_write_time(strScript) + std::chrono::seconds(10));
+        UTEST_CHECK(!cache.storeScript(entries("racing")));
+        UTEST_CHECK(!hit(strScript, "racing"));
+    }
+
+    // a missing script is never served
+    fs::remove(strScript);
+    UTEST_CHECK(!hit(strScript, "third"));
+    UTEST_CHECK(!CommScriptCache(strScript).storeScript(entries("missing")));
+}
+
+static void testCapacity(const fs::path& dir)
+{
+    const std::string strA = (dir / "a.txt").string();
+    const std::string strB = (dir / "b.txt").string();
+    const std::string strC = (dir / "c.txt").string();
+    writeFile(strA, "! 1 ms\n");
+    writeFile(strB, "! 2 ms\n");
+    writeFile(strC, "! 3 ms\n");
+
+    CommScriptCache::clear();
+    CommScriptCache::setCapacity(2U);
+    const uint64_t uEvictions = CommScriptCache::stats().uEvictions;
+
+    // the least recently used script is dropped first
+    UTEST_CHECK(fill(strA, "a") && fill(strB, "b"));
+    UTEST_CHECK(hit(strA, "a"));
+    UTEST_CHECK(fill(strC, "c"));
+    UTEST_CHECK(hit(strA, "a") && hit(strC, "c") && !hit(strB, "b"));
+    UTEST_CHECK(2U == CommScriptCache::stats().szEntries);
+    UTEST_CHECK(uEvictions + 1U == CommScriptCache::stats().uEvictions);
+
+    // lowering the capacity drops the extra scripts
+    CommScriptCache::setCapacity(1U);
+    UTEST_CHECK(1U == CommScriptCache::stats().szEntries);
+    UTEST_CHECK(hit(strC, "c") && !hit(strA, "a"));
+
+    // 0: off, nothing is looked up nor stored
+    CommScriptCache::setCapacity(0U);
+    UTEST_CHECK(0U == CommScriptCache::stats().szEntries);
+    {
+        CommCommandsType sLoaded;
+        CommScriptCache cache(strA);
+        UTEST_CHECK(!cache.loadScript(sLoaded) && !cache.storeScript(entries("a")));
+    }
+    UTEST_CHECK(0U == CommScriptCache::stats().szEntries);
+
+    // turned off between the lookup and the store
+    CommScriptCache::setCapacity(2U);
+    {
+        CommCommandsType sLoaded;
+        CommScriptCache cache(strA);
+        UTEST_CHECK(!cache.loadScript(sLoaded));
+        CommScriptCache::setCapacity(0U);
+        UTEST_CHECK(!cache.storeScript(entries("a")));
+    }
+    UTEST_CHECK(0U == CommScriptCache::stats().szEntries);
+}
+
+static void testConfigure()
+{
+    std::unordered_map<std::string, std::string> mapSettings;
+    CommScriptCache::setCapacity(PLUGIN_DEFAULT_SCRIPT_CACHE_ENTRIES);
+
+    UTEST_CHECK(CommScriptCache::configure(mapSettings)); // key absent: unchanged
+    UTEST_CHECK(PLUGIN_DEFAULT_SCRIPT_CACHE_ENTRIES == CommScriptCache::capacity());
+
+    mapSettings[PLUGIN_INI_SCRIPT_CACHE] = "4";
+    UTEST_CHECK(CommScriptCache::configure(mapSettings) && (4U == CommScriptCache::capacity()));
+
+    mapSettings[PLUGIN_INI_SCRIPT_CACHE] = "0";
+    UTEST_CHECK(CommScriptCache::configure(mapSettings) && (0U == CommScriptCache::capacity()));
+
+    mapSettings[PLUGIN_INI_SCRIPT_CACHE] = "many";
+    UTEST_CHECK(!CommScriptCache::configure(mapSettings) && (0U == CommScriptCache::capacity()));
+}
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_comm_script_cache";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    testInvalidation(dir);
+    testCapacity(dir);
+    testConfigure();
+
+    fs::remove_all(dir);
+
+    return utest::result("comm_script_cache");
+}
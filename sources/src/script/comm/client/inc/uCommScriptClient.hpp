@@ -11,12 +11,16 @@
 #include "uCommScriptCommandValidator.hpp"
 #include "uCommScriptValidator.hpp"
 #include "uCommScriptInterpreter.hpp"
+#include "uCommScriptCache.hpp"
 
 #include "uTimer.hpp"
 #include "uLogger.hpp"
+#include "uNumeric.hpp"
 
+#include <atomic>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 /////////////////////////////////////////////////////////////////////////////////
 //                            LOCAL DEFINITIONS                                //
@@ -36,6 +40,56 @@
 //                    CLASS DECLARATION / DEFINITION                           //
 /////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * @brief Settings of the comm scripts run from a module (a plugin library)
+ *
+ * The plugins apply their INI section at setParams() time: PLUGIN_INI_SCRIPT_WINDOW is
+ * the pipelining window of the clients built without an explicit one, PLUGIN_INI_SCRIPT_CACHE
+ * the capacity of the CommScriptCache.
+ */
+class CommScriptSettings
+{
+    public:
+
+        /**
+         * @brief Applies the keys present in the plugin settings
+         * @return false if a value is invalid
+         */
+        static bool configure(const std::unordered_map<std::string, std::string>& mapSettings)
+        {
+            bool bRetVal = CommScriptCache::configure(mapSettings);
+
+            auto it = mapSettings.find(PLUGIN_INI_SCRIPT_WINDOW);
+            if (it != mapSettings.end()) {
+                size_t szWindow = 0U;
+                if ((false == numeric::str2sizet(it->second, szWindow)) || (0U == szWindow)) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Invalid"); LOG_STRING(PLUGIN_INI_SCRIPT_WINDOW); LOG_STRING(it->second));
+                    return false;
+                }
+                m_getWindow().store(szWindow, std::memory_order_relaxed);
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("ScriptWindow :"); LOG_SIZET(szWindow));
+            }
+
+            return bRetVal;
+        }
+
+        /**
+         * @brief Requests sent ahead of their responses (1 = no pipelining)
+         */
+        static size_t window()
+        {
+            return m_getWindow().load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        static std::atomic<size_t>& m_getWindow()
+        {
+            static std::atomic<size_t> s_szWindow{PLUGIN_SCRIPT_DEFAULT_WINDOW};
+            return s_szWindow;
+        }
+};
+
 
 template <typename TDriver>
 class CommScriptClient
@@ -47,12 +101,14 @@ class CommScriptClient
             std::shared_ptr<const TDriver> shpDriver,
             size_t szMaxRecvSize = PLUGIN_DEFAULT_RECEIVE_SIZE,
             uint32_t u32DefaultTimeout = 5000,
-            size_t szDelay = PLUGIN_SCRIPT_DEFAULT_CMDS_DELAY
+            size_t szDelay = PLUGIN_SCRIPT_DEFAULT_CMDS_DELAY,
+            size_t szWindow = CommScriptSettings::window()
         )
             : m_shpCommScriptRunner(std::make_shared<CommScriptRunner<CommCommandsType, TDriver>>(
                 std::make_shared<ScriptReader>(strScriptPathName),
                 std::make_shared<CommScriptValidator>(std::make_shared<CommScriptCommandValidator>()),
-                std::make_shared<CommScriptInterpreter<TDriver>>(shpDriver, szMaxRecvSize, u32DefaultTimeout, szDelay)
+                std::make_shared<CommScriptInterpreter<TDriver>>(shpDriver, szMaxRecvSize, u32DefaultTimeout, szDelay, szWindow),
+                std::make_shared<CommScriptCache>(strScriptPathName)
             ))
         {}
 
@@ -13,10 +13,17 @@
 #include "uNumeric.hpp"
 #include "uTimer.hpp"
 #include "uFile.hpp"
+#include "uFileChunkReader.hpp"
+#include "uFileChunkWriter.hpp"
+#include "uStreamRegex.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <regex>
 #include <string>
 #include <memory>
+#include <span>
 #include <string_view>
 #include <filesystem>
 
@@ -38,6 +45,158 @@
 //                            CLASS DEFINITION                                 //
 /////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * @brief Receive side of a pipelined command
+ *
+ * Tells how many bytes the expected response still needs and checks them as they
+ * come, so a read never takes a byte of the responses queued behind it:
+ * exact data and sizes are read up to their length, tokens and lines byte by byte.
+ */
+class CommResponseMatcher
+{
+public:
+
+    enum class State
+    {
+        PENDING,   ///< More bytes are needed
+        MATCH,     ///< The response is complete and as expected
+        MISMATCH   ///< The response differs from the expected one
+    };
+
+    /**
+     * @param type Receive token type, one of the pipelinable ones
+     * @param payload The precompiled expected data or token
+     * @param szSize Number of bytes of a SIZEOF response, longest line otherwise
+     */
+    CommResponseMatcher(CommCommandTokenType type, const CommCommandPayload& payload, size_t szSize)
+        : m_type(type)
+        , m_payload(payload)
+        , m_szSize(szSize)
+        , m_bCheckLine((type == CommCommandTokenType::LINE) && !payload.vData.empty())
+    {
+        if ((m_type == CommCommandTokenType::LINE) && !m_payload.vData.empty() && (m_payload.vData.back() == '\0')) {
+            m_expected = std::span<const uint8_t>(m_payload.vData).first(m_payload.vData.size() - 1);
+        } else {
+            m_expected = std::span<const uint8_t>(m_payload.vData);
+        }
+    }
+
+    /**
+     * @brief Number of bytes to read next
+     */
+    size_t wanted() const
+    {
+        switch (m_type) {
+            case CommCommandTokenType::SIZEOF:
+                return m_szSize - m_szReceived;
+            case CommCommandTokenType::TOKEN_STRING:
+            case CommCommandTokenType::TOKEN_HEXSTREAM:
+            case CommCommandTokenType::LINE:
+                return 1;
+            default:
+                return m_expected.size() - m_szReceived;
+        }
+    }
+
+    /**
+     * @brief A response accepted by the matcher, fed to it by the dry runs
+     */
+    std::vector<uint8_t> sample() const
+    {
+        switch (m_type) {
+            case CommCommandTokenType::SIZEOF:
+                return std::vector<uint8_t>(m_szSize, 0U);
+            case CommCommandTokenType::TOKEN_STRING:
+            case CommCommandTokenType::TOKEN_HEXSTREAM:
+                return m_payload.vData;
+            case CommCommandTokenType::LINE: {
+                std::vector<uint8_t> vLine(m_expected.begin(), m_expected.end());
+                vLine.push_back('\n');
+                return vLine;
+            }
+            default:
+                return std::vector<uint8_t>(m_expected.begin(), m_expected.end());
+        }
+    }
+
+    /**
+     * @brief Check the next bytes, at most wanted() of them
+     */
+    State feed(std::span<const uint8_t> data)
+    {
+        switch (m_type) {
+            case CommCommandTokenType::SIZEOF:
+                m_szReceived += data.size();
+                return (m_szReceived == m_szSize) ? State::MATCH : State::PENDING;
+
+            case CommCommandTokenType::TOKEN_STRING:
+            case CommCommandTokenType::TOKEN_HEXSTREAM:
+                return feedToken(data);
+
+            case CommCommandTokenType::LINE:
+                return feedLine(data);
+
+            default:
+                if (!std::equal(data.begin(), data.end(), m_expected.begin() + m_szReceived)) {
+                    return State::MISMATCH;
+                }
+                m_szReceived += data.size();
+                return (m_szReceived == m_expected.size()) ? State::MATCH : State::PENDING;
+        }
+    }
+
+private:
+
+    CommCommandTokenType m_type;
+    const CommCommandPayload& m_payload;
+    std::span<const uint8_t> m_expected;
+    size_t m_szSize;
+    size_t m_szReceived = 0;
+    size_t m_szMatched = 0;
+    bool m_bCheckLine;
+    bool m_bLineDiffers = false;
+
+    /* KMP search of the token, the bytes before it are skipped as in ReadMode::UntilToken */
+    State feedToken(std::span<const uint8_t> data)
+    {
+        const auto& token = m_payload.vData;
+        const auto& lps = m_payload.viTokenLps;
+
+        if (token.empty() || (lps.size() != token.size())) {
+            return State::MISMATCH; // command not validated
+        }
+
+        for (uint8_t byte : data) {
+            while ((m_szMatched > 0) && (byte != token[m_szMatched])) {
+                m_szMatched = static_cast<size_t>(lps[m_szMatched - 1]);
+            }
+            if (byte == token[m_szMatched]) {
+                if (++m_szMatched == token.size()) {
+                    return State::MATCH;
+                }
+            }
+        }
+        return State::PENDING;
+    }
+
+    /* line content up to '\n', compared when an expected line is given */
+    State feedLine(std::span<const uint8_t> data)
+    {
+        for (uint8_t byte : data) {
+            if (byte == '\n') {
+                return (m_bLineDiffers || (m_bCheckLine && (m_szReceived != m_expected.size()))) ? State::MISMATCH : State::MATCH;
+            }
+            if (m_bCheckLine && ((m_szReceived >= m_expected.size()) || (m_expected[m_szReceived] != byte))) {
+                m_bLineDiffers = true;
+            }
+            if (++m_szReceived >= m_szSize) {
+                return State::MISMATCH; // no delimiter within the receive buffer
+            }
+        }
+        return State::PENDING;
+    }
+};
+
 /**
  * @brief Interprets and executes communication commands from scripts
  * 
@@ -47,6 +206,9 @@
  * - Multiple data formats (hex, string, file, token, etc.)
  * - Pattern matching and validation
  * - File transfers in chunks
+ *
+ * The data of the commands (bytes, token KMP tables, regex objects) is
+ * precompiled by CommScriptCommandValidator, only the I/O is done here.
  * 
  * @tparam TDriver The concrete driver type (must derive from ICommDriver)
  */
@@ -101,15 +263,15 @@ public:
         // Execute based on direction
         if (command.direction == CommCommandDirection::SEND_RECV) {
             // Send first, then receive
-            result = executeSend(command.values.first, command.tokens.first);
+            result = executeSend(command.values.first, command.tokens.first, command.payloads.first);
             if (result && command.tokens.second != CommCommandTokenType::EMPTY) {
-                result = executeReceive(command.values.second, command.tokens.second);
+                result = executeReceive(command.values.second, command.tokens.second, command.payloads.second);
             }
         } else if (command.direction == CommCommandDirection::RECV_SEND) {
             // Receive first, then send
-            result = executeReceive(command.values.first, command.tokens.first);
+            result = executeReceive(command.values.first, command.tokens.first, command.payloads.first);
             if (result && command.tokens.second != CommCommandTokenType::EMPTY) {
-                result = executeSend(command.values.second, command.tokens.second);
+                result = executeSend(command.values.second, command.tokens.second, command.payloads.second);
             }
         } else if (command.direction == CommCommandDirection::DELAY) {
             size_t szDelay = 0;
@@ -161,6 +323,168 @@ public:
         m_maxRecvSize = size;
     }
 
+    /**
+     * @brief True if the command can take part in a pipelined send window
+     *
+     * That is a SEND_RECV command whose response ends at a point known in advance:
+     * exact data (HEXSTREAM, non empty strings), a size (SIZEOF), a token or a line.
+     */
+    static bool isPipelinable(const CommCommand& command)
+    {
+        if ((command.direction != CommCommandDirection::SEND_RECV) ||
+            (command.tokens.first == CommCommandTokenType::EMPTY) ||
+            (command.tokens.first == CommCommandTokenType::FILENAME)) {
+            return false;
+        }
+
+        switch (command.tokens.second) {
+            case CommCommandTokenType::HEXSTREAM:
+            case CommCommandTokenType::STRING_DELIMITED:
+            case CommCommandTokenType::STRING_RAW:
+                return !command.payloads.second.vData.empty();
+            case CommCommandTokenType::SIZEOF:
+            case CommCommandTokenType::TOKEN_STRING:
+            case CommCommandTokenType::TOKEN_HEXSTREAM:
+            case CommCommandTokenType::LINE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief Send the request of a pipelinable command, its response is collected later by receiveResponse()
+     * @param command The parsed command, see isPipelinable()
+     * @return true if send successful, false otherwise
+     */
+    bool sendRequest(const CommCommand& command)
+    {
+        if (!m_driver || !m_driver->is_open()) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Driver not available or port not open"));
+            return false;
+        }
+        auto lineNr = ustring::fmtLineNr(command.iLineNumber);
+        LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING(lineNr.data());
+                  LOG_STRING("Send (pipelined):"); LOG_STRING(command.values.first));
+
+        if (!executeSend(command.values.first, command.tokens.first, command.payloads.first)) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("Comm command failed"));
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Collect and check the response of a command sent by sendRequest()
+     *
+     * Responses are collected in the order their requests were sent; each one gets
+     * the default timeout from the moment it is waited for.
+     *
+     * @param command The parsed command, see isPipelinable()
+     * @return true if the response was received and matches, false otherwise
+     */
+    bool receiveResponse(const CommCommand& command)
+    {
+        auto lineNr = ustring::fmtLineNr(command.iLineNumber);
+        const CommCommandTokenType type = command.tokens.second;
+        const bool bIsToken = (type == CommCommandTokenType::TOKEN_STRING) || (type == CommCommandTokenType::TOKEN_HEXSTREAM);
+
+        size_t szSize = 0;
+        if (!responseSize(command, szSize)) {
+            return false;
+        }
+
+        CommResponseMatcher matcher(type, command.payloads.second, szSize);
+        CommResponseMatcher::State state = CommResponseMatcher::State::PENDING;
+
+        ICommDriver::ReadOptions options;
+        options.mode = ICommDriver::ReadMode::Exact;
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_defaultTimeout);
+        uint32_t u32Timeout = m_defaultTimeout;
+        m_lastReceived.clear();
+
+        while (CommResponseMatcher::State::PENDING == state) {
+            // the bytes skipped while searching a token are not kept
+            if (bIsToken) {
+                m_lastReceived.clear();
+            }
+            const size_t szOffset = m_lastReceived.size();
+            m_lastReceived.resize(szOffset + matcher.wanted());
+
+            auto result = m_driver->tout_read(u32Timeout, std::span<uint8_t>(m_lastReceived).subspan(szOffset), options);
+
+            if ((result.status != ICommDriver::Status::SUCCESS) || (0 == result.bytes_read)) {
+                m_lastReceived.resize(szOffset);
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data());
+                          LOG_STRING("Response not received:");
+                          LOG_STRING(ICommDriver::to_string(result.status));
+                          LOG_STRING("expected:"); LOG_STRING(command.values.second));
+                return false;
+            }
+
+            m_lastReceived.resize(szOffset + result.bytes_read);
+            state = matcher.feed(std::span<const uint8_t>(m_lastReceived).subspan(szOffset));
+
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if ((CommResponseMatcher::State::PENDING == state) && (remaining.count() <= 0)) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data());
+                          LOG_STRING("Response incomplete within timeout, expected:"); LOG_STRING(command.values.second));
+                return false;
+            }
+            u32Timeout = static_cast<uint32_t>(std::max<int64_t>(remaining.count(), 0));
+        }
+
+        if (CommResponseMatcher::State::MISMATCH == state) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data());
+                      LOG_STRING("Response mismatch, expected:"); LOG_STRING(command.values.second);
+                      LOG_STRING("received:"); LOG_SIZET(m_lastReceived.size()); LOG_STRING("bytes"));
+            hexutils::logHexdump(LOG_ERROR, "Recv:", "SAoC", m_lastReceived);
+            return false;
+        }
+
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data());
+                  LOG_STRING("Response ok:"); LOG_STRING(command.values.second));
+        return true;
+    }
+
+    /**
+     * @brief Dry run of receiveResponse(): the response the command expects is fed to its matcher
+     *
+     * No I/O is done; a response the matcher could never accept, e.g. a size or an
+     * expected line that does not fit the receive buffer, fails here instead of
+     * in the middle of a window of outstanding requests.
+     *
+     * @param command The parsed command, see isPipelinable()
+     * @return true if the expected response is matched, false otherwise
+     */
+    bool checkResponse(const CommCommand& command) const
+    {
+        size_t szSize = 0;
+        if (!responseSize(command, szSize)) {
+            return false;
+        }
+
+        CommResponseMatcher matcher(command.tokens.second, command.payloads.second, szSize);
+        CommResponseMatcher::State state = CommResponseMatcher::State::PENDING;
+        const std::vector<uint8_t> vResponse = matcher.sample();
+        std::span<const uint8_t> remaining(vResponse);
+
+        while ((CommResponseMatcher::State::PENDING == state) && !remaining.empty()) {
+            const size_t szChunk = std::min(matcher.wanted(), remaining.size());
+            state = matcher.feed(remaining.first(szChunk));
+            remaining = remaining.subspan(szChunk);
+        }
+
+        if (CommResponseMatcher::State::MATCH != state) {
+            auto lineNr = ustring::fmtLineNr(command.iLineNumber);
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data());
+                      LOG_STRING("Response cannot be matched, expected:"); LOG_STRING(command.values.second));
+            return false;
+        }
+        return true;
+    }
+
 private:
 
     std::shared_ptr<const TDriver> m_driver;
@@ -168,13 +492,28 @@ private:
     uint32_t m_defaultTimeout;
     std::vector<uint8_t> m_lastReceived;
 
+    /* bytes of a SIZEOF response, the longest response otherwise */
+    bool responseSize(const CommCommand& command, size_t& szSize) const
+    {
+        szSize = m_maxRecvSize;
+        if (command.tokens.second == CommCommandTokenType::SIZEOF) {
+            if (!numeric::str2sizet(command.values.second, szSize) || (szSize == 0) || (szSize > m_maxRecvSize)) {
+                auto lineNr = ustring::fmtLineNr(command.iLineNumber);
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("Size out of range:"); LOG_STRING(command.values.second));
+                return false;
+            }
+        }
+        return true;
+    }
+
     /**
      * @brief Execute a send operation
      * @param value The data value to send (string representation)
      * @param type The token type indicating how to interpret the value
+     * @param payload The precompiled data to send
      * @return true if send successful, false otherwise
      */
-    bool executeSend(const std::string& value, CommCommandTokenType type)
+    bool executeSend(const std::string& value, CommCommandTokenType type, const CommCommandPayload& payload)
     {
         // Empty token means no send operation
         if (type == CommCommandTokenType::EMPTY) {
@@ -191,16 +530,14 @@ private:
             return sendFile(value);
         }
 
-        // Convert value to bytes based on type
-        std::vector<uint8_t> data;
-        if (!convertToData(value, type, data)) {
+        if (payload.vData.empty()) {
             LOG_PRINT(LOG_ERROR, LOG_HDR; 
-                      LOG_STRING("Failed to convert data for send"));
+                      LOG_STRING("No data to send, command not validated"));
             return false;
         }
 
         // Send the data
-        auto result = m_driver->tout_write(m_defaultTimeout, std::span<const uint8_t>(data));
+        auto result = m_driver->tout_write(m_defaultTimeout, std::span<const uint8_t>(payload.vData));
         
         if (result.status != ICommDriver::Status::SUCCESS) {
             LOG_PRINT(LOG_ERROR, LOG_HDR; 
@@ -220,9 +557,10 @@ private:
      * @brief Execute a receive operation
      * @param value The expected data value or pattern (string representation)
      * @param type The token type indicating how to interpret the value
+     * @param payload The precompiled expected data, token or pattern
      * @return true if receive successful and data matches expectation, false otherwise
      */
-    bool executeReceive(const std::string& value, CommCommandTokenType type)
+    bool executeReceive(const std::string& value, CommCommandTokenType type, const CommCommandPayload& payload)
     {
         // Empty token means no receive operation
         if (type == CommCommandTokenType::EMPTY) {
@@ -236,19 +574,17 @@ private:
 
         switch (type) {
             case CommCommandTokenType::REGEX:
-                return receiveAndMatchRegex(value);
+                return receiveAndMatchRegex(payload);
 
             case CommCommandTokenType::TOKEN_STRING:
-                return receiveUntilToken(value);
-
             case CommCommandTokenType::TOKEN_HEXSTREAM:
-                return receiveUntilToken(value, true);
+                return receiveUntilToken(payload);
 
             case CommCommandTokenType::SIZEOF:
                 return receiveExactSize(value);
 
             case CommCommandTokenType::LINE:
-                return receiveUntilDelimiter('\n', value);
+                return receiveUntilDelimiter('\n', payload);
 
             case CommCommandTokenType::FILENAME:
                 return receiveToFile(value);
@@ -257,7 +593,7 @@ private:
             case CommCommandTokenType::STRING_DELIMITED:
             case CommCommandTokenType::STRING_DELIMITED_EMPTY:
             case CommCommandTokenType::STRING_RAW:
-                return receiveAndCompare(value, type);
+                return receiveAndCompare(payload);
 
             case CommCommandTokenType::ANYTHING:
                 return receiveAndHexdump(value);
@@ -270,68 +606,88 @@ private:
 
     /**
      * @brief Receive data and match against regex pattern
+     *
+     * The bytes are fed to the matcher as they arrive, so a response split over several
+     * reads is matched as a whole within the default timeout. The receive ends once the
+     * bytes match and no more are pending (or the match cannot grow), or as soon as
+     * (DFA patterns only) they can no longer match.
      */
-    bool receiveAndMatchRegex(const std::string& pattern)
+    bool receiveAndMatchRegex(const CommCommandPayload& payload)
     {
-        // Read exact bytes from driver
+        if (!payload.shpRegex) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Regex pattern not compiled, command not validated"));
+            return false;
+        }
+
+        uregex::StreamMatcher matcher(payload.shpDfa.get(), payload.shpRegex.get());
+        uregex::MatchState state = uregex::MatchState::PARTIAL;
+
         m_lastReceived.resize(m_maxRecvSize);
         ICommDriver::ReadOptions options;
         options.mode = ICommDriver::ReadMode::Exact;
 
-        auto result = m_driver->tout_read(m_defaultTimeout, 
-                                          std::span<uint8_t>(m_lastReceived), 
-                                          options);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_defaultTimeout);
+        uint32_t u32Timeout = m_defaultTimeout;
+        size_t szReceived = 0;
 
-        if (result.status != ICommDriver::Status::SUCCESS) {
-            LOG_PRINT(LOG_ERROR, LOG_HDR; 
-                      LOG_STRING("Read failed:"); 
-                      LOG_STRING(ICommDriver::to_string(result.status)));
-            return false;
+        while ((uregex::MatchState::NO_MATCH != state) && (szReceived < m_lastReceived.size())) {
+            // once matched only the bytes already pending are taken
+            if (uregex::MatchState::MATCH == state) {
+                if (!matcher.canExtend()) {
+                    break;
+                }
+                u32Timeout = 0;
+            }
+
+            std::span<uint8_t> chunk(m_lastReceived.data() + szReceived, m_lastReceived.size() - szReceived);
+            auto result = m_driver->tout_read(u32Timeout, chunk, options);
+
+            if ((result.status != ICommDriver::Status::SUCCESS) || (0 == result.bytes_read)) {
+                // a timeout once some bytes arrived is reported as a mismatch below
+                if (0 == szReceived) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR;
+                              LOG_STRING("Read failed:");
+                              LOG_STRING(ICommDriver::to_string(result.status)));
+                    return false;
+                }
+                break;
+            }
+
+            state = matcher.feed(chunk.first(result.bytes_read));
+            szReceived += result.bytes_read;
+
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) {
+                break;
+            }
+            u32Timeout = static_cast<uint32_t>(remaining.count());
         }
 
         // Resize to actual bytes read
-        m_lastReceived.resize(result.bytes_read);
+        m_lastReceived.resize(szReceived);
 
-        // Convert to string for regex matching
-        std::string received(m_lastReceived.begin(), m_lastReceived.end());
+        bool matched = (uregex::MatchState::MATCH == state);
 
-        // Match against pattern
-        try {
-            std::regex re(pattern);
-            bool matched = std::regex_match(received, re);
-            
-            if (!matched) {
-                LOG_PRINT(LOG_ERROR, LOG_HDR; 
-                          LOG_STRING("Regex match failed. Received:"); 
-                          LOG_STRING(received));
-            }
-            
-            return matched;
-        } catch (const std::regex_error& e) {
-            LOG_PRINT(LOG_ERROR, LOG_HDR; 
-                      LOG_STRING("Invalid regex pattern:"); 
-                      LOG_STRING(e.what()));
-            return false;
+        if (!matched) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR;
+                      LOG_STRING("Regex match failed. Received:");
+                      LOG_STRING(std::string(m_lastReceived.begin(), m_lastReceived.end())));
         }
+
+        return matched;
     }
 
     /**
      * @brief Receive data until a specific token is found
      */
-    bool receiveUntilToken(const std::string& tokenStr, bool isHexStream = false)
+    bool receiveUntilToken(const CommCommandPayload& payload)
     {
-        // Convert token string to bytes
-        std::vector<uint8_t> token;
-        if (!convertToData(tokenStr, (isHexStream ? CommCommandTokenType::TOKEN_HEXSTREAM : CommCommandTokenType::TOKEN_STRING), token)) {
-            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Failed to convert token"));
-            return false;
-        }
-
-        // Setup read options for token search
+        // Setup read options for token search, with the precomputed KMP table
         m_lastReceived.resize(m_maxRecvSize);
         ICommDriver::ReadOptions options;
         options.mode = ICommDriver::ReadMode::UntilToken;
-        options.token = std::span<const uint8_t>(token);
+        options.token = std::span<const uint8_t>(payload.vData);
+        options.token_lps = std::span<const int>(payload.viTokenLps);
         options.use_buffer = true;
 
         auto result = m_driver->tout_read(m_defaultTimeout, 
@@ -394,7 +750,7 @@ private:
     /**
      * @brief Receive data until delimiter character
      */
-    bool receiveUntilDelimiter(uint8_t delimiter, const std::string& expectedStr)
+    bool receiveUntilDelimiter(uint8_t delimiter, const CommCommandPayload& payload)
     {
         m_lastReceived.resize(m_maxRecvSize);
         ICommDriver::ReadOptions options;
@@ -415,23 +771,18 @@ private:
         m_lastReceived.resize(result.bytes_read);
 
         // If no expected string provided, just return success
-        if (expectedStr.empty()) {
+        if (payload.vData.empty()) {
             LOG_PRINT(LOG_VERBOSE, LOG_HDR; 
                       LOG_STRING("Received line:"); LOG_SIZET(result.bytes_read); 
                       LOG_STRING("bytes"));
             return true;
         }
 
-        // Compare with expected (add newline to expected for comparison)
-        std::vector<uint8_t> expected;
-        if (!convertToData(expectedStr, CommCommandTokenType::LINE, expected)) {
-            return false;
-        }
-
         // Note: m_lastReceived won't have the delimiter, but expected will have '\0'
         // added by the driver when the expected delimiter was encontered
+        std::span<const uint8_t> expected(payload.vData);
         if (expected.size() > 0 && expected.back() == '\0') {
-            expected.pop_back();
+            expected = expected.first(expected.size() - 1);
         }
 
         bool matched = std::equal(m_lastReceived.begin(), m_lastReceived.end(), 
@@ -447,7 +798,7 @@ private:
     /**
      * @brief Receive data and compare with expected value
      */
-    bool receiveAndCompare(const std::string& expectedStr, CommCommandTokenType type)
+    bool receiveAndCompare(const CommCommandPayload& payload)
     {
         // First receive the data
         m_lastReceived.resize(m_maxRecvSize);
@@ -466,13 +817,7 @@ private:
         }
 
         m_lastReceived.resize(result.bytes_read);
-
-        // Convert expected string to bytes
-        std::vector<uint8_t> expected;
-        if (!convertToData(expectedStr, type, expected)) {
-            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Failed to convert expected data"));
-            return false;
-        }
+        const std::vector<uint8_t>& expected = payload.vData;
 
         // Compare
         bool matched = (result.bytes_read == expected.size()) &&
@@ -517,6 +862,9 @@ private:
     /**
      * @brief Send file in chunks
      * Format: "filename" or "filename,chunksize"
+     *
+     * The file is memory mapped and each chunk is written to the driver straight
+     * from the mapping; the kernel reads ahead while the previous chunk is sent.
      */
     bool sendFile(const std::string& fileSpec)
     {
@@ -529,7 +877,7 @@ private:
 
         // Parse chunk size if provided
         if (!parts.second.empty()) {
-            if (!numeric::str2sizet(parts.second, chunkSize)) {
+            if (!numeric::str2sizet(parts.second, chunkSize) || (0 == chunkSize)) {
                 LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Invalid chunk size:"); LOG_STRING(parts.second));
                 return false;
             }
@@ -549,47 +897,47 @@ private:
                   LOG_STRING("Size:"); LOG_UINT64(fileSize);
                   LOG_STRING("Chunk:"); LOG_SIZET(chunkSize));
 
-        // Open file
-        std::ifstream file(filepath, std::ios::binary);
-        if (!file) {
-            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Failed to open file:"); LOG_STRING(filepath));
-            return false;
-        }
-
         // Send file in chunks
-        std::vector<uint8_t> chunk(chunkSize);
+        const auto tStart = std::chrono::steady_clock::now();
         size_t totalSent = 0;
+        bool bSent = true;
+
+        auto sendChunk = [&](std::span<const uint8_t> chunk, std::shared_ptr<const TDriver> shpDriver) -> bool {
+            auto result = shpDriver->tout_write(m_defaultTimeout, chunk);
 
-        while (file) {
-            file.read(reinterpret_cast<char*>(chunk.data()), chunkSize);
-            std::streamsize bytesRead = file.gcount();
+            if (result.status != ICommDriver::Status::SUCCESS) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; 
+                          LOG_STRING("File write failed at offset:"); 
+                          LOG_SIZET(totalSent);
+                          LOG_STRING("Status:"); 
+                          LOG_STRING(ICommDriver::to_string(result.status)));
+                bSent = false;
+                return false;
+            }
 
-            if (bytesRead > 0) {
-                std::span<const uint8_t> dataSpan(chunk.data(), bytesRead);
-                auto result = m_driver->tout_write(m_defaultTimeout, dataSpan);
+            totalSent += result.bytes_written;
+            return true;
+        };
 
-                if (result.status != ICommDriver::Status::SUCCESS) {
-                    LOG_PRINT(LOG_ERROR, LOG_HDR; 
-                              LOG_STRING("File write failed at offset:"); 
-                              LOG_SIZET(totalSent);
-                              LOG_STRING("Status:"); 
-                              LOG_STRING(ICommDriver::to_string(result.status)));
-                    return false;
-                }
+        if (!ufile::FileChunkReader<TDriver>::read(filepath, chunkSize, sendChunk, m_driver)) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Failed to open file:"); LOG_STRING(filepath));
+            return false;
+        }
 
-                totalSent += result.bytes_written;
-            }
+        if (!bSent) {
+            return false;
         }
 
-        LOG_PRINT(LOG_VERBOSE, LOG_HDR; 
-                  LOG_STRING("File sent successfully. Total:"); 
-                  LOG_SIZET(totalSent); LOG_STRING("bytes"));
+        logTransfer("File sent:", totalSent, tStart);
         return true;
     }
 
     /**
      * @brief Receive data to file
      * Format: "filename" or "filename,expected_size" or "filename,expected_size,chunksize"
+     *
+     * The chunks are written to the file by a dedicated thread (triple buffered),
+     * so the next device read is issued while the previous chunk goes to the disk.
      */
     bool receiveToFile(const std::string& fileSpec)
     {
@@ -616,7 +964,7 @@ private:
 
         // Parse optional chunk size
         if (parts.size() > 2 && !parts[2].empty()) {
-            if (!numeric::str2sizet(parts[2], chunkSize)) {
+            if (!numeric::str2sizet(parts[2], chunkSize) || (0 == chunkSize)) {
                 LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Invalid chunk size:"); LOG_STRING(parts[2]));
                 return false;
             }
@@ -627,16 +975,17 @@ private:
                   LOG_STRING("Expected:"); LOG_SIZET(expectedSize);
                   LOG_STRING("Chunk:"); LOG_SIZET(chunkSize));
 
-        // Open output file
-        std::ofstream file(filepath, std::ios::binary);
-        if (!file) {
+        // Open output file, started with its writer thread
+        ufile::FileChunkWriter writer(chunkSize);
+        if (!writer.open(filepath)) {
             LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Failed to create file:"); LOG_STRING(filepath));
             return false;
         }
 
         // Receive file in chunks
-        std::vector<uint8_t> chunk(chunkSize);
+        const auto tStart = std::chrono::steady_clock::now();
         size_t totalReceived = 0;
+        bool bReceived = true;
         ICommDriver::ReadOptions options;
         options.mode = ICommDriver::ReadMode::Exact;
 
@@ -648,11 +997,17 @@ private:
                 if (bytesToRead == 0) break; // All expected data received
             }
 
+            // Free buffer, waits while all of them are queued for writing
+            std::span<uint8_t> chunk = writer.acquire();
+            if (chunk.empty()) {
+                break; // write failure, reported by close()
+            }
+
             // Read chunk
-            std::span<uint8_t> buffer(chunk.data(), bytesToRead);
-            auto result = m_driver->tout_read(m_defaultTimeout, buffer, options);
+            auto result = m_driver->tout_read(m_defaultTimeout, chunk.first(bytesToRead), options);
 
             if (result.status != ICommDriver::Status::SUCCESS) {
+                writer.commit(0);
                 // Check if we've received all expected data
                 if (expectedSize > 0 && totalReceived == expectedSize) {
                     break;
@@ -660,20 +1015,17 @@ private:
                 LOG_PRINT(LOG_ERROR, LOG_HDR; 
                           LOG_STRING("File read failed:"); 
                           LOG_STRING(ICommDriver::to_string(result.status)));
-                return false;
+                bReceived = false;
+                break;
             }
 
+            // Hand the chunk to the writer thread
+            writer.commit(result.bytes_read);
+
             if (result.bytes_read == 0) {
                 break; // No more data
             }
 
-            // Write to file
-            file.write(reinterpret_cast<const char*>(chunk.data()), result.bytes_read);
-            if (!file) {
-                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("File write failed"));
-                return false;
-            }
-
             totalReceived += result.bytes_read;
 
             // Stop if we've received expected amount
@@ -682,77 +1034,34 @@ private:
             }
         }
 
-        LOG_PRINT(LOG_VERBOSE, LOG_HDR; 
-                  LOG_STRING("File received successfully. Total:"); 
-                  LOG_SIZET(totalReceived); LOG_STRING("bytes"));
-        return true;
-    }
+        if (!writer.close()) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; 
+                      LOG_STRING("File write failed after"); 
+                      LOG_UINT64(writer.bytesWritten()); LOG_STRING("bytes"));
+            return false;
+        }
 
-    /**
-     * @brief Convert string value to data bytes based on token type
-     */
-    bool convertToData(const std::string& value, 
-                      CommCommandTokenType type, 
-                      std::vector<uint8_t>& data) const
-    {
-        switch (type) {
-            case CommCommandTokenType::HEXSTREAM:
-                return hexutils::hexstringToVector(value, data);
-            case CommCommandTokenType::LINE:                
-            case CommCommandTokenType::STRING_RAW:
-            case CommCommandTokenType::STRING_DELIMITED:
-            case CommCommandTokenType::STRING_DELIMITED_EMPTY:
-                return ustring::stringToVector(expandEscapes(value), data);
-            case CommCommandTokenType::TOKEN_STRING:
-                return ustring::stringToVector(expandEscapes(value), data, false);
-            case CommCommandTokenType::TOKEN_HEXSTREAM:
-                return hexutils::stringUnhexlify(value, data);
-            default:
-                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Unsupported token type for data conversion"));
-                return false;
+        if (!bReceived) {
+            return false;
         }
+
+        logTransfer("File received:", totalReceived, tStart);
+        return true;
     }
 
     /**
-     * @brief Expand literal escape sequences into their actual byte values
-     * @param value Input string possibly containing literal \r and \n sequences
-     * @return String with \r replaced by 0x0D and \n replaced by 0x0A
-     * 
-     * Handles:
-     *   \r        → 0x0D
-     *   \n        → 0x0A
-     *   \r\n      → 0x0D 0x0A
-     *   \\r \\n   → left as-is (escaped backslash)
+     * @brief Report the size, duration and throughput of a file transfer
      */
-    std::string expandEscapes(const std::string& value) const
+    static void logTransfer(const char *pstrWhat, uint64_t u64Bytes, std::chrono::steady_clock::time_point tStart)
     {
-        std::string result;
-        result.reserve(value.size());
-
-        for (size_t i = 0; i < value.size(); ++i) {
-            if (value[i] == '\\' && (i + 1) < value.size()) {
-                switch (value[i + 1]) {
-                    case 'r':
-                        result += '\r';     // 0x0D
-                        ++i;
-                        continue;
-                    case 'n':
-                        result += '\n';     // 0x0A
-                        ++i;
-                        continue;
-                    case '\\':
-                        result += '\\';    // escaped backslash → keep one
-                        ++i;
-                        continue;
-                    default:
-                        break;
-                }
-            }
-            result += value[i];
-        }
+        const double dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+        const uint64_t u64Rate = (dSeconds > 0.0) ? static_cast<uint64_t>(static_cast<double>(u64Bytes) / dSeconds) : 0U;
 
-        return result;
-    }    
+        LOG_PRINT(LOG_INFO, LOG_HDR; 
+                  LOG_STRING(pstrWhat); LOG_UINT64(u64Bytes); LOG_STRING("bytes in");
+                  LOG_UINT64(static_cast<uint64_t>(dSeconds * 1000.0)); LOG_STRING("ms,");
+                  LOG_UINT64(u64Rate); LOG_STRING("B/s"));
+    }
 };
 
 #endif // U_COMM_SCRIPT_COMMAND_INTERPRETER_HPP
@@ -10,14 +10,18 @@
 #include "uFile.hpp"
 #include "uNumeric.hpp"
 #include "uFileChunkReader.hpp"
+#include "uStreamRegex.hpp"
 #include "uLogger.hpp"
 
 #include <cctype>
+#include <memory>
 #include <regex>
+#include <span>
 #include <string>
 #include <utility>
 #include <string_view>
 #include <algorithm>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////////////////
 //                            LOCAL DEFINITIONS                                //
@@ -56,6 +60,9 @@
  *   S"256"           - Size (validated numeric)
  *   "hello"          - Delimited string
  *   raw_string       - Raw string (no quotes)
+ *
+ * The data of the expressions is precompiled into CommCommand::payloads (bytes,
+ * token KMP tables, regex objects) so that the interpreter only does the I/O.
  */
 class CommScriptCommandValidator : public IScriptCommandValidator<CommCommand>
 {
@@ -130,7 +137,7 @@ class CommScriptCommandValidator : public IScriptCommandValidator<CommCommand>
                     }
 
                     result.values = std::make_pair(field1, field2);
-                    return evaluateAndValidate(result, separatorFound);
+                    return evaluateAndValidate(result, separatorFound) && compilePayloads(result);
 
                 } /* parse() */
 
@@ -366,7 +373,139 @@ class CommScriptCommandValidator : public IScriptCommandValidator<CommCommand>
                     }
 
                     return true;
-                }        
+                }
+
+                /**
+                 * @brief Precompile the data of both expressions of a validated command
+                 * @param command Validated command, its payloads are filled in
+                 * @return true if the data of both expressions could be built
+                 */
+                bool compilePayloads(CommCommand& command) const
+                {
+                    /* delay values are a number and a unit, nothing to send or receive */
+                    if (command.direction == CommCommandDirection::DELAY) {
+                        return true;
+                    }
+
+                    return compilePayload(command.values.first, command.tokens.first, command.payloads.first) &&
+                           compilePayload(command.values.second, command.tokens.second, command.payloads.second);
+                }
+
+                /**
+                 * @brief Build the bytes, the token failure table or the regex object of an expression
+                 * @param value Expression value (undecorated)
+                 * @param type Expression token type
+                 * @param payload Output precompiled expression
+                 * @return true if the expression could be compiled
+                 */
+                bool compilePayload(const std::string& value, CommCommandTokenType type, CommCommandPayload& payload) const
+                {
+                    switch (type) {
+                        case CommCommandTokenType::HEXSTREAM:
+                            return hexutils::hexstringToVector(value, payload.vData);
+
+                        case CommCommandTokenType::LINE:
+                        case CommCommandTokenType::STRING_RAW:
+                        case CommCommandTokenType::STRING_DELIMITED:
+                        case CommCommandTokenType::STRING_DELIMITED_EMPTY:
+                            return ustring::stringToVector(expandEscapes(value), payload.vData);
+
+                        case CommCommandTokenType::TOKEN_STRING:
+                            ustring::stringToVector(expandEscapes(value), payload.vData, false);
+                            buildTokenLps(payload.vData, payload.viTokenLps);
+                            return true;
+
+                        case CommCommandTokenType::TOKEN_HEXSTREAM:
+                            if (!hexutils::stringUnhexlify(value, payload.vData)) {
+                                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Invalid hex token:"); LOG_STRING(value));
+                                return false;
+                            }
+                            buildTokenLps(payload.vData, payload.viTokenLps);
+                            return true;
+
+                        case CommCommandTokenType::REGEX:
+                            try {
+                                payload.shpRegex = std::make_shared<const std::regex>(value, std::regex::ECMAScript | std::regex::optimize);
+                            } catch (const std::regex_error& e) {
+                                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Invalid regex pattern:"); LOG_STRING(value); LOG_STRING(e.what()));
+                                return false;
+                            }
+                            /* matched while the bytes arrive if the pattern fits the DFA subset */
+                            if (auto dfa = uregex::ByteDfa::compile(value)) {
+                                payload.shpDfa = std::make_shared<const uregex::ByteDfa>(std::move(*dfa));
+                                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("Regex streamed, DFA states:"); LOG_SIZET(payload.shpDfa->stateCount()); LOG_STRING(value));
+                            } else {
+                                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("Regex outside the streamable subset, matched on the whole response:"); LOG_STRING(value));
+                            }
+                            return true;
+
+                        default:
+                            /* EMPTY, ANYTHING, SIZEOF and FILENAME carry no data */
+                            return true;
+                    }
+                }
+
+                /**
+                 * @brief Build the KMP failure table of a token
+                 * @param token Token bytes
+                 * @param viLps Output table, longest proper prefix which is also a suffix for each position
+                 */
+                static void buildTokenLps(std::span<const uint8_t> token, std::vector<int>& viLps)
+                {
+                    viLps.assign(token.size(), 0);
+                    int len = 0;
+
+                    for (size_t i = 1; i < token.size(); ) {
+                        if (token[i] == token[static_cast<size_t>(len)]) {
+                            viLps[i++] = ++len;
+                        } else if (len != 0) {
+                            len = viLps[static_cast<size_t>(len) - 1];
+                        } else {
+                            viLps[i++] = 0;
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Expand literal escape sequences into their actual byte values
+                 * @param value Input string possibly containing literal \r and \n sequences
+                 * @return String with \r replaced by 0x0D and \n replaced by 0x0A
+                 * 
+                 * Handles:
+                 *   \r        → 0x0D
+                 *   \n        → 0x0A
+                 *   \r\n      → 0x0D 0x0A
+                 *   \\r \\n   → left as-is (escaped backslash)
+                 */
+                static std::string expandEscapes(const std::string& value)
+                {
+                    std::string result;
+                    result.reserve(value.size());
+
+                    for (size_t i = 0; i < value.size(); ++i) {
+                        if (value[i] == '\\' && (i + 1) < value.size()) {
+                            switch (value[i + 1]) {
+                                case 'r':
+                                    result += '\r';     // 0x0D
+                                    ++i;
+                                    continue;
+                                case 'n':
+                                    result += '\n';     // 0x0A
+                                    ++i;
+                                    continue;
+                                case '\\':
+                                    result += '\\';    // escaped backslash → keep one
+                                    ++i;
+                                    continue;
+                                default:
+                                    break;
+                            }
+                        }
+                        result += value[i];
+                    }
+
+                    return result;
+                }
 
         }; /* class ItemParser */
 
@@ -3,11 +3,16 @@
 
 #include "uSharedConfig.hpp"
 
+#include <cstdint>
+#include <memory>
+#include <regex>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <utility>
 
+namespace uregex { class ByteDfa; }
+
 /**
  * @brief Direction of command execution
  */
@@ -39,6 +44,17 @@ enum class CommCommandTokenType
     INVALID                  ///< Unrecognized or malformed token
 };
 
+/**
+ * @brief Expression precompiled by the validator, the interpreter only does the I/O with it
+ */
+struct CommCommandPayload
+{
+    std::vector<uint8_t> vData;                 ///< Bytes to send, to compare with or the token to wait for
+    std::vector<int> viTokenLps;                ///< KMP failure table of a TOKEN_STRING / TOKEN_HEXSTREAM token
+    std::shared_ptr<const std::regex> shpRegex; ///< Compiled REGEX pattern
+    std::shared_ptr<const uregex::ByteDfa> shpDfa; ///< REGEX pattern as a byte DFA, null if outside the streamable subset
+};
+
 /**
  * @brief Script token structure containing parsed command information
  */
@@ -47,6 +63,7 @@ struct CommCommand
     CommCommandDirection direction;                               ///< Send-Recv or Recv-Send
     std::pair<std::string, std::string> values;                   ///< First and second expression values
     std::pair<CommCommandTokenType, CommCommandTokenType> tokens; ///< First and second expression token types
+    std::pair<CommCommandPayload, CommCommandPayload> payloads;   ///< First and second expression precompiled
     int iLineNumber;
 
     CommCommand()
@@ -9,7 +9,9 @@
 #include "uLogger.hpp"
 #include "uTimer.hpp"
 
+#include <algorithm>
 #include <string>
+#include <deque>
 #include <memory>
 #include <queue>
 
@@ -42,18 +44,21 @@ class CommScriptInterpreter : public ICommScriptInterpreter<CommCommandsType, TD
          * @param szMaxRecvSize Maximum buffer size for receive operations
          * @param u32DefaultTimeout Default timeout in milliseconds
          * @param szDelay Delay in milliseconds between command executions
+         * @param szWindow Number of requests sent ahead of their responses (1 = no pipelining)
          */
         explicit CommScriptInterpreter(
             std::shared_ptr<const TDriver> shpDriver, 
             size_t szMaxRecvSize = PLUGIN_DEFAULT_RECEIVE_SIZE,
             uint32_t u32DefaultTimeout = 5000,
-            size_t szDelay = 0)
+            size_t szDelay = 0,
+            size_t szWindow = 1)
             : m_shpCommandInterpreter(std::make_shared<CommScriptCommandInterpreter<TDriver>>(
                 shpDriver, 
                 szMaxRecvSize, 
                 u32DefaultTimeout
               ))
             , m_szDelay(szDelay)
+            , m_szWindow(std::max<size_t>(szWindow, 1))
         {}
 
         bool interpretScript (CommCommandsType& sScriptEntries, bool bRealExec) override
@@ -63,10 +68,15 @@ class CommScriptInterpreter : public ICommScriptInterpreter<CommCommandsType, TD
             /* dry validation */
             if (false == bRealExec)
             {            
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("Push script entries in FIFO"));
+                /* a pipelined script is walked as it will run, each queued response checked by its matcher */
+                if (m_szWindow > 1) {
+                    bRetVal = m_runPipelined(sScriptEntries.vCommands, false);
+                }
 
-                /* nothing to validate for the comm scripts, just push the script entries in a queue */
-                m_getPendingScripts().push(sScriptEntries.vCommands);
+                if (true == bRetVal) {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("Push script entries in FIFO"));
+                    m_getPendingScripts().push(sScriptEntries.vCommands);
+                }
             }
             else
             {
@@ -79,12 +89,16 @@ class CommScriptInterpreter : public ICommScriptInterpreter<CommCommandsType, TD
                 const auto vCommands = std::move(m_getPendingScripts().front());
                 m_getPendingScripts().pop();
 
-                for (const auto& command : vCommands) {
-                    if (false == m_shpCommandInterpreter->interpretCommand(command, bRealExec)) {
-                        bRetVal = false;
-                        break;
+                if (m_szWindow > 1) {
+                    bRetVal = m_runPipelined(vCommands, true);
+                } else {
+                    for (const auto& command : vCommands) {
+                        if (false == m_shpCommandInterpreter->interpretCommand(command, bRealExec)) {
+                            bRetVal = false;
+                            break;
+                        }
+                        utime::delay_ms(m_szDelay);
                     }
-                    utime::delay_ms(m_szDelay);
                 }
             }
 
@@ -99,6 +113,50 @@ class CommScriptInterpreter : public ICommScriptInterpreter<CommCommandsType, TD
         
         std::shared_ptr<CommScriptCommandInterpreter<TDriver>> m_shpCommandInterpreter;
         size_t m_szDelay;
+        size_t m_szWindow;
+
+        /**
+         * @brief Real execution with up to m_szWindow requests sent ahead of their responses
+         *
+         * Pipelinable commands (see CommScriptCommandInterpreter::isPipelinable) only send
+         * their request, the responses are collected in send order when the window is full;
+         * any other command first waits for all the outstanding responses, then runs as usual.
+         * The dry run (bRealExec false) does no I/O: each response is checked by
+         * CommScriptCommandInterpreter::checkResponse when it would be collected.
+         */
+        bool m_runPipelined(const std::vector<CommCommand>& vCommands, bool bRealExec)
+        {
+            std::deque<const CommCommand*> dqInFlight;
+
+            auto collect = [this, &dqInFlight, bRealExec](size_t szKeep) -> bool {
+                while (dqInFlight.size() > szKeep) {
+                    const CommCommand& command = *dqInFlight.front();
+                    if (false == (bRealExec ? m_shpCommandInterpreter->receiveResponse(command) : m_shpCommandInterpreter->checkResponse(command))) {
+                        return false;
+                    }
+                    dqInFlight.pop_front();
+                }
+                return true;
+            };
+
+            for (const auto& command : vCommands) {
+                if (CommScriptCommandInterpreter<TDriver>::isPipelinable(command)) {
+                    if ((false == collect(m_szWindow - 1)) || (bRealExec && (false == m_shpCommandInterpreter->sendRequest(command)))) {
+                        return false;
+                    }
+                    dqInFlight.push_back(&command);
+                } else {
+                    if ((false == collect(0)) || (bRealExec && (false == m_shpCommandInterpreter->interpretCommand(command, true)))) {
+                        return false;
+                    }
+                }
+                if (bRealExec) {
+                    utime::delay_ms(m_szDelay);
+                }
+            }
+
+            return collect(0);
+        }
 
         /* Global FIFO shared across all instances of the same TDriver specialization.
          * Survives the destruction of individual CommScriptInterpreter instances
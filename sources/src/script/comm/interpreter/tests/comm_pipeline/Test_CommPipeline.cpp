@@ -0,0 +1,254 @@
+/**
+ * @file    Test_CommPipeline.cpp
+ * @brief   Pipelined comm scripts (CommScriptInterpreter with a window above 1): responses
+ *          arriving split across reads are matched in send order, a wrong one aborts the
+ *          script, the dry run checks every response without any I/O, and the clients
+ *          take their window from CommScriptSettings (SCRIPT_WINDOW)
+ */
+
+#include "uCommScriptClient.hpp"
+#include "uTestCheck.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+///////////////////////////////////////////////////////////////////
+//                       SIMULATED DEVICE                        //
+///////////////////////////////////////////////////////////////////
+
+// answers each known request; a read returns at most szChunk of the queued bytes
+class ChunkedDevice : public ICommDriver
+{
+    public:
+
+        ChunkedDevice(std::vector<std::pair<std::string, std::string>> vAnswers, size_t szChunk)
+            : m_vAnswers(std::move(vAnswers)), m_szChunk(szChunk)
+        {}
+
+        bool is_open() const override { return true; }
+
+        ReadResult tout_read(uint32_t, std::span<uint8_t> buffer, const ReadOptions&) const override
+        {
+            ReadResult result;
+            const size_t szBytes = std::min({buffer.size(), m_szChunk, m_dqPending.size()});
+            for (size_t i = 0; i < szBytes; ++i) {
+                buffer[i] = m_dqPending.front().first;
+                if (m_dqPending.front().second) {
+                    --m_szOutstanding; // last byte of a response
+                }
+                m_dqPending.pop_front();
+            }
+            result.bytes_read = szBytes;
+            result.status = (szBytes > 0) ? Status::SUCCESS : Status::READ_TIMEOUT;
+            return result;
+        }
+
+        WriteResult tout_write(uint32_t, std::span<const uint8_t> buffer) const override
+        {
+            const std::string strRequest(buffer.begin(), buffer.end());
+            m_vRequests.push_back(strRequest);
+            for (const auto& [strKnown, strAnswer] : m_vAnswers) {
+                if ((strKnown == strRequest) && !strAnswer.empty()) {
+                    for (size_t i = 0; i < strAnswer.size(); ++i) {
+                        m_dqPending.emplace_back(static_cast<uint8_t>(strAnswer[i]), (i + 1) == strAnswer.size());
+                    }
+                    m_szPeak = std::max(m_szPeak, ++m_szOutstanding);
+                    break;
+                }
+            }
+            return {Status::SUCCESS, buffer.size()};
+        }
+
+        const std::vector<std::string>& requests() const { return m_vRequests; }
+        size_t peakOutstanding() const { return m_szPeak; }
+        bool drained() const { return m_dqPending.empty(); }
+
+    private:
+
+        std::vector<std::pair<std::string, std::string>> m_vAnswers;
+        size_t m_szChunk;
+        mutable std::deque<std::pair<uint8_t, bool>> m_dqPending;  ///< Byte, last of its response
+        mutable std::vector<std::string> m_vRequests;
+        mutable size_t m_szOutstanding = 0;
+        mutable size_t m_szPeak = 0;
+};
+
+///////////////////////////////////////////////////////////////////
+//                            SCRIPT                             //
+///////////////////////////////////////////////////////////////////
+
+// block writes acked one by one, a token after some noise, a line, a sized read
+static const std::vector<std::string> kScript = {
+    "> H\"5A0100\" | H\"79\"",
+    "> H\"5A0101\" | H\"79\"",
+    "> H\"5A0102\" | H\"79\"",
+    "> H\"5A0103\" | H\"79\"",
+    "> H\"4702\" | T\"READY\"",
+    "> H\"5601\" | L\"v1.2\"",
+    "! 1 ms",
+    "> H\"5A0104\" | H\"7979\"",
+    "> H\"5204\" | S\"4\"",
+    "> H\"5A0105\" | H\"79\""
+};
+
+static std::vector<std::pair<std::string, std::string>> answers()
+{
+    using namespace std::string_literals;
+
+    // "\x00" in a request: built as std::string literals
+    return {
+        {"\x5A\x01\x00"s, "\x79"s},
+        {"\x5A\x01\x01"s, "\x79"s},
+        {"\x5A\x01\x02"s, "\x79"s},
+        {"\x5A\x01\x03"s, "\x79"s},
+        {"\x47\x02"s, "boot log...READY"s},
+        {"\x56\x01"s, "v1.2\n"s},
+        {"\x5A\x01\x04"s, "\x79\x79"s},
+        {"\x52\x04"s, "\xDE\xAD\xBE\xEF"s},
+        {"\x5A\x01\x05"s, "\x79"s}
+    };
+}
+
+static bool validate(const std::vector<std::string>& vLines, CommCommandsType& sEntries)
+{
+    CommScriptCommandValidator validator;
+    sEntries = CommCommandsType{};
+    for (size_t i = 0; i < vLines.size(); ++i) {
+        CommCommand command;
+        if (!validator.validateCommand(static_cast<int>(i + 1), vLines[i], command)) {
+            return false;
+        }
+        sEntries.vCommands.push_back(std::move(command));
+    }
+    return true;
+}
+
+// dry run then execution, as the runner does
+static bool run(std::shared_ptr<const ChunkedDevice> shpDevice, CommCommandsType& sEntries, size_t szWindow, size_t szMaxRecv = 64)
+{
+    CommScriptInterpreter<ChunkedDevice> interpreter(shpDevice, szMaxRecv, 200, 0, szWindow);
+    return interpreter.interpretScript(sEntries, false) && interpreter.interpretScript(sEntries, true);
+}
+
+///////////////////////////////////////////////////////////////////
+//                            TESTS                              //
+///////////////////////////////////////////////////////////////////
+
+static void testSplitReads()
+{
+    CommCommandsType sEntries;
+    UTEST_CHECK(validate(kScript, sEntries));
+
+    for (size_t szChunk : {1U, 2U, 3U, 5U, 64U}) {
+        for (size_t szWindow : {2U, 3U, 4U, 8U}) {
+            auto shpDevice = std::make_shared<ChunkedDevice>(answers(), szChunk);
+            UTEST_CHECK(run(shpDevice, sEntries, szWindow));
+            UTEST_CHECK(shpDevice->drained());
+            UTEST_CHECK(9U == shpDevice->requests().size());
+            UTEST_CHECK(std::string("\x5A\x01\x05") == shpDevice->requests().back());
+            // the delay line waits for all the outstanding responses
+            UTEST_CHECK(std::min<size_t>(szWindow, 6U) == shpDevice->peakOutstanding());
+        }
+    }
+}
+
+static void testMismatch()
+{
+    CommCommandsType sEntries;
+    UTEST_CHECK(validate(kScript, sEntries));
+
+    // the third block is refused: the script stops with at most window - 1 requests sent past it
+    auto vAnswers = answers();
+    vAnswers[2].second = "\x1F";
+    auto shpDevice = std::make_shared<ChunkedDevice>(vAnswers, 1);
+    UTEST_CHECK(!run(shpDevice, sEntries, 4));
+    UTEST_CHECK(6U == shpDevice->requests().size());
+
+    // a response never coming is a timeout, not a hang
+    vAnswers = answers();
+    vAnswers[7].second.clear();
+    shpDevice = std::make_shared<ChunkedDevice>(vAnswers, 2);
+    UTEST_CHECK(!run(shpDevice, sEntries, 4));
+}
+
+static void testDryRun()
+{
+    CommCommandsType sEntries;
+    auto shpDevice = std::make_shared<ChunkedDevice>(answers(), 1);
+
+    // a valid script: no I/O during the dry run
+    UTEST_CHECK(validate(kScript, sEntries));
+    {
+        CommScriptInterpreter<ChunkedDevice> interpreter(shpDevice, 64, 200, 0, 4);
+        UTEST_CHECK(interpreter.interpretScript(sEntries, false));
+        UTEST_CHECK(shpDevice->requests().empty());
+        UTEST_CHECK(interpreter.interpretScript(sEntries, true));
+    }
+
+    // responses larger than the receive buffer are refused before anything is sent
+    for (const char *pstrLine : {"> H\"5204\" | S\"65\"", "> H\"5601\" | L\"0123456789012345678901234567890123456789012345678901234567890123456789\""}) {
+        std::vector<std::string> vLines = kScript;
+        vLines.push_back(pstrLine);
+        UTEST_CHECK(validate(vLines, sEntries));
+
+        shpDevice = std::make_shared<ChunkedDevice>(answers(), 1);
+        CommScriptInterpreter<ChunkedDevice> interpreter(shpDevice, 64, 200, 0, 4);
+        UTEST_CHECK(!interpreter.interpretScript(sEntries, false));
+        UTEST_CHECK(!interpreter.interpretScript(sEntries, true)); // nothing queued for execution
+        UTEST_CHECK(shpDevice->requests().empty());
+    }
+}
+
+static void testSettings()
+{
+    std::unordered_map<std::string, std::string> mapSettings;
+    UTEST_CHECK(CommScriptSettings::configure(mapSettings));
+    UTEST_CHECK(PLUGIN_SCRIPT_DEFAULT_WINDOW == CommScriptSettings::window());
+
+    mapSettings[PLUGIN_INI_SCRIPT_WINDOW] = "0";
+    UTEST_CHECK(!CommScriptSettings::configure(mapSettings));
+    mapSettings[PLUGIN_INI_SCRIPT_WINDOW] = "wide";
+    UTEST_CHECK(!CommScriptSettings::configure(mapSettings));
+    UTEST_CHECK(PLUGIN_SCRIPT_DEFAULT_WINDOW == CommScriptSettings::window());
+
+    mapSettings[PLUGIN_INI_SCRIPT_WINDOW] = "3";
+    mapSettings[PLUGIN_INI_SCRIPT_CACHE] = "0";
+    UTEST_CHECK(CommScriptSettings::configure(mapSettings));
+    UTEST_CHECK((3U == CommScriptSettings::window()) && (0U == CommScriptCache::capacity()));
+
+    // a client built without a window, as the plugin script helpers do, pipelines with SCRIPT_WINDOW
+    const fs::path path = fs::temp_directory_path() / "test_comm_pipeline.txt";
+    {
+        std::ofstream file(path, std::ios::trunc);
+        for (const auto& strLine : kScript) {
+            file << strLine << "\n";
+        }
+    }
+    auto shpDevice = std::make_shared<ChunkedDevice>(answers(), 2);
+    CommScriptClient<ChunkedDevice> client(path.string(), shpDevice, 64, 200, 0);
+    UTEST_CHECK(client.execute(false) && client.execute(true));
+    UTEST_CHECK(shpDevice->drained() && (3U == shpDevice->peakOutstanding()));
+    fs::remove(path);
+}
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    testSplitReads();
+    testMismatch();
+    testDryRun();
+    testSettings();
+
+    return utest::result("comm_pipeline");
+}
@@ -44,11 +44,13 @@ public:
      * @param shpScriptReader Script reader component
      * @param shvScriptValidator Script validator component
      * @param shvScriptInterpreter Communication-enabled script interpreter (Level 2+)
+     * @param shpScriptCache Optional cache of the validated entries
      */
     explicit CommScriptRunner( std::shared_ptr<IScriptReader> shpScriptReader,
                                std::shared_ptr<IScriptValidator<TScriptEntries>> shvScriptValidator,
-                               std::shared_ptr<ICommScriptInterpreter<TScriptEntries, TDriver>> shvScriptInterpreter )
-        : ScriptRunner<TScriptEntries>(shpScriptReader, shvScriptValidator, shvScriptInterpreter)
+                               std::shared_ptr<ICommScriptInterpreter<TScriptEntries, TDriver>> shvScriptInterpreter,
+                               std::shared_ptr<IScriptCache<TScriptEntries>> shpScriptCache = nullptr )
+        : ScriptRunner<TScriptEntries>(shpScriptReader, shvScriptValidator, shvScriptInterpreter, std::move(shpScriptCache))
         , m_shpScriptInterpreterComm(std::move(shvScriptInterpreter))
     {}
 
@@ -0,0 +1,61 @@
+#ifndef U_SCRIPT_CACHE_HPP
+#define U_SCRIPT_CACHE_HPP
+
+#include "IScriptCache.hpp"
+#include "uScriptDataTypes.hpp"
+
+#include <cstdint>
+#include <string>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                        COMPILED SCRIPT CACHE                                //
+/////////////////////////////////////////////////////////////////////////////////
+
+// -----------------------------------------------------------------------------
+// Binary cache of the validated IR of a core script, stored in a ".usc" file
+// next to the script or, when a cache directory is given, in that directory.
+//
+// An entry is valid when
+//   - the format version matches (kFormatVersion, bumped on any IR change),
+//   - the script text hashes to the stored value (FNV-1a 64 + size),
+//   - every plugin loaded by the script has the same size and modification
+//     time as when the entry was stored.
+// Constant and array macros are part of the script text, so they are covered
+// by the script hash.
+//
+// The cache file is mapped read-only and the IR is decoded straight from the
+// mapping.  Runtime state the interpreter attaches to the IR (plugin command
+// bindings, MATH / EVAL program indices) is not stored; it is rebuilt by the
+// dry run, which skips only the command validation for cached entries.
+// Entries are written to a temporary file and renamed into place, so
+// concurrent runs of the same script never see a partial file.
+// -----------------------------------------------------------------------------
+class ScriptCache : public IScriptCache<ScriptEntriesType>
+{
+public:
+
+    static constexpr uint32_t kFormatVersion = 4U;
+
+    // strCacheDir empty: "<script>.usc" next to the script
+    explicit ScriptCache(const std::string& strScriptPathName, const std::string& strCacheDir = "");
+
+    bool loadScript(ScriptEntriesType& sScriptEntries) override;
+    bool storeScript(const ScriptEntriesType& sScriptEntries) override;
+
+    const std::string& getCachePathName() const { return m_strCachePathName; }
+
+private:
+
+    bool m_hashScript(uint64_t& u64Hash, uint64_t& u64Size) const noexcept;
+
+    std::string m_strScriptPathName;
+    std::string m_strCachePathName;
+
+    // script text seen by loadScript; storeScript refuses to cache entries
+    // if the script changed in between
+    uint64_t    m_u64ScriptHash = 0U;
+    uint64_t    m_u64ScriptSize = 0U;
+    bool        m_bScriptHashed = false;
+};
+
+#endif // U_SCRIPT_CACHE_HPP
@@ -0,0 +1,735 @@
+#include "uScriptCache.hpp"
+#include "uScriptDataTypes.hpp"
+#include "IPluginDataTypes.hpp"
+
+#include "uSharedConfig.hpp"
+#include "uPluginLoader.hpp"
+#include "uLogger.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            LOCAL DEFINITIONS                                //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifdef LT_HDR
+    #undef LT_HDR
+#endif
+#ifdef LOG_HDR
+    #undef LOG_HDR
+#endif
+
+#define LT_HDR     "CORE_SCR_C  |"
+#define LOG_HDR    LOG_STRING(LT_HDR)
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            LOCAL CONSTANTS                                  //
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+constexpr uint32_t kCacheMagic     = 0x31435355U;    // "USC1"
+constexpr uint32_t kCacheByteOrder = 0x01020304U;    // files are host-endian
+constexpr const char *kCacheExtension = ".usc";
+
+// every IR node type must be handled by ioNode(); adding one changes the
+// file layout, so kFormatVersion has to be bumped as well
+static_assert(std::variant_size_v<ScriptCommandType> == 22U,
+              "IR node added: extend ioNode() and bump ScriptCache::kFormatVersion");
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            LOCAL FUNCTIONS                                  //
+/////////////////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------------------
+  FNV-1a, 64 bit
+-------------------------------------------------------------------------------*/
+
+uint64_t fnv1a64(const uint8_t *pData, size_t szSize, uint64_t u64Hash = 0xcbf29ce484222325ULL) noexcept
+{
+    for (size_t i = 0; i < szSize; ++i) {
+        u64Hash ^= pData[i];
+        u64Hash *= 0x100000001b3ULL;
+    }
+    return u64Hash;
+
+} /* fnv1a64() */
+
+
+/*-------------------------------------------------------------------------------
+  Read-only view of a whole file: mmap on POSIX, a plain read elsewhere.
+-------------------------------------------------------------------------------*/
+
+class MappedFile
+{
+public:
+
+    explicit MappedFile(const std::string& strPathName) noexcept
+    {
+#ifdef _WIN32
+        std::ifstream file(strPathName, std::ios::binary | std::ios::ate);
+        if (file.is_open()) {
+            const std::streamoff size = file.tellg();
+            if (size >= 0) {
+                m_vData.resize(static_cast<size_t>(size));
+                file.seekg(0);
+                m_bOpen = m_vData.empty() || file.read(reinterpret_cast<char*>(m_vData.data()), size).good();
+                m_pData = m_vData.data();
+                m_szSize = m_vData.size();
+            }
+        }
+#else
+        const int fd = ::open(strPathName.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            struct stat st {};
+            if ((0 == ::fstat(fd, &st)) && S_ISREG(st.st_mode)) {
+                m_szSize = static_cast<size_t>(st.st_size);
+                if (0U == m_szSize) {
+                    m_bOpen = true;
+                } else {
+                    void *pMap = ::mmap(nullptr, m_szSize, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (pMap != MAP_FAILED) {
+                        m_pData = static_cast<const uint8_t*>(pMap);
+                        m_bOpen = true;
+                    }
+                }
+            }
+            ::close(fd);
+        }
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if ((m_pData != nullptr) && (m_szSize > 0U)) {
+            ::munmap(const_cast<uint8_t*>(m_pData), m_szSize);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool           isOpen() const noexcept { return m_bOpen; }
+    const uint8_t *data()   const noexcept { return m_pData; }
+    size_t         size()   const noexcept { return m_bOpen ? m_szSize : 0U; }
+
+private:
+
+#ifdef _WIN32
+    std::vector<uint8_t> m_vData;
+#endif
+    const uint8_t *m_pData  = nullptr;
+    size_t         m_szSize = 0U;
+    bool           m_bOpen  = false;
+};
+
+
+/*-------------------------------------------------------------------------------
+  Plugin fingerprint: size and modification time of the plugin library the
+  interpreter would load for strName.
+-------------------------------------------------------------------------------*/
+
+struct PluginFingerprint {
+    std::string strName;
+    uint64_t    u64Size  = 0U;
+    uint64_t    u64MTime = 0U;
+};
+
+bool fingerprintPlugin(const std::string& strName, PluginFingerprint& sPrint) noexcept
+{
+    static const PluginPathGenerator pathGen(SCRIPT_PLUGINS_PATH, PLUGIN_PREFIX, SCRIPT_PLUGIN_EXTENSION);
+
+    std::error_code ec;
+    const std::filesystem::path path = pathGen(strName);
+    const auto size  = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+
+    sPrint.strName  = strName;
+    sPrint.u64Size  = static_cast<uint64_t>(size);
+    sPrint.u64MTime = static_cast<uint64_t>(mtime.time_since_epoch().count());
+    return true;
+
+} /* fingerprintPlugin() */
+
+
+/*-------------------------------------------------------------------------------
+  Archives.  Both expose the same field functions so that one ioNode() /
+  ioTemplate() describes the layout for writing and reading.
+-------------------------------------------------------------------------------*/
+
+class CacheWriter
+{
+public:
+
+    void flag(bool b)            { u8(b ? 1U : 0U); }
+    void u8(uint8_t u)           { m_strData.push_back(static_cast<char>(u)); }
+    void u32(uint32_t u)         { m_raw(&u, sizeof(u)); }
+    void u64(uint64_t u)         { m_raw(&u, sizeof(u)); }
+    void i32(int i)              { u32(static_cast<uint32_t>(static_cast<int32_t>(i))); }
+    void size(size_t sz)         { u64(static_cast<uint64_t>(sz)); }
+
+    void str(const std::string& s)
+    {
+        u32(static_cast<uint32_t>(s.size()));
+        m_strData.append(s);
+    }
+
+    template <typename E>
+    void enumeration(E e, E /*eMax*/) { u32(static_cast<uint32_t>(e)); }
+
+    template <typename T>
+    void count(const std::vector<T>& v) { u32(static_cast<uint32_t>(v.size())); }
+
+    void strVector(const std::vector<std::string>& v)
+    {
+        count(v);
+        for (const auto& s : v) {
+            str(s);
+        }
+    }
+
+    const std::string& data() const noexcept { return m_strData; }
+
+private:
+
+    void m_raw(const void *p, size_t sz) { m_strData.append(static_cast<const char*>(p), sz); }
+
+    std::string m_strData;
+};
+
+
+class CacheReader
+{
+public:
+
+    CacheReader(const uint8_t *pData, size_t szSize) noexcept
+        : m_pCur(pData), m_pEnd(pData + szSize)
+    {}
+
+    bool ok()    const noexcept { return m_bOk; }
+    bool atEnd() const noexcept { return m_bOk && (m_pCur == m_pEnd); }
+
+    void flag(bool& b)           { uint8_t u = 0U; u8(u); b = (u != 0U); }
+    void u8(uint8_t& u)          { m_raw(&u, sizeof(u)); }
+    void u32(uint32_t& u)        { m_raw(&u, sizeof(u)); }
+    void u64(uint64_t& u)        { m_raw(&u, sizeof(u)); }
+    void i32(int& i)             { uint32_t u = 0U; u32(u); i = static_cast<int32_t>(u); }
+    void size(size_t& sz)        { uint64_t u = 0U; u64(u); sz = static_cast<size_t>(u); }
+
+    void str(std::string& s)
+    {
+        uint32_t uLen = 0U;
+        u32(uLen);
+        if (m_bOk && (uLen <= static_cast<size_t>(m_pEnd - m_pCur))) {
+            s.assign(reinterpret_cast<const char*>(m_pCur), uLen);
+            m_pCur += uLen;
+        } else {
+            m_bOk = false;
+        }
+    }
+
+    template <typename E>
+    void enumeration(E& e, E eMax)
+    {
+        uint32_t u = 0U;
+        u32(u);
+        if (u > static_cast<uint32_t>(eMax)) {
+            m_bOk = false;
+        }
+        e = static_cast<E>(u);
+    }
+
+    // every element takes at least one byte, which bounds a corrupt count
+    template <typename T>
+    void count(std::vector<T>& v)
+    {
+        uint32_t uCount = 0U;
+        u32(uCount);
+        if (m_bOk && (uCount <= static_cast<size_t>(m_pEnd - m_pCur))) {
+            v.resize(uCount);
+        } else {
+            m_bOk = false;
+            v.clear();
+        }
+    }
+
+    void strVector(std::vector<std::string>& v)
+    {
+        count(v);
+        for (auto& s : v) {
+            str(s);
+        }
+    }
+
+private:
+
+    void m_raw(void *p, size_t sz)
+    {
+        if (m_bOk && (sz <= static_cast<size_t>(m_pEnd - m_pCur))) {
+            std::memcpy(p, m_pCur, sz);
+            m_pCur += sz;
+        } else {
+            m_bOk = false;
+        }
+    }
+
+    const uint8_t *m_pCur;
+    const uint8_t *m_pEnd;
+    bool           m_bOk = true;
+};
+
+
+/*-------------------------------------------------------------------------------
+  Layout of the compiled templates and of the IR nodes.  Runtime fields set
+  by the interpreter (sBinding, uProgram, uCondProgram) are not stored.
+-------------------------------------------------------------------------------*/
+
+template <typename Ar, typename Tpl>
+void ioTemplate(Ar& ar, Tpl& sTpl)
+{
+    ar.count(sTpl.vSegments);
+    for (auto& seg : sTpl.vSegments) {
+        ar.enumeration(seg.eKind, MacroSegment::Kind::ARRAY_ELEM);
+        ar.str(seg.strText);
+        ar.str(seg.strIndex);
+        ar.u32(seg.uVarSlot);
+        ar.u32(seg.uArraySlot);
+        ar.u32(seg.uIndexSlot);
+    }
+    ar.size(sTpl.szLiteralSize);
+    ar.flag(sTpl.bCompiled);
+    ar.flag(sTpl.bHasMacros);
+
+} /* ioTemplate() */
+
+
+template <typename Ar, typename T>
+void ioNode(Ar& ar, T& c)
+{
+    using N = std::remove_const_t<T>;
+
+    if constexpr (std::is_same_v<N, MacroCommand>) {
+        ar.str(c.strPlugin); ar.str(c.strCommand); ar.str(c.strParams); ar.str(c.strVarMacroName);
+        ioTemplate(ar, c.sParamsTpl);
+        ar.u32(c.uVarSlot);
+    } else if constexpr (std::is_same_v<N, Command>) {
+        ar.str(c.strPlugin); ar.str(c.strCommand); ar.str(c.strParams);
+        ioTemplate(ar, c.sParamsTpl);
+    } else if constexpr (std::is_same_v<N, Condition>) {
+        ar.str(c.strCondition); ar.str(c.strLabelName);
+        ioTemplate(ar, c.sConditionTpl);
+        ar.size(c.szTargetIndex);
+    } else if constexpr (std::is_same_v<N, Label>) {
+        ar.str(c.strLabelName);
+    } else if constexpr (std::is_same_v<N, RepeatTimes>) {
+        ar.str(c.strLabel); ar.i32(c.iCount); ar.str(c.strCountExpr); ar.str(c.strVarMacroName);
+        ioTemplate(ar, c.sCountTpl);
+        ar.u32(c.uVarSlot);
+    } else if constexpr (std::is_same_v<N, RepeatUntil>) {
+        ar.str(c.strLabel); ar.str(c.strCondition); ar.str(c.strVarMacroName);
+        ioTemplate(ar, c.sConditionTpl);
+        ar.u32(c.uVarSlot);
+    } else if constexpr (std::is_same_v<N, RepeatEnd>) {
+        ar.str(c.strLabel);
+    } else if constexpr (std::is_same_v<N, LoopBreak> || std::is_same_v<N, LoopContinue>) {
+        ar.str(c.strLabel); ar.size(c.szTargetIndex); ar.size(c.szUnwindDepth);
+    } else if constexpr (std::is_same_v<N, PrintStatement>) {
+        ar.str(c.strText);
+        ioTemplate(ar, c.sTextTpl);
+    } else if constexpr (std::is_same_v<N, VarMacroInit>) {
+        ar.str(c.strName); ar.str(c.strValueTpl);
+        ioTemplate(ar, c.sValueTpl);
+        ar.u32(c.uVarSlot);
+    } else if constexpr (std::is_same_v<N, FormatStatement>) {
+        ar.str(c.strName); ar.str(c.strInputTpl); ar.str(c.strFormatTpl);
+        ioTemplate(ar, c.sInputTpl);
+        ioTemplate(ar, c.sFormatTpl);
+        ar.u32(c.uVarSlot);
+    } else if constexpr (std::is_same_v<N, DelayStatement>) {
+        ar.size(c.szValue);
+        ar.enumeration(c.eUnit, DelayUnit::SEC);
+    } else if constexpr (std::is_same_v<N, MathStatement>) {
+        ar.str(c.strName); ar.str(c.strExprTpl); ar.flag(c.bHexOutput);
+        ioTemplate(ar, c.sExprTpl);
+        ar.u32(c.uVarSlot);
+    } else if constexpr (std::is_same_v<N, BreakpointStatement>) {
+        ar.str(c.strLabelTpl);
+        ioTemplate(ar, c.sLabelTpl);
+    } else if constexpr (std::is_same_v<N, ParallelBegin>) {
+        ar.str(c.strLabel);
+        ar.count(c.vBranchIndices);
+        for (auto& szIndex : c.vBranchIndices) {
+            ar.size(szIndex);
+        }
+        ar.size(c.szEndIndex);
+    } else if constexpr (std::is_same_v<N, ParallelBranch>) {
+        ar.size(c.szEndIndex);
+    } else if constexpr (std::is_same_v<N, ParallelEnd>) {
+        ar.str(c.strLabel);
+    } else if constexpr (std::is_same_v<N, AsyncCommand>) {
+        ar.str(c.strHandle); ar.str(c.strPlugin); ar.str(c.strCommand); ar.str(c.strParams);
+        ioTemplate(ar, c.sParamsTpl);
+        ar.u32(c.uVarSlot);
+    } else if constexpr (std::is_same_v<N, AwaitStatement>) {
+        ar.str(c.strHandle); ar.size(c.szTimeoutUs);
+        ar.u32(c.uVarSlot);
+    } else if constexpr (std::is_same_v<N, PeriodStatement>) {
+        ar.size(c.szPeriodUs); ar.str(c.strLoopLabel); ar.u32(c.uTimeline);
+    } else if constexpr (std::is_same_v<N, DelayUntilStatement>) {
+        ar.size(c.szOffsetUs);
+    } else {
+        static_assert(!sizeof(N), "IR node without cache layout");
+    }
+
+} /* ioNode() */
+
+
+template <size_t... I>
+bool emplaceNode(ScriptCommandType& command, size_t szIndex, std::index_sequence<I...>)
+{
+    return ((szIndex == I ? (command.template emplace<I>(), true) : false) || ...);
+
+} /* emplaceNode() */
+
+
+/*-------------------------------------------------------------------------------
+  Whole file:
+    header       magic, format version, byte order, script hash, script size
+    plugins      fingerprints of the plugin libraries the script loads
+    entries      plugins, constant / array macros, slot names, IR nodes
+    trailer      magic
+-------------------------------------------------------------------------------*/
+
+void writeEntries(CacheWriter& ar, const ScriptEntriesType& sEntries)
+{
+    ar.u32(static_cast<uint32_t>(sEntries.vPlugins.size()));
+    for (const auto& plugin : sEntries.vPlugins) {
+        ar.str(plugin.strPluginName);
+        ar.str(plugin.strPluginVersRule);
+        ar.str(plugin.strPluginVersRequested);
+    }
+
+    ar.u32(static_cast<uint32_t>(sEntries.mapMacros.size()));
+    for (const auto& [strName, strValue] : sEntries.mapMacros) {
+        ar.str(strName);
+        ar.str(strValue);
+    }
+
+    ar.u32(static_cast<uint32_t>(sEntries.mapArrayMacros.size()));
+    for (const auto& [strName, vElements] : sEntries.mapArrayMacros) {
+        ar.str(strName);
+        ar.strVector(vElements);
+    }
+
+    ar.strVector(sEntries.vVarSlots);
+    ar.strVector(sEntries.vArraySlots);
+
+    ar.count(sEntries.vCommands);
+    for (const auto& line : sEntries.vCommands) {
+        ar.i32(line.iLineNumber);
+        ar.u8(static_cast<uint8_t>(line.command.index()));
+        std::visit([&ar](const auto& command) { ioNode(ar, command); }, line.command);
+    }
+
+} /* writeEntries() */
+
+
+bool readEntries(CacheReader& ar, ScriptEntriesType& sEntries)
+{
+    uint32_t uCount = 0U;
+
+    ar.u32(uCount);
+    for (uint32_t i = 0; ar.ok() && (i < uCount); ++i) {
+        PluginDataType plugin {};
+        ar.str(plugin.strPluginName);
+        ar.str(plugin.strPluginVersRule);
+        ar.str(plugin.strPluginVersRequested);
+        sEntries.vPlugins.push_back(std::move(plugin));
+    }
+
+    ar.u32(uCount);
+    for (uint32_t i = 0; ar.ok() && (i < uCount); ++i) {
+        std::string strName;
+        std::string strValue;
+        ar.str(strName);
+        ar.str(strValue);
+        sEntries.mapMacros.emplace(std::move(strName), std::move(strValue));
+    }
+
+    ar.u32(uCount);
+    for (uint32_t i = 0; ar.ok() && (i < uCount); ++i) {
+        std::string strName;
+        std::vector<std::string> vElements;
+        ar.str(strName);
+        ar.strVector(vElements);
+        sEntries.mapArrayMacros.emplace(std::move(strName), std::move(vElements));
+    }
+
+    ar.strVector(sEntries.vVarSlots);
+    ar.strVector(sEntries.vArraySlots);
+
+    ar.count(sEntries.vCommands);
+    for (auto& line : sEntries.vCommands) {
+        uint8_t uIndex = 0U;
+        ar.i32(line.iLineNumber);
+        ar.u8(uIndex);
+        if (!ar.ok() || !emplaceNode(line.command, uIndex,
+                                     std::make_index_sequence<std::variant_size_v<ScriptCommandType>>{})) {
+            return false;
+        }
+        std::visit([&ar](auto& command) { ioNode(ar, command); }, line.command);
+    }
+
+    return ar.ok();
+
+} /* readEntries() */
+
+} // namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            CLASS IMPLEMENTATION                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------------------
+  "<script>.usc" next to the script, or "<stem>-<hash of the absolute script
+  path>.usc" in the cache directory so that scripts with the same name in
+  different directories do not share an entry.
+-------------------------------------------------------------------------------*/
+
+ScriptCache::ScriptCache(const std::string& strScriptPathName, const std::string& strCacheDir)
+    : m_strScriptPathName(strScriptPathName)
+{
+    namespace fs = std::filesystem;
+
+    if (strCacheDir.empty()) {
+        m_strCachePathName = strScriptPathName + kCacheExtension;
+    } else {
+        std::error_code ec;
+        fs::path absPath = fs::absolute(strScriptPathName, ec);
+        const std::string strAbsPath = ec ? strScriptPathName : absPath.lexically_normal().string();
+        const uint64_t u64PathHash = fnv1a64(reinterpret_cast<const uint8_t*>(strAbsPath.data()), strAbsPath.size());
+
+        char acHash[17] = {};
+        for (size_t i = 0; i < 16U; ++i) {
+            acHash[i] = "0123456789abcdef"[(u64PathHash >> ((15U - i) * 4U)) & 0xFU];
+        }
+
+        const std::string strName = fs::path(strScriptPathName).stem().string() + "-" + acHash + kCacheExtension;
+        m_strCachePathName = (fs::path(strCacheDir) / strName).string();
+    }
+
+} /* ScriptCache() */
+
+
+/*-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------*/
+
+bool ScriptCache::loadScript(ScriptEntriesType& sScriptEntries)
+{
+    bool bRetVal = false;
+
+    do {
+        m_bScriptHashed = m_hashScript(m_u64ScriptHash, m_u64ScriptSize);
+        if (false == m_bScriptHashed) {
+            break;
+        }
+
+        MappedFile cacheFile(m_strCachePathName);
+        if (false == cacheFile.isOpen()) {
+            LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("No cache entry:"); LOG_STRING(m_strCachePathName));
+            break;
+        }
+
+        CacheReader ar(cacheFile.data(), cacheFile.size());
+
+        uint32_t uMagic = 0U, uVersion = 0U, uByteOrder = 0U;
+        uint64_t u64Hash = 0U, u64Size = 0U;
+        ar.u32(uMagic);
+        ar.u32(uVersion);
+        ar.u32(uByteOrder);
+        ar.u64(u64Hash);
+        ar.u64(u64Size);
+
+        if (!ar.ok() || (uMagic != kCacheMagic) || (uVersion != kFormatVersion) || (uByteOrder != kCacheByteOrder)) {
+            LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Cache entry has another format:"); LOG_STRING(m_strCachePathName));
+            break;
+        }
+
+        if ((u64Hash != m_u64ScriptHash) || (u64Size != m_u64ScriptSize)) {
+            LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Cache entry stale, script changed"));
+            break;
+        }
+
+        uint32_t uNrPlugins = 0U;
+        bool bPluginsOk = true;
+        ar.u32(uNrPlugins);
+        for (uint32_t i = 0; bPluginsOk && ar.ok() && (i < uNrPlugins); ++i) {
+            PluginFingerprint sStored;
+            PluginFingerprint sCurrent;
+            ar.str(sStored.strName);
+            ar.u64(sStored.u64Size);
+            ar.u64(sStored.u64MTime);
+            bPluginsOk = ar.ok() && fingerprintPlugin(sStored.strName, sCurrent) &&
+                         (sCurrent.u64Size == sStored.u64Size) && (sCurrent.u64MTime == sStored.u64MTime);
+            if (false == bPluginsOk) {
+                LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Cache entry stale, plugin changed:"); LOG_STRING(sStored.strName));
+            }
+        }
+        if (!bPluginsOk || !ar.ok()) {
+            break;
+        }
+
+        ScriptEntriesType sEntries;
+        uint32_t uTrailer = 0U;
+        const bool bDecoded = readEntries(ar, sEntries);
+        ar.u32(uTrailer);
+
+        if (!bDecoded || (uTrailer != kCacheMagic) || !ar.atEnd()) {
+            LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Corrupt cache entry ignored:"); LOG_STRING(m_strCachePathName));
+            break;
+        }
+
+        sEntries.bFromCache = true;
+        sScriptEntries = std::move(sEntries);
+
+        LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Cache hit:"); LOG_STRING(m_strCachePathName);
+                  LOG_STRING("commands:"); LOG_SIZET(sScriptEntries.vCommands.size()));
+
+        bRetVal = true;
+
+    } while(false);
+
+    return bRetVal;
+
+} /* loadScript() */
+
+
+/*-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------*/
+
+bool ScriptCache::storeScript(const ScriptEntriesType& sScriptEntries)
+{
+    namespace fs = std::filesystem;
+
+    bool bRetVal = false;
+
+    do {
+        // the entries must belong to the text loadScript() hashed
+        uint64_t u64Hash = 0U, u64Size = 0U;
+        if (!m_hashScript(u64Hash, u64Size) || !m_bScriptHashed ||
+            (u64Hash != m_u64ScriptHash) || (u64Size != m_u64ScriptSize)) {
+            LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Script changed while running, not cached"));
+            break;
+        }
+
+        std::vector<PluginFingerprint> vPrints(sScriptEntries.vPlugins.size());
+        bool bPrinted = true;
+        for (size_t i = 0; bPrinted && (i < vPrints.size()); ++i) {
+            bPrinted = fingerprintPlugin(sScriptEntries.vPlugins[i].strPluginName, vPrints[i]);
+        }
+        if (false == bPrinted) {
+            LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Plugin library not found, not cached"));
+            break;
+        }
+
+        CacheWriter ar;
+        ar.u32(kCacheMagic);
+        ar.u32(kFormatVersion);
+        ar.u32(kCacheByteOrder);
+        ar.u64(u64Hash);
+        ar.u64(u64Size);
+
+        ar.u32(static_cast<uint32_t>(vPrints.size()));
+        for (const auto& sPrint : vPrints) {
+            ar.str(sPrint.strName);
+            ar.u64(sPrint.u64Size);
+            ar.u64(sPrint.u64MTime);
+        }
+
+        writeEntries(ar, sScriptEntries);
+        ar.u32(kCacheMagic);
+
+        // write a private temporary file, then rename it over the entry
+        std::error_code ec;
+        const fs::path cachePath(m_strCachePathName);
+        if (cachePath.has_parent_path()) {
+            fs::create_directories(cachePath.parent_path(), ec);
+        }
+
+        const std::string strTmpPathName = m_strCachePathName + "." + std::to_string(std::random_device{}()) + ".tmp";
+        {
+            std::ofstream ofs(strTmpPathName, std::ios::binary | std::ios::trunc);
+            ofs.write(ar.data().data(), static_cast<std::streamsize>(ar.data().size()));
+            if (false == ofs.good()) {
+                LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Cannot write"); LOG_STRING(strTmpPathName));
+                ofs.close();
+                fs::remove(strTmpPathName, ec);
+                break;
+            }
+        }
+
+        fs::rename(strTmpPathName, cachePath, ec);
+        if (ec) {
+            LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Cannot write"); LOG_STRING(m_strCachePathName); LOG_STRING(ec.message()));
+            fs::remove(strTmpPathName, ec);
+            break;
+        }
+
+        LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Cache stored:"); LOG_STRING(m_strCachePathName);
+                  LOG_STRING("bytes:"); LOG_SIZET(ar.data().size()));
+
+        bRetVal = true;
+
+    } while(false);
+
+    return bRetVal;
+
+} /* storeScript() */
+
+
+/*-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------*/
+
+bool ScriptCache::m_hashScript(uint64_t& u64Hash, uint64_t& u64Size) const noexcept
+{
+    MappedFile scriptFile(m_strScriptPathName);
+    if (false == scriptFile.isOpen()) {
+        return false;
+    }
+
+    u64Hash = fnv1a64(scriptFile.data(), scriptFile.size());
+    u64Size = static_cast<uint64_t>(scriptFile.size());
+    return true;
+
+} /* m_hashScript() */
@@ -0,0 +1,152 @@
+/**
+ * @file    Test_ScriptCache.cpp
+ * @brief   ScriptCache (uScriptCache.hpp): the entries of a validated script survive a
+ *          store / load round trip; entries of another format version, of a changed
+ *          script or of a damaged file are rejected
+ */
+
+#include "uScriptCache.hpp"
+#include "IPluginDataTypes.hpp"
+#include "uScriptCommandValidator.hpp"
+#include "uScriptReader.hpp"
+#include "uScriptValidator.hpp"
+#include "uTestCheck.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// one line of most IR node kinds, no plugin
+static const char kScript[] =
+    "DEVICE := /dev/ttyUSB0\n"
+    "BYTES  [= 0x01, 0x02, 0x03\n"
+    "PRINT start on $DEVICE\n"
+    "count ?= 0\n"
+    "i ?= REPEAT outer 3\n"
+    "    count ?= MATH $count + $i\n"
+    "    IF EVAL $count > 100 :NUM GOTO skip\n"
+    "    PRINT byte $BYTES.$i\n"
+    "    LABEL skip\n"
+    "END_REPEAT outer\n"
+    "line ?= FORMAT $DEVICE $count | %1 on %0\n"
+    "DELAY 1 ms\n"
+    "PRINT $line\n";
+
+static std::vector<char> readFile(const std::string& strPath)
+{
+    std::ifstream file(strPath, std::ios::binary);
+    return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string& strPath, const std::string& strText)
+{
+    std::ofstream file(strPath, std::ios::binary | std::ios::trunc);
+    file << strText;
+}
+
+static bool validate(const std::string& strPath, ScriptEntriesType& sEntries)
+{
+    std::vector<ScriptRawLine> vLines;
+    ScriptValidator validator(std::make_shared<ScriptCommandValidator>());
+    return ScriptReader(strPath).readScript(vLines) && validator.validateScript(vLines, sEntries);
+}
+
+// what the cache stores of the entries, written through another cache directory
+static std::vector<char> storedBytes(const std::string& strScript, const std::string& strDir, const ScriptEntriesType& sEntries)
+{
+    ScriptCache cache(strScript, strDir);
+    ScriptEntriesType sUnused;
+    (void)cache.loadScript(sUnused); // hashes the script
+    return cache.storeScript(sEntries) ? readFile(cache.getCachePathName()) : std::vector<char>{};
+}
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_script_cache";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string strScript = (dir / "script.txt").string();
+    const std::string strDirA = (dir / "a").string();
+    const std::string strDirB = (dir / "b").string();
+    writeFile(strScript, kScript);
+
+    ScriptEntriesType sValidated;
+    UTEST_CHECK(validate(strScript, sValidated));
+    UTEST_CHECK(sValidated.vCommands.size() > 10U);
+
+    // no entry yet
+    ScriptEntriesType sLoaded;
+    ScriptCache cache(strScript, strDirA);
+    UTEST_CHECK(!cache.loadScript(sLoaded));
+    UTEST_CHECK(cache.storeScript(sValidated));
+    UTEST_CHECK(fs::exists(cache.getCachePathName()));
+
+    // round trip: same entries, stored again byte for byte
+    UTEST_CHECK(ScriptCache(strScript, strDirA).loadScript(sLoaded));
+    UTEST_CHECK(sLoaded.bFromCache && !sValidated.bFromCache);
+    UTEST_CHECK(sLoaded.vCommands.size() == sValidated.vCommands.size());
+    UTEST_CHECK(sLoaded.mapMacros == sValidated.mapMacros);
+    UTEST_CHECK(sLoaded.mapArrayMacros == sValidated.mapArrayMacros);
+    UTEST_CHECK(sLoaded.vVarSlots == sValidated.vVarSlots);
+    UTEST_CHECK(sLoaded.vArraySlots == sValidated.vArraySlots);
+    for (size_t i = 0; (i < sLoaded.vCommands.size()) && (i < sValidated.vCommands.size()); ++i) {
+        UTEST_CHECK(sLoaded.vCommands[i].iLineNumber == sValidated.vCommands[i].iLineNumber);
+        UTEST_CHECK(sLoaded.vCommands[i].command.index() == sValidated.vCommands[i].command.index());
+    }
+    const std::vector<char> vStored = readFile(cache.getCachePathName());
+    UTEST_CHECK(!vStored.empty() && (storedBytes(strScript, strDirB, sLoaded) == vStored));
+
+    // another format version
+    {
+        std::vector<char> vOther = vStored;
+        const uint32_t uVersion = ScriptCache::kFormatVersion + 1U;
+        std::memcpy(vOther.data() + sizeof(uint32_t), &uVersion, sizeof(uVersion));
+        writeFile(cache.getCachePathName(), std::string(vOther.begin(), vOther.end()));
+        UTEST_CHECK(!ScriptCache(strScript, strDirA).loadScript(sLoaded));
+    }
+
+    // damaged: truncated, trailer overwritten
+    writeFile(cache.getCachePathName(), std::string(vStored.begin(), vStored.end() - 9));
+    UTEST_CHECK(!ScriptCache(strScript, strDirA).loadScript(sLoaded));
+    {
+        std::vector<char> vDamaged = vStored;
+        vDamaged.back() ^= 0x5A;
+        writeFile(cache.getCachePathName(), std::string(vDamaged.begin(), vDamaged.end()));
+        UTEST_CHECK(!ScriptCache(strScript, strDirA).loadScript(sLoaded));
+    }
+
+    // the intact entry is valid again
+    writeFile(cache.getCachePathName(), std::string(vStored.begin(), vStored.end()));
+    UTEST_CHECK(ScriptCache(strScript, strDirA).loadScript(sLoaded));
+
+    // the script changed: same size, one character differs
+    std::string strChanged = kScript;
+    strChanged[strChanged.find("ttyUSB0")] = 'T';
+    writeFile(strScript, strChanged);
+    UTEST_CHECK(!ScriptCache(strScript, strDirA).loadScript(sLoaded));
+
+    // the script changed between the load and the store: nothing is cached
+    {
+        ScriptCache racing(strScript, strDirA);
+        UTEST_CHECK(!racing.loadScript(sLoaded));
+        writeFile(strScript, kScript);
+        UTEST_CHECK(!racing.storeScript(sValidated));
+        UTEST_CHECK(readFile(racing.getCachePathName()) == vStored);
+    }
+
+    // a store without a load first is refused
+    UTEST_CHECK(!ScriptCache(strScript, strDirB).storeScript(sValidated));
+
+    fs::remove_all(dir);
+
+    return utest::result("script_cache");
+}
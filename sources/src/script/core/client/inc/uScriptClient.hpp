@@ -7,8 +7,11 @@
 #include "uScriptValidator.hpp"
 #include "uScriptInterpreter.hpp"
 #include "uScriptCommandValidator.hpp"
+#include "uScriptCache.hpp"
 #include "uScriptDataTypes.hpp"
 
+#include "uSharedConfig.hpp"
+#include "uIniCfgLoader.hpp"
 #include "uTimer.hpp"
 
 #include <string>
@@ -19,11 +22,17 @@ class ScriptClient
 {
     public:
 
-        explicit ScriptClient(const std::string& strScriptPathName, IniCfgLoader&& loader)
-            : m_shpScriptRunner (std::make_shared<ScriptRunner<ScriptEntriesType>> (
+        // strProfileReport / strTraceFile: profiler report / timeline trace
+        // pathname from the command line (empty: as configured in the .ini file)
+        explicit ScriptClient(const std::string& strScriptPathName, IniCfgLoader&& loader,
+                              const std::string& strProfileReport = std::string(),
+                              const std::string& strTraceFile = std::string())
+            : m_shpScriptCache  (m_createCache(strScriptPathName, loader))
+            , m_shpScriptRunner (std::make_shared<ScriptRunner<ScriptEntriesType>> (
                                         std::make_shared<ScriptReader>(strScriptPathName),
                                         std::make_shared<ScriptValidator>(std::make_shared<ScriptCommandValidator>()),
-                                        std::make_shared<ScriptInterpreter>(std::move(loader))
+                                        std::make_shared<ScriptInterpreter>(std::move(loader), strProfileReport, strTraceFile),
+                                        m_shpScriptCache
                                     )
                                 )
         {}
@@ -36,6 +45,25 @@ class ScriptClient
 
     private:
 
+        // compiled script cache, enabled by CACHE_ENABLED in the [SCRIPT]
+        // section; CACHE_DIR optionally moves the .usc files out of the
+        // script directory
+        static std::shared_ptr<ScriptCache> m_createCache(const std::string& strScriptPathName, IniCfgLoader& loader)
+        {
+            bool bCacheEnabled = false;
+            std::string strCacheDir;
+
+            if (loader.isLoaded() && loader.sectionExists(SCRIPT_INI_SECTION_NAME) && loader.loadSection(SCRIPT_INI_SECTION_NAME)) {
+                loader.getBoolFromIni(SCRIPT_INI_CACHE_ENABLE, bCacheEnabled);
+                if (bCacheEnabled) {
+                    loader.getStringFromIni(SCRIPT_INI_CACHE_DIR, strCacheDir);
+                }
+            }
+
+            return bCacheEnabled ? std::make_shared<ScriptCache>(strScriptPathName, strCacheDir) : nullptr;
+        }
+
+        std::shared_ptr<ScriptCache> m_shpScriptCache;
         std::shared_ptr<ScriptRunner<ScriptEntriesType>> m_shpScriptRunner;
 
 };
@@ -84,6 +84,12 @@ public:
                 break;
             }
 
+            // ASYNC is a keyword RHS as well: before the catch-all VAR_MACRO_INIT.
+            if (true == usyntax::m_isAsync(command) ) {
+                token = Token::ASYNC_STMT;
+                break;
+            }
+
             // Must be checked AFTER VARIABLE_MACRO (rhs PLUGIN.COMMAND wins) and
             // AFTER REPEAT (index-capture form wins).  Anything else of the form
             // "identifier ?= <value>" is a direct string initialisation.
@@ -132,11 +138,41 @@ public:
                 break;
             }
 
+            if (true == usyntax::m_isPeriod(command) ) {
+                token = Token::PERIOD_STMT;
+                break;
+            }
+
+            if (true == usyntax::m_isDelayUntil(command) ) {
+                token = Token::DELAY_UNTIL_STMT;
+                break;
+            }
+
             if (true == usyntax::m_isBreakpoint(command) ) {
                 token = Token::BREAKPOINT_STMT;
                 break;
             }
 
+            if (true == usyntax::m_isParallel(command) ) {
+                token = Token::PARALLEL;
+                break;
+            }
+
+            if (true == usyntax::m_isBranch(command) ) {
+                token = Token::BRANCH;
+                break;
+            }
+
+            if (true == usyntax::m_isEndParallel(command) ) {
+                token = Token::END_PARALLEL;
+                break;
+            }
+
+            if (true == usyntax::m_isAwait(command) ) {
+                token = Token::AWAIT_STMT;
+                break;
+            }
+
             token = Token::INVALID;
             bRetVal = false;
 
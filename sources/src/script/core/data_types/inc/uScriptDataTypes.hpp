@@ -6,6 +6,9 @@
 #include <variant>
 #include <unordered_map>
 
+#include "uScriptMacroTemplate.hpp"
+#include "IPlugin.hpp"
+
 /////////////////////////////////////////////////////////////////////////////////
 //                               DATATYPES                                     //
 /////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +36,13 @@ enum class Token {
     MATH_STMT,      // name ?= MATH <expression>   (arithmetic evaluator)
     VAR_MACRO_INIT, // name ?=  <string value> (direct initialisation)
     FORMAT_STMT,    // name ?= FORMAT input | format_pattern
+    PARALLEL,       // PARALLEL <label>
+    BRANCH,         // BRANCH                      (next branch of the PARALLEL block)
+    END_PARALLEL,   // END_PARALLEL <label>
+    ASYNC_STMT,     // handle ?= ASYNC PLUGIN.COMMAND <args>
+    AWAIT_STMT,     // AWAIT <handle> [TIMEOUT <value> <unit>]
+    PERIOD_STMT,    // PERIOD      <value> <unit>
+    DELAY_UNTIL_STMT,// DELAY_UNTIL <value> <unit>
     INVALID
 };
 
@@ -46,22 +56,50 @@ struct ScriptRawLine {
     std::string strContent;
 };
 
+// Jump target (index in vCommands) precomputed by the validator for IF..GOTO,
+// BREAK and CONTINUE.  kNoJump leaves the node to the label-scan fallback.
+inline constexpr size_t kNoJump = static_cast<size_t>(-1);
+
+// Direct handle to the plugin command a Command / MacroCommand executes.
+// Filled in by the interpreter once the plugins are loaded and the commands
+// cross-checked; pPlugin == nullptr means "look the plugin up by name" (shell
+// lines, or a plugin that was not loaded), szCommandId == kInvalidCommandId
+// means the plugin has no id based dispatch and doDispatch(name) is used.
+struct PluginCommandBinding {
+    PluginInterface *pPlugin     = nullptr;
+    size_t           szCommandId = PluginInterface::kInvalidCommandId;
+};
+
+// The s*Tpl members below hold the compiled form of the neighbouring raw
+// template string; they are filled in by ScriptValidator after all statements
+// have been parsed (see uScriptMacroTemplate.hpp).
+// uVarSlot is the variable slot of the macro a node writes, assigned by the
+// same validator pass (kNoSlot for nodes built outside the validator).
+
 struct MacroCommand {
     std::string strPlugin;
     std::string strCommand;
     std::string strParams;
     std::string strVarMacroName;
+    MacroTemplate sParamsTpl{};
+    uint32_t      uVarSlot = kNoSlot;
+    PluginCommandBinding sBinding{};
 };
 
 struct Command {
     std::string strPlugin;
     std::string strCommand;
     std::string strParams;
+    MacroTemplate sParamsTpl{};
+    PluginCommandBinding sBinding{};
 };
 
 struct Condition {
     std::string strCondition;
     std::string strLabelName;
+    MacroTemplate sConditionTpl{};
+    size_t      szTargetIndex = kNoJump;    // index of the LABEL node
+    uint32_t    uCondProgram  = kNoSlot;    // interpreter EVAL program (kNoSlot = none)
 };
 
 struct Label {
@@ -76,6 +114,8 @@ struct RepeatTimes {
     int         iCount;             // number of iterations (>= 1)
     std::string strCountExpr;       // raw "$macroname" — empty for literal counts
     std::string strVarMacroName;    // iteration-index capture macro (empty = no capture)
+    MacroTemplate sCountTpl{};      // compiled strCountExpr
+    uint32_t    uVarSlot = kNoSlot; // slot of strVarMacroName
 };
 
 // Repeat until <condition> becomes true (do-while semantics: body always runs at least once).
@@ -86,6 +126,9 @@ struct RepeatUntil {
     std::string strLabel;
     std::string strCondition;       // raw expression (may contain $macros, expanded at run time)
     std::string strVarMacroName;    // iteration-counter capture macro (empty = no capture)
+    MacroTemplate sConditionTpl{};  // compiled strCondition
+    uint32_t    uVarSlot = kNoSlot; // slot of strVarMacroName
+    uint32_t    uCondProgram = kNoSlot; // interpreter EVAL program (kNoSlot = none)
 };
 
 // Closing marker shared by both REPEAT counted and REPEAT UNTIL.
@@ -96,8 +139,12 @@ struct RepeatEnd {
 // BREAK <loop-label>
 // Immediately exits the named enclosing loop. All loops between the current
 // innermost and the named target are also unwound (their LoopStates are popped).
+// szTargetIndex / szUnwindDepth: index of the target END_REPEAT and number of
+// inner loops (between the BREAK and the target loop) to pop before it.
 struct LoopBreak {
     std::string strLabel;       // label of the enclosing loop to exit
+    size_t      szTargetIndex = kNoJump;
+    size_t      szUnwindDepth = 0;
 };
 
 // CONTINUE <loop-label>
@@ -106,6 +153,8 @@ struct LoopBreak {
 // All loops between the current innermost and the target are also unwound.
 struct LoopContinue {
     std::string strLabel;       // label of the enclosing loop to continue
+    size_t      szTargetIndex = kNoJump;    // same meaning as for LoopBreak
+    size_t      szUnwindDepth = 0;
 };
 
 // PRINT <text>
@@ -116,6 +165,7 @@ struct LoopContinue {
 // An empty PRINT (bare keyword with no text) prints a blank line.
 struct PrintStatement {
     std::string strText;        // raw text template (may contain $macros)
+    MacroTemplate sTextTpl{};   // compiled strText
 };
 
 // name ?= <string value>
@@ -125,11 +175,14 @@ struct PrintStatement {
 // indices, or array elements (e.g.  done ?= FALSE,  copy ?= $other,
 // first ?= $ARRAY.$0).
 // An empty value is valid and initialises the macro to an empty string.
-// Like MacroCommand, writes to m_RuntimeVarMacros at execution time, so the
+// Like MacroCommand, writes to m_vVarSlots at execution time, so the
 // value is immediately visible to all subsequent $macro lookups.
 struct VarMacroInit {
     std::string strName;        // macro name (identifier)
     std::string strValueTpl;    // raw value template (may contain $macros)
+    MacroTemplate sValueTpl{};  // compiled strValueTpl
+    uint32_t    uVarSlot = kNoSlot; // slot of strName
+    uint32_t    uCondProgram = kNoSlot; // interpreter EVAL program for "EVAL ..." values
 };
 
 // name ?= FORMAT input | format_pattern
@@ -139,11 +192,14 @@ struct VarMacroInit {
 // corresponding item.  Items may be reordered, repeated, or omitted freely.
 // Both the input and the format template may contain $macros; expansion is
 // deferred to execution time.
-// Stores the result string in m_RuntimeVarMacros[strName].
+// Stores the result string in the variable slot of strName.
 struct FormatStatement {
     std::string strName;        // destination macro name (identifier)
     std::string strInputTpl;    // raw input template   (may contain $macros)
     std::string strFormatTpl;   // raw format template  (may contain $macros and %N)
+    MacroTemplate sInputTpl{};  // compiled strInputTpl
+    MacroTemplate sFormatTpl{}; // compiled strFormatTpl
+    uint32_t    uVarSlot = kNoSlot; // slot of strName
 };
 
 // Time unit for a DELAY statement.
@@ -159,13 +215,33 @@ struct DelayStatement {
     DelayUnit eUnit;     // US | MS | SEC
 };
 
+// PERIOD <value> <unit>
+// Paces the enclosing loop against absolute deadlines: the first pass after
+// the loop was entered waits one period, every later pass waits until the
+// previous deadline plus one period, so the cadence does not drift with the
+// run time of the loop body.  A pass arriving a whole period late or more
+// restarts the timeline (an overrun).
+// strLoopLabel and uTimeline are filled in by the validator.
+struct PeriodStatement {
+    size_t      szPeriodUs = 0U;
+    std::string strLoopLabel{};         // innermost enclosing loop ("" = none)
+    uint32_t    uTimeline  = kNoSlot;   // index of the interpreter pacing state
+};
+
+// DELAY_UNTIL <value> <unit>
+// Waits until <value> after the start of the script execution; returns at
+// once when that moment has already passed.
+struct DelayUntilStatement {
+    size_t szOffsetUs = 0U;
+};
+
 // name ?= MATH <expression>
 // Native arithmetic evaluator — no plugin required.
 // The expression template is stored verbatim; $macro substitution is performed
 // at execution time so that variable macro values and loop indices are always
 // current.  After expansion the resulting string is fed to Calculator::evaluate()
 // and the returned double is converted to a string and stored in
-// m_RuntimeVarMacros[strName].
+// the variable slot of strName.
 //
 // The expression may use the full Calculator syntax: +, -, *, /, //, %, **,
 // comparison and logical operators, bitwise operators, the ternary operator,
@@ -177,10 +253,18 @@ struct DelayStatement {
 // Syntax:   result ?= MATH 2 + 3
 //           result ?= MATH $x * $y + 1
 //           result ?= MATH sqrt($val) + pi
+//
+// Before the dry run the interpreter compiles the expression once, with each
+// $macro as a numeric hole, and stores the index of the compiled program in
+// uProgram.  A line whose macros all hold plain numeric literals then runs
+// the cached program; anything else takes the expand-and-evaluate path.
 struct MathStatement {
     std::string strName;       // destination macro name (identifier)
     std::string strExprTpl;    // raw expression template (may contain $macros)
     bool        bHexOutput = false;
+    MacroTemplate sExprTpl{};  // compiled strExprTpl
+    uint32_t    uVarSlot = kNoSlot; // slot of strName
+    uint32_t    uProgram = kNoSlot; // interpreter MATH program (kNoSlot = none)
 };
 
 // BREAKPOINT [label]
@@ -199,6 +283,61 @@ struct MathStatement {
 // Inside a GOTO/BREAK/CONTINUE skip region it is also transparent.
 struct BreakpointStatement {
     std::string strLabelTpl;  // optional label template (may contain $macros; may be empty)
+    MacroTemplate sLabelTpl{};  // compiled strLabelTpl
+};
+
+// PARALLEL <label>
+//     BRANCH
+//         ...
+//     BRANCH
+//         ...
+// END_PARALLEL <label>
+// Runs the branches concurrently, each on its own worker thread with its own
+// loop stack and a private copy of the variable macros; the block fails if
+// any branch fails.  Variables assigned in a branch are published to the
+// script after the join (branch order, a later branch wins).
+// The validator guarantees that a branch is self-contained (no loop, GOTO,
+// BREAK or CONTINUE crosses its boundary), that no two branches of a block
+// use the same plugin and that blocks do not nest, and stores the indices
+// below: vBranchIndices holds the BRANCH nodes in order, szEndIndex the
+// END_PARALLEL node; a branch body runs from its BRANCH node + 1 up to the
+// szEndIndex of that BRANCH (the next BRANCH or the END_PARALLEL).
+struct ParallelBegin {
+    std::string         strLabel;
+    std::vector<size_t> vBranchIndices{};
+    size_t              szEndIndex = kNoJump;
+};
+
+struct ParallelBranch {
+    size_t szEndIndex = kNoJump;    // index of the node closing this branch
+};
+
+struct ParallelEnd {
+    std::string strLabel;
+};
+
+// handle ?= ASYNC PLUGIN.COMMAND [params]
+// Queues the command on the worker thread of its plugin and continues at
+// once; the commands of one plugin run in submission order, a plain command
+// of the same plugin first waits for them.  The result (getData) is stored
+// in the variable strHandle by the matching AWAIT, not before.
+struct AsyncCommand {
+    std::string strHandle;
+    std::string strPlugin;
+    std::string strCommand;
+    std::string strParams;
+    MacroTemplate sParamsTpl{};
+    uint32_t      uVarSlot = kNoSlot;   // slot of strHandle
+    PluginCommandBinding sBinding{};
+};
+
+// AWAIT <handle> [TIMEOUT <value> <unit>]
+// Waits for the ASYNC command of strHandle and stores its result; fails if
+// the command failed or did not complete within szTimeoutUs (0 = no limit).
+struct AwaitStatement {
+    std::string strHandle;
+    size_t      szTimeoutUs = 0U;
+    uint32_t    uVarSlot = kNoSlot;     // slot of strHandle
 };
 
 // ---------------------------------------------------------------------------
@@ -211,7 +350,10 @@ using ScriptCommandType = std::variant<MacroCommand, Command, Condition, Label,
                                        RepeatTimes, RepeatUntil, RepeatEnd,
                                        LoopBreak, LoopContinue, PrintStatement,
                                        VarMacroInit, FormatStatement, DelayStatement,
-                                       MathStatement, BreakpointStatement>;
+                                       MathStatement, BreakpointStatement,
+                                       ParallelBegin, ParallelBranch, ParallelEnd,
+                                       AsyncCommand, AwaitStatement,
+                                       PeriodStatement, DelayUntilStatement>;
 
 struct ScriptLine {
     int               iLineNumber = 0;
@@ -227,11 +369,23 @@ using PluginStorageType     = std::vector<PluginDataType>;
 // the $NAME.$index_macro syntax at runtime.
 using ArrayMacroStorageType = std::unordered_map<std::string, std::vector<std::string>>;
 
+// Symbol tables built by the validator: slot index → name.  Every variable
+// macro and loop index gets one variable slot (shared by all nodes using the
+// name); every array macro gets one array slot.
+using SlotNameStorageType   = std::vector<std::string>;
+
+// bFromCache is set when the entries were loaded from the compiled script
+// cache (uScriptCache.hpp): they passed the dry run of the run that stored
+// them, so the interpreter does not validate the commands again.
+
 struct ScriptEntries {
     PluginStorageType     vPlugins;
     MacroStorageType      mapMacros;
     ArrayMacroStorageType mapArrayMacros;
     CommandsStorageType   vCommands;
+    SlotNameStorageType   vVarSlots;
+    SlotNameStorageType   vArraySlots;
+    bool                  bFromCache = false;
 };
 
 using ScriptEntriesType = ScriptEntries;
@@ -261,6 +415,13 @@ inline const std::string& getTokenTypeName(Token type)
         case Token::MATH_STMT:      { static const std::string name = "MATH";           return name; }
         case Token::VAR_MACRO_INIT: { static const std::string name = "VAR_MACRO_INIT"; return name; }
         case Token::FORMAT_STMT:    { static const std::string name = "FORMAT";         return name; }
+        case Token::PARALLEL:       { static const std::string name = "PARALLEL";       return name; }
+        case Token::BRANCH:         { static const std::string name = "BRANCH";         return name; }
+        case Token::END_PARALLEL:   { static const std::string name = "END_PARALLEL";   return name; }
+        case Token::ASYNC_STMT:     { static const std::string name = "ASYNC_STMT";     return name; }
+        case Token::AWAIT_STMT:     { static const std::string name = "AWAIT_STMT";     return name; }
+        case Token::PERIOD_STMT:    { static const std::string name = "PERIOD_STMT";    return name; }
+        case Token::DELAY_UNTIL_STMT: { static const std::string name = "DELAY_UNTIL_STMT"; return name; }
         case Token::INVALID:        { static const std::string name = "INVALID";        return name; }
         default:                    { static const std::string name = "UNKNOWN";        return name; }
     }
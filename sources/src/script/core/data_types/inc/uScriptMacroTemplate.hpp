@@ -0,0 +1,240 @@
+#ifndef SCRIPTMACROTEMPLATE_HPP
+#define SCRIPTMACROTEMPLATE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <limits>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                        COMPILED MACRO TEMPLATES                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+// Slot index of a variable / array resolved by the validator's symbol pass.
+// kNoSlot marks a name that was not known at validation time (e.g. created
+// later from the interactive shell); those are looked up by name instead.
+inline constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+
+// ---------------------------------------------------------------------------
+// A $macro template pre-split by the validator into literal text and macro
+// references, so that runtime expansion is a single linear concatenation
+// instead of a regex scan repeated until nothing changes.
+//
+// Recognised references (same grammar as the runtime macro pattern):
+//   $NAME          → MACRO       (strText = NAME)
+//   $NAME.$INDEX   → ARRAY_ELEM  (strText = NAME, strIndex = INDEX)
+// Everything else, including a '$' not followed by an identifier, is LITERAL.
+// ---------------------------------------------------------------------------
+struct MacroSegment {
+    enum class Kind : uint8_t { LITERAL, MACRO, ARRAY_ELEM };
+
+    Kind        eKind = Kind::LITERAL;
+    std::string strText;        // literal text | macro name | array name
+    std::string strIndex;       // ARRAY_ELEM only: name of the index macro
+    uint32_t    uVarSlot   = kNoSlot;   // variable slot of strText
+    uint32_t    uArraySlot = kNoSlot;   // ARRAY_ELEM only: array slot of strText
+    uint32_t    uIndexSlot = kNoSlot;   // ARRAY_ELEM only: variable slot of strIndex
+};
+
+// bCompiled is false for IR nodes that did not pass through the validator
+// (e.g. lines built by the interactive shell); those are expanded through the
+// legacy regex path from their raw string instead.
+struct MacroTemplate {
+    std::vector<MacroSegment> vSegments;
+    size_t                    szLiteralSize = 0;   // sum of literal lengths (reserve hint)
+    bool                      bCompiled     = false;
+    bool                      bHasMacros    = false;
+};
+
+
+namespace umacro
+{
+
+inline bool isIdentStart(char c) noexcept
+{
+    return ((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) || (c == '_');
+}
+
+inline bool isIdentChar(char c) noexcept
+{
+    return isIdentStart(c) || ((c >= '0') && (c <= '9'));
+}
+
+// Length of the identifier starting at strInput[szPos] (0 if none).
+inline size_t identLength(std::string_view strInput, size_t szPos) noexcept
+{
+    if ((szPos >= strInput.size()) || !isIdentStart(strInput[szPos])) {
+        return 0;
+    }
+    size_t szEnd = szPos + 1;
+    while ((szEnd < strInput.size()) && isIdentChar(strInput[szEnd])) {
+        ++szEnd;
+    }
+    return szEnd - szPos;
+}
+
+
+/*-------------------------------------------------------------------------------
+  Split a raw template into segments.  Adjacent literal characters are merged
+  into a single segment so the runtime loop appends whole runs at once.
+-------------------------------------------------------------------------------*/
+
+inline MacroTemplate compileMacroTemplate(std::string_view strInput)
+{
+    MacroTemplate sTpl;
+    sTpl.bCompiled = true;
+
+    auto appendLiteral = [&sTpl](std::string_view sv) {
+        if (sv.empty()) {
+            return;
+        }
+        if (!sTpl.vSegments.empty() && (sTpl.vSegments.back().eKind == MacroSegment::Kind::LITERAL)) {
+            sTpl.vSegments.back().strText.append(sv);
+        } else {
+            sTpl.vSegments.push_back({MacroSegment::Kind::LITERAL, std::string(sv), {}});
+        }
+        sTpl.szLiteralSize += sv.size();
+    };
+
+    size_t szLitStart = 0;
+    size_t i = 0;
+
+    while (i < strInput.size()) {
+        if (strInput[i] != '$') {
+            ++i;
+            continue;
+        }
+
+        const size_t szNameLen = identLength(strInput, i + 1);
+        if (szNameLen == 0) {
+            ++i;    // lone '$' stays part of the literal run
+            continue;
+        }
+
+        appendLiteral(strInput.substr(szLitStart, i - szLitStart));
+
+        const size_t szNameEnd = i + 1 + szNameLen;
+        size_t szIndexLen = 0;
+        if ((szNameEnd + 1 < strInput.size()) && (strInput[szNameEnd] == '.') && (strInput[szNameEnd + 1] == '$')) {
+            szIndexLen = identLength(strInput, szNameEnd + 2);
+        }
+
+        if (szIndexLen > 0) {
+            sTpl.vSegments.push_back({MacroSegment::Kind::ARRAY_ELEM,
+                                      std::string(strInput.substr(i + 1, szNameLen)),
+                                      std::string(strInput.substr(szNameEnd + 2, szIndexLen))});
+            i = szNameEnd + 2 + szIndexLen;
+        } else {
+            sTpl.vSegments.push_back({MacroSegment::Kind::MACRO,
+                                      std::string(strInput.substr(i + 1, szNameLen)), {}});
+            i = szNameEnd;
+        }
+
+        sTpl.bHasMacros = true;
+        szLitStart = i;
+    }
+
+    appendLiteral(strInput.substr(szLitStart));
+
+    return sTpl;
+
+} /* compileMacroTemplate() */
+
+
+/*-------------------------------------------------------------------------------
+  Linear expansion of a compiled template into strOut.
+
+    fnResolve(name, uVarSlot)     -> const std::string*   (nullptr = unknown)
+    fnElement(array, uArraySlot, pIndexValue)
+                                  -> std::pair<bool, const std::string*>
+                                     pIndexValue = resolved index macro value
+                                                   (nullptr = index unknown)
+                                     first  = name denotes an array
+                                     second = element (nullptr = bad index)
+
+  Unknown references are copied through unexpanded, exactly as the regex path
+  leaves them.  For $NAME.$INDEX where NAME is not an array, NAME is expanded
+  and ".$INDEX" is then resolved as a plain macro, matching the result of the
+  regex path's second pass.
+
+  Returns true if any substituted value itself contains a '$', or follows a
+  '$' it turns into a new reference (a literal '$' right before a macro, e.g.
+  "$$NAME") — the caller must then rescan the result to keep the
+  nested-expansion semantics.
+-------------------------------------------------------------------------------*/
+
+template <typename FnResolve, typename FnElement>
+inline bool expandMacroTemplate(const MacroTemplate& sTpl, std::string& strOut,
+                                FnResolve&& fnResolve, FnElement&& fnElement)
+{
+    bool bNeedsRescan = false;
+
+    strOut.clear();
+    strOut.reserve(sTpl.szLiteralSize + (sTpl.vSegments.size() * 8U));
+
+    auto appendValue = [&strOut, &bNeedsRescan](const std::string& strValue) {
+        if (!bNeedsRescan) {
+            // a '$' in the value, or a '$' ending the text before it ("$$NAME")
+            // that the value completes to a new reference
+            const bool bJoinsSigil = !strOut.empty() && (strOut.back() == '$') &&
+                                     !strValue.empty() && isIdentStart(strValue.front());
+            bNeedsRescan = bJoinsSigil || (strValue.find('$') != std::string::npos);
+        }
+        strOut.append(strValue);
+    };
+
+    auto appendMacro = [&](const std::string& strName, uint32_t uSlot) {
+        if (const std::string *pValue = fnResolve(strName, uSlot)) {
+            appendValue(*pValue);
+        } else {
+            strOut.push_back('$');
+            strOut.append(strName);
+        }
+    };
+
+    for (const auto& seg : sTpl.vSegments) {
+        switch (seg.eKind) {
+            case MacroSegment::Kind::LITERAL: {
+                strOut.append(seg.strText);
+                break;
+            }
+            case MacroSegment::Kind::MACRO: {
+                appendMacro(seg.strText, seg.uVarSlot);
+                break;
+            }
+            case MacroSegment::Kind::ARRAY_ELEM: {
+                const std::string *pIndex = fnResolve(seg.strIndex, seg.uIndexSlot);
+                auto [bIsArray, pElem] = fnElement(seg.strText, seg.uArraySlot, pIndex);
+                if (bIsArray) {
+                    if (pElem != nullptr) {
+                        appendValue(*pElem);
+                    } else {
+                        strOut.push_back('$');
+                        strOut.append(seg.strText);
+                        strOut.append(".$");
+                        strOut.append(seg.strIndex);
+                    }
+                } else if (const std::string *pValue = fnResolve(seg.strText, seg.uVarSlot)) {
+                    appendValue(*pValue);
+                    strOut.push_back('.');
+                    appendMacro(seg.strIndex, seg.uIndexSlot);
+                } else {
+                    strOut.push_back('$');
+                    strOut.append(seg.strText);
+                    strOut.append(".$");
+                    strOut.append(seg.strIndex);
+                }
+                break;
+            }
+        }
+    }
+
+    return bNeedsRescan;
+
+} /* expandMacroTemplate() */
+
+} /* namespace umacro */
+
+#endif // SCRIPTMACROTEMPLATE_HPP
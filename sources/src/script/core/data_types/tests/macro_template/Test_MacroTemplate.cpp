@@ -0,0 +1,98 @@
+/**
+ * @file    Test_MacroTemplate.cpp
+ * @brief   Expansion of compiled macro templates (uScriptMacroTemplate.hpp): the
+ *          results the interpreter's former regex rescan produced, including the
+ *          cases where an expansion forms a new reference and must be rescanned
+ */
+
+#include "uScriptMacroTemplate.hpp"
+#include "uTestCheck.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+static const std::map<std::string, std::string> g_mapMacros {
+    {"X",     "Y"},
+    {"Y",     "Z"},
+    {"NUM",   "1abc"},
+    {"REF",   "$Y"},
+    {"TAIL",  "a$"},
+    {"B",     "bee"},
+    {"IDX",   "1"},
+    {"TWO",   "2"},
+    {"EMPTY", ""},
+};
+
+static const std::map<std::string, std::vector<std::string>> g_mapArrays {
+    {"ARR", {"zero", "one", "$X"}},
+};
+
+static bool expandOnce(const std::string& strInput, std::string& strOut)
+{
+    auto resolve = [](const std::string& strName, uint32_t) -> const std::string* {
+        auto it = g_mapMacros.find(strName);
+        return (it != g_mapMacros.end()) ? &it->second : nullptr;
+    };
+    auto element = [](const std::string& strArray, uint32_t, const std::string *pIndex) -> std::pair<bool, const std::string*> {
+        auto it = g_mapArrays.find(strArray);
+        if (it == g_mapArrays.end()) {
+            return {false, nullptr};
+        }
+        if ((pIndex == nullptr) || (std::stoul(*pIndex) >= it->second.size())) {
+            return {true, nullptr};
+        }
+        return {true, &it->second[std::stoul(*pIndex)]};
+    };
+
+    return umacro::expandMacroTemplate(umacro::compileMacroTemplate(strInput), strOut, resolve, element);
+}
+
+// what the interpreter does: expand, and rescan while an expansion asks for it
+static std::string expand(const std::string& strInput)
+{
+    std::string strOut;
+    bool bRescan = expandOnce(strInput, strOut);
+    for (int i = 0; bRescan && (i < 8); ++i) {
+        const std::string strAgain = strOut;
+        bRescan = expandOnce(strAgain, strOut);
+    }
+    return strOut;
+}
+
+int main()
+{
+    // plain references, unknown ones stay as written
+    UTEST_CHECK(expand("a $X b") == "a Y b");
+    UTEST_CHECK(expand("$X$B") == "Ybee");
+    UTEST_CHECK(expand("$UNKNOWN $X") == "$UNKNOWN Y");
+    UTEST_CHECK(expand("$EMPTY|") == "|");
+    UTEST_CHECK(expand("cost: 5$ $") == "cost: 5$ $");
+
+    // a value carrying its own reference is expanded again
+    UTEST_CHECK(expand("$REF") == "Z");
+
+    // a '$' ending the text before a reference: "$$X" -> "$Y" -> "Z"
+    std::string strOut;
+    UTEST_CHECK(expandOnce("$$X", strOut));
+    UTEST_CHECK(strOut == "$Y");
+    UTEST_CHECK(expand("$$X") == "Z");
+    UTEST_CHECK(expand("pre$$X.") == "preZ.");
+
+    // ... but not when the value cannot start an identifier
+    UTEST_CHECK(!expandOnce("$$NUM", strOut));
+    UTEST_CHECK(strOut == "$1abc");
+
+    // a value ending in '$' followed by a non-identifier is left alone
+    UTEST_CHECK(expand("$TAIL.") == "a$.");
+
+    // array elements, index resolved through a macro
+    UTEST_CHECK(expand("$ARR.$IDX") == "one");
+    UTEST_CHECK(expand("$ARR.$NOPE") == "$ARR.$NOPE");
+    UTEST_CHECK(expand("$X.$IDX") == "Y.1");
+
+    // an element carrying a reference
+    UTEST_CHECK(expand("[$ARR.$TWO]") == "[Y]");
+
+    return utest::result("macro_template");
+}
@@ -0,0 +1,71 @@
+#ifndef U_SCRIPT_ASYNC_HPP
+#define U_SCRIPT_ASYNC_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                       ASYNC PLUGIN COMMAND WORKERS                          //
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace uasync {
+
+// -----------------------------------------------------------------------------
+// Outcome of one ASYNC command: the dispatch status and, on success, the data
+// the plugin returned for it (getData).
+// -----------------------------------------------------------------------------
+struct Result
+{
+    bool        bOk = false;
+    std::string strValue;
+};
+
+// -----------------------------------------------------------------------------
+// Worker thread running the ASYNC commands of one plugin in submission order.
+// Its log lines are written as soon as they are complete (the logger stages
+// them per thread), so its output interleaves with the script thread line by
+// line.
+//
+// The constructor starts the thread (throws std::system_error if that is not
+// possible); the destructor runs the queued jobs to the end, then joins.
+// strName labels the thread in the timeline trace.
+// -----------------------------------------------------------------------------
+class PluginWorker
+{
+public:
+
+    explicit PluginWorker(std::string strName = std::string());
+    ~PluginWorker();
+
+    PluginWorker(const PluginWorker&)            = delete;
+    PluginWorker& operator=(const PluginWorker&) = delete;
+
+    // queue a job, its result is delivered through the returned future
+    std::future<Result> submit(std::function<Result()> job);
+
+    // block until the queue is empty and no job is running;
+    // returns false if there was nothing to wait for
+    bool waitIdle();
+
+private:
+
+    void m_run();
+
+    std::mutex                              m_mutex;
+    std::condition_variable                 m_cvWork;
+    std::condition_variable                 m_cvIdle;
+    std::deque<std::packaged_task<Result()>> m_queue;
+    bool                                    m_bBusy = false;
+    bool                                    m_bStop = false;
+    std::string                             m_strName;
+    std::thread                             m_thread;
+};
+
+} // namespace uasync
+
+#endif // U_SCRIPT_ASYNC_HPP
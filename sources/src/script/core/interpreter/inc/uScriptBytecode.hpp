@@ -0,0 +1,91 @@
+#ifndef U_SCRIPT_BYTECODE_HPP
+#define U_SCRIPT_BYTECODE_HPP
+
+#include "uScriptDataTypes.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                     COMPILED (BYTECODE) SCRIPT PROGRAM                      //
+/////////////////////////////////////////////////////////////////////////////////
+
+// -----------------------------------------------------------------------------
+// Operation codes of the compiled backend.
+//
+// Control flow is fully resolved at compile time: LABEL nodes are not emitted
+// and every jump carries the program counter it resumes at.  The branches of
+// a PARALLEL block run on the tree-walking interpreter of their worker, so
+// BRANCH / END_PARALLEL are not emitted either and PARALLEL jumps past them.
+// Every other statement has an opcode of its own.
+// -----------------------------------------------------------------------------
+enum class OpCode : uint8_t
+{
+    CALL,           // Command                 plugin dispatch
+    CALL_STORE,     // MacroCommand            plugin dispatch + store the result
+    CALL_ASYNC,     // AsyncCommand            queue the dispatch on the plugin worker
+    AWAIT,          // AwaitStatement          wait for an ASYNC command, store its result
+    JUMP_IF,        // Condition               IF <cond> GOTO: pc = uTarget when true
+    LOOP_TIMES,     // RepeatTimes             push loop state (label uLabel)
+    LOOP_UNTIL,     // RepeatUntil             push loop state (label uLabel)
+    LOOP_END,       // RepeatEnd               loop-back or pop (label uLabel)
+    BREAK,          // LoopBreak               unwind uArg + 1 loops, pc = uTarget
+    CONTINUE,       // LoopContinue            unwind uArg loops, run LOOP_END at uTarget
+    PRINT,          // PrintStatement
+    VAR_INIT,       // VarMacroInit
+    FORMAT,         // FormatStatement
+    MATH,           // MathStatement
+    BREAKPOINT,     // BreakpointStatement
+    DELAY,          // DelayStatement
+    PERIOD,         // PeriodStatement         pace the enclosing loop (label uLabel)
+    DELAY_UNTIL,    // DelayUntilStatement
+    PARALLEL        // ParallelBegin           run the branches, pc = uTarget
+};
+
+// -----------------------------------------------------------------------------
+// One instruction.  Plain data only: the operands (templates, names) stay in
+// the validated IR node pvNode points to, whose type follows from eOp.  Loop
+// labels are interned to integer ids and the line number is only formatted
+// when a log line is written.
+// -----------------------------------------------------------------------------
+struct Instruction
+{
+    OpCode      eOp     = OpCode::PRINT;
+    uint32_t    uNode   = 0U;       // index of the source ScriptLine in vCommands
+    int         iLineNr = 0;        // script line of the source node
+    uint32_t    uTarget = 0U;       // JUMP_IF / BREAK / CONTINUE / PARALLEL: resume program counter
+    uint32_t    uArg    = 0U;       // BREAK / CONTINUE: number of inner loops to unwind
+    uint32_t    uLabel  = kNoSlot;  // LOOP_* / BREAK / CONTINUE / PERIOD: interned loop label
+    const void *pvNode  = nullptr;  // statement of the source node
+
+    template <typename T>
+    const T& node() const noexcept
+    {
+        return *static_cast<const T*>(pvNode);
+    }
+};
+
+struct BytecodeProgram
+{
+    std::vector<Instruction> vCode;
+    uint32_t                 uNrLabels = 0U;    // number of interned loop labels
+
+    void clear()
+    {
+        vCode.clear();
+        uNrLabels = 0U;
+    }
+};
+
+
+namespace ubytecode {
+
+// Lower the validated IR into a dense instruction array.  The instructions
+// point into sScriptEntries, which must outlive sProgram unchanged.
+// Fails (and leaves sProgram empty) when a jump of the IR was not resolved by
+// the validator — the caller then keeps using the tree-walking interpreter.
+bool compileScript(const ScriptEntriesType& sScriptEntries, BytecodeProgram& sProgram);
+
+} // namespace ubytecode
+
+#endif // U_SCRIPT_BYTECODE_HPP
@@ -3,6 +3,9 @@
 
 #include "uSharedConfig.hpp"
 #include "uScriptDataTypes.hpp"
+#include "uScriptBytecode.hpp"
+#include "uScriptAsync.hpp"
+#include "uScriptProfiler.hpp"
 
 #include "IScriptInterpreterShell.hpp"
 #include "IPlugin.hpp"
@@ -11,9 +14,15 @@
 #include "uIniCfgLoader.hpp"
 #include "uPluginLoader.hpp"
 #include "uBoolEvaluator.hpp"
+#include "uCalculator.hpp"
 #include "uExprEvaluator.hpp"
 #include "uNumeric.hpp"
+#include "uTimer.hpp"
+#include "uTrace.hpp"
 
+#include <functional>
+#include <future>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -24,13 +33,41 @@ class ScriptInterpreter : public IScriptInterpreterShell<ScriptEntriesType>
 
 public:
 
-    explicit ScriptInterpreter(IniCfgLoader&& loader)
+    // strProfileReport / strTraceFile (command line) enable the profiler /
+    // the timeline trace and override the PROFILE / PROFILE_REPORT and
+    // TRACE / TRACE_FILE keys of the [SCRIPT] section
+    explicit ScriptInterpreter(IniCfgLoader&& loader, const std::string& strProfileReport = std::string(),
+                               const std::string& strTraceFile = std::string())
                 : m_IniCfgLoader(std::move(loader))
                 , m_PluginLoader(PluginPathGenerator(SCRIPT_PLUGINS_PATH, PLUGIN_PREFIX, SCRIPT_PLUGIN_EXTENSION),
                                  PluginEntryPointResolver(SCRIPT_PLUGIN_ENTRY_POINT_NAME, SCRIPT_PLUGIN_EXIT_POINT_NAME))
     {
         if (m_IniCfgLoader.loadSection(SCRIPT_INI_SECTION_NAME)) {
             m_IniCfgLoader.getNumFromIni (SCRIPT_INI_CMD_EXEC_DELAY,m_szDelay);
+            m_IniCfgLoader.getBoolFromIni(SCRIPT_INI_BYTECODE_EXEC,m_bBytecodeExec);
+            m_IniCfgLoader.getBoolFromIni(SCRIPT_INI_PARALLEL_PLUGIN_INIT,m_bParallelPluginInit);
+            m_IniCfgLoader.getNumFromIni (SCRIPT_INI_DELAY_SPIN_US,m_szDelaySpinUs);
+            m_IniCfgLoader.getBoolFromIni(SCRIPT_INI_PROFILE,m_bProfile);
+            if (m_bProfile) {
+                m_IniCfgLoader.getStringFromIni(SCRIPT_INI_PROFILE_REPORT,m_strProfileReport);
+            }
+            m_IniCfgLoader.getBoolFromIni(SCRIPT_INI_TRACE,m_bTrace);
+            if (m_bTrace) {
+                m_IniCfgLoader.getStringFromIni(SCRIPT_INI_TRACE_FILE,m_strTraceFile);
+            }
+        }
+        if (false == strProfileReport.empty()) {
+            m_bProfile = true;
+            m_strProfileReport = strProfileReport;
+        }
+        if (false == strTraceFile.empty()) {
+            m_bTrace = true;
+            m_strTraceFile = strTraceFile;
+        }
+        if (m_bTrace) {
+            // handed to the plugins with their parameters (m_loadPlugin)
+            m_shpTracer = std::make_shared<utrace::TraceSession>();
+            utrace::setTracer(m_shpTracer);
         }
     }
 
@@ -43,6 +80,12 @@ public:
 
 private:
 
+    // Branch interpreter of a PARALLEL block (see m_runParallel): works on the
+    // script entries and bound plugins of parent, with its own loop stack and
+    // a copy of the variables, MATH variables and compiled programs of parent.
+    struct BranchTag {};
+    ScriptInterpreter(BranchTag, const ScriptInterpreter& parent);
+
     // -------------------------------------------------------------------------
     // Reason for the current forward-skip (all three share m_strSkipUntilLabel
     // as the target name; the reason controls which node type clears the skip).
@@ -58,16 +101,33 @@ private:
     // -------------------------------------------------------------------------
     enum class SkipReason { NONE, GOTO, CONTINUE_LOOP, BREAK_LOOP };
 
+    // -------------------------------------------------------------------------
+    // Storage for one variable slot (see ScriptEntries::vVarSlots).
+    //
+    // A slot carries two tiers: the script-level value written by assignments
+    // and the loop-scoped binding of an active REPEAT iteration-index macro.
+    // The loop binding wins while uLoopDepth > 0, giving C-style block scope:
+    // the index is invisible once its loop exits and the script-level value
+    // (if any) shows through again.
+    // -------------------------------------------------------------------------
+    struct VarSlot {
+        std::string  strName;
+        std::string  strValue;          // script-level value
+        bool         bDefined = false;  // strValue has been written
+        std::string  strLoopValue;      // innermost active loop binding
+        uint32_t     uLoopDepth = 0U;   // number of active loops binding this slot
+    };
+
     // -------------------------------------------------------------------------
     // Runtime state for a single active loop.
     //
-    // mapLoopMacros holds all variable macros that are scoped to this loop —
-    // currently the single iteration-index macro (if strVarMacroName is set).
-    // The map is destroyed automatically when this LoopState is popped from
-    // m_loopStateStack, giving C-style block scope semantics: a macro declared
-    // inside a loop is invisible once the loop exits.  An inner-loop macro with
-    // the same name shadows an outer-loop macro for the duration of the inner
-    // loop, then the outer value becomes visible again on pop.
+    // uVarSlot is the slot bound to the iteration-index macro (if
+    // strVarMacroName is set).  The binding is released when this LoopState is
+    // popped via m_popLoopState, giving C-style block scope semantics: a macro
+    // declared inside a loop is invisible once the loop exits.  An inner-loop
+    // macro with the same name shadows an outer-loop macro for the duration of
+    // the inner loop (the outer value is parked in strShadowedValue), then the
+    // outer value becomes visible again on pop.
     // -------------------------------------------------------------------------
     struct LoopState {
         std::string  strLabel;          // loop label (matches the REPEAT node)
@@ -75,19 +135,96 @@ private:
         int          iRemaining;        // REPEAT N: iterations left;  REPEAT UNTIL: unused (-1)
         bool         bIsUntil;          // true → REPEAT UNTIL  |  false → REPEAT N
         std::string  strCondition;      // REPEAT UNTIL: raw condition template (may hold $macros)
+        MacroTemplate sConditionTpl;    // REPEAT UNTIL: compiled strCondition
+        uint32_t     uCondProgram;      // REPEAT UNTIL: compiled EVAL condition (kNoSlot = none)
         std::string  strVarMacroName;   // name of the iteration-index macro ("" = no capture)
         uint64_t     uIterationCount;   // 0-based current iteration index
+        uint32_t     uVarSlot;          // slot of strVarMacroName (kNoSlot = no capture / not yet bound)
+        std::string  strShadowedValue;  // outer loop binding of the same slot, restored on pop
+        uint64_t     uEntry = 0U;       // serial number of this loop entry (PERIOD timelines)
+        uint32_t     uLabelId = kNoSlot; // bytecode backend: interned strLabel (kNoSlot: compare the names)
+    };
 
-        // Macros scoped to this loop iteration.  Lifetime == enclosing LoopState.
-        std::unordered_map<std::string, std::string> mapLoopMacros;
+    // -------------------------------------------------------------------------
+    // Pacing state of one PERIOD statement (PeriodStatement::uTimeline).
+    // A timeline belongs to one entry of the enclosing loop: the first pass
+    // of a new entry starts it again.
+    // -------------------------------------------------------------------------
+    struct PeriodTimeline {
+        bool         bStarted = false;
+        uint64_t     uLoopEntry = 0U;   // LoopState::uEntry the timeline belongs to
+        int64_t      iDeadlineNs = 0;   // deadline of the last pass (utime::monotonic_ns)
+        size_t       szPeriodUs = 0U;
+        size_t       szOverruns = 0U;   // passes a whole period late (timeline restarted)
+        int          iLineNr = 0;       // script line of the PERIOD statement
+        utime::JitterStats sStats;      // lateness of the passes that waited
     };
 
     bool m_loadPlugin(PluginDataType& command, bool bInitEnable) noexcept;
     bool m_loadPlugins () noexcept;
     bool m_crossCheckCommands() noexcept;
+
+    // Store the plugin instance and pre-resolved command id in every
+    // Command / MacroCommand (run once, after m_crossCheckCommands).
+    void m_bindPluginCommands() noexcept;
+    bool m_dispatchPluginCommand(PluginInterface *pPlugin, const PluginCommandBinding& sBinding,
+                                 const std::string& strCommand, const std::string& strParams) const noexcept;
     bool m_initPlugins() noexcept;
     bool m_enablePlugins() noexcept;
+
+    // Run fnStep (doInit / doEnable + its logs) for every loaded plugin,
+    // stopping at the first failure.  With PARALLEL_PLUGIN_INIT the plugins
+    // declaring isConcurrentInitSafe() (privileged ones excepted) run first on
+    // a small worker pool; their logs are captured and replayed in plugin
+    // order, interleaved with the sequential plugins, so the output and the
+    // reported failure are the same for every run.
+    bool m_runPluginPhase(const std::function<bool(PluginDataType&)>& fnStep) noexcept;
     void m_replaceVariableMacros(std::string& input);
+
+    // Resolve a macro through all scope tiers (loop binding, then runtime
+    // value of its slot, then shell variables).  uSlot may be kNoSlot, in which
+    // case the slot is looked up by name.  Returns nullptr when unknown.
+    const std::string* m_resolveVariableMacro(const std::string& strName, uint32_t uSlot = kNoSlot) const noexcept;
+
+    // Symbol-slot helpers.
+    // m_bindSymbolSlots: (re)build the slot tables from the validator output.
+    // m_varSlotOf:       slot of a name, appended on first use (shell lines).
+    // m_setVariable:     write the script-level value of a variable.
+    // m_popLoopState:    pop the innermost loop and release its index binding.
+    void m_bindSymbolSlots() noexcept;
+    uint32_t m_varSlotOf(const std::string& strName);
+    void m_setVariable(uint32_t uSlot, const std::string& strName, std::string strValue);
+    void m_popLoopState() noexcept;
+
+    // Pop the szDepth innermost loops for a BREAK / CONTINUE with a
+    // precomputed target; fails if the target loop is not then on top.
+    // The bytecode backend identifies the target by its interned label id.
+    bool m_unwindLoops(size_t szDepth, const std::string& strTargetLabel, uint32_t uLabelId = kNoSlot) noexcept;
+
+    // Expand a template compiled by the validator into strOut with a single
+    // linear pass.  Falls back to m_replaceVariableMacros on strRaw for
+    // templates that were never compiled (shell-built lines) and rescans the
+    // result only when a substituted value itself contains a $macro.
+    void m_expandMacros(const MacroTemplate& sTpl, const std::string& strRaw, std::string& strOut);
+
+    // MATH programs.
+    // m_compileMathStatements: compile every validated MATH line once, each
+    //                          $macro becoming a hole (run before the dry run).
+    // m_loadMathHoles:         fill m_vMathHoles for a compiled line; false if
+    //                          a macro does not hold a plain numeric literal.
+    void m_compileMathStatements() noexcept;
+    bool m_loadMathHoles(const MathStatement& command) noexcept;
+
+    // EVAL conditions, compiled the same way (m_compileConditions) and run
+    // through m_evalConditionTpl, which falls back to expanding the template
+    // and m_evaluateCondition.  On failure strExpanded holds the expanded text.
+    void m_compileConditions() noexcept;
+    bool m_evalConditionTpl(const MacroTemplate& sTpl, const std::string& strRaw, uint32_t uCondProgram,
+                            bool& bResult, std::string& strExpanded) noexcept;
+
+    // Value of a macro segment used as a hole, nullptr if the textual
+    // expansion would not simply substitute it.
+    const std::string* m_resolveHoleValue(const MacroSegment& seg) const noexcept;
     bool m_retrieveScriptSettings() noexcept;
     bool m_executeScript() noexcept;
 
@@ -95,6 +232,74 @@ private:
     // Called from the normal END_REPEAT path and from the CONTINUE path.
     void m_runEndRepeat(size_t& iIndex, bool& bRetVal) noexcept;
 
+    // Statement handlers shared by m_executeCommand and m_executeBytecode.
+    // iLineNr is the script line, formatted ("NNNN:") only when a log line is
+    // written; szBeginIndex is the position of the REPEAT node in the sequence
+    // being executed and uLabelId the interned loop label of the bytecode
+    // backend (kNoSlot for the IR interpreter).
+    template <typename T>
+    bool m_runPluginCommand(const T& command, PluginInterface *pPlugin, int iLineNr) noexcept;
+    bool m_evalJumpCondition(const Condition& command, int iLineNr, bool& bJump) noexcept;
+    bool m_enterRepeatTimes(const RepeatTimes& command, size_t szBeginIndex, int iLineNr,
+                            uint32_t uLabelId = kNoSlot) noexcept;
+    void m_enterRepeatUntil(const RepeatUntil& command, size_t szBeginIndex, int iLineNr,
+                            uint32_t uLabelId = kNoSlot) noexcept;
+    void m_runDelay(const DelayStatement& command, int iLineNr) noexcept;
+    bool m_runVarInit(const VarMacroInit& command, int iLineNr) noexcept;
+    bool m_runFormat(const FormatStatement& command, int iLineNr) noexcept;
+    bool m_runMath(const MathStatement& command, int iLineNr) noexcept;
+    bool m_runBreakpoint(const BreakpointStatement& command, int iLineNr) noexcept;
+
+    // PARALLEL blocks.
+    // m_runParallel:           run every branch on its own worker thread (one
+    //                          branch interpreter each), join, publish the
+    //                          variables the branches wrote; false if any failed.
+    // m_executeBranch:         run the IR range [szBegin, szEnd) of a branch.
+    // m_publishBranchVariables: copy the variables written by a branch.
+    bool m_runParallel(const ParallelBegin& command, int iLineNr) noexcept;
+    bool m_executeBranch(size_t szBegin, size_t szEnd) noexcept;
+    void m_publishBranchVariables(const ScriptInterpreter& branch);
+
+    // Timing engine: absolute deadlines (utime::sleep_until_ns), the last
+    // m_szDelaySpinUs of each wait busy-waited.
+    // m_waitFor:       wait szUs from now, returns the lateness (ns).
+    // m_runPeriod:     PERIOD: wait for the next deadline of its timeline
+    //                  (uLoopLabelId: interned label of the enclosing loop).
+    // m_runDelayUntil: DELAY_UNTIL: wait for an offset from the run start.
+    // m_reportTiming:  log the lateness statistics at the end of the run.
+    int64_t m_waitFor(size_t szUs) noexcept;
+    void m_runPeriod(const PeriodStatement& command, int iLineNr, uint32_t uLoopLabelId = kNoSlot) noexcept;
+    void m_runDelayUntil(const DelayUntilStatement& command, int iLineNr) noexcept;
+    void m_reportTiming() const noexcept;
+
+    // ASYNC / AWAIT.
+    // m_runAsync:             queue the command on the worker of its plugin
+    //                         (started on first use).
+    // m_runAwait:             wait for the command of a handle, store its result.
+    // m_waitAsyncIdle:        let the queued ASYNC commands of a plugin finish
+    //                         before a plain command of that plugin runs.
+    // m_finishAsyncCommands:  end of run: wait for the commands still pending
+    //                         and stop the workers.
+    bool m_runAsync(const AsyncCommand& command, PluginInterface *pPlugin, int iLineNr) noexcept;
+    bool m_runAwait(const AwaitStatement& command, int iLineNr) noexcept;
+    void m_waitAsyncIdle(PluginInterface *pPlugin, int iLineNr) noexcept;
+    void m_finishAsyncCommands() noexcept;
+
+    // Profiler report: source line and text of every IR line, then the
+    // table / JSON / CSV files (see uprofile::Profiler::writeReport).
+    std::vector<uprofile::LineInfo> m_profileLineInfo() const;
+    void m_writeProfileReport(int64_t iRunNs) noexcept;
+
+    // Bracket the execution of an IR line for the profiler and the trace.
+    void m_lineBegin(size_t szLine) noexcept;
+    void m_lineEnd() noexcept;
+
+    // Timeline trace of the real run (Chrome trace event format).
+    // m_startTrace: name the IR lines, activate the session.
+    // m_writeTrace: stop the session, write m_strTraceFile.
+    void m_startTrace();
+    void m_writeTrace() noexcept;
+
     // Build per-plugin O(1) command-set lookup used by m_crossCheckCommands.
     // Maps plugin name → unordered_set of supported command names.
     void m_buildPluginCommandIndex() noexcept;
@@ -103,6 +308,11 @@ private:
     // to implement backward jumps.
     bool m_executeCommand(ScriptLine& data, bool bRealExec, size_t& iIndex) noexcept;
     bool m_executeCommands(bool bRealExec) noexcept;
+    void m_resetExecutionState() noexcept;
+
+    // Real execution through m_sBytecode (compiled after the dry run when
+    // BYTECODE_EXEC is enabled in the [SCRIPT] section of the .ini file).
+    bool m_executeBytecode() noexcept;
     bool m_pluginIsLoaded(const std::string& strPluginName) noexcept;
 
     // Unified condition evaluator — handles both plain boolean expressions
@@ -139,23 +349,41 @@ private:
     // members (internals)
     bool m_bIniConfigAvailable = true;
     size_t m_szDelay = 0U;
+    bool m_bBytecodeExec = false;       // compiled backend requested (.ini)
+    bool m_bParallelPluginInit = false; // concurrent plugin init / enable requested (.ini)
+    size_t m_szDelaySpinUs = 0U;        // busy-wait window before each deadline (.ini)
+    bool m_bProfile = false;            // per-line profiler requested (.ini / command line)
+    std::string m_strProfileReport = SCRIPT_PROFILE_REPORT_DEFAULT;
+    bool m_bTrace = false;              // timeline trace requested (.ini / command line)
+    std::string m_strTraceFile = SCRIPT_TRACE_FILE_DEFAULT;
+    bool m_bBytecodeReady = false;      // m_sBytecode holds the current script
+    BytecodeProgram m_sBytecode;
     ScriptEntriesType *m_sScriptEntries = nullptr;
     std::string m_strSkipUntilLabel;
     SkipReason  m_eSkipReason = SkipReason::NONE;
 
-    // Runtime loop-state stack implemented as a vector so that
-    // m_replaceVariableMacros can walk it from innermost to outermost scope.
+    // Runtime loop-state stack.
     // back() == top of stack; push_back/pop_back maintain LIFO order.
     std::vector<LoopState> m_loopStateStack;
 
-    // Runtime variable macro values: populated as each MacroCommand dispatches
-    // successfully or when a VarMacroInit node executes.
-    // Keyed by strVarMacroName; value is the string returned by getData().
-    // Using a dedicated map rather than a field inside the IR structs gives
-    // correct last-EXECUTED semantics: when the same macro name appears multiple
-    // times in the script the map always holds the value most recently written
-    // at runtime.
-    std::unordered_map<std::string, std::string> m_RuntimeVarMacros;
+    // Runtime variable macro values, indexed by the slot the validator
+    // assigned (ScriptEntries::vVarSlots).  Populated as each MacroCommand
+    // dispatches successfully or when a VarMacroInit / MATH / FORMAT node
+    // executes.  Keeping values outside the IR structs gives correct
+    // last-EXECUTED semantics: when the same macro name appears multiple times
+    // in the script its slot always holds the value most recently written.
+    // Names unknown to the validator (shell lines) get slots appended on
+    // first write; m_mapVarSlotIndex serves those name-based lookups.
+    std::vector<VarSlot> m_vVarSlots;
+    std::unordered_map<std::string, uint32_t> m_mapVarSlotIndex;
+
+    // Branch interpreters only: slots written by m_setVariable, published to
+    // the parent after the join (empty, thus not tracked, otherwise).
+    std::vector<char> m_vSlotWritten;
+
+    // Array macro element vectors indexed by array slot.  Points into
+    // ScriptEntries::mapArrayMacros, whose nodes are stable.
+    std::vector<const std::vector<std::string>*> m_vArraySlots;
 
     // Per-plugin command set index: plugin name → set of supported command names.
     // Built once in m_crossCheckCommands for O(1) membership tests.
@@ -169,9 +397,49 @@ private:
     // Persistent variable map shared across all MATH statements in the script.
     // Allows intra-expression assignments (e.g. MATH x = 5 + 3) to be visible
     // in subsequent MATH evaluations as plain identifiers.
-    // Calculator built-in constants (pi, e, tau, phi, inf, nan) are seeded on
-    // first use by Calculator's constructor via try_emplace.
+    // Calculator built-in constants (pi, e, tau, phi, inf, nan) are seeded
+    // via try_emplace by m_compileMathStatements and by Calculator's constructor.
     std::unordered_map<std::string, double> m_mathVars;
+
+    // Compiled MATH expressions, indexed by MathStatement::uProgram.
+    // vHoleSegments[n] is the expression template segment feeding hole $<n>.
+    struct MathProgram {
+        CalcProgram           sProgram;
+        std::vector<uint32_t> vHoleSegments;
+    };
+    std::vector<MathProgram> m_vMathPrograms;
+    std::vector<double>      m_vMathHoles;     // hole values of the line being run
+
+    // Compiled EVAL conditions, indexed by uCondProgram of Condition,
+    // RepeatUntil (and their LoopState) and VarMacroInit.
+    struct CondProgram {
+        EvalProgram           sProgram;
+        std::vector<uint32_t> vHoleSegments;
+    };
+    std::vector<CondProgram>        m_vCondPrograms;
+    std::vector<const std::string*> m_vCondHoles;   // hole values of the condition being run
+
+    // Timing: DELAY_UNTIL origin, loop entry serials, lateness statistics.
+    int64_t  m_iRunStartNs = 0;
+    uint64_t m_uLoopEntries = 0U;
+    std::vector<PeriodTimeline> m_vPeriodTimelines;
+    utime::JitterStats m_sDelayStats;   // DELAY / DELAY_UNTIL waits
+
+    // Per-line execution profile of the real run (enabled by m_bProfile).
+    uprofile::Profiler m_sProfiler;
+
+    // Timeline trace: the session (m_bTrace), active only during the real
+    // run (m_pTrace set), the event name of every IR line ("NNNN: text",
+    // shared with the branch interpreters) and the line being executed.
+    std::shared_ptr<utrace::TraceSession>       m_shpTracer;
+    utrace::TraceSession                       *m_pTrace = nullptr;
+    std::shared_ptr<const std::vector<std::string>> m_shpTraceNames;
+    size_t                                      m_szTraceLine = SIZE_MAX;
+    int64_t                                     m_iTraceLineNs = 0;
+
+    // ASYNC commands: one worker per plugin, pending results by handle slot.
+    std::unordered_map<PluginInterface*, std::unique_ptr<uasync::PluginWorker>> m_mapAsyncWorkers;
+    std::unordered_map<uint32_t, std::future<uasync::Result>>                   m_mapAsyncPending;
 };
 
 #endif // U_SCRIPT_INTERPRETER_HPP
@@ -0,0 +1,174 @@
+#ifndef U_SCRIPT_PROFILER_HPP
+#define U_SCRIPT_PROFILER_HPP
+
+#include "uTimer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                          PER-LINE EXECUTION PROFILER                        //
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace uprofile {
+
+// -----------------------------------------------------------------------------
+// Parts of the execution of a line accounted for separately; the rest of
+// the time of a line is the statement itself (bookkeeping, logging).
+// -----------------------------------------------------------------------------
+enum class Phase : uint8_t
+{
+    DISPATCH,   // plugin doDispatch (and getData for ?= commands)
+    MACRO,      // $macro expansion outside of conditions
+    CONDITION,  // IF / REPEAT UNTIL / EVAL conditions, their macros included
+    DELAY,      // DELAY, PERIOD, DELAY_UNTIL and the inter-command delay
+    COUNT
+};
+
+// -----------------------------------------------------------------------------
+// Latency histogram with log-linear buckets: 8 buckets per power of two,
+// so a percentile is known within 1/8 of its value.  Values below 8 ns
+// get a bucket each; everything above ~2.4 hours lands in the last one.
+// -----------------------------------------------------------------------------
+class Histogram
+{
+public:
+
+    static constexpr uint32_t kSubBits   = 3U;
+    static constexpr uint32_t kMaxExp    = 42U;
+    static constexpr size_t   kBuckets   = (kMaxExp - kSubBits + 2U) << kSubBits;
+
+    void add(uint64_t uNs) noexcept { ++m_aBuckets[indexOf(uNs)]; }
+    void merge(const Histogram& other) noexcept;
+
+    // value below which dPercent % of the uCount samples fall (bucket middle)
+    uint64_t percentile(double dPercent, uint64_t uCount) const noexcept;
+
+    static size_t indexOf(uint64_t uNs) noexcept;
+
+private:
+
+    std::array<uint32_t, kBuckets> m_aBuckets{};
+};
+
+// -----------------------------------------------------------------------------
+// Statistics of one IR line (index in ScriptEntries::vCommands).
+// -----------------------------------------------------------------------------
+struct LineStats
+{
+    uint64_t  uCount   = 0U;
+    uint64_t  uTotalNs = 0U;
+    uint64_t  uMinNs   = UINT64_MAX;
+    uint64_t  uMaxNs   = 0U;
+    std::array<uint64_t, static_cast<size_t>(Phase::COUNT)> aPhaseNs{};
+    Histogram sHistogram;
+};
+
+// -----------------------------------------------------------------------------
+// Report description of a line, supplied by the interpreter.
+// -----------------------------------------------------------------------------
+struct LineInfo
+{
+    int         iLineNumber = 0;
+    std::string strText;
+};
+
+// -----------------------------------------------------------------------------
+// Collects the time spent on every IR line of a run.  The executor brackets
+// each line with beginLine / endLine; the handlers add the phases through
+// ScopedPhase.  Phases do not nest: a phase started inside another one is
+// accounted to the outer phase.
+//
+// Statistics are preallocated by reset() for the line range [szFirst,
+// szEnd), so recording never allocates.  A disabled profiler (the default)
+// costs one test per call and reads no clock.  Not thread safe: every
+// interpreter (PARALLEL branches included) owns one, merged after the join.
+// -----------------------------------------------------------------------------
+class Profiler
+{
+public:
+
+    bool enabled() const noexcept { return m_bEnabled; }
+
+    void reset(size_t szFirst, size_t szEnd);
+    void disable() noexcept { m_bEnabled = false; }
+
+    void beginLine(size_t szLine) noexcept
+    {
+        if (m_bEnabled) {
+            m_szLine  = szLine;
+            m_iLineNs = utime::monotonic_ns();
+        }
+    }
+
+    void endLine() noexcept;
+
+    bool enterPhase() noexcept
+    {
+        if (!m_bEnabled || m_bInPhase) {
+            return false;
+        }
+        m_bInPhase = true;
+        return true;
+    }
+
+    void leavePhase() noexcept { m_bInPhase = false; }
+    void addPhase(Phase ePhase, int64_t iNs) noexcept;
+
+    void merge(const Profiler& other) noexcept;
+
+    // Write <strBase>.txt (table sorted by total time), <strBase>.json and
+    // <strBase>.csv; vInfo is indexed by IR line, uRunNs is the duration of
+    // the run.  Also logs the slowest lines.
+    bool writeReport(const std::string& strBase, const std::vector<LineInfo>& vInfo, uint64_t uRunNs) const;
+
+private:
+
+    const LineStats* m_statsOf(size_t szLine) const noexcept;
+
+    bool                   m_bEnabled = false;
+    bool                   m_bInPhase = false;
+    size_t                 m_szFirst  = 0U;
+    size_t                 m_szLine   = SIZE_MAX;
+    int64_t                m_iLineNs  = 0;
+    std::vector<LineStats> m_vStats;
+};
+
+// -----------------------------------------------------------------------------
+// Adds the lifetime of the object to a phase of the current line.
+// -----------------------------------------------------------------------------
+class ScopedPhase
+{
+public:
+
+    ScopedPhase(Profiler& sProfiler, Phase ePhase) noexcept
+        : m_pProfiler(sProfiler.enterPhase() ? &sProfiler : nullptr)
+        , m_ePhase(ePhase)
+        , m_iStartNs(m_pProfiler ? utime::monotonic_ns() : 0)
+    {
+    }
+
+    ~ScopedPhase()
+    {
+        if (m_pProfiler) {
+            m_pProfiler->addPhase(m_ePhase, utime::monotonic_ns() - m_iStartNs);
+            m_pProfiler->leavePhase();
+        }
+    }
+
+    ScopedPhase(const ScopedPhase&)            = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+
+    Profiler *m_pProfiler;
+    Phase     m_ePhase;
+    int64_t   m_iStartNs;
+};
+
+} // namespace uprofile
+
+#endif // U_SCRIPT_PROFILER_HPP
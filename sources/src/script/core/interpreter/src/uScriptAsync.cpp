@@ -0,0 +1,102 @@
+#include "uScriptAsync.hpp"
+#include "uTrace.hpp"
+
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            PUBLIC INTERFACE                                 //
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace uasync {
+
+/*-------------------------------------------------------------------------------
+  The thread is started last, once every member it uses is constructed.
+-------------------------------------------------------------------------------*/
+
+PluginWorker::PluginWorker(std::string strName)
+    : m_strName(std::move(strName))
+    , m_thread(&PluginWorker::m_run, this)
+{
+}
+
+
+PluginWorker::~PluginWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_cvWork.notify_one();
+    m_thread.join();
+
+} /* ~PluginWorker() */
+
+
+
+std::future<Result> PluginWorker::submit(std::function<Result()> job)
+{
+    std::packaged_task<Result()> task(std::move(job));
+    std::future<Result> future = task.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(task));
+    }
+    m_cvWork.notify_one();
+
+    return future;
+
+} /* submit() */
+
+
+
+bool PluginWorker::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_queue.empty() && !m_bBusy) {
+        return false;
+    }
+    m_cvIdle.wait(lock, [this]() { return m_queue.empty() && !m_bBusy; });
+
+    return true;
+
+} /* waitIdle() */
+
+
+/*-------------------------------------------------------------------------------
+  Jobs are taken one at a time; the queue is drained before a stop request
+  is honoured.
+-------------------------------------------------------------------------------*/
+
+void PluginWorker::m_run()
+{
+    if (auto shpTracer = utrace::getTracer(); shpTracer && !m_strName.empty()) {
+        shpTracer->name_thread(m_strName);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;) {
+        m_cvWork.wait(lock, [this]() { return m_bStop || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            break;  // stop requested, nothing left to run
+        }
+
+        std::packaged_task<Result()> task = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_bBusy = true;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        m_bBusy = false;
+        if (m_queue.empty()) {
+            m_cvIdle.notify_all();
+        }
+    }
+
+} /* m_run() */
+
+} // namespace uasync
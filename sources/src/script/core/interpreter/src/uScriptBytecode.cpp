@@ -0,0 +1,186 @@
+#include "uScriptBytecode.hpp"
+
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            LOCAL FUNCTIONS                                  //
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/*-------------------------------------------------------------------------------
+  Opcode and operand of an IR node, and for the jumps the IR index of their
+  target; pstrLabel is the loop label to intern (nullptr if none).
+  bEmit is cleared for nodes that are not emitted (LABEL, BRANCH, END_PARALLEL).
+  Returns false for unresolved jumps (szIrTarget == kNoJump).
+-------------------------------------------------------------------------------*/
+
+bool lowerNode(const ScriptLine& data, Instruction& sInstr, size_t& szIrTarget,
+               const std::string *&pstrLabel, bool& bEmit)
+{
+    bool bRetVal = true;
+    bEmit        = true;
+    szIrTarget   = kNoJump;
+    pstrLabel    = nullptr;
+
+    std::visit([&](const auto& command) {
+        using T = std::decay_t<decltype(command)>;
+
+        sInstr.pvNode = &command;
+
+        if constexpr (std::is_same_v<T, Command>) {
+            sInstr.eOp = OpCode::CALL;
+        } else if constexpr (std::is_same_v<T, MacroCommand>) {
+            sInstr.eOp = OpCode::CALL_STORE;
+        } else if constexpr (std::is_same_v<T, AsyncCommand>) {
+            sInstr.eOp = OpCode::CALL_ASYNC;
+        } else if constexpr (std::is_same_v<T, AwaitStatement>) {
+            sInstr.eOp = OpCode::AWAIT;
+        } else if constexpr (std::is_same_v<T, Condition>) {
+            sInstr.eOp = OpCode::JUMP_IF;
+            szIrTarget = command.szTargetIndex;
+            bRetVal    = (szIrTarget != kNoJump);
+        } else if constexpr (std::is_same_v<T, Label> || std::is_same_v<T, ParallelBranch> ||
+                             std::is_same_v<T, ParallelEnd>) {
+            bEmit = false;
+        } else if constexpr (std::is_same_v<T, RepeatTimes> || std::is_same_v<T, RepeatUntil> ||
+                             std::is_same_v<T, RepeatEnd>) {
+            sInstr.eOp = std::is_same_v<T, RepeatTimes> ? OpCode::LOOP_TIMES :
+                         std::is_same_v<T, RepeatUntil> ? OpCode::LOOP_UNTIL : OpCode::LOOP_END;
+            pstrLabel  = &command.strLabel;
+        } else if constexpr (std::is_same_v<T, LoopBreak> || std::is_same_v<T, LoopContinue>) {
+            sInstr.eOp  = std::is_same_v<T, LoopBreak> ? OpCode::BREAK : OpCode::CONTINUE;
+            sInstr.uArg = static_cast<uint32_t>(command.szUnwindDepth);
+            pstrLabel   = &command.strLabel;
+            szIrTarget  = command.szTargetIndex;
+            bRetVal     = (szIrTarget != kNoJump);
+        } else if constexpr (std::is_same_v<T, PrintStatement>) {
+            sInstr.eOp = OpCode::PRINT;
+        } else if constexpr (std::is_same_v<T, VarMacroInit>) {
+            sInstr.eOp = OpCode::VAR_INIT;
+        } else if constexpr (std::is_same_v<T, FormatStatement>) {
+            sInstr.eOp = OpCode::FORMAT;
+        } else if constexpr (std::is_same_v<T, MathStatement>) {
+            sInstr.eOp = OpCode::MATH;
+        } else if constexpr (std::is_same_v<T, BreakpointStatement>) {
+            sInstr.eOp = OpCode::BREAKPOINT;
+        } else if constexpr (std::is_same_v<T, DelayStatement>) {
+            sInstr.eOp = OpCode::DELAY;
+        } else if constexpr (std::is_same_v<T, PeriodStatement>) {
+            sInstr.eOp = OpCode::PERIOD;
+            pstrLabel  = command.strLoopLabel.empty() ? nullptr : &command.strLoopLabel;
+        } else if constexpr (std::is_same_v<T, DelayUntilStatement>) {
+            sInstr.eOp = OpCode::DELAY_UNTIL;
+        } else if constexpr (std::is_same_v<T, ParallelBegin>) {
+            sInstr.eOp = OpCode::PARALLEL;
+            szIrTarget = command.szEndIndex;
+            bRetVal    = (szIrTarget != kNoJump);
+        } else {
+            static_assert(!sizeof(T), "IR node without an opcode");
+        }
+    }, data.command);
+
+    return bRetVal;
+
+} /* lowerNode() */
+
+} // namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            PUBLIC INTERFACE                                 //
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace ubytecode {
+
+/*-------------------------------------------------------------------------------
+  Two passes over vCommands: the first assigns a program counter to every IR
+  index (a LABEL gets the pc of the next emitted instruction), the second
+  emits the instructions with their jump targets translated to program
+  counters and their loop labels interned.
+-------------------------------------------------------------------------------*/
+
+bool compileScript(const ScriptEntriesType& sScriptEntries, BytecodeProgram& sProgram)
+{
+    const auto& vCommands = sScriptEntries.vCommands;
+    bool bRetVal = false;
+
+    sProgram.clear();
+
+    do {
+        if (vCommands.size() >= std::numeric_limits<uint32_t>::max()) {
+            break;
+        }
+
+        Instruction sInstr;
+        size_t szIrTarget = kNoJump;
+        const std::string *pstrLabel = nullptr;
+        bool bEmit = true;
+
+        // pass 1: IR index -> program counter
+        std::vector<uint32_t> vPc(vCommands.size() + 1U);
+        uint32_t uPc = 0U;
+        bool bResolved = true;
+
+        for (size_t i = 0; i < vCommands.size(); ++i) {
+            vPc[i] = uPc;
+            if (false == lowerNode(vCommands[i], sInstr, szIrTarget, pstrLabel, bEmit)) {
+                bResolved = false;
+                break;
+            }
+            if (bEmit) {
+                ++uPc;
+            }
+        }
+        vPc[vCommands.size()] = uPc;
+
+        if (false == bResolved) {
+            break;
+        }
+
+        // pass 2: emit
+        std::unordered_map<std::string, uint32_t> mapLabelIds;
+        sProgram.vCode.reserve(uPc);
+
+        for (size_t i = 0; i < vCommands.size(); ++i) {
+            sInstr = Instruction{};
+            lowerNode(vCommands[i], sInstr, szIrTarget, pstrLabel, bEmit);
+            if (false == bEmit) {
+                continue;
+            }
+
+            sInstr.uNode   = static_cast<uint32_t>(i);
+            sInstr.iLineNr = vCommands[i].iLineNumber;
+            if (nullptr != pstrLabel) {
+                sInstr.uLabel = mapLabelIds.emplace(*pstrLabel, static_cast<uint32_t>(mapLabelIds.size())).first->second;
+            }
+
+            switch (sInstr.eOp) {
+                case OpCode::JUMP_IF:   sInstr.uTarget = vPc[szIrTarget];      break; // first instruction after the LABEL
+                case OpCode::BREAK:     sInstr.uTarget = vPc[szIrTarget] + 1U; break; // first instruction after END_REPEAT
+                case OpCode::CONTINUE:  sInstr.uTarget = vPc[szIrTarget];      break; // the END_REPEAT itself
+                case OpCode::PARALLEL:  sInstr.uTarget = vPc[szIrTarget];      break; // first instruction after END_PARALLEL
+                default: break;
+            }
+
+            sProgram.vCode.push_back(sInstr);
+        }
+
+        sProgram.uNrLabels = static_cast<uint32_t>(mapLabelIds.size());
+        bRetVal = true;
+
+    } while(false);
+
+    if (false == bRetVal) {
+        sProgram.clear();
+    }
+
+    return bRetVal;
+
+} /* compileScript() */
+
+} // namespace ubytecode
@@ -1,15 +1,20 @@
 #include "uScriptInterpreter.hpp"
+#include "uScriptBytecode.hpp"
 #include "uScriptCommandValidator.hpp"    
 #include "uScriptDataTypes.hpp"        
 #include "uString.hpp"
 #include "uTimer.hpp"
 #include "uLogger.hpp"
-#include "uCalculator.hpp"
 #include "uCheckContinue.hpp"
 #include "uHexlify.hpp"
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <optional>
 #include <regex>
 #include <sstream>
+#include <thread>
 #include <iomanip>
 #include <unordered_set>
 #include <utility>
@@ -38,6 +43,62 @@ static constexpr std::string_view kMathPrefix  = "MATH ";
 static constexpr std::string_view kFmtPrefix   = "FORMAT ";
 static constexpr std::string_view kPrintPrefix = "PRINT ";
 
+// upper bound of the worker threads used by PARALLEL_PLUGIN_INIT
+static constexpr size_t kMaxPluginWorkers = 8U;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            LOCAL FUNCTIONS                                  //
+/////////////////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------------------
+  Rewrite a compiled template with every macro segment replaced by the hole
+  "$<n>" (n counting from 0); vHoleSegments[n] is the index of its segment.
+  fnIsolated(prev, next) gets the literal text around a macro (empty at the
+  template edges) and decides whether the macro can stand alone as a hole.
+  Fails for adjacent macros and for literals carrying a '$' of their own.
+-------------------------------------------------------------------------------*/
+
+template <typename FnIsolated>
+static bool holeTemplate(const MacroTemplate& sTpl, FnIsolated&& fnIsolated,
+                         std::string& strHoled, std::vector<uint32_t>& vHoleSegments)
+{
+    const auto& vSegments = sTpl.vSegments;
+    static const std::string strEmpty;
+
+    strHoled.clear();
+    vHoleSegments.clear();
+
+    for (size_t i = 0; i < vSegments.size(); ++i) {
+        const auto& seg = vSegments[i];
+        if (seg.eKind == MacroSegment::Kind::LITERAL) {
+            if (seg.strText.find('$') != std::string::npos) {
+                return false;
+            }
+            strHoled.append(seg.strText);
+            continue;
+        }
+
+        const bool bHasPrev = (i > 0);
+        const bool bHasNext = (i + 1 < vSegments.size());
+        if ((bHasPrev && (vSegments[i - 1].eKind != MacroSegment::Kind::LITERAL)) ||
+            (bHasNext && (vSegments[i + 1].eKind != MacroSegment::Kind::LITERAL))) {
+            return false;   // adjacent macros
+        }
+        if (!fnIsolated(bHasPrev ? vSegments[i - 1].strText : strEmpty,
+                        bHasNext ? vSegments[i + 1].strText : strEmpty)) {
+            return false;
+        }
+
+        strHoled.push_back('$');
+        strHoled.append(std::to_string(vHoleSegments.size()));
+        vHoleSegments.push_back(static_cast<uint32_t>(i));
+    }
+
+    return true;
+
+} /* holeTemplate() */
+
 /*-------------------------------------------------------------------------------
 
 -------------------------------------------------------------------------------*/
@@ -50,6 +111,9 @@ bool ScriptInterpreter::interpretScript(ScriptEntriesType& sScriptEntries, bool
         if(false == bRealExec) {
 
             m_sScriptEntries = &sScriptEntries;
+            m_bindSymbolSlots();
+            m_compileMathStatements();
+            m_compileConditions();
 
             if (false == m_loadPlugins()) {
                 break;
@@ -59,15 +123,30 @@ bool ScriptInterpreter::interpretScript(ScriptEntriesType& sScriptEntries, bool
                 break;
             }
 
+            m_bindPluginCommands();
+
             if (false == m_initPlugins()) {
                 break;
             }
 
-            // only validate commands (dry run)
-            if (false == m_executeCommands(false)) {
+            // only validate commands (dry run); cached entries were already
+            // validated by the run that stored them
+            if (sScriptEntries.bFromCache) {
+                LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Commands validation skipped, script loaded from cache"));
+            } else if (false == m_executeCommands(false)) {
                 break;
             }
 
+            // lower the validated IR for the compiled backend (if enabled)
+            m_bBytecodeReady = false;
+            if (m_bBytecodeExec) {
+                m_bBytecodeReady = ubytecode::compileScript(sScriptEntries, m_sBytecode);
+                LOG_PRINT((m_bBytecodeReady ? LOG_DEBUG : LOG_WARNING), LOG_HDR;
+                          LOG_STRING("Bytecode compilation");
+                          LOG_STRING(m_bBytecodeReady ? "ok, instructions:" : "failed, using the IR interpreter");
+                          LOG_SIZET(m_sBytecode.vCode.size()));
+            }
+
         } else {
 
             // if plugins argument validation passed then we enable the plugins for the real execution
@@ -75,8 +154,26 @@ bool ScriptInterpreter::interpretScript(ScriptEntriesType& sScriptEntries, bool
                 break;
             }
 
-            // execute commands
-            if (false == m_executeCommands(true)) {
+            // execute commands; ASYNC commands still running complete before
+            // the plugins can be disabled, also when the script failed
+            if (m_bProfile) {
+                m_sProfiler.reset(0U, sScriptEntries.vCommands.size());
+            }
+            if (m_shpTracer) {
+                m_startTrace();
+            }
+            m_iRunStartNs = utime::monotonic_ns();
+            const bool bExecOk = m_bBytecodeReady ? m_executeBytecode() : m_executeCommands(true);
+            const int64_t iRunNs = utime::monotonic_ns() - m_iRunStartNs;
+            m_finishAsyncCommands();
+            m_reportTiming();
+            if (m_sProfiler.enabled()) {
+                m_writeProfileReport(iRunNs);
+            }
+            if (m_pTrace) {
+                m_writeTrace();
+            }
+            if (false == bExecOk) {
                 break;
             }
         }
@@ -127,7 +224,15 @@ bool ScriptInterpreter::listMacrosPlugins()
 
     // Show runtime variable macro values — these are the values most recently
     // written by executed MacroCommands, which is what the script actually sees.
-    printKVMap(m_RuntimeVarMacros, LOG_HEADER_VMACROS);
+    {
+        std::vector<std::pair<std::string, std::string>> vRuntimeVars;
+        for (const auto& slot : m_vVarSlots) {
+            if (slot.bDefined) {
+                vRuntimeVars.emplace_back(slot.strName, slot.strValue);
+            }
+        }
+        printKVMap(vRuntimeVars, LOG_HEADER_VMACROS);
+    }
 
     if (!m_sScriptEntries->vPlugins.empty()) {
         LOG_PRINT(LOG_EMPTY, LOG_STRING(LOG_HEADER_PLUGINS));
@@ -155,7 +260,8 @@ bool ScriptInterpreter::listCommands()
         [&](const ScriptLine& data) {
             std::visit([&data](const auto& command) {
                 using T = std::decay_t<decltype(command)>;
-                if constexpr (std::is_same_v<T, Command> || std::is_same_v<T, MacroCommand>) {
+                if constexpr (std::is_same_v<T, Command> || std::is_same_v<T, MacroCommand> ||
+                              std::is_same_v<T, AsyncCommand>) {
                     LOG_PRINT(LOG_EMPTY, LOG_STRING(command.strPlugin + "." + command.strCommand + " " + command.strParams));
                 }
             }, data.command);
@@ -206,9 +312,9 @@ bool ScriptInterpreter::loadPlugin(const std::string& strPluginName, bool bInitE
 
 void ScriptInterpreter::m_mirrorToShellVarMacros(const std::string& strName)
 {
-    auto it = m_RuntimeVarMacros.find(strName);
-    if (it != m_RuntimeVarMacros.end()) {
-        m_ShellVarMacros[strName] = it->second;
+    auto it = m_mapVarSlotIndex.find(strName);
+    if ((it != m_mapVarSlotIndex.end()) && m_vVarSlots[it->second].bDefined) {
+        m_ShellVarMacros[strName] = m_vVarSlots[it->second].strValue;
     }
 } /* m_mirrorToShellVarMacros() */
 
@@ -274,7 +380,7 @@ bool ScriptInterpreter::executeCmd(const std::string& strCommand)
                     bRetVal = m_dispatchShellLine(
                         MacroCommand{vstrTokens[1], vstrTokens[2], (szSize == 4) ? vstrTokens[3] : "", vstrTokens[0]}
                     );
-                    // m_executeCommand already wrote the result into m_RuntimeVarMacros;
+                    // m_executeCommand already wrote the result into its variable slot;
                     // mirror it to m_ShellVarMacros so it persists across executeCmd calls.
                     if (!vstrTokens[0].empty()) {
                         m_mirrorToShellVarMacros(vstrTokens[0]);
@@ -507,6 +613,7 @@ bool ScriptInterpreter::m_loadPlugin(PluginDataType& command, bool bInitEnable)
         }
 
         command.sSetParams.shpLogger = getLogger();
+        command.sSetParams.shpTracer = m_shpTracer;
 
         // set parameters to plugin
         if (false == command.shptrPluginEntryPoint->setParams(&command.sSetParams)) {
@@ -605,7 +712,8 @@ bool ScriptInterpreter::m_crossCheckCommands () noexcept
     for (const auto& data : m_sScriptEntries->vCommands) {
         std::visit([this, &bRetVal, &data](const auto & command) {
             using T = std::decay_t<decltype(command)>;
-            if constexpr (std::is_same_v<T, MacroCommand> || std::is_same_v<T, Command>) {
+            if constexpr (std::is_same_v<T, MacroCommand> || std::is_same_v<T, Command> ||
+                          std::is_same_v<T, AsyncCommand>) {
                 auto pluginIt = m_pluginCmdIndex.find(command.strPlugin);
                 if (pluginIt != m_pluginCmdIndex.end()) {
                     if (pluginIt->second.count(command.strCommand) == 0) {
@@ -631,6 +739,60 @@ bool ScriptInterpreter::m_crossCheckCommands () noexcept
 } /* m_crossCheckCommands() */
 
 
+/*-------------------------------------------------------------------------------
+  Bind every Command / MacroCommand to its plugin instance and, where the
+  plugin supports it, to a pre-resolved command id.  Runs once after the
+  cross-check so execution no longer scans vPlugins nor hashes command names.
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_bindPluginCommands() noexcept
+{
+    size_t szNrBound = 0;
+    size_t szNrById  = 0;
+
+    for (auto& data : m_sScriptEntries->vCommands) {
+        std::visit([this, &szNrBound, &szNrById](auto& command) {
+            using T = std::decay_t<decltype(command)>;
+            if constexpr (std::is_same_v<T, MacroCommand> || std::is_same_v<T, Command> ||
+                          std::is_same_v<T, AsyncCommand>) {
+                command.sBinding = PluginCommandBinding{};
+                for (const auto& plugin : m_sScriptEntries->vPlugins) {
+                    if (command.strPlugin == plugin.strPluginName) {
+                        command.sBinding.pPlugin     = plugin.shptrPluginEntryPoint.get();
+                        command.sBinding.szCommandId = command.sBinding.pPlugin->resolveCommand(command.strCommand);
+                        ++szNrBound;
+                        if (command.sBinding.szCommandId != PluginInterface::kInvalidCommandId) {
+                            ++szNrById;
+                        }
+                        break;
+                    }
+                }
+            }
+        }, data.command);
+    }
+
+    LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Commands bound:"); LOG_SIZET(szNrBound);
+              LOG_STRING("by id:"); LOG_SIZET(szNrById));
+
+} /* m_bindPluginCommands() */
+
+
+/*-------------------------------------------------------------------------------
+  Dispatch through the pre-resolved id when available, by name otherwise.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_dispatchPluginCommand(PluginInterface *pPlugin, const PluginCommandBinding& sBinding,
+                                                const std::string& strCommand, const std::string& strParams) const noexcept
+{
+    UTRACE_SCOPE(utrace::Category::DISPATCH, strCommand);
+
+    return (sBinding.szCommandId != PluginInterface::kInvalidCommandId)
+                ? pPlugin->doDispatchById(sBinding.szCommandId, strParams)
+                : pPlugin->doDispatch(strCommand, strParams);
+
+} /* m_dispatchPluginCommand() */
+
+
 
 /*-------------------------------------------------------------------------------
 
@@ -638,17 +800,15 @@ bool ScriptInterpreter::m_crossCheckCommands () noexcept
 
 bool ScriptInterpreter::m_initPlugins () noexcept
 {
-    bool bRetVal = true;
-
-    for (const auto& plugin : m_sScriptEntries->vPlugins) {
+    bool bRetVal = m_runPluginPhase([this](PluginDataType& plugin) {
         if (false == plugin.shptrPluginEntryPoint->doInit((true == plugin.shptrPluginEntryPoint->isPrivileged()) ? this : nullptr)) {
             LOG_PRINT(LOG_ERROR, LOG_HDR; 
                       LOG_STRING("Failed to initialize plugin:"); 
                       LOG_STRING(plugin.strPluginName));
-            bRetVal = false;
-            break;
+            return false;
         }
-    }
+        return true;
+    });
 
     LOG_PRINT((bRetVal ? LOG_DEBUG : LOG_ERROR), LOG_HDR; 
                 LOG_STRING("Plugins initialization"); 
@@ -666,7 +826,7 @@ bool ScriptInterpreter::m_initPlugins () noexcept
 
 bool ScriptInterpreter::m_enablePlugins() noexcept
 {
-    for (auto& plugin : m_sScriptEntries->vPlugins) {
+    bool bRetVal = m_runPluginPhase([](PluginDataType& plugin) {
         if (!plugin.shptrPluginEntryPoint->doEnable()) {
             LOG_PRINT(LOG_ERROR, LOG_HDR;
                       LOG_STRING("Failed to enable plugin:");
@@ -676,14 +836,110 @@ bool ScriptInterpreter::m_enablePlugins() noexcept
         LOG_PRINT(LOG_VERBOSE, LOG_HDR;
                   LOG_STRING(plugin.strPluginName);
                   LOG_STRING("enabled"));
-    }
+        return true;
+    });
 
-    LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Plugins enabling ok"));
-    return true;
+    if (bRetVal) {
+        LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Plugins enabling ok"));
+    }
+    return bRetVal;
 
 } /* m_enablePlugins() */
 
 
+
+/*-------------------------------------------------------------------------------
+ * Concurrent plugins run while the calling thread waits: a privileged plugin
+ * may load further plugins (vPlugins grows), so the sequential ones are only
+ * started once the workers are joined.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_runPluginPhase(const std::function<bool(PluginDataType&)>& fnStep) noexcept
+{
+    auto& vPlugins = m_sScriptEntries->vPlugins;
+
+    std::vector<size_t> vConcurrent;
+    if (m_bParallelPluginInit) {
+        for (size_t i = 0; i < vPlugins.size(); ++i) {
+            const auto& shpPlugin = vPlugins[i].shptrPluginEntryPoint;
+            if (shpPlugin->isConcurrentInitSafe() && !shpPlugin->isPrivileged()) {
+                vConcurrent.push_back(i);
+            }
+        }
+    }
+
+    // nothing to overlap, keep the plain sequential order
+    if (vConcurrent.size() < 2U) {
+        for (auto& plugin : vPlugins) {
+            if (!fnStep(plugin)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const size_t szCount = vPlugins.size();
+    std::vector<std::vector<LogBuffer::Record>> vLogs(szCount);
+    std::vector<char> vDone(szCount, 0);   // ran on a worker
+    std::vector<char> vOk(szCount, 0);
+
+    std::shared_ptr<LogBuffer> shpLogger = getLogger();
+    std::atomic<size_t> szNext {0U};
+
+    auto worker = [&]() {
+        for (size_t k = szNext.fetch_add(1U); k < vConcurrent.size(); k = szNext.fetch_add(1U)) {
+            const size_t i = vConcurrent[k];
+            shpLogger->beginCapture();
+            try {
+                vOk[i] = fnStep(vPlugins[i]) ? 1 : 0;
+            } catch (...) {
+                vOk[i] = 0;
+            }
+            vLogs[i] = shpLogger->endCapture();
+            vDone[i] = 1;
+        }
+    };
+
+    const size_t szWorkers = std::min(vConcurrent.size(), kMaxPluginWorkers);
+    std::vector<std::thread> vWorkers;
+    vWorkers.reserve(szWorkers);
+    try {
+        for (size_t w = 0; w < szWorkers; ++w) {
+            vWorkers.emplace_back(worker);
+        }
+    } catch (const std::system_error&) {
+        // could not spawn (more) threads, the calling thread takes the rest
+    }
+    if (vWorkers.size() < szWorkers) {
+        worker();
+    }
+    for (auto& thread : vWorkers) {
+        thread.join();
+    }
+
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR;
+              LOG_STRING("Plugins run concurrently:"); LOG_SIZET(vConcurrent.size());
+              LOG_STRING("workers:"); LOG_SIZET(szWorkers));
+
+    // replay / run in plugin order; after the first failure the remaining
+    // sequential plugins are skipped, as in the sequential mode
+    bool bRetVal = true;
+    for (size_t i = 0; i < szCount; ++i) {
+        if (0 != vDone[i]) {
+            shpLogger->replay(vLogs[i]);
+            if (0 == vOk[i]) {
+                bRetVal = false;
+            }
+        } else if (bRetVal) {
+            bRetVal = fnStep(vPlugins[i]);
+        }
+    }
+
+    return bRetVal;
+
+} /* m_runPluginPhase() */
+
+
 /*-------------------------------------------------------------------------------
  * Traverse the command list in reverse to resolve macros using their most recently assigned values.
 -------------------------------------------------------------------------------*/
@@ -703,40 +959,10 @@ void ScriptInterpreter::m_replaceVariableMacros(std::string& input)
     static const std::regex macroPattern(R"(\$([A-Za-z_][A-Za-z0-9_]*)(?:\.\$([A-Za-z_][A-Za-z0-9_]*))?)");
     std::smatch match;
 
-    /* Helper: resolve a single bare macro name through all scope tiers.
-      Returns the resolved string, or an empty optional if not found. */
-
-    auto resolveName = [&](const std::string& name) -> std::pair<bool, std::string> {
-
-        // Loop-scoped macros — innermost first
-        for (auto scopeIt = m_loopStateStack.rbegin();
-             scopeIt != m_loopStateStack.rend(); ++scopeIt)
-        {
-            auto loopIt = scopeIt->mapLoopMacros.find(name);
-            if (loopIt != scopeIt->mapLoopMacros.end()) {
-                return {true, loopIt->second};
-            }
-        }
-
-        // Script-level variable macros — O(1) runtime map.
-        // Holds the value that was most recently EXECUTED, not the value that
-        // appears last in the IR.  This is correct when the same name is used
-        // on both sides of an assignment (e.g. score ?= CORE.MATH $score + 10).
-        {
-            auto rtIt = m_RuntimeVarMacros.find(name);
-            if (rtIt != m_RuntimeVarMacros.end()) {
-                return {true, rtIt->second};
-            }
-        }
-
-        // Shell macros
-        {
-            auto shellIt = m_ShellVarMacros.find(name);
-            if (shellIt != m_ShellVarMacros.end()) {
-                return {true, shellIt->second};
-            }
-        }
-        return {false, {}};
+    auto resolveName = [this](const std::string& name) -> std::pair<bool, std::string> {
+        const std::string *pValue = m_resolveVariableMacro(name);
+        return (pValue != nullptr) ? std::pair<bool, std::string>{true, *pValue}
+                                   : std::pair<bool, std::string>{false, {}};
     };
 
     bool replaced = true;
@@ -822,217 +1048,1645 @@ void ScriptInterpreter::m_replaceVariableMacros(std::string& input)
 } /* m_replaceVariableMacros() */
 
 
-
 /*-------------------------------------------------------------------------------
-  m_initLoopIterIndex — write iteration counter "0" into the loop's own macro
-  scope on first entry.  Called by both RepeatTimes and RepeatUntil handlers
-  immediately after pushing a new LoopState onto the stack.
-  No-op when strVarMacroName is empty (loop has no capture variable).
+  m_resolveVariableMacro — scope-tier lookup shared by both expansion paths.
 -------------------------------------------------------------------------------*/
 
-void ScriptInterpreter::m_initLoopIterIndex(LoopState& state) noexcept
+const std::string* ScriptInterpreter::m_resolveVariableMacro(const std::string& strName, uint32_t uSlot) const noexcept
 {
-    if (!state.strVarMacroName.empty()) {
-        state.mapLoopMacros[state.strVarMacroName] = "0";
-        LOG_PRINT(LOG_VERBOSE, LOG_HDR;
-                  LOG_STRING("REPEAT iter-index $"); LOG_STRING(state.strVarMacroName);
-                  LOG_STRING("= 0"));
+    if (uSlot == kNoSlot) {
+        auto it = m_mapVarSlotIndex.find(strName);
+        if (it != m_mapVarSlotIndex.end()) {
+            uSlot = it->second;
+        }
     }
-} /* m_initLoopIterIndex() */
+
+    if (uSlot != kNoSlot) {
+        const VarSlot& slot = m_vVarSlots[uSlot];
+
+        // Loop-scoped binding — innermost active loop
+        if (slot.uLoopDepth > 0U) {
+            return &slot.strLoopValue;
+        }
+
+        // Script-level variable macro.
+        // Holds the value that was most recently EXECUTED, not the value that
+        // appears last in the IR.  This is correct when the same name is used
+        // on both sides of an assignment (e.g. score ?= MATH $score + 10).
+        if (slot.bDefined) {
+            return &slot.strValue;
+        }
+    }
+
+    // Shell macros
+    auto shellIt = m_ShellVarMacros.find(strName);
+    if (shellIt != m_ShellVarMacros.end()) {
+        return &shellIt->second;
+    }
+
+    return nullptr;
+
+} /* m_resolveVariableMacro() */
 
 
 /*-------------------------------------------------------------------------------
-  m_advanceLoopIterIndex — increment the iteration counter and update the
-  loop-scope macro.  Called by m_runEndRepeat on each loop-back.
-  No-op when strVarMacroName is empty.
+  m_bindSymbolSlots — size the slot tables after the validator's symbol pass.
+  Validator slots keep their indices; slots appended later by shell lines
+  follow them.
 -------------------------------------------------------------------------------*/
 
-void ScriptInterpreter::m_advanceLoopIterIndex(LoopState& state) noexcept
+void ScriptInterpreter::m_bindSymbolSlots() noexcept
 {
-    ++state.uIterationCount;
-    if (!state.strVarMacroName.empty()) {
-        state.mapLoopMacros[state.strVarMacroName] = std::to_string(state.uIterationCount);
-        LOG_PRINT(LOG_VERBOSE, LOG_HDR;
-                  LOG_STRING("REPEAT iter-index $"); LOG_STRING(state.strVarMacroName);
-                  LOG_STRING("="); LOG_STRING(std::to_string(state.uIterationCount)));
+    m_vVarSlots.clear();
+    m_mapVarSlotIndex.clear();
+    m_vArraySlots.clear();
+
+    const auto& vVarSlots = m_sScriptEntries->vVarSlots;
+    m_vVarSlots.reserve(vVarSlots.size());
+    for (size_t i = 0; i < vVarSlots.size(); ++i) {
+        m_vVarSlots.push_back(VarSlot{vVarSlots[i], {}, false, {}, 0U});
+        m_mapVarSlotIndex.emplace(vVarSlots[i], static_cast<uint32_t>(i));
     }
-} /* m_advanceLoopIterIndex() */
+
+    for (const auto& strArray : m_sScriptEntries->vArraySlots) {
+        auto arrIt = m_sScriptEntries->mapArrayMacros.find(strArray);
+        m_vArraySlots.push_back((arrIt != m_sScriptEntries->mapArrayMacros.end()) ? &arrIt->second : nullptr);
+    }
+
+} /* m_bindSymbolSlots() */
 
 
 /*-------------------------------------------------------------------------------
-  m_runEndRepeat — shared END_REPEAT logic.
-  Called from the normal END_REPEAT path and from the CONTINUE_LOOP path.
-  Assumes m_loopStateStack.back() is the loop being ended.
-  May modify iIndex (loop-back) or pop the stack (loop done).
+  m_varSlotOf — slot of a variable name; a new slot is appended for names the
+  validator never saw (lines typed in the shell).
 -------------------------------------------------------------------------------*/
 
-void ScriptInterpreter::m_runEndRepeat(size_t& iIndex, bool& bRetVal) noexcept
+uint32_t ScriptInterpreter::m_varSlotOf(const std::string& strName)
 {
-    LoopState& state = m_loopStateStack.back();
+    auto [it, bInserted] = m_mapVarSlotIndex.emplace(strName, static_cast<uint32_t>(m_vVarSlots.size()));
+    if (bInserted) {
+        m_vVarSlots.push_back(VarSlot{strName, {}, false, {}, 0U});
+    }
+    return it->second;
 
-    // Save values used in post-pop log lines before any pop_back().
-    const std::string strLabel = state.strLabel;
+} /* m_varSlotOf() */
 
-    if (!state.bIsUntil) {
 
-        // REPEAT N 
-        --state.iRemaining;
-        LOG_PRINT(LOG_VERBOSE, LOG_HDR;
-                  LOG_STRING("REPEAT"); LOG_STRING(strLabel);
-                  LOG_STRING("remaining:"); LOG_STRING(std::to_string(state.iRemaining)));
+/*-------------------------------------------------------------------------------
+  m_setVariable — store the script-level value of a variable macro.
+-------------------------------------------------------------------------------*/
 
-        if (state.iRemaining > 0) {
-            m_advanceLoopIterIndex(state);
-            iIndex = state.szBeginIndex; // caller does ++iIndex → szBeginIndex+1
-        } else {
-            m_loopStateStack.pop_back(); // destroys mapLoopMacros — state ref is now dangling
-            LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("REPEAT done:"); LOG_STRING(strLabel));
-        }
-    } else {
+void ScriptInterpreter::m_setVariable(uint32_t uSlot, const std::string& strName, std::string strValue)
+{
+    if (uSlot == kNoSlot) {
+        uSlot = m_varSlotOf(strName);
+    }
+    VarSlot& slot = m_vVarSlots[uSlot];
+    slot.strValue = std::move(strValue);
+    slot.bDefined = true;
+    if (uSlot < m_vSlotWritten.size()) {
+        m_vSlotWritten[uSlot] = 1;
+    }
 
-        // REPEAT UNTIL 
-        // Copy the condition template before any macro expansion (do not mutate it).
-        std::string strCondExpanded = state.strCondition;
-        m_replaceVariableMacros(strCondExpanded);
+} /* m_setVariable() */
 
-        bool bCondResult = false;
-        if (true == m_evaluateCondition(strCondExpanded, bCondResult)) {
-            if (!bCondResult) {
-                m_advanceLoopIterIndex(state);
-                iIndex = state.szBeginIndex;
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR;
-                          LOG_STRING("REPEAT UNTIL looping:"); LOG_STRING(strLabel));
-            } else {
-                m_loopStateStack.pop_back(); // destroys mapLoopMacros — state ref is now dangling
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR;
-                          LOG_STRING("REPEAT UNTIL done:"); LOG_STRING(strLabel));
-            }
+
+/*-------------------------------------------------------------------------------
+  m_popLoopState — pop the innermost loop and release its iteration-index
+  binding, restoring the binding of an outer loop using the same name.
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_popLoopState() noexcept
+{
+    LoopState& state = m_loopStateStack.back();
+
+    if (state.uVarSlot != kNoSlot) {
+        VarSlot& slot = m_vVarSlots[state.uVarSlot];
+        if (--slot.uLoopDepth > 0U) {
+            slot.strLoopValue = std::move(state.strShadowedValue);
         } else {
-            LOG_PRINT(LOG_ERROR, LOG_HDR;
-                      LOG_STRING("REPEAT UNTIL: failed to evaluate condition:"); LOG_STRING(strCondExpanded));
-            bRetVal = false;
+            slot.strLoopValue.clear();
         }
     }
 
-} /* m_runEndRepeat() */
+    m_loopStateStack.pop_back();
 
+} /* m_popLoopState() */
 
-/*-------------------------------------------------------------------------------
-  Execute a single IR command.
 
-  iIndex is the current position in vCommands (owned by the caller's loop).
-  Loop end nodes (RepeatEnd) may set iIndex to (desired_next - 1) so that the
-  caller's unconditional ++iIndex lands at the correct body-start address.
+/*-------------------------------------------------------------------------------
+  m_unwindLoops — pop the szDepth loops nested inside the BREAK / CONTINUE
+  target and check that the target loop is then on top of the stack (by its
+  interned label id when given, by name otherwise).
 -------------------------------------------------------------------------------*/
 
-bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size_t& iIndex) noexcept
+bool ScriptInterpreter::m_unwindLoops(size_t szDepth, const std::string& strTargetLabel, uint32_t uLabelId) noexcept
 {
-    bool bRetVal = true;
-    bool bIsPluginCommand = false;
-    auto lineNr = ustring::fmtLineNr(data.iLineNumber);
+    if (m_loopStateStack.size() <= szDepth) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Loop stack underflow while unwinding to:"); LOG_STRING(strTargetLabel));
+        return false;
+    }
 
-    std::visit([this, bRealExec, &lineNr, &bIsPluginCommand, &bRetVal, &iIndex](auto& command) {
-        using T = std::decay_t<decltype(command)>;
+    for (size_t i = 0; i < szDepth; ++i) {
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("Unwinding loop:"); LOG_STRING(m_loopStateStack.back().strLabel));
+        m_popLoopState();
+    }
 
-        /*-----------------------------------------------------------------
-            Plugin commands (Command / MacroCommand)
-        -----------------------------------------------------------------*/
+    const LoopState& state = m_loopStateStack.back();
+    if ((uLabelId != kNoSlot) ? (state.uLabelId != uLabelId) : (state.strLabel != strTargetLabel)) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Unexpected loop on stack:"); LOG_STRING(state.strLabel);
+                  LOG_STRING("while unwinding to:"); LOG_STRING(strTargetLabel));
+        return false;
+    }
 
-        if constexpr (std::is_same_v<T, MacroCommand> || std::is_same_v<T, Command>) {
-            if (m_eSkipReason == SkipReason::NONE) {
-                bIsPluginCommand = true;
-                for (auto& plugin : m_sScriptEntries->vPlugins) {
-                    if (command.strPlugin == plugin.strPluginName) {
-                        if(bRealExec) { // real execution
-                            // Expand macros onto a copy — the IR must not be mutated so
-                            // that every loop iteration starts from the original template.
-                            std::string strExpandedParams = command.strParams;
-                            m_replaceVariableMacros(strExpandedParams);
-                            LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                LOG_STRING("Exec:"); 
-                                LOG_STRING(command.strPlugin + "." + command.strCommand + " " + strExpandedParams));
-                            // block to ensure correct command execution time measurement (separate from delay)
-                            {
-                                utime::Timer timer(std::string(lineNr.data()) + " Command");
-                                if (false == plugin.shptrPluginEntryPoint->doDispatch(command.strCommand, strExpandedParams)) {
-                                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                        LOG_STRING("Failed executing"); 
-                                        LOG_STRING(command.strPlugin + "." + command.strCommand + " " + strExpandedParams)); 
-                                        bRetVal = false;
-                                    break;
-                                } else { // execution succeeded, update the value of the associated macro if any
-                                    if constexpr (std::is_same_v<T, MacroCommand>) {
-                                        const std::string strValue = plugin.shptrPluginEntryPoint->getData();
-                                        m_RuntimeVarMacros[command.strVarMacroName] = strValue;
-                                        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                            LOG_STRING("VAR["); LOG_STRING(command.strVarMacroName); 
-                                            LOG_STRING("]->[") 
-                                            LOG_STRING(strValue); 
-                                            LOG_STRING("]"));
-                                        plugin.shptrPluginEntryPoint->resetData();
-                                    }
-                                }
-                            }
-                            utime::delay_ms(m_szDelay); /* delay between the commands execution */
-                        } else { // only for validation purposes
-                            LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                    LOG_STRING("Validate:"); 
-                                    LOG_STRING(command.strPlugin + "." + command.strCommand); 
-                                    LOG_STRING(command.strParams));
-                            if (false == plugin.shptrPluginEntryPoint->doDispatch(command.strCommand, command.strParams)) {
-                                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                    LOG_STRING("Failed validating"); 
-                                    LOG_STRING(command.strPlugin + "." + command.strCommand); 
-                                    LOG_STRING(command.strParams));
-                                bRetVal = false;
-                                break;
-                            }
-                        }
-                    }
-                }
-            } else {
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                    LOG_STRING("Skipped:"); LOG_STRING(command.strPlugin); 
-                    LOG_STRING(command.strCommand); LOG_STRING("args["); 
-                    LOG_STRING(command.strParams); LOG_STRING("]"));
-            }
+    return true;
 
-        /*-----------------------------------------------------------------
-            IF/GOTO condition
-        -----------------------------------------------------------------*/
+} /* m_unwindLoops() */
 
-        } else if constexpr (std::is_same_v<T, Condition>) {
-            if(bRealExec) {
-                if(m_eSkipReason == SkipReason::NONE) {
-                    // Expand variable macros on a copy — constant macros were already
-                    // substituted at validation time, but $vmacros are only known at
-                    // runtime and must be resolved here before the evaluator sees them.
-                    std::string strCondExpanded = command.strCondition;
-                    m_replaceVariableMacros(strCondExpanded);
 
-                    bool beResult = false;
+/*-------------------------------------------------------------------------------
+  m_expandMacros — linear expansion of a validator-compiled template.
+-------------------------------------------------------------------------------*/
 
-                    if (true == m_evaluateCondition(strCondExpanded, beResult)) {
-                        if (true == beResult) {
-                            m_strSkipUntilLabel = command.strLabelName;
-                            m_eSkipReason       = SkipReason::GOTO;
-                            LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                LOG_STRING("Start skipping to label:"); 
-                                LOG_STRING(m_strSkipUntilLabel));
-                        }
-                    } else {
-                        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                            LOG_STRING("Failed to evaluate condition:"); 
-                            LOG_STRING(strCondExpanded));
-                        bRetVal = false;
-                    }
-                } else {
-                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                        LOG_STRING("Skipped:"); 
-                        LOG_STRING("[IF ..] GOTO:"); 
-                        LOG_STRING(command.strLabelName));
-                }
-            }
+void ScriptInterpreter::m_expandMacros(const MacroTemplate& sTpl, const std::string& strRaw, std::string& strOut)
+{
+    uprofile::ScopedPhase phase(m_sProfiler, uprofile::Phase::MACRO);
+
+    if (!sTpl.bCompiled) {
+        strOut = strRaw;
+        m_replaceVariableMacros(strOut);
+        return;
+    }
+
+    if (!sTpl.bHasMacros) {
+        strOut = strRaw;
+        return;
+    }
+
+    auto resolve = [this](const std::string& strName, uint32_t uSlot) {
+        return m_resolveVariableMacro(strName, uSlot);
+    };
+
+    auto element = [this](const std::string& strArray, uint32_t uArraySlot, const std::string *pIndex) -> std::pair<bool, const std::string*> {
+        const std::vector<std::string> *pArray = nullptr;
+        if (uArraySlot != kNoSlot) {
+            pArray = m_vArraySlots[uArraySlot];
+        } else {
+            // array defined from the shell after validation
+            auto arrIt = m_sScriptEntries->mapArrayMacros.find(strArray);
+            if (arrIt != m_sScriptEntries->mapArrayMacros.end()) {
+                pArray = &arrIt->second;
+            }
+        }
+        if (pArray == nullptr) {
+            return {false, nullptr};
+        }
+        if (pIndex == nullptr) {
+            return {true, nullptr};     // index macro not (yet) defined — leave unexpanded
+        }
+
+        size_t idx = 0;
+        try {
+            idx = static_cast<size_t>(std::stoull(*pIndex));
+        } catch (...) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR;
+                      LOG_STRING("Array ["); LOG_STRING(strArray);
+                      LOG_STRING("] non-numeric index:"); LOG_STRING(*pIndex));
+            return {true, nullptr};
+        }
+        if (idx >= pArray->size()) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR;
+                      LOG_STRING("Array ["); LOG_STRING(strArray);
+                      LOG_STRING("] index"); LOG_STRING(*pIndex);
+                      LOG_STRING("out of range (size=");
+                      LOG_STRING(std::to_string(pArray->size())); LOG_STRING(")"));
+            return {true, nullptr};
+        }
+        return {true, &(*pArray)[idx]};
+    };
+
+    if (umacro::expandMacroTemplate(sTpl, strOut, resolve, element)) {
+        // a substituted value carried its own $macro — keep the nested-expansion semantics
+        m_replaceVariableMacros(strOut);
+    }
+
+} /* m_expandMacros() */
+
+
+/*-------------------------------------------------------------------------------
+  m_compileMathStatements — compile each validated MATH expression once.
+
+  Every $macro segment of the template becomes the hole "$<n>".  A line is
+  left uncompiled (uProgram = kNoSlot) and evaluated from its expanded text
+  when the substitution could fuse with the surrounding characters (0x$v,
+  1.$v, $v2, 1e+$v, two adjacent macros), when a literal carries its own '$',
+  or when the expression does not parse — the textual path then reports the
+  error with the expanded expression, as before.
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_compileMathStatements() noexcept
+{
+    m_vMathPrograms.clear();
+    Calculator::seedConstants(m_mathVars);
+
+    auto isolated = [](const std::string& strPrev, const std::string& strNext) {
+        auto fuses = [](char c) {
+            return umacro::isIdentChar(c) || (c == '.') || (c == '$');
+        };
+        if (!strPrev.empty()) {
+            if (fuses(strPrev.back())) {
+                return false;
+            }
+            const size_t n = strPrev.size();
+            if ((n >= 2U) && ((strPrev[n - 1] == '+') || (strPrev[n - 1] == '-')) &&
+                ((strPrev[n - 2] == 'e') || (strPrev[n - 2] == 'E'))) {
+                return false;   // exponent sign
+            }
+        }
+        return strNext.empty() || !fuses(strNext.front());
+    };
+
+    std::string strHoled;
+
+    for (auto& line : m_sScriptEntries->vCommands) {
+        auto *pMath = std::get_if<MathStatement>(&line.command);
+        if (pMath == nullptr) {
+            continue;
+        }
+
+        pMath->uProgram = kNoSlot;
+        if (!pMath->sExprTpl.bCompiled) {
+            continue;
+        }
+
+        MathProgram sMath;
+        if (!holeTemplate(pMath->sExprTpl, isolated, strHoled, sMath.vHoleSegments)) {
+            continue;
+        }
+
+        try {
+            sMath.sProgram = Calculator::compile(strHoled, true);
+        } catch (const std::exception&) {
+            continue;
+        }
+
+        pMath->uProgram = static_cast<uint32_t>(m_vMathPrograms.size());
+        m_vMathPrograms.push_back(std::move(sMath));
+    }
+
+    LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Compiled MATH expressions:"); LOG_SIZET(m_vMathPrograms.size()));
+
+} /* m_compileMathStatements() */
+
+
+/*-------------------------------------------------------------------------------
+  m_resolveHoleValue — value of a macro segment for a compiled expression.
+
+  Returns nullptr whenever the textual expansion could differ from a plain
+  substitution of the returned value: unresolved macro, array reference
+  without a validated array or with a non-decimal / out of range index, or a
+  value that carries a $macro of its own (the expansion would rescan it).
+-------------------------------------------------------------------------------*/
+
+const std::string* ScriptInterpreter::m_resolveHoleValue(const MacroSegment& seg) const noexcept
+{
+    const std::string *pValue = nullptr;
+
+    if (seg.eKind == MacroSegment::Kind::MACRO) {
+        pValue = m_resolveVariableMacro(seg.strText, seg.uVarSlot);
+    } else if ((seg.uArraySlot != kNoSlot) && (m_vArraySlots[seg.uArraySlot] != nullptr)) {
+        const std::string *pIndex = m_resolveVariableMacro(seg.strIndex, seg.uIndexSlot);
+        const auto& vArray = *m_vArraySlots[seg.uArraySlot];
+        size_t idx = 0;
+        bool bDigits = (pIndex != nullptr) && !pIndex->empty() && (pIndex->size() < 10U);
+        for (size_t k = 0; bDigits && (k < pIndex->size()); ++k) {
+            bDigits = ((*pIndex)[k] >= '0') && ((*pIndex)[k] <= '9');
+            idx = (idx * 10U) + static_cast<size_t>((*pIndex)[k] - '0');
+        }
+        if (bDigits && (idx < vArray.size())) {
+            pValue = &vArray[idx];
+        }
+    }
+
+    if ((pValue != nullptr) && (pValue->find('$') != std::string::npos)) {
+        pValue = nullptr;
+    }
+
+    return pValue;
+
+} /* m_resolveHoleValue() */
+
+
+/*-------------------------------------------------------------------------------
+  m_loadMathHoles — resolve the macros of a compiled MATH line to numbers.
+
+  Only values that the expanded text would parse as a single unsigned number
+  are accepted; anything else makes the caller fall back to the textual
+  path, which keeps its exact semantics for them.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_loadMathHoles(const MathStatement& command) noexcept
+{
+    if (command.uProgram == kNoSlot) {
+        return false;
+    }
+
+    const MathProgram& sMath = m_vMathPrograms[command.uProgram];
+    m_vMathHoles.resize(sMath.vHoleSegments.size());
+
+    for (size_t i = 0; i < sMath.vHoleSegments.size(); ++i) {
+        const std::string *pValue = m_resolveHoleValue(command.sExprTpl.vSegments[sMath.vHoleSegments[i]]);
+        if ((pValue == nullptr) || !Calculator::parseLiteral(pValue->c_str(), m_vMathHoles[i])) {
+            return false;
+        }
+    }
+
+    return true;
+
+} /* m_loadMathHoles() */
+
+
+/*-------------------------------------------------------------------------------
+  m_compileConditions — compile each validated EVAL condition once
+  (IF EVAL ... GOTO, REPEAT ... UNTIL EVAL ..., name ?= EVAL ...).
+
+  Macros become "$<n>" holes and must be whole words of the expression;
+  conditions that are not EVAL expressions (plain TRUE / FALSE logic) or do
+  not compile keep the expand-and-evaluate path.
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_compileConditions() noexcept
+{
+    m_vCondPrograms.clear();
+
+    auto isolated = [](const std::string& strPrev, const std::string& strNext) {
+        auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+        return (strPrev.empty() || isSpace(strPrev.back())) && (strNext.empty() || isSpace(strNext.front()));
+    };
+
+    std::string strHoled;
+
+    auto compile = [&](const MacroTemplate& sTpl, uint32_t& uCondProgram) {
+        uCondProgram = kNoSlot;
+        CondProgram sCond;
+        if (!sTpl.bCompiled || !holeTemplate(sTpl, isolated, strHoled, sCond.vHoleSegments)) {
+            return;
+        }
+        if (strHoled.compare(0, kEvalPrefix.size(), kEvalPrefix) != 0) {
+            return;
+        }
+        if (!EvalExprEvaluator::compile(strHoled.substr(kEvalPrefix.size()), sCond.sProgram)) {
+            return;
+        }
+        uCondProgram = static_cast<uint32_t>(m_vCondPrograms.size());
+        m_vCondPrograms.push_back(std::move(sCond));
+    };
+
+    for (auto& line : m_sScriptEntries->vCommands) {
+        std::visit([&](auto& command) {
+            using T = std::decay_t<decltype(command)>;
+            if constexpr (std::is_same_v<T, Condition> || std::is_same_v<T, RepeatUntil>) {
+                compile(command.sConditionTpl, command.uCondProgram);
+            } else if constexpr (std::is_same_v<T, VarMacroInit>) {
+                compile(command.sValueTpl, command.uCondProgram);
+            }
+        }, line.command);
+    }
+
+    LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Compiled EVAL conditions:"); LOG_SIZET(m_vCondPrograms.size()));
+
+} /* m_compileConditions() */
+
+
+/*-------------------------------------------------------------------------------
+  m_evalConditionTpl — evaluate a condition template.
+
+  Runs the compiled program when the condition has one and every macro
+  value keeps its structure, otherwise expands the template and hands it to
+  m_evaluateCondition.  On failure strExpanded holds the expanded condition
+  for the caller's error message.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_evalConditionTpl(const MacroTemplate& sTpl, const std::string& strRaw, uint32_t uCondProgram,
+                                           bool& bResult, std::string& strExpanded) noexcept
+{
+    uprofile::ScopedPhase phase(m_sProfiler, uprofile::Phase::CONDITION);
+    bool bCompiled = (uCondProgram != kNoSlot);
+
+    if (bCompiled) {
+        const CondProgram& sCond = m_vCondPrograms[uCondProgram];
+        m_vCondHoles.resize(sCond.vHoleSegments.size());
+        for (size_t i = 0; bCompiled && (i < sCond.vHoleSegments.size()); ++i) {
+            m_vCondHoles[i] = m_resolveHoleValue(sTpl.vSegments[sCond.vHoleSegments[i]]);
+            bCompiled = (m_vCondHoles[i] != nullptr);
+        }
+        bCompiled = bCompiled && EvalExprEvaluator::canRun(sCond.sProgram, m_vCondHoles.data());
+    }
+
+    if (!bCompiled) {
+        m_expandMacros(sTpl, strRaw, strExpanded);
+        return m_evaluateCondition(strExpanded, bResult);
+    }
+
+    // the expanded text is only needed by the log lines; every macro resolved
+    auto exprText = [&]() -> const std::string& {
+        m_expandMacros(sTpl, strRaw, strExpanded);
+        return strExpanded;
+    };
+
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("EVAL expression:"); LOG_STRING(exprText().substr(kEvalPrefix.size())));
+
+    if (m_evalExprEvaluator.run(m_vCondPrograms[uCondProgram].sProgram, m_vCondHoles.data(), bResult)) {
+        return true;
+    }
+
+    m_expandMacros(sTpl, strRaw, strExpanded);
+    return false;
+
+} /* m_evalConditionTpl() */
+
+
+
+/*-------------------------------------------------------------------------------
+  m_initLoopIterIndex — bind iteration counter "0" to the loop's index slot
+  on first entry.  Called by both RepeatTimes and RepeatUntil handlers
+  immediately after pushing a new LoopState onto the stack.
+  No-op when strVarMacroName is empty (loop has no capture variable).
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_initLoopIterIndex(LoopState& state) noexcept
+{
+    if (!state.strVarMacroName.empty()) {
+        if (state.uVarSlot == kNoSlot) {
+            state.uVarSlot = m_varSlotOf(state.strVarMacroName);
+        }
+        VarSlot& slot = m_vVarSlots[state.uVarSlot];
+        if (slot.uLoopDepth++ > 0U) {
+            state.strShadowedValue = std::move(slot.strLoopValue);   // shadow the outer loop
+        }
+        slot.strLoopValue = "0";
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR;
+                  LOG_STRING("REPEAT iter-index $"); LOG_STRING(state.strVarMacroName);
+                  LOG_STRING("= 0"));
+    }
+} /* m_initLoopIterIndex() */
+
+
+/*-------------------------------------------------------------------------------
+  m_advanceLoopIterIndex — increment the iteration counter and update the
+  loop-scope macro.  Called by m_runEndRepeat on each loop-back.
+  No-op when strVarMacroName is empty.
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_advanceLoopIterIndex(LoopState& state) noexcept
+{
+    ++state.uIterationCount;
+    if (state.uVarSlot != kNoSlot) {
+        m_vVarSlots[state.uVarSlot].strLoopValue = std::to_string(state.uIterationCount);
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR;
+                  LOG_STRING("REPEAT iter-index $"); LOG_STRING(state.strVarMacroName);
+                  LOG_STRING("="); LOG_STRING(std::to_string(state.uIterationCount)));
+    }
+} /* m_advanceLoopIterIndex() */
+
+
+/*-------------------------------------------------------------------------------
+  m_runEndRepeat — shared END_REPEAT logic.
+  Called from the normal END_REPEAT path and from the CONTINUE_LOOP path.
+  Assumes m_loopStateStack.back() is the loop being ended.
+  May modify iIndex (loop-back) or pop the stack (loop done).
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_runEndRepeat(size_t& iIndex, bool& bRetVal) noexcept
+{
+    LoopState& state = m_loopStateStack.back();
+
+    // Save values used in post-pop log lines before any pop_back().
+    const std::string strLabel = state.strLabel;
+
+    if (!state.bIsUntil) {
+
+        // REPEAT N 
+        --state.iRemaining;
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR;
+                  LOG_STRING("REPEAT"); LOG_STRING(strLabel);
+                  LOG_STRING("remaining:"); LOG_STRING(std::to_string(state.iRemaining)));
+
+        if (state.iRemaining > 0) {
+            m_advanceLoopIterIndex(state);
+            iIndex = state.szBeginIndex; // caller does ++iIndex → szBeginIndex+1
+        } else {
+            m_popLoopState(); // releases the index binding — state ref is now dangling
+            LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING("REPEAT done:"); LOG_STRING(strLabel));
+        }
+    } else {
+
+        // REPEAT UNTIL 
+        // Evaluate on a copy / the compiled program (do not mutate the template).
+        std::string strCondExpanded;
+        bool bCondResult = false;
+        if (true == m_evalConditionTpl(state.sConditionTpl, state.strCondition, state.uCondProgram, bCondResult, strCondExpanded)) {
+            if (!bCondResult) {
+                m_advanceLoopIterIndex(state);
+                iIndex = state.szBeginIndex;
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR;
+                          LOG_STRING("REPEAT UNTIL looping:"); LOG_STRING(strLabel));
+            } else {
+                m_popLoopState(); // releases the index binding — state ref is now dangling
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR;
+                          LOG_STRING("REPEAT UNTIL done:"); LOG_STRING(strLabel));
+            }
+        } else {
+            LOG_PRINT(LOG_ERROR, LOG_HDR;
+                      LOG_STRING("REPEAT UNTIL: failed to evaluate condition:"); LOG_STRING(strCondExpanded));
+            bRetVal = false;
+        }
+    }
+
+} /* m_runEndRepeat() */
+
+
+/*-------------------------------------------------------------------------------
+  Real execution of a plugin command (Command / MacroCommand), shared by the
+  tree-walking and the bytecode backend.  iLineNr is the script line number.
+  The execution time is logged at LOG_DEBUG: the timer (and its name) is only
+  built when that level is written and the profiler, which times the dispatch
+  itself, is off.
+-------------------------------------------------------------------------------*/
+
+template <typename T>
+bool ScriptInterpreter::m_runPluginCommand(const T& command, PluginInterface *pPlugin, int iLineNr) noexcept
+{
+    // Expand macros onto a copy — the IR must not be mutated so
+    // that every loop iteration starts from the original template.
+    std::string strExpandedParams;
+    m_expandMacros(command.sParamsTpl, command.strParams, strExpandedParams);
+    LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+        LOG_STRING("Exec:"); 
+        LOG_STRING(command.strPlugin + "." + command.strCommand + " " + strExpandedParams));
+    if (false == m_mapAsyncWorkers.empty()) {
+        m_waitAsyncIdle(pPlugin, iLineNr);
+    }
+    // block to ensure correct command execution time measurement (separate from delay)
+    {
+        std::optional<utime::Timer> timer;
+        if (!m_sProfiler.enabled() && LOG_ENABLED(LOG_DEBUG)) {
+            timer.emplace(std::string(ustring::fmtLineNr(iLineNr).data()) + " Command");
+        }
+        uprofile::ScopedPhase phase(m_sProfiler, uprofile::Phase::DISPATCH);
+        if (false == m_dispatchPluginCommand(pPlugin, command.sBinding, command.strCommand, strExpandedParams)) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                LOG_STRING("Failed executing"); 
+                LOG_STRING(command.strPlugin + "." + command.strCommand + " " + strExpandedParams)); 
+            return false;
+        } else { // execution succeeded, update the value of the associated macro if any
+            if constexpr (std::is_same_v<T, MacroCommand>) {
+                const std::string strValue = pPlugin->getData();
+                m_setVariable(command.uVarSlot, command.strVarMacroName, strValue);
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                    LOG_STRING("VAR["); LOG_STRING(command.strVarMacroName); 
+                    LOG_STRING("]->[") 
+                    LOG_STRING(strValue); 
+                    LOG_STRING("]"));
+                pPlugin->resetData();
+            }
+        }
+    }
+    m_waitFor(m_szDelay * 1000U); /* delay between the commands execution */
+
+    return true;
+
+} /* m_runPluginCommand() */
+
+
+/*-------------------------------------------------------------------------------
+  Evaluate the condition of an IF ... GOTO node.
+  Returns false (and logs) when the condition cannot be evaluated.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_evalJumpCondition(const Condition& command, int iLineNr, bool& bJump) noexcept
+{
+    // Expand variable macros on a copy — constant macros were already
+    // substituted at validation time, but $vmacros are only known at
+    // runtime and must be resolved here before the evaluator sees them.
+    std::string strCondExpanded;
+    if (false == m_evalConditionTpl(command.sConditionTpl, command.strCondition, command.uCondProgram, bJump, strCondExpanded)) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+            LOG_STRING("Failed to evaluate condition:"); 
+            LOG_STRING(strCondExpanded));
+        return false;
+    }
+
+    return true;
+
+} /* m_evalJumpCondition() */
+
+
+/*-------------------------------------------------------------------------------
+  REPEAT N / REPEAT UNTIL entry: push the loop state.  szBeginIndex is the
+  position of the REPEAT node in the executed sequence (IR index or program
+  counter), m_runEndRepeat loops back to szBeginIndex + 1.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_enterRepeatTimes(const RepeatTimes& command, size_t szBeginIndex, int iLineNr,
+                                          uint32_t uLabelId) noexcept
+{
+    const int iResolvedCount = m_resolveRepeatCount(command);
+    if (iResolvedCount < 1) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("REPEAT: failed to resolve count for loop:");
+                  LOG_STRING(command.strLabel));
+        return false;
+    }
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+              LOG_STRING("REPEAT start:"); 
+              LOG_STRING(command.strLabel);
+              LOG_STRING("count:"); 
+              LOG_STRING(std::to_string(iResolvedCount)));
+    m_loopStateStack.push_back({command.strLabel, szBeginIndex, iResolvedCount, false, "", {}, kNoSlot,
+                                command.strVarMacroName, 0U, command.uVarSlot, {}, ++m_uLoopEntries, uLabelId});
+    // Write the initial iteration index "0" into the loop's own scope.
+    m_initLoopIterIndex(m_loopStateStack.back());
+
+    return true;
+
+} /* m_enterRepeatTimes() */
+
+
+void ScriptInterpreter::m_enterRepeatUntil(const RepeatUntil& command, size_t szBeginIndex, int iLineNr,
+                                          uint32_t uLabelId) noexcept
+{
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+              LOG_STRING("REPEAT UNTIL start:"); 
+              LOG_STRING(command.strLabel);
+              LOG_STRING("cond:"); 
+              LOG_STRING(command.strCondition));
+    m_loopStateStack.push_back({command.strLabel, szBeginIndex, -1, true, command.strCondition, command.sConditionTpl,
+                                command.uCondProgram, command.strVarMacroName, 0U, command.uVarSlot, {}, ++m_uLoopEntries,
+                                uLabelId});
+    // Write the initial iteration index "0" into the loop's own scope.
+    m_initLoopIterIndex(m_loopStateStack.back());
+
+} /* m_enterRepeatUntil() */
+
+
+/*-------------------------------------------------------------------------------
+  DELAY <value> <unit>
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_runDelay(const DelayStatement& command, int iLineNr) noexcept
+{
+    const std::string strUnit = (command.eUnit == DelayUnit::US)  ? "us"  :
+                                (command.eUnit == DelayUnit::MS)  ? "ms"  : "sec";
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+              LOG_STRING("DELAY:"); 
+              LOG_STRING(std::to_string(command.szValue));
+              LOG_STRING(strUnit));
+    const size_t szScale = (command.eUnit == DelayUnit::US) ? 1U :
+                           (command.eUnit == DelayUnit::MS) ? 1000U : 1000000U;
+    m_sDelayStats.add(m_waitFor(command.szValue * szScale));
+
+} /* m_runDelay() */
+
+
+
+int64_t ScriptInterpreter::m_waitFor(size_t szUs) noexcept
+{
+    if (0U == szUs) {
+        return 0;
+    }
+
+    uprofile::ScopedPhase phase(m_sProfiler, uprofile::Phase::DELAY);
+    UTRACE_SCOPE(utrace::Category::DELAY, "wait");
+
+    const int64_t iDeadlineNs = utime::monotonic_ns() + static_cast<int64_t>(szUs) * 1000;
+    return utime::sleep_until_ns(iDeadlineNs, static_cast<int64_t>(m_szDelaySpinUs) * 1000);
+
+} /* m_waitFor() */
+
+
+/*-------------------------------------------------------------------------------
+  PERIOD <value> <unit>: deadline(n) = deadline(n-1) + period, independent of
+  when the pass arrives, so neither the loop body nor the wake-up latency of
+  earlier passes shift the cadence.  A pass a whole period late (or more)
+  does not wait; it restarts the timeline and counts as an overrun.
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_runPeriod(const PeriodStatement& command, int iLineNr, uint32_t uLoopLabelId) noexcept
+{
+    if (command.uTimeline >= m_vPeriodTimelines.size()) {
+        m_vPeriodTimelines.resize(command.uTimeline + 1U);
+    }
+    PeriodTimeline& sTimeline = m_vPeriodTimelines[command.uTimeline];
+
+    uint64_t uLoopEntry = 0U;
+    for (auto it = m_loopStateStack.rbegin(); it != m_loopStateStack.rend(); ++it) {
+        if ((uLoopLabelId != kNoSlot) ? (it->uLabelId == uLoopLabelId) : (it->strLabel == command.strLoopLabel)) {
+            uLoopEntry = it->uEntry;
+            break;
+        }
+    }
+
+    const int64_t iPeriodNs = static_cast<int64_t>(command.szPeriodUs) * 1000;
+    const int64_t iNowNs    = utime::monotonic_ns();
+
+    if (!sTimeline.bStarted || (sTimeline.uLoopEntry != uLoopEntry)) {
+        sTimeline.bStarted    = true;
+        sTimeline.uLoopEntry  = uLoopEntry;
+        sTimeline.iDeadlineNs = iNowNs + iPeriodNs;
+        sTimeline.szPeriodUs  = command.szPeriodUs;
+        sTimeline.iLineNr     = iLineNr;
+    } else {
+        sTimeline.iDeadlineNs += iPeriodNs;
+        if ((iNowNs - sTimeline.iDeadlineNs) >= iPeriodNs) {
+            LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                      LOG_STRING("PERIOD overrun, late us:"); LOG_INT64((iNowNs - sTimeline.iDeadlineNs) / 1000));
+            ++sTimeline.szOverruns;
+            sTimeline.iDeadlineNs = iNowNs;
+            return;
+        }
+    }
+
+    uprofile::ScopedPhase phase(m_sProfiler, uprofile::Phase::DELAY);
+    UTRACE_SCOPE(utrace::Category::DELAY, "PERIOD");
+    sTimeline.sStats.add(utime::sleep_until_ns(sTimeline.iDeadlineNs, static_cast<int64_t>(m_szDelaySpinUs) * 1000));
+
+} /* m_runPeriod() */
+
+
+
+void ScriptInterpreter::m_runDelayUntil(const DelayUntilStatement& command, int iLineNr) noexcept
+{
+    const int64_t iDeadlineNs = m_iRunStartNs + static_cast<int64_t>(command.szOffsetUs) * 1000;
+
+    if (utime::monotonic_ns() >= iDeadlineNs) {
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("DELAY_UNTIL: deadline already passed, us:"); LOG_SIZET(command.szOffsetUs));
+        return;
+    }
+
+    uprofile::ScopedPhase phase(m_sProfiler, uprofile::Phase::DELAY);
+    UTRACE_SCOPE(utrace::Category::DELAY, "DELAY_UNTIL");
+    m_sDelayStats.add(utime::sleep_until_ns(iDeadlineNs, static_cast<int64_t>(m_szDelaySpinUs) * 1000));
+
+} /* m_runDelayUntil() */
+
+
+
+void ScriptInterpreter::m_reportTiming() const noexcept
+{
+    if (m_sDelayStats.count() > 0U) {
+        LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING("Timing DELAY"); LOG_STRING(m_sDelayStats.to_string()));
+    }
+
+    for (const auto& sTimeline : m_vPeriodTimelines) {
+        if (sTimeline.bStarted) {
+            LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING(ustring::fmtLineNr(sTimeline.iLineNr).data());
+                      LOG_STRING("Timing PERIOD"); LOG_SIZET(sTimeline.szPeriodUs); LOG_STRING("us");
+                      LOG_STRING(sTimeline.sStats.to_string());
+                      LOG_STRING("overruns:"); LOG_SIZET(sTimeline.szOverruns));
+        }
+    }
+
+} /* m_reportTiming() */
+
+
+/*-------------------------------------------------------------------------------
+  Text of an IR line for the profiler report, rebuilt from the IR (comments,
+  spacing and the macros of the original line are not kept).
+-------------------------------------------------------------------------------*/
+
+std::vector<uprofile::LineInfo> ScriptInterpreter::m_profileLineInfo() const
+{
+    std::vector<uprofile::LineInfo> vInfo;
+    vInfo.reserve(m_sScriptEntries->vCommands.size());
+
+    auto unitText = [](DelayUnit eUnit) {
+        return (eUnit == DelayUnit::US) ? " us" : (eUnit == DelayUnit::MS) ? " ms" : " sec";
+    };
+
+    for (const auto& line : m_sScriptEntries->vCommands) {
+        std::string strText = std::visit([&unitText](const auto& command) -> std::string {
+            using T = std::decay_t<decltype(command)>;
+            if constexpr (std::is_same_v<T, Command>) {
+                return command.strPlugin + "." + command.strCommand + " " + command.strParams;
+            } else if constexpr (std::is_same_v<T, MacroCommand>) {
+                return command.strVarMacroName + " ?= " + command.strPlugin + "." + command.strCommand + " " + command.strParams;
+            } else if constexpr (std::is_same_v<T, AsyncCommand>) {
+                return command.strHandle + " ?= ASYNC " + command.strPlugin + "." + command.strCommand + " " + command.strParams;
+            } else if constexpr (std::is_same_v<T, Condition>) {
+                return (command.strCondition.empty() ? std::string() : "IF " + command.strCondition + " ") + "GOTO " + command.strLabelName;
+            } else if constexpr (std::is_same_v<T, Label>) {
+                return "LABEL " + command.strLabelName;
+            } else if constexpr (std::is_same_v<T, RepeatTimes>) {
+                return "REPEAT " + command.strLabel + " " + (command.strCountExpr.empty() ? std::to_string(command.iCount) : command.strCountExpr);
+            } else if constexpr (std::is_same_v<T, RepeatUntil>) {
+                return "REPEAT " + command.strLabel + " UNTIL " + command.strCondition;
+            } else if constexpr (std::is_same_v<T, RepeatEnd>) {
+                return "END_REPEAT " + command.strLabel;
+            } else if constexpr (std::is_same_v<T, LoopBreak>) {
+                return "BREAK " + command.strLabel;
+            } else if constexpr (std::is_same_v<T, LoopContinue>) {
+                return "CONTINUE " + command.strLabel;
+            } else if constexpr (std::is_same_v<T, PrintStatement>) {
+                return "PRINT " + command.strText;
+            } else if constexpr (std::is_same_v<T, VarMacroInit>) {
+                return command.strName + " ?= " + command.strValueTpl;
+            } else if constexpr (std::is_same_v<T, FormatStatement>) {
+                return command.strName + " ?= FORMAT " + command.strInputTpl + " | " + command.strFormatTpl;
+            } else if constexpr (std::is_same_v<T, DelayStatement>) {
+                return "DELAY " + std::to_string(command.szValue) + unitText(command.eUnit);
+            } else if constexpr (std::is_same_v<T, PeriodStatement>) {
+                return "PERIOD " + std::to_string(command.szPeriodUs) + " us";
+            } else if constexpr (std::is_same_v<T, DelayUntilStatement>) {
+                return "DELAY_UNTIL " + std::to_string(command.szOffsetUs) + " us";
+            } else if constexpr (std::is_same_v<T, MathStatement>) {
+                return command.strName + " ?= MATH " + command.strExprTpl;
+            } else if constexpr (std::is_same_v<T, BreakpointStatement>) {
+                return "BREAKPOINT " + command.strLabelTpl;
+            } else if constexpr (std::is_same_v<T, ParallelBegin>) {
+                return "PARALLEL " + command.strLabel;
+            } else if constexpr (std::is_same_v<T, ParallelBranch>) {
+                return "BRANCH";
+            } else if constexpr (std::is_same_v<T, ParallelEnd>) {
+                return "END_PARALLEL " + command.strLabel;
+            } else if constexpr (std::is_same_v<T, AwaitStatement>) {
+                return "AWAIT " + command.strHandle;
+            } else {
+                return std::string();
+            }
+        }, line.command);
+
+        while (!strText.empty() && (strText.back() == ' ')) {
+            strText.pop_back();
+        }
+        vInfo.push_back(uprofile::LineInfo{line.iLineNumber, std::move(strText)});
+    }
+
+    return vInfo;
+
+} /* m_profileLineInfo() */
+
+
+
+void ScriptInterpreter::m_writeProfileReport(int64_t iRunNs) noexcept
+{
+    try {
+        m_sProfiler.writeReport(m_strProfileReport, m_profileLineInfo(), static_cast<uint64_t>(std::max<int64_t>(0, iRunNs)));
+    } catch (const std::exception& ex) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Profile report failed:"); LOG_STRING(ex.what()));
+    }
+    m_sProfiler.disable();
+
+} /* m_writeProfileReport() */
+
+
+/*-------------------------------------------------------------------------------
+  Node spans: the line is recorded when it ends, as one complete event named
+  after the script line.  The profiler keeps its own bracket.
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_lineBegin(size_t szLine) noexcept
+{
+    m_sProfiler.beginLine(szLine);
+    if (m_pTrace) {
+        m_szTraceLine  = szLine;
+        m_iTraceLineNs = utime::monotonic_ns();
+    }
+
+} /* m_lineBegin() */
+
+
+
+void ScriptInterpreter::m_lineEnd() noexcept
+{
+    m_sProfiler.endLine();
+    if (m_pTrace && (m_szTraceLine < m_shpTraceNames->size())) {
+        m_pTrace->record(utrace::Category::NODE, (*m_shpTraceNames)[m_szTraceLine], m_iTraceLineNs, utime::monotonic_ns());
+        m_szTraceLine = SIZE_MAX;
+    }
+
+} /* m_lineEnd() */
+
+
+
+void ScriptInterpreter::m_startTrace()
+{
+    try {
+        std::vector<std::string> vNames;
+        for (const auto& sInfo : m_profileLineInfo()) {
+            vNames.push_back(ustring::fmtLineNr<std::string>(sInfo.iLineNumber) + " " + sInfo.strText);
+        }
+        m_shpTraceNames = std::make_shared<const std::vector<std::string>>(std::move(vNames));
+    } catch (const std::exception& ex) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Trace setup failed:"); LOG_STRING(ex.what()));
+        return;
+    }
+
+    m_shpTracer->start();
+    m_shpTracer->name_thread("script");
+    m_pTrace = m_shpTracer.get();
+
+} /* m_startTrace() */
+
+
+
+void ScriptInterpreter::m_writeTrace() noexcept
+{
+    m_shpTracer->stop();
+    m_pTrace = nullptr;
+
+    try {
+        size_t szEvents = 0U;
+        size_t szDropped = 0U;
+        if (m_shpTracer->write(m_strTraceFile, szEvents, szDropped)) {
+            LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING("Trace written:"); LOG_STRING(m_strTraceFile);
+                      LOG_STRING("events:"); LOG_SIZET(szEvents); LOG_STRING("dropped:"); LOG_SIZET(szDropped));
+        } else {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Failed to write the trace:"); LOG_STRING(m_strTraceFile));
+        }
+    } catch (const std::exception& ex) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Trace output failed:"); LOG_STRING(ex.what()));
+    }
+
+} /* m_writeTrace() */
+
+
+/*-------------------------------------------------------------------------------
+  Branch interpreter: shares the (read-only) script entries and the plugins
+  bound to them; everything the execution writes is private.  The .ini
+  loader is left empty, the settings are taken from parent.
+-------------------------------------------------------------------------------*/
+
+ScriptInterpreter::ScriptInterpreter(BranchTag, const ScriptInterpreter& parent)
+    : m_PluginLoader(PluginPathGenerator(SCRIPT_PLUGINS_PATH, PLUGIN_PREFIX, SCRIPT_PLUGIN_EXTENSION),
+                     PluginEntryPointResolver(SCRIPT_PLUGIN_ENTRY_POINT_NAME, SCRIPT_PLUGIN_EXIT_POINT_NAME))
+    , m_szDelay(parent.m_szDelay)
+    , m_szDelaySpinUs(parent.m_szDelaySpinUs)
+    , m_sScriptEntries(parent.m_sScriptEntries)
+    , m_vVarSlots(parent.m_vVarSlots)
+    , m_mapVarSlotIndex(parent.m_mapVarSlotIndex)
+    , m_vSlotWritten(parent.m_vVarSlots.size(), 0)
+    , m_vArraySlots(parent.m_vArraySlots)
+    , m_ShellVarMacros(parent.m_ShellVarMacros)
+    , m_mathVars(parent.m_mathVars)
+    , m_vMathPrograms(parent.m_vMathPrograms)
+    , m_vCondPrograms(parent.m_vCondPrograms)
+    , m_iRunStartNs(parent.m_iRunStartNs)
+    , m_pTrace(parent.m_pTrace)
+    , m_shpTraceNames(parent.m_shpTraceNames)
+{
+}
+
+
+/*-------------------------------------------------------------------------------
+  PARALLEL <label>: one worker thread per branch.  The branch interpreters
+  are built on the calling thread, which then waits for all of them (a
+  failing branch does not stop the others: hardware already started is left
+  to finish).  The workers stage their log lines privately and write each
+  one out when complete, so lines of different branches interleave but are
+  never mixed.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_runParallel(const ParallelBegin& command, int iLineNr) noexcept
+{
+    const auto& vBranchIndices = command.vBranchIndices;
+    const size_t szNrBranches  = vBranchIndices.size();
+
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+              LOG_STRING("PARALLEL start:"); LOG_STRING(command.strLabel);
+              LOG_STRING("branches:"); LOG_SIZET(szNrBranches));
+
+    // ASYNC commands queued before the block finish first: the branch
+    // interpreters do not know which plugins are still busy
+    for (auto& [pPlugin, upWorker] : m_mapAsyncWorkers) {
+        m_waitAsyncIdle(pPlugin, iLineNr);
+    }
+
+    std::vector<std::unique_ptr<ScriptInterpreter>> vBranches;
+    std::vector<char> vOk(szNrBranches, 0);
+
+    auto branchEnd = [&](size_t k) {
+        return std::get<ParallelBranch>(m_sScriptEntries->vCommands[vBranchIndices[k]].command).szEndIndex;
+    };
+
+    try {
+        vBranches.reserve(szNrBranches);
+        for (size_t k = 0; k < szNrBranches; ++k) {
+            vBranches.push_back(std::unique_ptr<ScriptInterpreter>(new ScriptInterpreter(BranchTag{}, *this)));
+            if (m_sProfiler.enabled()) {
+                vBranches.back()->m_sProfiler.reset(vBranchIndices[k] + 1U, branchEnd(k));
+            }
+        }
+    } catch (const std::exception& ex) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("PARALLEL: failed to set up the branches:"); LOG_STRING(ex.what()));
+        return false;
+    }
+
+    auto runBranch = [&](size_t k) {
+        vOk[k] = vBranches[k]->m_executeBranch(vBranchIndices[k] + 1U, branchEnd(k)) ? 1 : 0;
+    };
+
+    std::vector<std::thread> vWorkers;
+    std::vector<size_t> vInline;    // branches whose thread could not be started
+    vWorkers.reserve(szNrBranches);
+    for (size_t k = 0; k < szNrBranches; ++k) {
+        try {
+            vWorkers.emplace_back([&, k]() {
+                if (m_pTrace) {
+                    m_pTrace->name_thread("PARALLEL " + command.strLabel + " branch " + std::to_string(k + 1U));
+                }
+                runBranch(k);
+            });
+        } catch (const std::system_error&) {
+            vInline.push_back(k);
+        }
+    }
+    for (size_t k : vInline) {
+        runBranch(k);
+    }
+    for (auto& thread : vWorkers) {
+        thread.join();
+    }
+
+    bool bRetVal = true;
+    for (size_t k = 0; k < szNrBranches; ++k) {
+        m_publishBranchVariables(*vBranches[k]);
+        m_sProfiler.merge(vBranches[k]->m_sProfiler);
+        m_sDelayStats.merge(vBranches[k]->m_sDelayStats);
+        auto& vTimelines = vBranches[k]->m_vPeriodTimelines;  // same uTimeline indices as here
+        if (vTimelines.size() > m_vPeriodTimelines.size()) {
+            m_vPeriodTimelines.resize(vTimelines.size());
+        }
+        for (size_t t = 0; t < vTimelines.size(); ++t) {
+            if (vTimelines[t].bStarted && m_vPeriodTimelines[t].bStarted) {
+                m_vPeriodTimelines[t].sStats.merge(vTimelines[t].sStats);
+                m_vPeriodTimelines[t].szOverruns += vTimelines[t].szOverruns;
+            } else if (vTimelines[t].bStarted) {
+                m_vPeriodTimelines[t] = std::move(vTimelines[t]);
+            }
+        }
+        if (0 == vOk[k]) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                      LOG_STRING("PARALLEL"); LOG_STRING(command.strLabel);
+                      LOG_STRING("branch"); LOG_SIZET(k + 1U); LOG_STRING("failed"));
+            bRetVal = false;
+        }
+    }
+
+    LOG_PRINT((bRetVal ? LOG_INFO : LOG_ERROR), LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+              LOG_STRING("PARALLEL"); LOG_STRING(command.strLabel);
+              LOG_STRING(bRetVal ? "ok" : "failed"));
+
+    return bRetVal;
+
+} /* m_runParallel() */
+
+
+/*-------------------------------------------------------------------------------
+  Body of a branch: same loop as m_executeCommands over [szBegin, szEnd).
+  Jumps stay inside the range (checked by the validator).
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_executeBranch(size_t szBegin, size_t szEnd) noexcept
+{
+    auto& vCommands = m_sScriptEntries->vCommands;
+    size_t i = szBegin;
+
+    while (i < szEnd) {
+        m_lineBegin(i);
+        const bool bOk = m_executeCommand(vCommands[i], true, i);
+        m_lineEnd();
+        if (false == bOk) {
+            return false;
+        }
+        ++i;
+    }
+
+    return true;
+
+} /* m_executeBranch() */
+
+
+/*-------------------------------------------------------------------------------
+  Copy the script-level variables written by a branch (slots appended by the
+  branch itself were never seen by the parent and are dropped).
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_publishBranchVariables(const ScriptInterpreter& branch)
+{
+    const size_t szCount = std::min(m_vVarSlots.size(), branch.m_vSlotWritten.size());
+
+    for (size_t i = 0; i < szCount; ++i) {
+        if (0 != branch.m_vSlotWritten[i]) {
+            m_setVariable(static_cast<uint32_t>(i), branch.m_vVarSlots[i].strName, branch.m_vVarSlots[i].strValue);
+        }
+    }
+
+} /* m_publishBranchVariables() */
+
+
+/*-------------------------------------------------------------------------------
+  handle ?= ASYNC PLUGIN.COMMAND [params]: the parameters are expanded now,
+  the dispatch and the getData / resetData of the result run on the worker.
+  A handle whose previous command was not awaited yet is rejected.  If no
+  worker thread can be started the command runs at once, inline.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_runAsync(const AsyncCommand& command, PluginInterface *pPlugin, int iLineNr) noexcept
+{
+    if (m_mapAsyncPending.count(command.uVarSlot)) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("ASYNC: handle still pending:"); LOG_STRING(command.strHandle));
+        return false;
+    }
+
+    std::string strExpandedParams;
+    m_expandMacros(command.sParamsTpl, command.strParams, strExpandedParams);
+    LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+        LOG_STRING("Async:");
+        LOG_STRING(command.strPlugin + "." + command.strCommand + " " + strExpandedParams);
+        LOG_STRING("->"); LOG_STRING(command.strHandle));
+
+    // the IR node outlives the job (pending commands finish with the run)
+    auto job = [this, pPlugin, sBinding = command.sBinding, strCommand = command.strCommand,
+                strParams = std::move(strExpandedParams), iLineNr, pstrHandle = &command.strHandle]() {
+        uasync::Result sResult;
+        {
+            std::optional<utime::Timer> timer;
+            if (LOG_ENABLED(LOG_DEBUG)) {
+                timer.emplace(std::string(ustring::fmtLineNr(iLineNr).data()) + " Async " + *pstrHandle);
+            }
+            sResult.bOk = m_dispatchPluginCommand(pPlugin, sBinding, strCommand, strParams);
+        }
+        if (sResult.bOk) {
+            sResult.strValue = pPlugin->getData();
+            pPlugin->resetData();
+        }
+        return sResult;
+    };
+
+    try {
+        auto& upWorker = m_mapAsyncWorkers[pPlugin];
+        if (!upWorker) {
+            upWorker = std::make_unique<uasync::PluginWorker>("ASYNC " + command.strPlugin);
+        }
+        m_mapAsyncPending.emplace(command.uVarSlot, upWorker->submit(std::move(job)));
+    } catch (const std::system_error&) {
+        m_mapAsyncWorkers.erase(pPlugin);
+        LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("ASYNC: no worker thread, running inline:"); LOG_STRING(command.strHandle));
+        std::promise<uasync::Result> promise;
+        promise.set_value(job());
+        m_mapAsyncPending.emplace(command.uVarSlot, promise.get_future());
+    }
+
+    m_waitFor(m_szDelay * 1000U); /* delay between the commands execution */
+
+    return true;
+
+} /* m_runAsync() */
+
+
+/*-------------------------------------------------------------------------------
+  AWAIT <handle> [TIMEOUT n unit]: on a timeout the command keeps running and
+  the script fails; the command is then waited for by m_finishAsyncCommands.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_runAwait(const AwaitStatement& command, int iLineNr) noexcept
+{
+    auto it = m_mapAsyncPending.find(command.uVarSlot);
+    if (it == m_mapAsyncPending.end()) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("AWAIT: no pending ASYNC command for handle:"); LOG_STRING(command.strHandle));
+        return false;
+    }
+
+    if ((command.szTimeoutUs > 0U) &&
+        (it->second.wait_for(std::chrono::microseconds(command.szTimeoutUs)) != std::future_status::ready)) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("AWAIT: timeout for handle:"); LOG_STRING(command.strHandle);
+                  LOG_STRING("us:"); LOG_SIZET(command.szTimeoutUs));
+        return false;
+    }
+
+    const uasync::Result sResult = it->second.get();
+    m_mapAsyncPending.erase(it);
+
+    if (false == sResult.bOk) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("AWAIT: ASYNC command failed for handle:"); LOG_STRING(command.strHandle));
+        return false;
+    }
+
+    m_setVariable(command.uVarSlot, command.strHandle, sResult.strValue);
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+        LOG_STRING("VAR["); LOG_STRING(command.strHandle);
+        LOG_STRING("]->[");
+        LOG_STRING(sResult.strValue);
+        LOG_STRING("]"));
+
+    return true;
+
+} /* m_runAwait() */
+
+
+
+void ScriptInterpreter::m_waitAsyncIdle(PluginInterface *pPlugin, int iLineNr) noexcept
+{
+    auto it = m_mapAsyncWorkers.find(pPlugin);
+    if ((it != m_mapAsyncWorkers.end()) && it->second->waitIdle()) {
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("Waited for the ASYNC commands of the plugin"));
+    }
+
+} /* m_waitAsyncIdle() */
+
+
+/*-------------------------------------------------------------------------------
+  Results nobody awaited are dropped (with a warning); the worker destructors
+  run what is still queued and join.
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_finishAsyncCommands() noexcept
+{
+    for (auto& [uSlot, future] : m_mapAsyncPending) {
+        future.wait();
+        LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("ASYNC result not awaited:");
+                  LOG_STRING((uSlot < m_vVarSlots.size()) ? m_vVarSlots[uSlot].strName : std::string()));
+    }
+    m_mapAsyncPending.clear();
+    m_mapAsyncWorkers.clear();
+
+} /* m_finishAsyncCommands() */
+
+
+/*-------------------------------------------------------------------------------
+  name ?= <value> (see m_executeCommand): expand the value, or evaluate it
+  when it is an EVAL expression, and store it in the variable slot.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_runVarInit(const VarMacroInit& command, int iLineNr) noexcept
+{
+    std::string strExpanded;
+    bool bIsEval = (command.uCondProgram != kNoSlot);
+
+    if (false == bIsEval) {
+        m_expandMacros(command.sValueTpl, command.strValueTpl, strExpanded);
+
+        // If the expanded value starts with "EVAL " delegate to the
+        // unified condition evaluator and store "TRUE" or "FALSE".
+        std::string strEvalCheck = strExpanded;
+        ustring::stripPrefix(strEvalCheck, kEvalPrefix);
+        bIsEval = (strEvalCheck.size() < strExpanded.size());
+    }
+
+    if (bIsEval)
+    {
+        bool bEvalResult = false;
+        const bool bEvalOk = (command.uCondProgram != kNoSlot)
+            ? m_evalConditionTpl(command.sValueTpl, command.strValueTpl, command.uCondProgram, bEvalResult, strExpanded)
+            : m_evaluateCondition(strExpanded, bEvalResult);
+        if (bEvalOk) {
+            strExpanded = bEvalResult ? "TRUE" : "FALSE";
+            LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                      LOG_STRING("EVAL result for VAR_INIT ["); 
+                      LOG_STRING(command.strName);
+                      LOG_STRING("] -> ["); 
+                      LOG_STRING(strExpanded); LOG_STRING("]"));
+        } else {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                      LOG_STRING("EVAL failed for VAR_INIT ["); 
+                      LOG_STRING(command.strName);
+                      LOG_STRING("]"));
+            return false;
+        }
+    }
+
+    m_setVariable(command.uVarSlot, command.strName, strExpanded);
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+              LOG_STRING("VAR_INIT ["); LOG_STRING(command.strName);
+              LOG_STRING("]->["); 
+              LOG_STRING(strExpanded); LOG_STRING("]"));
+
+    return true;
+
+} /* m_runVarInit() */
+
+
+/*-------------------------------------------------------------------------------
+  name ?= FORMAT input | format_pattern (see m_executeCommand).
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_runFormat(const FormatStatement& command, int iLineNr) noexcept
+{
+    // macro expansion 
+    std::string strInput;
+    std::string strFormat;
+    m_expandMacros(command.sInputTpl,  command.strInputTpl,  strInput);
+    m_expandMacros(command.sFormatTpl, command.strFormatTpl, strFormat);
+
+    // tokenise input by whitespace
+    std::vector<std::string> vItems;
+    {
+        std::istringstream iss(strInput);
+        std::string token;
+        while (iss >> token) {
+            vItems.push_back(std::move(token));
+        }
+    }
+    const size_t szNrItems = vItems.size();
+
+    if (szNrItems == 0) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                  LOG_STRING("FORMAT ["); LOG_STRING(command.strName);
+                  LOG_STRING("]: input expanded to empty — no items to substitute"));
+        return false;
+    }
+
+    // build output by walking the format template
+    std::string strResult;
+    strResult.reserve(strFormat.size());
+
+    for (size_t i = 0; i < strFormat.size(); ++i) {
+        const char c = strFormat[i];
+        if (c == '%') {
+            // Validator guarantees a digit follows, but guard anyway.
+            if (i + 1 >= strFormat.size()) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                          LOG_STRING("FORMAT ["); 
+                          LOG_STRING(command.strName);
+                          LOG_STRING("]: '%' at end of expanded format template"));
+                return false;
+            }
+            const char cIdx = strFormat[++i];
+            if (!std::isdigit(static_cast<unsigned char>(cIdx))) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                          LOG_STRING("FORMAT ["); 
+                          LOG_STRING(command.strName);
+                          LOG_STRING("]: '%"); 
+                          LOG_STRING(std::string(1, cIdx));
+                          LOG_STRING("' — index character is not a digit"));
+                return false;
+            }
+            const size_t uiIndex = static_cast<size_t>(cIdx - '0');
+            if (uiIndex >= szNrItems) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                          LOG_STRING("FORMAT ["); 
+                          LOG_STRING(command.strName);
+                          LOG_STRING("]: index %"); 
+                          LOG_STRING(std::string(1, cIdx));
+                          LOG_STRING("out of range (input has");
+                          LOG_SIZET(szNrItems); 
+                          LOG_STRING("items)"));
+                return false;
+            }
+            strResult += vItems[uiIndex];
+        } else {
+            strResult += c;
+        }
+    }
+
+    // store result
+    m_setVariable(command.uVarSlot, command.strName, strResult);
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+              LOG_STRING("FORMAT ["); 
+              LOG_STRING(command.strName);
+              LOG_STRING("]->["); 
+              LOG_STRING(strResult); 
+              LOG_STRING("]"));
+
+    return true;
+
+} /* m_runFormat() */
+
+
+/*-------------------------------------------------------------------------------
+  name ?= MATH <expression> (see m_executeCommand).
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_runMath(const MathStatement& command, int iLineNr) noexcept
+{
+    // cached program when every macro holds a plain number,
+    // otherwise macro expansion of the whole expression
+    const bool bCompiled = m_loadMathHoles(command);
+
+    // the expanded text is only built for the textual path and the logs
+    std::string strExpr;
+    bool bExpanded = false;
+    auto exprText = [&]() -> const std::string& {
+        if (!bExpanded) {
+            m_expandMacros(command.sExprTpl, command.strExprTpl, strExpr);
+            bExpanded = true;
+        }
+        return strExpr;
+    };
+
+    // expansion may log errors of its own, so it must not start
+    // inside a LOG_PRINT; on the cached path all macros resolved
+    if (!bCompiled) {
+        exprText();
+    }
+
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+              LOG_STRING("MATH ["); 
+              LOG_STRING(command.strName);
+              LOG_STRING("] expr=["); 
+              LOG_STRING(exprText()); 
+              LOG_STRING("]"));
+
+    // evaluate 
+    double dResult = 0.0;
+    try {
+        if (bCompiled) {
+            dResult = Calculator::run(m_vMathPrograms[command.uProgram].sProgram, m_mathVars, m_vMathHoles.data());
+        } else {
+            Calculator calc(exprText(), m_mathVars);
+            dResult = calc.evaluate();
+        }
+    } catch (const std::exception& ex) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                  LOG_STRING("MATH ["); 
+                  LOG_STRING(command.strName);
+                  LOG_STRING("]: evaluation failed:"); 
+                  LOG_STRING(ex.what());
+                  LOG_STRING("expr=["); 
+                  LOG_STRING(exprText()); 
+                  LOG_STRING("]"));
+        return false;
+    }
+
+    // double -> string 
+    // Use defaultfloat + 15 significant digits so integer results
+    // print cleanly (5, not 5.000000) and precision is preserved.
+    std::string strResult;
+    {
+        std::ostringstream oss;
+        oss << std::defaultfloat << std::setprecision(15) << dResult;
+        strResult = oss.str();
+    }
+
+    // | HEX post-processor: convert the integer result to a minimal
+    // big-endian hex string using hexutils::intToHexString.
+    // e.g.  2 → "02",  255 → "FF",  256 → "0100"
+    if (command.bHexOutput) {
+        const uint64_t uVal = static_cast<uint64_t>(static_cast<int64_t>(dResult));
+        strResult = hexutils::intToHexString(uVal);
+        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data());
+                  LOG_STRING("MATH HEX [");
+                  LOG_STRING(command.strName);
+                  LOG_STRING("] -> [");
+                  LOG_STRING(strResult); LOG_STRING("]"));
+    }
+
+    // store result
+    m_setVariable(command.uVarSlot, command.strName, strResult);
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+              LOG_STRING("MATH ["); 
+              LOG_STRING(command.strName);
+              LOG_STRING("]->["); 
+              LOG_STRING(strResult); 
+              LOG_STRING("]"));
+
+    return true;
+
+} /* m_runMath() */
+
+
+/*-------------------------------------------------------------------------------
+  BREAKPOINT [label] (see m_executeCommand): false if the user aborts.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_runBreakpoint(const BreakpointStatement& command, int iLineNr) noexcept
+{
+    // Expand $macros in the label so the user sees current values
+    std::string strLabel;
+    m_expandMacros(command.sLabelTpl, command.strLabelTpl, strLabel);
+
+    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+              LOG_STRING("BREAKPOINT hit:");
+              LOG_STRING(strLabel.empty() ? "<no label>" : strLabel));
+
+    CheckContinue checkContinue;
+    const bool bOk = checkContinue(strLabel);
+
+    if (!bOk) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(iLineNr).data()); 
+                  LOG_STRING("BREAKPOINT: script aborted by user"));
+    }
+    // Note: the skip path (Space key) is handled inside CheckContinue
+    // by setting *pbSkip. BREAKPOINT does not propagate the skip to
+    // surrounding script flow — it only skips THIS breakpoint, not
+    // the next command. nullptr is passed for pbSkip intentionally:
+    // the Space key simply acts as "continue" for BREAKPOINT.
+
+    return bOk;
+
+} /* m_runBreakpoint() */
+
+
+/*-------------------------------------------------------------------------------
+  Execute a single IR command.
+
+  iIndex is the current position in vCommands (owned by the caller's loop).
+  Loop end nodes (RepeatEnd) may set iIndex to (desired_next - 1) so that the
+  caller's unconditional ++iIndex lands at the correct body-start address.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size_t& iIndex) noexcept
+{
+    bool bRetVal = true;
+    bool bIsPluginCommand = false;
+    auto lineNr = ustring::fmtLineNr(data.iLineNumber);
+
+    std::visit([this, bRealExec, &data, &lineNr, &bIsPluginCommand, &bRetVal, &iIndex](auto& command) {
+        using T = std::decay_t<decltype(command)>;
+
+        /*-----------------------------------------------------------------
+            Plugin commands (Command / MacroCommand)
+        -----------------------------------------------------------------*/
+
+        if constexpr (std::is_same_v<T, MacroCommand> || std::is_same_v<T, Command> ||
+                      std::is_same_v<T, AsyncCommand>) {
+            if (m_eSkipReason == SkipReason::NONE) {
+                bIsPluginCommand = true;
+
+                // Bound commands carry their plugin; shell-built lines look it up by name.
+                PluginInterface *pPlugin = command.sBinding.pPlugin;
+                if (nullptr == pPlugin) {
+                    for (const auto& plugin : m_sScriptEntries->vPlugins) {
+                        if (command.strPlugin == plugin.strPluginName) {
+                            pPlugin = plugin.shptrPluginEntryPoint.get();
+                            break;
+                        }
+                    }
+                }
+
+                if (nullptr != pPlugin) {
+                    if(bRealExec) { // real execution
+                        if constexpr (std::is_same_v<T, AsyncCommand>) {
+                            bRetVal = m_runAsync(command, pPlugin, data.iLineNumber);
+                        } else {
+                            bRetVal = m_runPluginCommand(command, pPlugin, data.iLineNumber);
+                        }
+                    } else { // only for validation purposes
+                        LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING(lineNr.data()); 
+                                LOG_STRING("Validate:"); 
+                                LOG_STRING(command.strPlugin + "." + command.strCommand); 
+                                LOG_STRING(command.strParams));
+                        if (false == m_dispatchPluginCommand(pPlugin, command.sBinding, command.strCommand, command.strParams)) {
+                            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
+                                LOG_STRING("Failed validating"); 
+                                LOG_STRING(command.strPlugin + "." + command.strCommand); 
+                                LOG_STRING(command.strParams));
+                            bRetVal = false;
+                        }
+                    }
+                }
+            } else {
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
+                    LOG_STRING("Skipped:"); LOG_STRING(command.strPlugin); 
+                    LOG_STRING(command.strCommand); LOG_STRING("args["); 
+                    LOG_STRING(command.strParams); LOG_STRING("]"));
+            }
+
+        /*-----------------------------------------------------------------
+            IF/GOTO condition
+        -----------------------------------------------------------------*/
+
+        } else if constexpr (std::is_same_v<T, Condition>) {
+            if(bRealExec) {
+                if(m_eSkipReason == SkipReason::NONE) {
+                    bool beResult = false;
+
+                    if (true == m_evalJumpCondition(command, data.iLineNumber, beResult)) {
+                        if (true == beResult) {
+                            if (command.szTargetIndex != kNoJump) {
+                                // GOTO never crosses a loop boundary: no loop state to unwind.
+                                // The caller's ++iIndex resumes right after the LABEL node.
+                                iIndex = command.szTargetIndex;
+                                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data());
+                                    LOG_STRING("Jump to label:");
+                                    LOG_STRING(command.strLabelName));
+                            } else {
+                                m_strSkipUntilLabel = command.strLabelName;
+                                m_eSkipReason       = SkipReason::GOTO;
+                                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
+                                    LOG_STRING("Start skipping to label:"); 
+                                    LOG_STRING(m_strSkipUntilLabel));
+                            }
+                        }
+                    } else {
+                        bRetVal = false;
+                    }
+                } else {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
+                        LOG_STRING("Skipped:"); 
+                        LOG_STRING("[IF ..] GOTO:"); 
+                        LOG_STRING(command.strLabelName));
+                }
+            }
 
         /*-----------------------------------------------------------------
             GOTO/IF target label
@@ -1058,23 +2712,7 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
 
         } else if constexpr (std::is_same_v<T, RepeatTimes>) {
             if (bRealExec && m_eSkipReason == SkipReason::NONE) {
-                const int iResolvedCount = m_resolveRepeatCount(command);
-                if (iResolvedCount < 1) {
-                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data());
-                              LOG_STRING("REPEAT: failed to resolve count for loop:");
-                              LOG_STRING(command.strLabel));
-                    bRetVal = false;
-                    return;
-                }
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                          LOG_STRING("REPEAT start:"); 
-                          LOG_STRING(command.strLabel);
-                          LOG_STRING("count:"); 
-                          LOG_STRING(std::to_string(iResolvedCount)));
-                m_loopStateStack.push_back({command.strLabel, iIndex, iResolvedCount, false, "",
-                                            command.strVarMacroName, 0U, {}});
-                // Write the initial iteration index "0" into the loop's own scope.
-                m_initLoopIterIndex(m_loopStateStack.back());
+                bRetVal = m_enterRepeatTimes(command, iIndex, data.iLineNumber);
             }
 
         /*-----------------------------------------------------------------
@@ -1083,15 +2721,7 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
 
         } else if constexpr (std::is_same_v<T, RepeatUntil>) {
             if (bRealExec && m_eSkipReason == SkipReason::NONE) {
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                          LOG_STRING("REPEAT UNTIL start:"); 
-                          LOG_STRING(command.strLabel);
-                          LOG_STRING("cond:"); 
-                          LOG_STRING(command.strCondition));
-                m_loopStateStack.push_back({command.strLabel, iIndex, -1, true, command.strCondition,
-                                            command.strVarMacroName, 0U, {}});
-                // Write the initial iteration index "0" into the loop's own scope.
-                m_initLoopIterIndex(m_loopStateStack.back());
+                m_enterRepeatUntil(command, iIndex, data.iLineNumber);
             }
 
         /*-----------------------------------------------------------------
@@ -1140,7 +2770,7 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
                         LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
                                   LOG_STRING("BREAK: unwinding loop:"); 
                                   LOG_STRING(command.strLabel));
-                        m_loopStateStack.pop_back();
+                        m_popLoopState();
                     }
                     if (command.strLabel == m_strSkipUntilLabel) {
                         // Target reached — resume after this END_REPEAT with no loop-back.
@@ -1161,7 +2791,7 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
                             LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
                                       LOG_STRING("CONTINUE: unwinding inner loop:"); 
                                       LOG_STRING(command.strLabel));
-                            m_loopStateStack.pop_back();
+                            m_popLoopState();
                         }
                     } else {
                         // Target reached — clear skip, keep LoopState alive, run loop logic.
@@ -1178,8 +2808,10 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
 
         /*-----------------------------------------------------------------
             BREAK <loop-label>
-         Skip forward to END_REPEAT of the named loop; all intermediate
-         loops are unwound by the END_REPEAT handler above.
+         Jump to END_REPEAT of the named loop after popping the inner loops
+         and the target loop itself (resolved by the validator).
+         Unresolved nodes skip forward instead; all intermediate loops are
+         then unwound by the END_REPEAT handler above.
          -----------------------------------------------------------------*/
 
         } else if constexpr (std::is_same_v<T, LoopBreak>) {
@@ -1187,14 +2819,24 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
                 LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
                           LOG_STRING("BREAK:"); 
                           LOG_STRING(command.strLabel));
-                m_strSkipUntilLabel = command.strLabel;
-                m_eSkipReason       = SkipReason::BREAK_LOOP;
+                if (command.szTargetIndex != kNoJump) {
+                    if (false == m_unwindLoops(command.szUnwindDepth, command.strLabel)) {
+                        bRetVal = false;
+                        return;
+                    }
+                    m_popLoopState();
+                    iIndex = command.szTargetIndex;   // caller's ++iIndex resumes after END_REPEAT
+                } else {
+                    m_strSkipUntilLabel = command.strLabel;
+                    m_eSkipReason       = SkipReason::BREAK_LOOP;
+                }
             }
 
         /*-----------------------------------------------------------------
             CONTINUE <loop-label>
-         Skip forward to END_REPEAT of the named loop, which then runs its
-         normal loop-back or exit logic.
+         Jump to END_REPEAT of the named loop after popping the inner loops,
+         then run its normal loop-back or exit logic.
+         Unresolved nodes skip forward to the END_REPEAT instead.
         -----------------------------------------------------------------*/
 
         } else if constexpr (std::is_same_v<T, LoopContinue>) {
@@ -1202,8 +2844,17 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
                 LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
                           LOG_STRING("CONTINUE:"); 
                           LOG_STRING(command.strLabel));
-                m_strSkipUntilLabel = command.strLabel;
-                m_eSkipReason       = SkipReason::CONTINUE_LOOP;
+                if (command.szTargetIndex != kNoJump) {
+                    if (false == m_unwindLoops(command.szUnwindDepth, command.strLabel)) {
+                        bRetVal = false;
+                        return;
+                    }
+                    iIndex = command.szTargetIndex;
+                    m_runEndRepeat(iIndex, bRetVal);
+                } else {
+                    m_strSkipUntilLabel = command.strLabel;
+                    m_eSkipReason       = SkipReason::CONTINUE_LOOP;
+                }
             }
 
         /*-----------------------------------------------------------------
@@ -1215,8 +2866,8 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
 
         } else if constexpr (std::is_same_v<T, PrintStatement>) {
             if (bRealExec && m_eSkipReason == SkipReason::NONE) {
-                std::string strExpanded = command.strText;
-                m_replaceVariableMacros(strExpanded);
+                std::string strExpanded;
+                m_expandMacros(command.sTextTpl, command.strText, strExpanded);
                 LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING(lineNr.data());
                           LOG_STRING(strExpanded));
             }
@@ -1232,23 +2883,47 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
 
         } else if constexpr (std::is_same_v<T, DelayStatement>) {
             if (bRealExec && m_eSkipReason == SkipReason::NONE) {
-                const std::string strUnit = (command.eUnit == DelayUnit::US)  ? "us"  :
-                                            (command.eUnit == DelayUnit::MS)  ? "ms"  : "sec";
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                          LOG_STRING("DELAY:"); 
-                          LOG_STRING(std::to_string(command.szValue));
-                          LOG_STRING(strUnit));
-                switch (command.eUnit) {
-                    case DelayUnit::US:  utime::delay_us(command.szValue);      break;
-                    case DelayUnit::MS:  utime::delay_ms(command.szValue);      break;
-                    case DelayUnit::SEC: utime::delay_seconds(command.szValue); break;
-                }
+                m_runDelay(command, data.iLineNumber);
+            }
+
+        } else if constexpr (std::is_same_v<T, PeriodStatement>) {
+            if (bRealExec && m_eSkipReason == SkipReason::NONE) {
+                m_runPeriod(command, data.iLineNumber);
+            }
+
+        } else if constexpr (std::is_same_v<T, DelayUntilStatement>) {
+            if (bRealExec && m_eSkipReason == SkipReason::NONE) {
+                m_runDelayUntil(command, data.iLineNumber);
+            }
+
+        /*-----------------------------------------------------------------
+            AWAIT <handle> [TIMEOUT n unit]
+         (ASYNC itself is dispatched with the plugin commands above)
+        -----------------------------------------------------------------*/
+
+        } else if constexpr (std::is_same_v<T, AwaitStatement>) {
+            if (bRealExec && m_eSkipReason == SkipReason::NONE) {
+                bRetVal = m_runAwait(command, data.iLineNumber);
+            }
+
+        /*-----------------------------------------------------------------
+            PARALLEL <label> ... END_PARALLEL <label>
+         Run the branches concurrently and resume after END_PARALLEL.
+         The dry run walks the branches in order like plain statements,
+         so BRANCH / END_PARALLEL are no-ops; they are also transparent
+         inside a skip region.
+        -----------------------------------------------------------------*/
+
+        } else if constexpr (std::is_same_v<T, ParallelBegin>) {
+            if (bRealExec && m_eSkipReason == SkipReason::NONE) {
+                bRetVal = m_runParallel(command, data.iLineNumber);
+                iIndex  = command.szEndIndex;   // caller's ++iIndex resumes after END_PARALLEL
             }
 
         /*-----------------------------------------------------------------
             name ?= <string value>
          Expand $macros in the value template and write the result into
-         m_RuntimeVarMacros.  This makes the value immediately visible to
+         its variable slot.  This makes the value immediately visible to
          all subsequent $macro lookups at tier 2 — exactly the same as a
          successful MacroCommand dispatch.
          During the dry-run pass the node is silently ignored (no expansion,
@@ -1257,38 +2932,7 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
 
         } else if constexpr (std::is_same_v<T, VarMacroInit>) {
             if (bRealExec && m_eSkipReason == SkipReason::NONE) {
-                std::string strExpanded = command.strValueTpl;
-                m_replaceVariableMacros(strExpanded);
-
-                // If the expanded value starts with "EVAL " delegate to the
-                // unified condition evaluator and store "TRUE" or "FALSE".
-                std::string strEvalCheck = strExpanded;
-                ustring::stripPrefix(strEvalCheck, kEvalPrefix);
-                if (strEvalCheck.size() < strExpanded.size())
-                {
-                    bool bEvalResult = false;
-                    if (m_evaluateCondition(strExpanded, bEvalResult)) {
-                        strExpanded = bEvalResult ? "TRUE" : "FALSE";
-                        LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                  LOG_STRING("EVAL result for VAR_INIT ["); 
-                                  LOG_STRING(command.strName);
-                                  LOG_STRING("] -> ["); 
-                                  LOG_STRING(strExpanded); LOG_STRING("]"));
-                    } else {
-                        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                  LOG_STRING("EVAL failed for VAR_INIT ["); 
-                                  LOG_STRING(command.strName);
-                                  LOG_STRING("]"));
-                        bRetVal = false;
-                        return;
-                    }
-                }
-
-                m_RuntimeVarMacros[command.strName] = strExpanded;
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                          LOG_STRING("VAR_INIT ["); LOG_STRING(command.strName);
-                          LOG_STRING("]->["); 
-                          LOG_STRING(strExpanded); LOG_STRING("]"));
+                bRetVal = m_runVarInit(command, data.iLineNumber);
             }
 
         /*-----------------------------------------------------------------
@@ -1300,7 +2944,7 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
               - '%' followed by a decimal digit → substitute items[digit]
               - '%' at end of template          → error (caught at validation)
               - any other char                  → copy verbatim
-         4. Store the assembled string in m_RuntimeVarMacros[name].
+         4. Store the assembled string in the variable slot of name.
         
          Out-of-range index (digit >= number of input tokens) is a runtime
          error: logged and the command fails so the script is aborted.
@@ -1308,98 +2952,21 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
 
         } else if constexpr (std::is_same_v<T, FormatStatement>) {
             if (bRealExec && m_eSkipReason == SkipReason::NONE) {
-
-                // macro expansion 
-                std::string strInput  = command.strInputTpl;
-                std::string strFormat = command.strFormatTpl;
-                m_replaceVariableMacros(strInput);
-                m_replaceVariableMacros(strFormat);
-
-                // tokenise input by whitespace
-                std::vector<std::string> vItems;
-                {
-                    std::istringstream iss(strInput);
-                    std::string token;
-                    while (iss >> token) {
-                        vItems.push_back(std::move(token));
-                    }
-                }
-                const size_t szNrItems = vItems.size();
-
-                if (szNrItems == 0) {
-                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                              LOG_STRING("FORMAT ["); LOG_STRING(command.strName);
-                              LOG_STRING("]: input expanded to empty — no items to substitute"));
-                    bRetVal = false;
-                    return;
-                }
-
-                // build output by walking the format template
-                std::string strResult;
-                strResult.reserve(strFormat.size());
-
-                for (size_t i = 0; i < strFormat.size(); ++i) {
-                    const char c = strFormat[i];
-                    if (c == '%') {
-                        // Validator guarantees a digit follows, but guard anyway.
-                        if (i + 1 >= strFormat.size()) {
-                            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                      LOG_STRING("FORMAT ["); 
-                                      LOG_STRING(command.strName);
-                                      LOG_STRING("]: '%' at end of expanded format template"));
-                            bRetVal = false;
-                            return;
-                        }
-                        const char cIdx = strFormat[++i];
-                        if (!std::isdigit(static_cast<unsigned char>(cIdx))) {
-                            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                      LOG_STRING("FORMAT ["); 
-                                      LOG_STRING(command.strName);
-                                      LOG_STRING("]: '%"); 
-                                      LOG_STRING(std::string(1, cIdx));
-                                      LOG_STRING("' — index character is not a digit"));
-                            bRetVal = false;
-                            return;
-                        }
-                        const size_t uiIndex = static_cast<size_t>(cIdx - '0');
-                        if (uiIndex >= szNrItems) {
-                            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                                      LOG_STRING("FORMAT ["); 
-                                      LOG_STRING(command.strName);
-                                      LOG_STRING("]: index %"); 
-                                      LOG_STRING(std::string(1, cIdx));
-                                      LOG_STRING("out of range (input has");
-                                      LOG_SIZET(szNrItems); 
-                                      LOG_STRING("items)"));
-                            bRetVal = false;
-                            return;
-                        }
-                        strResult += vItems[uiIndex];
-                    } else {
-                        strResult += c;
-                    }
-                }
-
-                // store result
-                m_RuntimeVarMacros[command.strName] = strResult;
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                          LOG_STRING("FORMAT ["); 
-                          LOG_STRING(command.strName);
-                          LOG_STRING("]->["); 
-                          LOG_STRING(strResult); 
-                          LOG_STRING("]"));
+                bRetVal = m_runFormat(command, data.iLineNumber);
             }
 
         /*-----------------------------------------------------------------
             name ?= MATH <expression>
         
          1. Expand $macros in the expression template.
-         2. Feed the expanded string to Calculator::evaluate().
+         2. Feed the expanded string to Calculator::evaluate(), or run the
+            program cached by m_compileMathStatements when every $macro
+            holds a plain numeric literal (same result, no re-parse).
          3. Convert the returned double to a clean string:
               - Integer-valued results print without a decimal point (5, not 5.0)
               - Floating-point results use up to 15 significant digits with
                 trailing zeros stripped (3.14159, not 3.141590000000000)
-         4. Store the string result in m_RuntimeVarMacros[name].
+         4. Store the string result in the variable slot of name.
         
          The Calculator variable map (m_mathVars) is persistent for the
          lifetime of this ScriptInterpreter instance, so intra-expression
@@ -1412,67 +2979,7 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
 
         } else if constexpr (std::is_same_v<T, MathStatement>) {
             if (bRealExec && m_eSkipReason == SkipReason::NONE) {
-
-                // macro expansion 
-                std::string strExpr = command.strExprTpl;
-                m_replaceVariableMacros(strExpr);
-
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                          LOG_STRING("MATH ["); 
-                          LOG_STRING(command.strName);
-                          LOG_STRING("] expr=["); 
-                          LOG_STRING(strExpr); 
-                          LOG_STRING("]"));
-
-                // evaluate 
-                double dResult = 0.0;
-                try {
-                    Calculator calc(strExpr, m_mathVars);
-                    dResult = calc.evaluate();
-                } catch (const std::exception& ex) {
-                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                              LOG_STRING("MATH ["); 
-                              LOG_STRING(command.strName);
-                              LOG_STRING("]: evaluation failed:"); 
-                              LOG_STRING(ex.what());
-                              LOG_STRING("expr=["); 
-                              LOG_STRING(strExpr); 
-                              LOG_STRING("]"));
-                    bRetVal = false;
-                    return;
-                }
-
-                // double -> string 
-                // Use defaultfloat + 15 significant digits so integer results
-                // print cleanly (5, not 5.000000) and precision is preserved.
-                std::string strResult;
-                {
-                    std::ostringstream oss;
-                    oss << std::defaultfloat << std::setprecision(15) << dResult;
-                    strResult = oss.str();
-                }
-
-                // | HEX post-processor: convert the integer result to a minimal
-                // big-endian hex string using hexutils::intToHexString.
-                // e.g.  2 → "02",  255 → "FF",  256 → "0100"
-                if (command.bHexOutput) {
-                    const uint64_t uVal = static_cast<uint64_t>(static_cast<int64_t>(dResult));
-                    strResult = hexutils::intToHexString(uVal);
-                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data());
-                              LOG_STRING("MATH HEX [");
-                              LOG_STRING(command.strName);
-                              LOG_STRING("] -> [");
-                              LOG_STRING(strResult); LOG_STRING("]"));
-                }
-
-                // store result
-                m_RuntimeVarMacros[command.strName] = strResult;
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                          LOG_STRING("MATH ["); 
-                          LOG_STRING(command.strName);
-                          LOG_STRING("]->["); 
-                          LOG_STRING(strResult); 
-                          LOG_STRING("]"));
+                bRetVal = m_runMath(command, data.iLineNumber);
             }
 
         /*-----------------------------------------------------------------
@@ -1494,28 +3001,7 @@ bool ScriptInterpreter::m_executeCommand (ScriptLine& data, bool bRealExec, size
 
         } else if constexpr (std::is_same_v<T, BreakpointStatement>) {
             if (bRealExec && m_eSkipReason == SkipReason::NONE) {
-
-                // Expand $macros in the label so the user sees current values
-                std::string strLabel = command.strLabelTpl;
-                m_replaceVariableMacros(strLabel);
-
-                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); 
-                          LOG_STRING("BREAKPOINT hit:");
-                          LOG_STRING(strLabel.empty() ? "<no label>" : strLabel));
-
-                CheckContinue checkContinue;
-                const bool bOk = checkContinue(strLabel);
-
-                if (!bOk) {
-                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data()); 
-                              LOG_STRING("BREAKPOINT: script aborted by user"));
-                    bRetVal = false;
-                }
-                // Note: the skip path (Space key) is handled inside CheckContinue
-                // by setting *pbSkip. BREAKPOINT does not propagate the skip to
-                // surrounding script flow — it only skips THIS breakpoint, not
-                // the next command. nullptr is passed for pbSkip intentionally:
-                // the Space key simply acts as "continue" for BREAKPOINT.
+                bRetVal = m_runBreakpoint(command, data.iLineNumber);
             }
         }
     }, data.command);
@@ -1561,17 +3047,16 @@ bool ScriptInterpreter::m_executeCommands (bool bRealExec) noexcept
 {
     bool bRetVal = true;
 
-    // Reset transient execution state before each pass.
-    m_strSkipUntilLabel.clear();
-    m_eSkipReason = SkipReason::NONE;
-    m_loopStateStack.clear();
-    m_RuntimeVarMacros.clear();
+    m_resetExecutionState();
 
     auto& vCommands = m_sScriptEntries->vCommands;
     size_t i = 0;
 
     while (i < vCommands.size()) {
-        if (false == m_executeCommand(vCommands[i], bRealExec, i)) {
+        m_lineBegin(i);
+        const bool bOk = m_executeCommand(vCommands[i], bRealExec, i);
+        m_lineEnd();
+        if (false == bOk) {
             bRetVal = false;
             break;
         }
@@ -1588,6 +3073,201 @@ bool ScriptInterpreter::m_executeCommands (bool bRealExec) noexcept
 } /* m_executeCommands() */
 
 
+/*-------------------------------------------------------------------------------
+  Reset the transient execution state before each pass.
+-------------------------------------------------------------------------------*/
+
+void ScriptInterpreter::m_resetExecutionState() noexcept
+{
+    m_strSkipUntilLabel.clear();
+    m_eSkipReason = SkipReason::NONE;
+    m_loopStateStack.clear();
+    for (auto& slot : m_vVarSlots) {
+        slot.strValue.clear();
+        slot.bDefined   = false;
+        slot.strLoopValue.clear();
+        slot.uLoopDepth = 0U;
+    }
+
+} /* m_resetExecutionState() */
+
+
+/*-------------------------------------------------------------------------------
+  Real execution through the compiled program (see uScriptBytecode.hpp).
+
+  Same conventions as m_executeCommands: pc is incremented after every
+  instruction, loop ends set pc to the LOOP_* instruction to loop back.
+  Jumps resume directly at their target.  All jumps are resolved, so the
+  skip machinery of the IR interpreter is never engaged here.
+-------------------------------------------------------------------------------*/
+
+bool ScriptInterpreter::m_executeBytecode() noexcept
+{
+    bool bRetVal = true;
+
+    m_resetExecutionState();
+
+    const auto& vCode = m_sBytecode.vCode;
+    size_t pc = 0;
+
+    while (bRetVal && (pc < vCode.size())) {
+        const Instruction& sInstr = vCode[pc];
+
+        // the instructions jumping away skip the end of the body: close the
+        // previous line here
+        m_lineEnd();
+        m_lineBegin(sInstr.uNode);
+
+        switch (sInstr.eOp) {
+
+            case OpCode::CALL:
+            case OpCode::CALL_STORE: {
+                bRetVal = (sInstr.eOp == OpCode::CALL)
+                            ? m_runPluginCommand(sInstr.node<Command>(), sInstr.node<Command>().sBinding.pPlugin, sInstr.iLineNr)
+                            : m_runPluginCommand(sInstr.node<MacroCommand>(), sInstr.node<MacroCommand>().sBinding.pPlugin, sInstr.iLineNr);
+                LOG_PRINT((bRetVal ? LOG_INFO : LOG_ERROR), LOG_HDR; LOG_STRING(ustring::fmtLineNr(sInstr.iLineNr).data());
+                        LOG_STRING("Command execution");
+                        LOG_STRING(bRetVal ? "ok" : "failed"));
+                break;
+            }
+
+            case OpCode::CALL_ASYNC: {
+                const AsyncCommand& sAsync = sInstr.node<AsyncCommand>();
+                bRetVal = m_runAsync(sAsync, sAsync.sBinding.pPlugin, sInstr.iLineNr);
+                LOG_PRINT((bRetVal ? LOG_INFO : LOG_ERROR), LOG_HDR; LOG_STRING(ustring::fmtLineNr(sInstr.iLineNr).data());
+                        LOG_STRING("Command execution");
+                        LOG_STRING(bRetVal ? "ok" : "failed"));
+                break;
+            }
+
+            case OpCode::AWAIT:
+                bRetVal = m_runAwait(sInstr.node<AwaitStatement>(), sInstr.iLineNr);
+                break;
+
+            case OpCode::JUMP_IF: {
+                const Condition& sCond = sInstr.node<Condition>();
+                bool bJump = false;
+                bRetVal = m_evalJumpCondition(sCond, sInstr.iLineNr, bJump);
+                if (bRetVal && bJump) {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(sInstr.iLineNr).data());
+                        LOG_STRING("Jump to label:");
+                        LOG_STRING(sCond.strLabelName));
+                    pc = sInstr.uTarget;
+                    continue;
+                }
+                break;
+            }
+
+            case OpCode::LOOP_TIMES:
+                bRetVal = m_enterRepeatTimes(sInstr.node<RepeatTimes>(), pc, sInstr.iLineNr, sInstr.uLabel);
+                break;
+
+            case OpCode::LOOP_UNTIL:
+                m_enterRepeatUntil(sInstr.node<RepeatUntil>(), pc, sInstr.iLineNr, sInstr.uLabel);
+                break;
+
+            case OpCode::LOOP_END: {
+                if (m_loopStateStack.empty() || m_loopStateStack.back().uLabelId != sInstr.uLabel) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(ustring::fmtLineNr(sInstr.iLineNr).data()); 
+                              LOG_STRING("END_REPEAT: unexpected label or empty stack:"); 
+                              LOG_STRING(sInstr.node<RepeatEnd>().strLabel));
+                    bRetVal = false;
+                    break;
+                }
+                m_runEndRepeat(pc, bRetVal);
+                break;
+            }
+
+            case OpCode::BREAK: {
+                const LoopBreak& sBreak = sInstr.node<LoopBreak>();
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(sInstr.iLineNr).data()); 
+                          LOG_STRING("BREAK:"); 
+                          LOG_STRING(sBreak.strLabel));
+                bRetVal = m_unwindLoops(sInstr.uArg, sBreak.strLabel, sInstr.uLabel);
+                if (bRetVal) {
+                    m_popLoopState();
+                    pc = sInstr.uTarget;
+                    continue;
+                }
+                break;
+            }
+
+            case OpCode::CONTINUE: {
+                const LoopContinue& sContinue = sInstr.node<LoopContinue>();
+                LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(ustring::fmtLineNr(sInstr.iLineNr).data()); 
+                          LOG_STRING("CONTINUE:"); 
+                          LOG_STRING(sContinue.strLabel));
+                bRetVal = m_unwindLoops(sInstr.uArg, sContinue.strLabel, sInstr.uLabel);
+                if (bRetVal) {
+                    pc = sInstr.uTarget;
+                    m_runEndRepeat(pc, bRetVal);
+                }
+                break;
+            }
+
+            case OpCode::PRINT: {
+                const PrintStatement& sPrint = sInstr.node<PrintStatement>();
+                std::string strExpanded;
+                m_expandMacros(sPrint.sTextTpl, sPrint.strText, strExpanded);
+                LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING(ustring::fmtLineNr(sInstr.iLineNr).data());
+                          LOG_STRING(strExpanded));
+                break;
+            }
+
+            case OpCode::VAR_INIT:
+                bRetVal = m_runVarInit(sInstr.node<VarMacroInit>(), sInstr.iLineNr);
+                break;
+
+            case OpCode::FORMAT:
+                bRetVal = m_runFormat(sInstr.node<FormatStatement>(), sInstr.iLineNr);
+                break;
+
+            case OpCode::MATH:
+                bRetVal = m_runMath(sInstr.node<MathStatement>(), sInstr.iLineNr);
+                break;
+
+            case OpCode::BREAKPOINT:
+                bRetVal = m_runBreakpoint(sInstr.node<BreakpointStatement>(), sInstr.iLineNr);
+                break;
+
+            case OpCode::DELAY:
+                m_runDelay(sInstr.node<DelayStatement>(), sInstr.iLineNr);
+                break;
+
+            case OpCode::PERIOD:
+                m_runPeriod(sInstr.node<PeriodStatement>(), sInstr.iLineNr, sInstr.uLabel);
+                break;
+
+            case OpCode::DELAY_UNTIL:
+                m_runDelayUntil(sInstr.node<DelayUntilStatement>(), sInstr.iLineNr);
+                break;
+
+            case OpCode::PARALLEL:
+                bRetVal = m_runParallel(sInstr.node<ParallelBegin>(), sInstr.iLineNr);
+                if (bRetVal) {
+                    pc = sInstr.uTarget;
+                    continue;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        ++pc;
+    }
+    m_lineEnd();
+
+    LOG_PRINT((bRetVal ? LOG_DEBUG : LOG_ERROR), LOG_HDR; 
+        LOG_STRING("Commands");
+        LOG_STRING("execution"); 
+        LOG_STRING(bRetVal ? "ok" : "failed"));
+
+    return bRetVal;
+
+} /* m_executeBytecode() */
+
+
 int ScriptInterpreter::m_resolveRepeatCount(const RepeatTimes& rep)
 {
     if (rep.strCountExpr.empty()) {
@@ -1596,8 +3276,8 @@ int ScriptInterpreter::m_resolveRepeatCount(const RepeatTimes& rep)
     }
 
     // expand $macroname → string → integer
-    std::string strExpanded = rep.strCountExpr;
-    m_replaceVariableMacros(strExpanded);   // your existing macro expansion call
+    std::string strExpanded;
+    m_expandMacros(rep.sCountTpl, rep.strCountExpr, strExpanded);
 
     int iCount = 0;
     if (!numeric::str2int(strExpanded, iCount) || iCount < 1) {
@@ -0,0 +1,312 @@
+#include "uScriptProfiler.hpp"
+#include "uLogger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            LOCAL DEFINITIONS                                //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifdef LT_HDR
+    #undef LT_HDR
+#endif
+#ifdef LOG_HDR
+    #undef LOG_HDR
+#endif
+
+#define LT_HDR     "CORE_SCR_P  |"
+#define LOG_HDR    LOG_STRING(LT_HDR)
+
+namespace {
+
+constexpr size_t kLogTopLines = 10U;
+
+constexpr const char *kPhaseNames[] = { "dispatch", "macro", "condition", "delay" };
+static_assert(std::size(kPhaseNames) == static_cast<size_t>(uprofile::Phase::COUNT));
+
+double toUs(uint64_t uNs) { return static_cast<double>(uNs) / 1000.0; }
+double toMs(uint64_t uNs) { return static_cast<double>(uNs) / 1000000.0; }
+
+std::string jsonEscape(const std::string& strIn)
+{
+    std::string strOut;
+    strOut.reserve(strIn.size());
+    for (const char c : strIn) {
+        switch (c) {
+            case '"':  strOut += "\\\""; break;
+            case '\\': strOut += "\\\\"; break;
+            case '\t': strOut += "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20U) {
+                    char szBuf[8];
+                    std::snprintf(szBuf, sizeof(szBuf), "\\u%04x", static_cast<unsigned>(c));
+                    strOut += szBuf;
+                } else {
+                    strOut += c;
+                }
+        }
+    }
+    return strOut;
+}
+
+std::string csvEscape(const std::string& strIn)
+{
+    std::string strOut = "\"";
+    for (const char c : strIn) {
+        strOut += c;
+        if (c == '"') {
+            strOut += '"';
+        }
+    }
+    return strOut + "\"";
+}
+
+} // anonymous namespace
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            PUBLIC INTERFACE                                 //
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace uprofile {
+
+/*-------------------------------------------------------------------------------
+  Bucket of a value: values below 2^kSubBits are exact; above, the exponent
+  selects a group of 2^kSubBits buckets and the bits below the leading one
+  the bucket inside the group.
+-------------------------------------------------------------------------------*/
+
+size_t Histogram::indexOf(uint64_t uNs) noexcept
+{
+    constexpr uint64_t uSubCount = 1ULL << kSubBits;
+
+    if (uNs < uSubCount) {
+        return static_cast<size_t>(uNs);
+    }
+
+    const uint32_t uExp = std::min<uint32_t>(63U - static_cast<uint32_t>(__builtin_clzll(uNs)), kMaxExp);
+    const uint64_t uSub = (uExp == kMaxExp && (uNs >> kMaxExp) > 1U)
+                            ? (uSubCount - 1U)
+                            : ((uNs >> (uExp - kSubBits)) & (uSubCount - 1U));
+
+    return static_cast<size_t>(((uExp - kSubBits + 1U) << kSubBits) + uSub);
+
+} /* indexOf() */
+
+
+
+void Histogram::merge(const Histogram& other) noexcept
+{
+    for (size_t i = 0; i < kBuckets; ++i) {
+        m_aBuckets[i] += other.m_aBuckets[i];
+    }
+
+} /* merge() */
+
+
+
+uint64_t Histogram::percentile(double dPercent, uint64_t uCount) const noexcept
+{
+    constexpr uint64_t uSubCount = 1ULL << kSubBits;
+
+    if (0U == uCount) {
+        return 0U;
+    }
+
+    const uint64_t uRank = std::max<uint64_t>(1U, static_cast<uint64_t>(dPercent / 100.0 * static_cast<double>(uCount) + 0.999999));
+    uint64_t uSeen = 0U;
+
+    for (size_t i = 0; i < kBuckets; ++i) {
+        uSeen += m_aBuckets[i];
+        if (uSeen >= uRank) {
+            if (i < uSubCount) {
+                return i;
+            }
+            const uint64_t uShift = (i >> kSubBits) - 1U;
+            const uint64_t uLow   = (uSubCount + (i & (uSubCount - 1U))) << uShift;
+            return uLow + ((1ULL << uShift) >> 1U);
+        }
+    }
+
+    return 0U;
+
+} /* percentile() */
+
+
+/*-------------------------------------------------------------------------------
+  Profiler
+-------------------------------------------------------------------------------*/
+
+void Profiler::reset(size_t szFirst, size_t szEnd)
+{
+    m_szFirst  = szFirst;
+    m_szLine   = SIZE_MAX;
+    m_bInPhase = false;
+    m_vStats.assign((szEnd > szFirst) ? (szEnd - szFirst) : 0U, LineStats{});
+    m_bEnabled = true;
+
+} /* reset() */
+
+
+
+void Profiler::endLine() noexcept
+{
+    if (!m_bEnabled || (m_szLine - m_szFirst) >= m_vStats.size()) {
+        return;
+    }
+
+    const uint64_t uNs = static_cast<uint64_t>(std::max<int64_t>(0, utime::monotonic_ns() - m_iLineNs));
+    LineStats& sLine = m_vStats[m_szLine - m_szFirst];
+
+    ++sLine.uCount;
+    sLine.uTotalNs += uNs;
+    sLine.uMinNs    = std::min(sLine.uMinNs, uNs);
+    sLine.uMaxNs    = std::max(sLine.uMaxNs, uNs);
+    sLine.sHistogram.add(uNs);
+    m_szLine = SIZE_MAX;
+
+} /* endLine() */
+
+
+
+void Profiler::addPhase(Phase ePhase, int64_t iNs) noexcept
+{
+    if ((m_szLine - m_szFirst) < m_vStats.size()) {
+        m_vStats[m_szLine - m_szFirst].aPhaseNs[static_cast<size_t>(ePhase)] += static_cast<uint64_t>(std::max<int64_t>(0, iNs));
+    }
+
+} /* addPhase() */
+
+
+/*-------------------------------------------------------------------------------
+  Lines of other outside of the range of this profiler are dropped; a
+  branch profiler covers a range of its parent.
+-------------------------------------------------------------------------------*/
+
+void Profiler::merge(const Profiler& other) noexcept
+{
+    for (size_t i = 0; i < other.m_vStats.size(); ++i) {
+        const LineStats& sFrom = other.m_vStats[i];
+        const size_t szLine = other.m_szFirst + i - m_szFirst;
+        if ((0U == sFrom.uCount) || (szLine >= m_vStats.size())) {
+            continue;
+        }
+        LineStats& sTo = m_vStats[szLine];
+        sTo.uCount   += sFrom.uCount;
+        sTo.uTotalNs += sFrom.uTotalNs;
+        sTo.uMinNs    = std::min(sTo.uMinNs, sFrom.uMinNs);
+        sTo.uMaxNs    = std::max(sTo.uMaxNs, sFrom.uMaxNs);
+        for (size_t p = 0; p < sTo.aPhaseNs.size(); ++p) {
+            sTo.aPhaseNs[p] += sFrom.aPhaseNs[p];
+        }
+        sTo.sHistogram.merge(sFrom.sHistogram);
+    }
+
+} /* merge() */
+
+
+
+const LineStats* Profiler::m_statsOf(size_t szLine) const noexcept
+{
+    return ((szLine - m_szFirst) < m_vStats.size()) ? &m_vStats[szLine - m_szFirst] : nullptr;
+
+} /* m_statsOf() */
+
+
+/*-------------------------------------------------------------------------------
+  The three files hold the same executed lines; the text table and the log
+  are sorted by total time, JSON and CSV keep the script order.  The share
+  of a line is relative to uRunNs, the wall time of the run (a PARALLEL line
+  includes its branches, so the shares may add up to more than 100 %).
+-------------------------------------------------------------------------------*/
+
+bool Profiler::writeReport(const std::string& strBase, const std::vector<LineInfo>& vInfo, uint64_t uRunNs) const
+{
+    std::vector<size_t> vOrder;
+
+    for (size_t i = 0; i < m_vStats.size(); ++i) {
+        if (m_vStats[i].uCount > 0U) {
+            vOrder.push_back(m_szFirst + i);
+        }
+    }
+
+    auto infoOf = [&vInfo](size_t szLine) -> LineInfo {
+        return (szLine < vInfo.size()) ? vInfo[szLine] : LineInfo{};
+    };
+
+    // count, total, min, avg, p50, p90, p99, max, then the phases
+    auto valuesOf = [this](size_t szLine) {
+        const LineStats& s = *m_statsOf(szLine);
+        auto pct = [&s](double dPercent) {
+            return toUs(std::clamp(s.sHistogram.percentile(dPercent, s.uCount), s.uMinNs, s.uMaxNs));
+        };
+        return std::array<double, 12>{ static_cast<double>(s.uCount), toMs(s.uTotalNs),
+                                       toUs(s.uMinNs), toUs(s.uTotalNs / s.uCount),
+                                       pct(50.0), pct(90.0), pct(99.0), toUs(s.uMaxNs),
+                                       toMs(s.aPhaseNs[0]), toMs(s.aPhaseNs[1]),
+                                       toMs(s.aPhaseNs[2]), toMs(s.aPhaseNs[3]) };
+    };
+
+    // JSON / CSV: script order
+    std::ofstream ofJson(strBase + ".json");
+    std::ofstream ofCsv(strBase + ".csv");
+    ofCsv << "line,text,count,total_ms,min_us,avg_us,p50_us,p90_us,p99_us,max_us,"
+             "dispatch_ms,macro_ms,condition_ms,delay_ms\n";
+    ofJson << "{\n  \"total_ms\": " << toMs(uRunNs) << ",\n  \"lines\": [";
+
+    char szRow[512];
+    for (size_t k = 0; k < vOrder.size(); ++k) {
+        const LineInfo sInfo = infoOf(vOrder[k]);
+        const auto v = valuesOf(vOrder[k]);
+
+        std::snprintf(szRow, sizeof(szRow), "%.0f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f",
+                      v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[9], v[10], v[11]);
+        ofCsv << sInfo.iLineNumber << "," << csvEscape(sInfo.strText) << "," << szRow << "\n";
+
+        std::snprintf(szRow, sizeof(szRow),
+                      "\"count\": %.0f, \"total_ms\": %.3f, \"min_us\": %.3f, \"avg_us\": %.3f, "
+                      "\"p50_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f, "
+                      "\"dispatch_ms\": %.3f, \"macro_ms\": %.3f, \"condition_ms\": %.3f, \"delay_ms\": %.3f",
+                      v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[9], v[10], v[11]);
+        ofJson << ((k > 0U) ? ",\n" : "\n") << "    { \"line\": " << sInfo.iLineNumber
+               << ", \"text\": \"" << jsonEscape(sInfo.strText) << "\", " << szRow << " }";
+    }
+    ofJson << "\n  ]\n}\n";
+
+    // text table and log: slowest first
+    std::stable_sort(vOrder.begin(), vOrder.end(), [this](size_t a, size_t b) {
+        return m_statsOf(a)->uTotalNs > m_statsOf(b)->uTotalNs;
+    });
+
+    std::ofstream ofText(strBase + ".txt");
+    std::snprintf(szRow, sizeof(szRow), "%-6s %8s %11s %6s %10s %10s %10s %10s %10s %10s %11s %11s %11s %11s  ",
+                  "line", "count", "total_ms", "%", "min_us", "avg_us", "p50_us", "p90_us", "p99_us", "max_us",
+                  kPhaseNames[0], kPhaseNames[1], kPhaseNames[2], kPhaseNames[3]);
+    ofText << szRow << "text\n";
+
+    for (size_t k = 0; k < vOrder.size(); ++k) {
+        const LineInfo sInfo = infoOf(vOrder[k]);
+        const auto v = valuesOf(vOrder[k]);
+        const double dShare = (uRunNs > 0U) ? (100.0 * static_cast<double>(m_statsOf(vOrder[k])->uTotalNs) / static_cast<double>(uRunNs)) : 0.0;
+
+        std::snprintf(szRow, sizeof(szRow), "%-6d %8.0f %11.3f %6.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %11.3f %11.3f %11.3f %11.3f  ",
+                      sInfo.iLineNumber, v[0], v[1], dShare, v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[9], v[10], v[11]);
+        ofText << szRow << sInfo.strText << "\n";
+
+        if (k < kLogTopLines) {
+            LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING(szRow); LOG_STRING(sInfo.strText));
+        }
+    }
+
+    const bool bRetVal = ofText.good() && ofJson.good() && ofCsv.good();
+    LOG_PRINT((bRetVal ? LOG_INFO : LOG_ERROR), LOG_HDR;
+              LOG_STRING("Profile report"); LOG_STRING(bRetVal ? "written:" : "failed:");
+              LOG_STRING(strBase + ".{txt,json,csv}"); LOG_STRING("lines:"); LOG_SIZET(vOrder.size()));
+
+    return bRetVal;
+
+} /* writeReport() */
+
+} // namespace uprofile
@@ -0,0 +1,97 @@
+/**
+ * @file    Test_AsyncAwait.cpp
+ * @brief   ASYNC / AWAIT (uScriptInterpreter.cpp): a queued command overlaps the next
+ *          lines and its handle is only set by AWAIT, a plain command of the same
+ *          plugin waits for the queued one, and AWAIT fails on a TIMEOUT or a failed
+ *          command while the script end still waits for what is running
+ */
+
+#include "uScriptTestRun.hpp"
+#include "uTestCheck.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// written by the recording plugins into the working directory
+static const char kTraceFile[] = "plugin_trace.txt";
+
+static const char kOverlapScript[] =
+    "LOAD_PLUGIN PROBEA\n"
+    "LOAD_PLUGIN PROBEB\n"
+    "h ?= before\n"
+    "h ?= ASYNC PROBEA.SLEEP 300\n"
+    "PRINT > pending=$h\n"
+    "x ?= PROBEB.SLEEP 300\n"
+    "AWAIT h TIMEOUT 5 sec\n"
+    "PRINT > h=$h x=$x\n";
+
+static const char kOrderScript[] =
+    "LOAD_PLUGIN PROBEA\n"
+    "h ?= ASYNC PROBEA.SLEEP 200\n"
+    "PROBEA.ECHO after\n"
+    "AWAIT h\n";
+
+static const char kTimeoutScript[] =
+    "LOAD_PLUGIN PROBEA\n"
+    "h ?= ASYNC PROBEA.SLEEP 400\n"
+    "AWAIT h TIMEOUT 50 ms\n"
+    "PRINT > not reached\n";
+
+static const char kFailScript[] =
+    "LOAD_PLUGIN PROBEA\n"
+    "h ?= ASYNC PROBEA.FAIL now\n"
+    "AWAIT h\n"
+    "PRINT > not reached\n";
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_async_await";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string strOverlap = (dir / "overlap.txt").string();
+    const std::string strOrder   = (dir / "order.txt").string();
+    const std::string strTimeout = (dir / "timeout.txt").string();
+    const std::string strFail    = (dir / "fail.txt").string();
+    UTEST_CHECK(utest::writeText(strOverlap, kOverlapScript));
+    UTEST_CHECK(utest::writeText(strOrder, kOrderScript));
+    UTEST_CHECK(utest::writeText(strTimeout, kTimeoutScript));
+    UTEST_CHECK(utest::writeText(strFail, kFailScript));
+
+    for (bool bBytecode : {false, true}) {
+        // both sleeps overlap: well under the 600 ms they take one after the other
+        const auto tStart = std::chrono::steady_clock::now();
+        utest::ScriptRun run = utest::runScript(strOverlap, bBytecode);
+        const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+        UTEST_CHECK(run.bValidated && run.bExecuted);
+        UTEST_CHECK(tElapsed < std::chrono::milliseconds(550));
+        UTEST_CHECK(utest::printed(run, "> ") == std::vector<std::string>({ "pending=before", "h=300 x=300" }));
+
+        // the plain command is issued only once the queued one is done
+        fs::remove(kTraceFile);
+        run = utest::runScript(strOrder, bBytecode);
+        UTEST_CHECK(run.bValidated && run.bExecuted);
+        UTEST_CHECK(utest::readLines(kTraceFile) == std::vector<std::string>({ "PROBEA.SLEEP 200", "PROBEA.ECHO after" }));
+
+        // the timed out command is not cancelled: the run ends after it
+        fs::remove(kTraceFile);
+        run = utest::runScript(strTimeout, bBytecode);
+        UTEST_CHECK(run.bValidated && !run.bExecuted);
+        UTEST_CHECK(utest::printed(run, "> ").empty());
+        UTEST_CHECK(utest::readLines(kTraceFile) == std::vector<std::string>({ "PROBEA.SLEEP 400" }));
+
+        run = utest::runScript(strFail, bBytecode);
+        UTEST_CHECK(run.bValidated && !run.bExecuted);
+        UTEST_CHECK(utest::printed(run, "> ").empty());
+    }
+
+    fs::remove(kTraceFile);
+    fs::remove_all(dir);
+
+    return utest::result("async_await");
+}
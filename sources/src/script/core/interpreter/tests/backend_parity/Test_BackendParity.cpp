@@ -0,0 +1,80 @@
+/**
+ * @file    Test_BackendParity.cpp
+ * @brief   Bytecode backend (uScriptBytecode.cpp) against the IR interpreter: every
+ *          script shipped in scripts/ runs with BYTECODE_EXEC = FALSE and TRUE, and
+ *          both runs must agree on the result, the interpreter log and the plugin
+ *          commands they issued
+ */
+
+#include "uScriptTestRun.hpp"
+#include "uTestCheck.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// written by the recording plugins into the working directory
+static const char kTraceFile[] = "plugin_trace.txt";
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_backend_parity";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    size_t szScripts = 0;
+    size_t szExecuted = 0;
+
+    for (const auto& entry : fs::recursive_directory_iterator(TEST_SCRIPTS_DIR)) {
+        const std::string strExt = entry.path().extension().string();
+        if (!entry.is_regular_file() || (strExt != ".txt" && strExt != ".usi")) {
+            continue;
+        }
+
+        // the runs write their .ini and .log next to the script: work on a copy
+        const std::string strScript = (dir / ("script_" + std::to_string(szScripts++) + strExt)).string();
+        fs::copy_file(entry.path(), strScript, fs::copy_options::overwrite_existing);
+
+        utest::ScriptRun vRuns[2];
+        std::vector<std::string> vTraces[2];
+
+        for (bool bBytecode : {false, true}) {
+            fs::remove(kTraceFile);
+            vRuns[bBytecode] = utest::runScript(strScript, bBytecode);
+            vTraces[bBytecode] = utest::readLines(kTraceFile);
+
+            // the timing reports carry measured lateness, not behaviour
+            auto& vLines = vRuns[bBytecode].vLines;
+            vLines.erase(std::remove_if(vLines.begin(), vLines.end(),
+                                        [](const std::string& strLine) { return strLine.rfind("Timing ", 0) == 0; }),
+                         vLines.end());
+        }
+
+        const bool bSame = (vRuns[0].bValidated == vRuns[1].bValidated) &&
+                           (vRuns[0].bExecuted  == vRuns[1].bExecuted) &&
+                           (vRuns[0].vLines     == vRuns[1].vLines) &&
+                           (vTraces[0]          == vTraces[1]);
+        if (!bSame) {
+            std::cerr << "backends differ on " << entry.path().string() << std::endl;
+        }
+        UTEST_CHECK(bSame);
+
+        if (vRuns[0].bExecuted && !vTraces[0].empty()) {
+            ++szExecuted;
+        }
+    }
+
+    fs::remove(kTraceFile);
+    fs::remove_all(dir);
+
+    // the comparison means nothing if no script reached its plugin commands
+    UTEST_CHECK(szExecuted > 0);
+
+    return utest::result("backend_parity");
+}
@@ -0,0 +1,69 @@
+/**
+ * @file    Test_EvalCompiled.cpp
+ * @brief   Compiled EVAL conditions (uExprEvaluator.hpp, uScriptInterpreter.cpp): the
+ *          operand types are inferred from the values filled into the holes, a
+ *          REPEAT UNTIL condition sees every new value, and a macro whose value
+ *          carries whitespace falls back to the textual evaluation
+ */
+
+#include "uScriptTestRun.hpp"
+#include "uTestCheck.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char kScript[] =
+    "c ?= MATH c = 0\n"
+    "REPEAT poll UNTIL EVAL $c == 5 :NUM\n"
+    "    c ?= MATH c = c + 1\n"
+    "END_REPEAT poll\n"
+    "PRINT > polled=$c\n"
+    "v ?= 1.2.3\n"
+    "n ?= 10\n"
+    "f ?= 3.14\n"
+    "flag ?= TRUE\n"
+    "pair ?= 1 == 1\n"
+    "ver ?= EVAL $v < 2.0.0\n"
+    "num ?= EVAL $n > 9\n"
+    "verf ?= EVAL $f > 3.2\n"
+    "numf ?= EVAL $f > 3.2 :NUM\n"
+    "split ?= EVAL $pair && x EQ x :STR\n"
+    "bool ?= EVAL $flag == TRUE\n"
+    "PRINT > ver=$ver num=$num verf=$verf numf=$numf split=$split bool=$bool\n"
+    "i ?= REPEAT pick 3\n"
+    "    IF EVAL $i >= 2 :NUM || $flag EQ FALSE :STR GOTO skip\n"
+    "    PRINT > picked $i\n"
+    "    LABEL skip\n"
+    "END_REPEAT pick\n";
+
+static const std::vector<std::string> kExpected {
+    "polled=5",
+    // 10 > 9 as numbers, 3.14 > 3.2 as versions unless :NUM says otherwise
+    "ver=TRUE num=TRUE verf=TRUE numf=FALSE split=TRUE bool=TRUE",
+    "picked 0",
+    "picked 1",
+};
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_eval_compiled";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string strScript = (dir / "eval.txt").string();
+    UTEST_CHECK(utest::writeText(strScript, kScript));
+
+    for (bool bBytecode : {false, true}) {
+        const utest::ScriptRun run = utest::runScript(strScript, bBytecode);
+        UTEST_CHECK(run.bValidated && run.bExecuted);
+        UTEST_CHECK(utest::printed(run, "> ") == kExpected);
+    }
+
+    fs::remove_all(dir);
+
+    return utest::result("eval_compiled");
+}
@@ -0,0 +1,105 @@
+#ifndef USCRIPT_TEST_RUN_HPP
+#define USCRIPT_TEST_RUN_HPP
+
+#include "uScriptClient.hpp"
+#include "IPluginDataTypes.hpp"
+#include "uIniCfgLoader.hpp"
+#include "uLogger.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                 CORE SCRIPT RUNS FOR THE INTERPRETER TESTS                  //
+/////////////////////////////////////////////////////////////////////////////////
+
+// A test writes its script into a scratch directory and runs it the way the
+// application does: validation and dry run, then the real run with the IR
+// interpreter or the bytecode backend.  The interpreter's log lines of the
+// real run are captured at LOG_INFO, which is where PRINT writes.
+
+namespace utest
+{
+
+struct ScriptRun {
+    bool bValidated = false;            // validation and dry run passed
+    bool bExecuted  = false;            // real run passed
+    std::vector<std::string> vLines;    // interpreter log lines of the real run, "NNNN: text"
+};
+
+inline bool writeText(const std::string& strPath, const std::string& strText)
+{
+    std::ofstream file(strPath, std::ios::binary | std::ios::trunc);
+    file << strText;
+    return file.good();
+}
+
+inline std::vector<std::string> readLines(const std::string& strPath)
+{
+    std::vector<std::string> vLines;
+    std::ifstream file(strPath);
+    for (std::string strLine; std::getline(file, strLine); ) {
+        vLines.push_back(strLine);
+    }
+    return vLines;
+}
+
+// strIniExtra is appended after the [SCRIPT] settings (more keys or sections)
+inline ScriptRun runScript(const std::string& strScript, bool bBytecode, const std::string& strIniExtra = std::string())
+{
+    static const std::string kHeader = "CORE_SCR_I  | ";
+
+    ScriptRun run;
+    const std::string strBase = strScript + (bBytecode ? ".bc" : ".ir");
+
+    IniCfgLoader iniLoader;
+    if (!writeText(strBase + ".ini", std::string("[SCRIPT]\nCMD_EXEC_DELAY = 0\nBYTECODE_EXEC = ") +
+                                     (bBytecode ? "TRUE\n" : "FALSE\n") + strIniExtra) ||
+        !iniLoader.load(strBase + ".ini")) {
+        return run;
+    }
+
+    ScriptClient client(strScript, std::move(iniLoader));
+    run.bValidated = client.execute(false);
+    if (!run.bValidated) {
+        return run;
+    }
+
+    std::filesystem::remove(strBase + ".log");
+    log_local->setFileThreshold(LOG_INFO);
+    log_local->enableFileLogging(strBase + ".log");
+    run.bExecuted = client.execute(true);
+    log_local->disableFileLogging();
+    log_local->setFileThreshold(LOG_FATAL);
+
+    std::ifstream log(strBase + ".log");
+    for (std::string strLine; std::getline(log, strLine); ) {
+        const size_t szPos = strLine.find(kHeader);
+        if (szPos != std::string::npos) {
+            // the logger separates (and ends) every appended item with a blank
+            const size_t szEnd = strLine.find_last_not_of(' ');
+            run.vLines.push_back(strLine.substr(szPos + kHeader.size(), szEnd + 1U - (szPos + kHeader.size())));
+        }
+    }
+
+    return run;
+}
+
+// the texts printed with the given tag, in order, line numbers and tag removed
+inline std::vector<std::string> printed(const ScriptRun& run, const std::string& strTag)
+{
+    std::vector<std::string> vTexts;
+    for (const auto& strLine : run.vLines) {
+        const size_t szPos = strLine.find(": " + strTag);
+        if (szPos != std::string::npos) {
+            vTexts.push_back(strLine.substr(szPos + 2U + strTag.size()));
+        }
+    }
+    return vTexts;
+}
+
+} // namespace utest
+
+#endif // USCRIPT_TEST_RUN_HPP
@@ -0,0 +1,82 @@
+/**
+ * @file    Test_LoopJumps.cpp
+ * @brief   Precomputed jump targets (uScriptInterpreter.cpp): GOTO and IF .. GOTO land on
+ *          their label, BREAK and CONTINUE out of nested loops pop the inner loops they
+ *          leave, and a loop started after an unwinding runs as a fresh one
+ */
+
+#include "uScriptTestRun.hpp"
+#include "uTestCheck.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char kScript[] =
+    "PRINT > start\n"
+    "GOTO first\n"
+    "PRINT > skipped by GOTO\n"
+    "LABEL first\n"
+    "i ?= REPEAT outer 4\n"
+    "    IF EVAL $i != 1 :NUM GOTO no_continue\n"
+    "    PRINT > continue $i\n"
+    "    CONTINUE outer\n"
+    "    LABEL no_continue\n"
+    "    j ?= REPEAT inner 5\n"
+    "        IF EVAL $j != 2 :NUM GOTO no_break\n"
+    "        IF EVAL $i != 2 :NUM GOTO break_inner\n"
+    "        PRINT > break outer $i/$j\n"
+    "        BREAK outer\n"
+    "        LABEL break_inner\n"
+    "        BREAK inner\n"
+    "        LABEL no_break\n"
+    "        PRINT > body $i/$j\n"
+    "    END_REPEAT inner\n"
+    "    PRINT > after inner $i\n"
+    "END_REPEAT outer\n"
+    "m ?= REPEAT rows 2\n"
+    "    n ?= REPEAT cols 3\n"
+    "        IF EVAL $n != 1 :NUM GOTO cell\n"
+    "        CONTINUE rows\n"
+    "        LABEL cell\n"
+    "        PRINT > cell $m/$n\n"
+    "    END_REPEAT cols\n"
+    "    PRINT > skipped by CONTINUE $m\n"
+    "END_REPEAT rows\n"
+    "k ?= REPEAT again 2\n"
+    "    PRINT > again $k\n"
+    "END_REPEAT again\n"
+    "PRINT > done\n";
+
+static const std::vector<std::string> kExpected {
+    "start",
+    "body 0/0", "body 0/1", "after inner 0",
+    "continue 1",
+    "body 2/0", "body 2/1", "break outer 2/2",
+    "cell 0/0", "cell 1/0",
+    "again 0", "again 1",
+    "done",
+};
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_loop_jumps";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string strScript = (dir / "jumps.txt").string();
+    UTEST_CHECK(utest::writeText(strScript, kScript));
+
+    for (bool bBytecode : {false, true}) {
+        const utest::ScriptRun run = utest::runScript(strScript, bBytecode);
+        UTEST_CHECK(run.bValidated && run.bExecuted);
+        UTEST_CHECK(utest::printed(run, "> ") == kExpected);
+    }
+
+    fs::remove_all(dir);
+
+    return utest::result("loop_jumps");
+}
@@ -0,0 +1,64 @@
+/**
+ * @file    Test_MathCompiled.cpp
+ * @brief   Cached MATH programs (uCalculator.hpp, uScriptInterpreter.cpp): holes are
+ *          refilled on every run, calculator variables persist across lines, and
+ *          macros that are not plain numbers or would fuse with their neighbours
+ *          give the same result as the textual evaluation
+ */
+
+#include "uScriptTestRun.hpp"
+#include "uTestCheck.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char kScript[] =
+    "acc ?= MATH acc = 0\n"
+    "i ?= REPEAT squares 4\n"
+    "    sq ?= MATH $i * $i\n"
+    "    acc ?= MATH acc = acc + $i * 2\n"
+    "    PRINT > sq=$sq acc=$acc\n"
+    "END_REPEAT squares\n"
+    "h ?= 0x1F\n"
+    "hex ?= MATH $h + 1\n"
+    "neg ?= -3\n"
+    "minus ?= MATH 10 $neg\n"
+    "d ?= 7\n"
+    "fused ?= MATH 0x$d$d + 1\n"
+    "sum ?= 2 + 3\n"
+    "text ?= MATH $sum * 2\n"
+    "circle ?= MATH 2pi\n"
+    "PRINT > hex=$hex minus=$minus fused=$fused text=$text circle=$circle\n";
+
+static const std::vector<std::string> kExpected {
+    "sq=0 acc=0",
+    "sq=1 acc=2",
+    "sq=4 acc=6",
+    "sq=9 acc=12",
+    // 0x77 + 1; "2 + 3 * 2" as written out
+    "hex=32 minus=7 fused=120 text=8 circle=6.28318530717959",
+};
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_math_compiled";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string strScript = (dir / "math.txt").string();
+    UTEST_CHECK(utest::writeText(strScript, kScript));
+
+    for (bool bBytecode : {false, true}) {
+        const utest::ScriptRun run = utest::runScript(strScript, bBytecode);
+        UTEST_CHECK(run.bValidated && run.bExecuted);
+        UTEST_CHECK(utest::printed(run, "> ") == kExpected);
+    }
+
+    fs::remove_all(dir);
+
+    return utest::result("math_compiled");
+}
@@ -0,0 +1,115 @@
+/**
+ * @file    Test_ParallelBlocks.cpp
+ * @brief   PARALLEL blocks (uScriptInterpreter.cpp, uScriptValidator.cpp): branches run
+ *          at the same time on private copies of the variables, which are published
+ *          in branch order at the join; a failing branch lets the others finish and
+ *          fails the script; two branches may not share a plugin
+ */
+
+#include "uScriptTestRun.hpp"
+#include "uTestCheck.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// written by the recording plugins into the working directory
+static const char kTraceFile[] = "plugin_trace.txt";
+
+static const char kJoinScript[] =
+    "LOAD_PLUGIN PROBEA\n"
+    "LOAD_PLUGIN PROBEB\n"
+    "x ?= start\n"
+    "PARALLEL block\n"
+    "BRANCH\n"
+    "    a ?= PROBEA.SLEEP 300\n"
+    "    i ?= REPEAT la 2\n"
+    "        PRINT > a $i x=$x\n"
+    "    END_REPEAT la\n"
+    "    x ?= from_a\n"
+    "BRANCH\n"
+    "    b ?= PROBEB.SLEEP 300\n"
+    "    PRINT > b x=$x\n"
+    "    x ?= from_b\n"
+    "END_PARALLEL block\n"
+    "PRINT > joined a=$a b=$b x=$x\n";
+
+static const char kFailScript[] =
+    "LOAD_PLUGIN PROBEA\n"
+    "LOAD_PLUGIN PROBEB\n"
+    "PARALLEL block\n"
+    "BRANCH\n"
+    "    PROBEA.FAIL now\n"
+    "    PRINT > after fail\n"
+    "BRANCH\n"
+    "    PROBEB.SLEEP 200\n"
+    "    PRINT > b done\n"
+    "END_PARALLEL block\n"
+    "PRINT > after block\n";
+
+static const char kSharedScript[] =
+    "LOAD_PLUGIN PROBEA\n"
+    "LOAD_PLUGIN PROBEB\n"
+    "PARALLEL block\n"
+    "BRANCH\n"
+    "    PROBEA.ECHO one\n"
+    "BRANCH\n"
+    "    PROBEA.ECHO two\n"
+    "END_PARALLEL block\n";
+
+static std::vector<std::string> sortedTrace()
+{
+    std::vector<std::string> vTrace = utest::readLines(kTraceFile);
+    std::sort(vTrace.begin(), vTrace.end());
+    return vTrace;
+}
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_parallel_blocks";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string strJoin   = (dir / "join.txt").string();
+    const std::string strFail   = (dir / "fail.txt").string();
+    const std::string strShared = (dir / "shared.txt").string();
+    UTEST_CHECK(utest::writeText(strJoin, kJoinScript));
+    UTEST_CHECK(utest::writeText(strFail, kFailScript));
+    UTEST_CHECK(utest::writeText(strShared, kSharedScript));
+
+    for (bool bBytecode : {false, true}) {
+        // both sleeps overlap: well under the 600 ms they take one after the other
+        fs::remove(kTraceFile);
+        const auto tStart = std::chrono::steady_clock::now();
+        utest::ScriptRun run = utest::runScript(strJoin, bBytecode);
+        const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+        UTEST_CHECK(run.bValidated && run.bExecuted);
+        UTEST_CHECK(tElapsed < std::chrono::milliseconds(550));
+        UTEST_CHECK(utest::printed(run, "> a ") == std::vector<std::string>({ "0 x=start", "1 x=start" }));
+        UTEST_CHECK(utest::printed(run, "> b ") == std::vector<std::string>({ "x=start" }));
+        UTEST_CHECK(utest::printed(run, "> joined ") == std::vector<std::string>({ "a=300 b=300 x=from_b" }));
+        UTEST_CHECK(sortedTrace() == std::vector<std::string>({ "PROBEA.SLEEP 300", "PROBEB.SLEEP 300" }));
+
+        // the failure of the first branch does not cut the second one short
+        fs::remove(kTraceFile);
+        run = utest::runScript(strFail, bBytecode);
+        UTEST_CHECK(run.bValidated && !run.bExecuted);
+        UTEST_CHECK(utest::printed(run, "> b done").size() == 1U);
+        UTEST_CHECK(utest::printed(run, "> after fail").empty());
+        UTEST_CHECK(utest::printed(run, "> after block").empty());
+        UTEST_CHECK(sortedTrace() == std::vector<std::string>({ "PROBEA.FAIL now", "PROBEB.SLEEP 200" }));
+
+        run = utest::runScript(strShared, bBytecode);
+        UTEST_CHECK(!run.bValidated);
+    }
+
+    fs::remove(kTraceFile);
+    fs::remove_all(dir);
+
+    return utest::result("parallel_blocks");
+}
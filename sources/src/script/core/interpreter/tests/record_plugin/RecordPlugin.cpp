@@ -0,0 +1,137 @@
+/**
+ * @file    RecordPlugin.cpp
+ * @brief   Stand-in for the hardware plugins in the interpreter tests: accepts the
+ *          commands the shipped scripts use plus ECHO, SLEEP and FAIL and, once
+ *          enabled, appends every completed call as "PLUGIN.COMMAND params" to
+ *          RECORD_TRACE_FILE in the working directory
+ */
+
+#include "uSharedConfig.hpp"
+#include "IPlugin.hpp"
+#include "IPluginDataTypes.hpp"
+#include "PluginOperations.hpp"
+#include "PluginExport.hpp"
+#include "uLogger.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#ifdef LT_HDR
+    #undef LT_HDR
+#endif
+#ifdef LOG_HDR
+    #undef LOG_HDR
+#endif
+#define LT_HDR     "RECORD      |"
+#define LOG_HDR    LOG_STRING(LT_HDR)
+
+#define RECORD_TRACE_FILE    "plugin_trace.txt"
+
+
+class RecordPlugin : public PluginInterface
+{
+public:
+
+    RecordPlugin() : m_strVersion("1.0.0.0")
+    {
+        m_mapCmds.insert(std::make_pair("I2C",    &RecordPlugin::m_Record_I2C));
+        m_mapCmds.insert(std::make_pair("MODE",   &RecordPlugin::m_Record_MODE));
+        m_mapCmds.insert(std::make_pair("SCRIPT", &RecordPlugin::m_Record_SCRIPT));
+        m_mapCmds.insert(std::make_pair("ECHO",   &RecordPlugin::m_Record_ECHO));
+        m_mapCmds.insert(std::make_pair("SLEEP",  &RecordPlugin::m_Record_SLEEP));
+        m_mapCmds.insert(std::make_pair("FAIL",   &RecordPlugin::m_Record_FAIL));
+        generic_build_table<RecordPlugin>(m_mapCmds, m_vCmds);
+    }
+
+    bool isInitialized( void ) const                { return m_bIsInitialized; }
+    bool isEnabled( void ) const                    { return m_bIsEnabled; }
+    bool setParams( const PluginDataSet *psSetParams )
+    {
+        return generic_setparams<RecordPlugin>(this, psSetParams, &m_bIsFaultTolerant, &m_bIsPrivileged);
+    }
+    void getParams( PluginDataGet *psGetParams ) const
+    {
+        generic_getparams<RecordPlugin>(this, psGetParams);
+    }
+    bool doDispatch( const std::string& strCmd, const std::string& strParams ) const
+    {
+        return generic_dispatch<RecordPlugin>(this, strCmd, strParams);
+    }
+    size_t resolveCommand( const std::string& strCmd ) const
+    {
+        return generic_resolve_command<RecordPlugin>(this, strCmd);
+    }
+    bool doDispatchById( size_t szCmdId, const std::string& strParams ) const
+    {
+        return generic_dispatch_by_id<RecordPlugin>(this, szCmdId, strParams);
+    }
+    const PluginCommandsMap<RecordPlugin> *getMap( void ) const { return &m_mapCmds; }
+    const PluginCommandsTable<RecordPlugin> *getTable( void ) const { return &m_vCmds; }
+    const std::string& getVersion( void ) const     { return m_strVersion; }
+    const std::string& getData( void ) const        { return m_strResultData; }
+    void resetData( void ) const                    { m_strResultData.clear(); }
+    bool doInit( void * )                           { m_bIsInitialized = true; return true; }
+    bool doEnable( void )                           { m_bIsEnabled = true; return true; }
+    void doCleanup( void )                          { m_bIsInitialized = false; m_bIsEnabled = false; }
+    bool isFaultTolerant( void ) const              { return m_bIsFaultTolerant; }
+    bool isPrivileged( void ) const                 { return m_bIsPrivileged; }
+
+private:
+
+    bool m_Record_I2C( const std::string &args ) const      { return m_record("I2C", args); }
+    bool m_Record_MODE( const std::string &args ) const     { return m_record("MODE", args); }
+    bool m_Record_SCRIPT( const std::string &args ) const   { return m_record("SCRIPT", args); }
+    bool m_Record_ECHO( const std::string &args ) const     { return m_record("ECHO", args); }
+
+    // SLEEP <ms>: the record is written when the sleep is over
+    bool m_Record_SLEEP( const std::string &args ) const
+    {
+        if (m_bIsEnabled) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::stoul(args)));
+        }
+        return m_record("SLEEP", args);
+    }
+
+    // FAIL: recorded, then reported as failed once the plugin is enabled
+    bool m_Record_FAIL( const std::string &args ) const
+    {
+        m_record("FAIL", args);
+        return !m_bIsEnabled;
+    }
+
+    // validation calls (plugin not enabled yet) are accepted without a record
+    bool m_record( const char *pstrCmd, const std::string &args ) const
+    {
+        if (m_bIsEnabled) {
+            std::ofstream trace(RECORD_TRACE_FILE, std::ios::app);
+            trace << RECORD_PLUGIN_NAME << "." << pstrCmd << " " << args << "\n";
+        }
+        m_strResultData = args;
+        return true;
+    }
+
+    PluginCommandsMap<RecordPlugin> m_mapCmds;
+    PluginCommandsTable<RecordPlugin> m_vCmds;
+    std::string m_strVersion;
+    mutable std::string m_strResultData;
+    bool m_bIsInitialized   = false;
+    bool m_bIsEnabled       = false;
+    bool m_bIsFaultTolerant = false;
+    bool m_bIsPrivileged    = false;
+};
+
+
+extern "C"
+{
+    EXPORTED RecordPlugin* pluginEntry()
+    {
+        return new RecordPlugin();
+    }
+
+    EXPORTED void pluginExit( RecordPlugin *ptrPlugin )
+    {
+        delete ptrPlugin;
+    }
+}
@@ -0,0 +1,60 @@
+/**
+ * @file    Test_VarSlots.cpp
+ * @brief   Variable slots (uScriptInterpreter.cpp): writes and reads through the slots
+ *          the validator assigned, loop indices bound to the slot of their name while the
+ *          loop runs, an outer binding restored when a nested loop reusing the name ends
+ */
+
+#include "uScriptTestRun.hpp"
+#include "uTestCheck.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char kScript[] =
+    "n ?= 1\n"
+    "copy ?= $n\n"
+    "n ?= 7\n"
+    "PRINT > copy=$copy n=$n\n"
+    "name ?= n\n"
+    "PRINT > indirect=$$name\n"
+    "i ?= REPEAT outer 2\n"
+    "    i ?= REPEAT inner 2\n"
+    "        PRINT > inner=$i\n"
+    "        last ?= $i\n"
+    "    END_REPEAT inner\n"
+    "    PRINT > outer=$i last=$last\n"
+    "END_REPEAT outer\n"
+    "PRINT > after=$i last=$last unknown=$nope\n";
+
+static const std::vector<std::string> kExpected {
+    "copy=1 n=7",
+    "indirect=7",
+    "inner=0", "inner=1", "outer=0 last=1",
+    "inner=0", "inner=1", "outer=1 last=1",
+    "after=$i last=1 unknown=$nope",
+};
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_var_slots";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string strScript = (dir / "slots.txt").string();
+    UTEST_CHECK(utest::writeText(strScript, kScript));
+
+    for (bool bBytecode : {false, true}) {
+        const utest::ScriptRun run = utest::runScript(strScript, bBytecode);
+        UTEST_CHECK(run.bValidated && run.bExecuted);
+        UTEST_CHECK(utest::printed(run, "> ") == kExpected);
+    }
+
+    fs::remove_all(dir);
+
+    return utest::result("var_slots");
+}
@@ -49,12 +49,48 @@ class ScriptValidator : public IScriptValidator<ScriptEntriesType>
         bool m_HandlePrint         ( const ScriptRawLine& rawLine ) noexcept;
         bool m_HandleDelay         ( const ScriptRawLine& rawLine ) noexcept;
         bool m_HandleBreakpoint    ( const ScriptRawLine& rawLine ) noexcept;
+        bool m_HandleParallel      ( const ScriptRawLine& rawLine ) noexcept;
+        bool m_HandleBranch        ( const ScriptRawLine& rawLine ) noexcept;
+        bool m_HandleEndParallel   ( const ScriptRawLine& rawLine ) noexcept;
+        bool m_HandleAsync         ( const ScriptRawLine& rawLine ) noexcept;
+        bool m_HandleAwait         ( const ScriptRawLine& rawLine ) noexcept;
+        bool m_HandlePeriod        ( const ScriptRawLine& rawLine ) noexcept;
+        bool m_HandleDelayUntil    ( const ScriptRawLine& rawLine ) noexcept;
+
+        // "<value>" "<unit>" (us | ms | sec) -> microseconds; false on overflow
+        bool m_parseDurationUs(const std::string& strValue, const std::string& strUnit, size_t& szUs) const noexcept;
 
         bool m_preprocessScriptStatements( const ScriptRawLine& rawLine, const Token token ) noexcept;
         bool m_validateConditions() noexcept;
         bool m_validateLoops()      noexcept;
         bool m_validatePlugins ()   noexcept;
 
+        // Checks the PARALLEL / BRANCH / END_PARALLEL structure (self-contained
+        // branches, one plugin per branch, no nesting) and stores the branch
+        // and block end indices.  Requires the loop structure already checked
+        // by m_validateLoops.
+        bool m_validateParallelBlocks() noexcept;
+
+        // Every AWAIT must follow an ASYNC of the same handle; a handle that
+        // is never awaited is reported as a warning.
+        bool m_validateAsync() noexcept;
+
+        // Stores the LABEL / END_REPEAT index targeted by every IF..GOTO,
+        // BREAK and CONTINUE (plus the number of inner loops to unwind) so the
+        // interpreter jumps directly instead of skipping node by node; gives
+        // every PERIOD its enclosing loop and pacing timeline.
+        // Requires the structure already checked by m_validateLoops.
+        void m_resolveJumpTargets() noexcept;
+
+        // Pre-splits every $macro template held by the IR into literal and
+        // macro segments so the interpreter can expand them without regex.
+        void m_compileMacroTemplates() noexcept;
+
+        // Assigns every variable macro, loop index and array macro a numeric
+        // slot and stamps it into the IR nodes and compiled templates, so the
+        // interpreter can keep values in a flat vector instead of name maps.
+        void m_resolveSymbolSlots() noexcept;
+
         bool m_ListStatements () noexcept;
 
         // Parses a comma-separated element list (the part after [=).
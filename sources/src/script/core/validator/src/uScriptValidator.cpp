@@ -16,6 +16,8 @@
 #include <map>
 #include <variant>
 #include <utility>
+#include <algorithm>
+#include <limits>
 
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -62,10 +64,24 @@ bool ScriptValidator::validateScript(std::vector<ScriptRawLine>& vRawLines, Scri
             break;
         }
 
+        if (false == m_validateParallelBlocks()) {
+            break;
+        }
+
+        if (false == m_validateAsync()) {
+            break;
+        }
+
+        m_resolveJumpTargets();
+
         if (false == m_validatePlugins()) {
             break;
         }
 
+        m_compileMacroTemplates();
+
+        m_resolveSymbolSlots();
+
         m_ListStatements();
 
         bRetVal = true;
@@ -225,6 +241,9 @@ bool ScriptValidator::m_validateLoops() noexcept
             else if constexpr (std::is_same_v<T, VarMacroInit>) {
                 allScriptMacroNames.insert(item.strName);
             }
+            else if constexpr (std::is_same_v<T, AsyncCommand>) {
+                allScriptMacroNames.insert(item.strHandle);
+            }
 
             // ----- loop open markers -----
             else if constexpr (std::is_same_v<T, RepeatTimes> || std::is_same_v<T, RepeatUntil>) {
@@ -324,6 +343,326 @@ bool ScriptValidator::m_validateLoops() noexcept
 } // m_validateLoops()
 
 
+/*-------------------------------------------------------------------------------
+  Validates the PARALLEL blocks and stores their branch / end indices:
+    1. Blocks are closed by END_PARALLEL with the same label, do not nest and
+       have distinct labels.
+    2. A block holds at least one BRANCH and nothing before its first BRANCH.
+    3. Every branch is self-contained: loops opened in a branch are closed in
+       it, BREAK / CONTINUE name a loop of the branch and IF..GOTO stays in
+       the branch (or outside any branch).
+    4. No two branches of a block use the same plugin instance — the plugins
+       are not required to be thread safe.
+    5. No BREAKPOINT inside a branch (interactive input from several threads).
+-------------------------------------------------------------------------------*/
+
+bool ScriptValidator::m_validateParallelBlocks() noexcept
+{
+    auto& vCommands = m_sScriptEntries->vCommands;
+    bool bRetVal = true;
+
+    // szBlock: index of the open PARALLEL node (kNoJump = none)
+    // szBranch: index of the open BRANCH node (kNoJump = before the first one)
+    // uBranchId: 1-based id of the open branch, 0 outside any branch
+    size_t   szBlock   = kNoJump;
+    size_t   szBranch  = kNoJump;
+    uint32_t uBranchId = 0U;
+    uint32_t uNextId   = 0U;
+    size_t   szNrBlocks = 0;
+
+    std::set<std::string> allBlockLabels;
+    std::vector<std::string> branchLoops;                          // loops opened in the open branch
+    std::map<std::string, uint32_t> mapPluginBranch;               // plugin → branch of the open block
+    std::map<std::string, uint32_t> mapLabelBranch;                // LABEL  → branch
+    std::vector<std::pair<std::string, uint32_t>> vGotoBranches;   // GOTO target, branch of the GOTO
+
+    // closes the open branch at node i (BRANCH or END_PARALLEL)
+    auto closeBranch = [&](size_t i) {
+        if (szBranch != kNoJump) {
+            if (!branchLoops.empty()) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Loop"); LOG_STRING(branchLoops.back());
+                          LOG_STRING("crosses a branch boundary of PARALLEL block"); LOG_STRING(std::get<ParallelBegin>(vCommands[szBlock].command).strLabel));
+                bRetVal = false;
+            }
+            std::get<ParallelBranch>(vCommands[szBranch].command).szEndIndex = i;
+        }
+        branchLoops.clear();
+    };
+
+    for (size_t i = 0; (i < vCommands.size()) && bRetVal; ++i) {
+        std::visit([&](auto& item) {
+            using T = std::decay_t<decltype(item)>;
+
+            if constexpr (std::is_same_v<T, ParallelBegin>) {
+                if (szBlock != kNoJump) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Nested PARALLEL block:"); LOG_STRING(item.strLabel));
+                    bRetVal = false;
+                    return;
+                }
+                if (!allBlockLabels.insert(item.strLabel).second) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Duplicate PARALLEL label:"); LOG_STRING(item.strLabel));
+                    bRetVal = false;
+                    return;
+                }
+                item.vBranchIndices.clear();
+                szBlock  = i;
+                szBranch = kNoJump;
+                mapPluginBranch.clear();
+                return;
+            }
+
+            if constexpr (std::is_same_v<T, ParallelEnd>) {
+                if (szBlock == kNoJump) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("END_PARALLEL without matching PARALLEL:"); LOG_STRING(item.strLabel));
+                    bRetVal = false;
+                    return;
+                }
+                auto& block = std::get<ParallelBegin>(vCommands[szBlock].command);
+                if (block.strLabel != item.strLabel) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR;
+                              LOG_STRING("END_PARALLEL label mismatch: expected ["); LOG_STRING(block.strLabel);
+                              LOG_STRING("] got ["); LOG_STRING(item.strLabel); LOG_STRING("]"));
+                    bRetVal = false;
+                    return;
+                }
+                if (block.vBranchIndices.empty()) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("PARALLEL block without BRANCH:"); LOG_STRING(item.strLabel));
+                    bRetVal = false;
+                    return;
+                }
+                closeBranch(i);
+                block.szEndIndex = i;
+                szBlock   = kNoJump;
+                szBranch  = kNoJump;
+                uBranchId = 0U;
+                ++szNrBlocks;
+                return;
+            }
+
+            if constexpr (std::is_same_v<T, ParallelBranch>) {
+                if (szBlock == kNoJump) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("BRANCH outside a PARALLEL block"));
+                    bRetVal = false;
+                    return;
+                }
+                closeBranch(i);
+                std::get<ParallelBegin>(vCommands[szBlock].command).vBranchIndices.push_back(i);
+                szBranch  = i;
+                uBranchId = ++uNextId;
+                return;
+            }
+
+            // any other statement of a block must be inside one of its branches
+            if ((szBlock != kNoJump) && (szBranch == kNoJump)) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Statement before the first BRANCH of PARALLEL block:");
+                          LOG_STRING(std::get<ParallelBegin>(vCommands[szBlock].command).strLabel));
+                bRetVal = false;
+                return;
+            }
+
+            if constexpr (std::is_same_v<T, Condition>) {
+                vGotoBranches.emplace_back(item.strLabelName, uBranchId);
+            }
+            else if constexpr (std::is_same_v<T, Label>) {
+                mapLabelBranch[item.strLabelName] = uBranchId;
+            }
+
+            if (uBranchId == 0U) {
+                return;
+            }
+
+            if constexpr (std::is_same_v<T, MacroCommand> || std::is_same_v<T, Command>) {
+                auto [it, bInserted] = mapPluginBranch.emplace(item.strPlugin, uBranchId);
+                if (!bInserted && (it->second != uBranchId)) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Plugin"); LOG_STRING(item.strPlugin);
+                              LOG_STRING("used by more than one branch of PARALLEL block");
+                              LOG_STRING(std::get<ParallelBegin>(vCommands[szBlock].command).strLabel));
+                    bRetVal = false;
+                }
+            }
+            else if constexpr (std::is_same_v<T, RepeatTimes> || std::is_same_v<T, RepeatUntil>) {
+                branchLoops.push_back(item.strLabel);
+            }
+            else if constexpr (std::is_same_v<T, RepeatEnd>) {
+                if (branchLoops.empty()) {
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Loop"); LOG_STRING(item.strLabel);
+                              LOG_STRING("crosses a branch boundary of PARALLEL block");
+                              LOG_STRING(std::get<ParallelBegin>(vCommands[szBlock].command).strLabel));
+                    bRetVal = false;
+                    return;
+                }
+                branchLoops.pop_back();     // nesting already checked by m_validateLoops
+            }
+            else if constexpr (std::is_same_v<T, LoopBreak> || std::is_same_v<T, LoopContinue>) {
+                if (std::find(branchLoops.begin(), branchLoops.end(), item.strLabel) == branchLoops.end()) {
+                    const char *pszKeyword = std::is_same_v<T, LoopBreak> ? "BREAK" : "CONTINUE";
+                    LOG_PRINT(LOG_ERROR, LOG_HDR;
+                              LOG_STRING(pszKeyword); LOG_STRING(item.strLabel);
+                              LOG_STRING("leaves a branch of PARALLEL block");
+                              LOG_STRING(std::get<ParallelBegin>(vCommands[szBlock].command).strLabel));
+                    bRetVal = false;
+                }
+            }
+            else if constexpr (std::is_same_v<T, BreakpointStatement>) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("BREAKPOINT not allowed inside PARALLEL block");
+                          LOG_STRING(std::get<ParallelBegin>(vCommands[szBlock].command).strLabel));
+                bRetVal = false;
+            }
+            else if constexpr (std::is_same_v<T, AsyncCommand> || std::is_same_v<T, AwaitStatement>) {
+                const char *pszKeyword = std::is_same_v<T, AsyncCommand> ? "ASYNC" : "AWAIT";
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(pszKeyword); LOG_STRING("not allowed inside PARALLEL block");
+                          LOG_STRING(std::get<ParallelBegin>(vCommands[szBlock].command).strLabel));
+                bRetVal = false;
+            }
+        }, vCommands[i].command);
+    }
+
+    if (bRetVal && (szBlock != kNoJump)) {
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Unclosed PARALLEL block (missing END_PARALLEL):");
+                  LOG_STRING(std::get<ParallelBegin>(vCommands[szBlock].command).strLabel));
+        bRetVal = false;
+    }
+
+    // --- GOTO must not cross branch boundaries --------------------------------
+    if (bRetVal) {
+        for (const auto& [targetLabel, uGotoBranch] : vGotoBranches) {
+            auto it = mapLabelBranch.find(targetLabel);
+            if ((it != mapLabelBranch.end()) && (it->second != uGotoBranch)) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR;
+                          LOG_STRING("GOTO crosses a PARALLEL branch boundary for label:"); LOG_STRING(targetLabel));
+                bRetVal = false;
+            }
+        }
+    }
+
+    LOG_PRINT((bRetVal ? LOG_DEBUG : LOG_ERROR), LOG_HDR; LOG_STRING("Parallel blocks validation"); LOG_STRING(bRetVal ? "ok" : "failed");
+              LOG_STRING("blocks:"); LOG_SIZET(szNrBlocks));
+
+    return bRetVal;
+
+} // m_validateParallelBlocks()
+
+
+/*-------------------------------------------------------------------------------
+  ASYNC / AWAIT pairing, in file order (the interpreter additionally fails an
+  AWAIT that finds no pending command, e.g. after a GOTO skipped the ASYNC).
+-------------------------------------------------------------------------------*/
+
+bool ScriptValidator::m_validateAsync() noexcept
+{
+    bool bRetVal = true;
+    std::unordered_map<std::string, bool> mapHandles;   // handle -> awaited
+
+    for (const auto& data : m_sScriptEntries->vCommands) {
+        std::visit([&](const auto& item) {
+            using T = std::decay_t<decltype(item)>;
+
+            if constexpr (std::is_same_v<T, AsyncCommand>) {
+                mapHandles.try_emplace(item.strHandle, false);
+            }
+            else if constexpr (std::is_same_v<T, AwaitStatement>) {
+                auto it = mapHandles.find(item.strHandle);
+                if (it == mapHandles.end()) {
+                    auto lineNr = ustring::fmtLineNr(data.iLineNumber);
+                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data());
+                              LOG_STRING("AWAIT without a preceding ASYNC for handle:"); LOG_STRING(item.strHandle));
+                    bRetVal = false;
+                } else {
+                    it->second = true;
+                }
+            }
+        }, data.command);
+    }
+
+    for (const auto& [strHandle, bAwaited] : mapHandles) {
+        if (false == bAwaited) {
+            LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("ASYNC handle never awaited:"); LOG_STRING(strHandle));
+        }
+    }
+
+    if (false == mapHandles.empty()) {
+        LOG_PRINT((bRetVal ? LOG_DEBUG : LOG_ERROR), LOG_HDR; LOG_STRING("Async validation"); LOG_STRING(bRetVal ? "ok" : "failed");
+                  LOG_STRING("handles:"); LOG_SIZET(mapHandles.size()));
+    }
+
+    return bRetVal;
+
+} // m_validateAsync()
+
+
+/*-------------------------------------------------------------------------------
+  Single forward pass.  GOTOs always precede their LABEL and BREAK/CONTINUE
+  always precede the END_REPEAT of their loop, so each jump is parked in a
+  pending list and patched when its target node is reached.
+  The unwind depth of BREAK/CONTINUE is the number of loops opened inside
+  the target loop that still enclose the statement.
+-------------------------------------------------------------------------------*/
+
+void ScriptValidator::m_resolveJumpTargets() noexcept
+{
+    auto& vCommands = m_sScriptEntries->vCommands;
+
+    std::unordered_map<std::string, std::vector<size_t>> mapPendingGotos;   // label      → IF..GOTO indices
+    std::unordered_map<std::string, std::vector<size_t>> mapPendingLoops;   // loop label → BREAK/CONTINUE indices
+    std::vector<std::string> loopStack;
+    size_t szNrJumps = 0;
+    uint32_t uNrTimelines = 0U;
+
+    for (size_t i = 0; i < vCommands.size(); ++i) {
+        std::visit([&](auto& item) {
+            using T = std::decay_t<decltype(item)>;
+
+            if constexpr (std::is_same_v<T, Condition>) {
+                mapPendingGotos[item.strLabelName].push_back(i);
+            }
+            else if constexpr (std::is_same_v<T, Label>) {
+                auto it = mapPendingGotos.find(item.strLabelName);
+                if (it != mapPendingGotos.end()) {
+                    for (size_t szGoto : it->second) {
+                        std::get<Condition>(vCommands[szGoto].command).szTargetIndex = i;
+                        ++szNrJumps;
+                    }
+                    mapPendingGotos.erase(it);
+                }
+            }
+            else if constexpr (std::is_same_v<T, RepeatTimes> || std::is_same_v<T, RepeatUntil>) {
+                loopStack.push_back(item.strLabel);
+            }
+            else if constexpr (std::is_same_v<T, PeriodStatement>) {
+                item.strLoopLabel = loopStack.empty() ? std::string() : loopStack.back();
+                item.uTimeline    = uNrTimelines++;
+            }
+            else if constexpr (std::is_same_v<T, LoopBreak> || std::is_same_v<T, LoopContinue>) {
+                auto itTarget = std::find(loopStack.rbegin(), loopStack.rend(), item.strLabel);
+                item.szUnwindDepth = static_cast<size_t>(std::distance(loopStack.rbegin(), itTarget));
+                mapPendingLoops[item.strLabel].push_back(i);
+            }
+            else if constexpr (std::is_same_v<T, RepeatEnd>) {
+                auto it = mapPendingLoops.find(item.strLabel);
+                if (it != mapPendingLoops.end()) {
+                    for (size_t szJump : it->second) {
+                        std::visit([i](auto& jump) {
+                            using J = std::decay_t<decltype(jump)>;
+                            if constexpr (std::is_same_v<J, LoopBreak> || std::is_same_v<J, LoopContinue>) {
+                                jump.szTargetIndex = i;
+                            }
+                        }, vCommands[szJump].command);
+                        ++szNrJumps;
+                    }
+                    mapPendingLoops.erase(it);
+                }
+                if (!loopStack.empty()) {
+                    loopStack.pop_back();
+                }
+            }
+        }, vCommands[i].command);
+    }
+
+    LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Jump targets resolved:"); LOG_SIZET(szNrJumps));
+
+} // m_resolveJumpTargets()
+
+
 /*-------------------------------------------------------------------------------
 
 -------------------------------------------------------------------------------*/
@@ -343,7 +682,7 @@ bool ScriptValidator::m_validatePlugins () noexcept
                     usedPlugins.insert(item.strPlugin);
                 }
 
-                if constexpr (std::is_same_v<T, Command>) {
+                if constexpr (std::is_same_v<T, Command> || std::is_same_v<T, AsyncCommand>) {
                     usedPlugins.insert(item.strPlugin);
                 }
             }, data.command);
@@ -394,6 +733,145 @@ bool ScriptValidator::m_validatePlugins () noexcept
 } // m_validatePlugins()
 
 
+/*-------------------------------------------------------------------------------
+  Compile the $macro templates of every IR node once, after all statements
+  are known.  Constant macros were already substituted while reading the
+  lines, so only variable / loop-index / array references remain.
+-------------------------------------------------------------------------------*/
+
+void ScriptValidator::m_compileMacroTemplates() noexcept
+{
+    size_t szNrTemplates = 0;
+
+    auto compile = [&szNrTemplates](MacroTemplate& sTpl, const std::string& strRaw) {
+        sTpl = umacro::compileMacroTemplate(strRaw);
+        ++szNrTemplates;
+    };
+
+    for (auto& data : m_sScriptEntries->vCommands) {
+        std::visit([&compile](auto& item) {
+            using T = std::decay_t<decltype(item)>;
+
+            if constexpr (std::is_same_v<T, MacroCommand> || std::is_same_v<T, Command> ||
+                          std::is_same_v<T, AsyncCommand>) {
+                compile(item.sParamsTpl, item.strParams);
+            } else if constexpr (std::is_same_v<T, Condition> || std::is_same_v<T, RepeatUntil>) {
+                compile(item.sConditionTpl, item.strCondition);
+            } else if constexpr (std::is_same_v<T, RepeatTimes>) {
+                compile(item.sCountTpl, item.strCountExpr);
+            } else if constexpr (std::is_same_v<T, PrintStatement>) {
+                compile(item.sTextTpl, item.strText);
+            } else if constexpr (std::is_same_v<T, VarMacroInit>) {
+                compile(item.sValueTpl, item.strValueTpl);
+            } else if constexpr (std::is_same_v<T, FormatStatement>) {
+                compile(item.sInputTpl, item.strInputTpl);
+                compile(item.sFormatTpl, item.strFormatTpl);
+            } else if constexpr (std::is_same_v<T, MathStatement>) {
+                compile(item.sExprTpl, item.strExprTpl);
+            } else if constexpr (std::is_same_v<T, BreakpointStatement>) {
+                compile(item.sLabelTpl, item.strLabelTpl);
+            }
+        }, data.command);
+    }
+
+    LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Macro templates compiled:"); LOG_SIZET(szNrTemplates));
+
+} // m_compileMacroTemplates()
+
+
+/*-------------------------------------------------------------------------------
+  Symbol resolution: one variable slot per distinct variable / loop-index name
+  (written or referenced) and one array slot per array macro.  Names that are
+  only referenced may still be defined at runtime by the shell; they simply
+  stay undefined in their slot and the interpreter falls back to the shell map.
+-------------------------------------------------------------------------------*/
+
+void ScriptValidator::m_resolveSymbolSlots() noexcept
+{
+    std::unordered_map<std::string, uint32_t> mapVarSlots;
+    std::unordered_map<std::string, uint32_t> mapArraySlots;
+
+    auto& vVarSlots   = m_sScriptEntries->vVarSlots;
+    auto& vArraySlots = m_sScriptEntries->vArraySlots;
+    vVarSlots.clear();
+    vArraySlots.clear();
+
+    for (const auto& array : m_sScriptEntries->mapArrayMacros) {
+        mapArraySlots.emplace(array.first, static_cast<uint32_t>(vArraySlots.size()));
+        vArraySlots.push_back(array.first);
+    }
+
+    auto varSlot = [&mapVarSlots, &vVarSlots](const std::string& strName) -> uint32_t {
+        if (strName.empty()) {
+            return kNoSlot;
+        }
+        auto [it, bInserted] = mapVarSlots.emplace(strName, static_cast<uint32_t>(vVarSlots.size()));
+        if (bInserted) {
+            vVarSlots.push_back(strName);
+        }
+        return it->second;
+    };
+
+    auto resolveTpl = [&varSlot, &mapArraySlots](MacroTemplate& sTpl) {
+        for (auto& seg : sTpl.vSegments) {
+            if (seg.eKind == MacroSegment::Kind::LITERAL) {
+                continue;
+            }
+            seg.uVarSlot = varSlot(seg.strText);
+            if (seg.eKind == MacroSegment::Kind::ARRAY_ELEM) {
+                seg.uIndexSlot = varSlot(seg.strIndex);
+                auto arrIt = mapArraySlots.find(seg.strText);
+                seg.uArraySlot = (arrIt != mapArraySlots.end()) ? arrIt->second : kNoSlot;
+            }
+        }
+    };
+
+    for (auto& data : m_sScriptEntries->vCommands) {
+        std::visit([&varSlot, &resolveTpl](auto& item) {
+            using T = std::decay_t<decltype(item)>;
+
+            if constexpr (std::is_same_v<T, MacroCommand>) {
+                item.uVarSlot = varSlot(item.strVarMacroName);
+                resolveTpl(item.sParamsTpl);
+            } else if constexpr (std::is_same_v<T, Command>) {
+                resolveTpl(item.sParamsTpl);
+            } else if constexpr (std::is_same_v<T, AsyncCommand>) {
+                item.uVarSlot = varSlot(item.strHandle);
+                resolveTpl(item.sParamsTpl);
+            } else if constexpr (std::is_same_v<T, AwaitStatement>) {
+                item.uVarSlot = varSlot(item.strHandle);
+            } else if constexpr (std::is_same_v<T, Condition>) {
+                resolveTpl(item.sConditionTpl);
+            } else if constexpr (std::is_same_v<T, RepeatTimes>) {
+                item.uVarSlot = varSlot(item.strVarMacroName);
+                resolveTpl(item.sCountTpl);
+            } else if constexpr (std::is_same_v<T, RepeatUntil>) {
+                item.uVarSlot = varSlot(item.strVarMacroName);
+                resolveTpl(item.sConditionTpl);
+            } else if constexpr (std::is_same_v<T, PrintStatement>) {
+                resolveTpl(item.sTextTpl);
+            } else if constexpr (std::is_same_v<T, VarMacroInit>) {
+                item.uVarSlot = varSlot(item.strName);
+                resolveTpl(item.sValueTpl);
+            } else if constexpr (std::is_same_v<T, FormatStatement>) {
+                item.uVarSlot = varSlot(item.strName);
+                resolveTpl(item.sInputTpl);
+                resolveTpl(item.sFormatTpl);
+            } else if constexpr (std::is_same_v<T, MathStatement>) {
+                item.uVarSlot = varSlot(item.strName);
+                resolveTpl(item.sExprTpl);
+            } else if constexpr (std::is_same_v<T, BreakpointStatement>) {
+                resolveTpl(item.sLabelTpl);
+            }
+        }, data.command);
+    }
+
+    LOG_PRINT(LOG_DEBUG, LOG_HDR; LOG_STRING("Symbol slots: variables"); LOG_SIZET(vVarSlots.size());
+              LOG_STRING("arrays"); LOG_SIZET(vArraySlots.size()));
+
+} // m_resolveSymbolSlots()
+
+
 /*-------------------------------------------------------------------------------
 
 -------------------------------------------------------------------------------*/
@@ -471,6 +949,34 @@ bool ScriptValidator::m_preprocessScriptStatements ( const ScriptRawLine& rawLin
                 bRetVal = m_HandleBreakpoint(rawLine);
             }
             break;
+        case Token::PARALLEL: {
+                bRetVal = m_HandleParallel(rawLine);
+            }
+            break;
+        case Token::BRANCH: {
+                bRetVal = m_HandleBranch(rawLine);
+            }
+            break;
+        case Token::END_PARALLEL: {
+                bRetVal = m_HandleEndParallel(rawLine);
+            }
+            break;
+        case Token::ASYNC_STMT: {
+                bRetVal = m_HandleAsync(rawLine);
+            }
+            break;
+        case Token::AWAIT_STMT: {
+                bRetVal = m_HandleAwait(rawLine);
+            }
+            break;
+        case Token::PERIOD_STMT: {
+                bRetVal = m_HandlePeriod(rawLine);
+            }
+            break;
+        case Token::DELAY_UNTIL_STMT: {
+                bRetVal = m_HandleDelayUntil(rawLine);
+            }
+            break;
         default: {  
                 auto lineNr = ustring::fmtLineNr(rawLine.iLineNumber);
                 LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data());
@@ -749,7 +1255,7 @@ bool ScriptValidator::m_HandleVariableMacro ( const ScriptRawLine& rawLine ) noe
   - An empty value (bare "name ?=") is valid and initialises the macro to "".
 
   The resulting VarMacroInit node is pushed to vCommands so that at execution
-  time m_executeCommand can write the expanded value into m_RuntimeVarMacros.
+  time m_executeCommand can write the expanded value into its variable slot.
 -------------------------------------------------------------------------------*/
 
 bool ScriptValidator::m_HandleVarMacroInit( const ScriptRawLine& rawLine ) noexcept
@@ -1430,6 +1936,197 @@ bool ScriptValidator::m_HandleBreakpoint( const ScriptRawLine& rawLine ) noexcep
 } // m_HandleBreakpoint()
 
 
+/*-------------------------------------------------------------------------------
+  PARALLEL <label>
+  BRANCH
+  END_PARALLEL <label>
+  The block structure is checked once all statements are known
+  (m_validateParallelBlocks).
+-------------------------------------------------------------------------------*/
+
+bool ScriptValidator::m_HandleParallel( const ScriptRawLine& rawLine ) noexcept
+{
+    std::vector<std::string> vstrTokens;
+    ustring::tokenize(rawLine.strContent, vstrTokens);
+
+    if (vstrTokens.size() != 2) {
+        return false;
+    }
+
+    m_sScriptEntries->vCommands.emplace_back(ScriptLine{m_iCurrentSourceLine, ParallelBegin{vstrTokens[1]}});
+    return true;
+
+} // m_HandleParallel()
+
+
+
+bool ScriptValidator::m_HandleBranch( const ScriptRawLine& rawLine ) noexcept
+{
+    (void)rawLine;
+    m_sScriptEntries->vCommands.emplace_back(ScriptLine{m_iCurrentSourceLine, ParallelBranch{}});
+    return true;
+
+} // m_HandleBranch()
+
+
+
+bool ScriptValidator::m_HandleEndParallel( const ScriptRawLine& rawLine ) noexcept
+{
+    std::vector<std::string> vstrTokens;
+    ustring::tokenize(rawLine.strContent, vstrTokens);
+
+    if (vstrTokens.size() != 2) {
+        return false;
+    }
+
+    m_sScriptEntries->vCommands.emplace_back(ScriptLine{m_iCurrentSourceLine, ParallelEnd{vstrTokens[1]}});
+    return true;
+
+} // m_HandleEndParallel()
+
+
+/*-------------------------------------------------------------------------------
+  ASYNC_STMT handler:  handle ?= ASYNC PLUGIN.COMMAND [params]
+
+  With the ASYNC keyword removed the line is a plain variable macro command,
+  tokenised the same way as in m_HandleVariableMacro.
+-------------------------------------------------------------------------------*/
+
+bool ScriptValidator::m_HandleAsync( const ScriptRawLine& rawLine ) noexcept
+{
+    static const std::string kKeyword = "ASYNC";
+    const auto assignPos = rawLine.strContent.find(SCRIPT_VARIABLE_MACRO_SEPARATOR);
+    if (assignPos == std::string::npos) {
+        return false;
+    }
+
+    // ASYNC must be the first token of the right hand side, followed by the command
+    const std::string strRhs = rawLine.strContent.substr(assignPos + std::string(SCRIPT_VARIABLE_MACRO_SEPARATOR).size());
+    const size_t szKeyword = strRhs.find_first_not_of(" \t");
+    if ((szKeyword == std::string::npos) || (0 != strRhs.compare(szKeyword, kKeyword.size(), kKeyword))) {
+        return false;
+    }
+    const size_t szCommand = strRhs.find_first_not_of(" \t", szKeyword + kKeyword.size());
+    if ((szCommand == std::string::npos) || (szCommand == szKeyword + kKeyword.size())) {
+        return false;
+    }
+
+    const std::string strLine = rawLine.strContent.substr(0, assignPos) + SCRIPT_VARIABLE_MACRO_SEPARATOR + " " + strRhs.substr(szCommand);
+    std::vector<std::string> vstrDelimiters{SCRIPT_VARIABLE_MACRO_SEPARATOR,
+                                            SCRIPT_PLUGIN_COMMAND_SEPARATOR,
+                                            SCRIPT_COMMAND_PARAMS_SEPARATOR};
+    std::vector<std::string> vstrTokens;
+    ustring::tokenizeEx(strLine, vstrDelimiters, vstrTokens);
+    const size_t szSize = vstrTokens.size();
+
+    if ((szSize != 3) && (szSize != 4)) {
+        return false;
+    }
+
+    if (m_sScriptEntries->mapMacros.count(vstrTokens[0])) {
+        auto lineNr = ustring::fmtLineNr(rawLine.iLineNumber);
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data());
+                  LOG_STRING("ASYNC ["); LOG_STRING(vstrTokens[0]);
+                  LOG_STRING("]: name already used as a constant macro (:=)"));
+        return false;
+    }
+
+    m_sScriptEntries->vCommands.emplace_back(ScriptLine{m_iCurrentSourceLine,
+        AsyncCommand{vstrTokens[0], vstrTokens[1], vstrTokens[2], (szSize == 4) ? vstrTokens[3] : ""}});
+    return true;
+
+} // m_HandleAsync()
+
+
+/*-------------------------------------------------------------------------------
+  AWAIT_STMT handler:  AWAIT <handle> [TIMEOUT <value> <unit>]
+  The lexer already checked the shape; the timeout is stored in microseconds.
+-------------------------------------------------------------------------------*/
+
+bool ScriptValidator::m_HandleAwait( const ScriptRawLine& rawLine ) noexcept
+{
+    std::vector<std::string> vstrTokens;
+    ustring::tokenize(rawLine.strContent, vstrTokens);
+
+    if ((vstrTokens.size() != 2) && (vstrTokens.size() != 5)) {
+        return false;
+    }
+
+    size_t szTimeoutUs = 0U;
+    if ((vstrTokens.size() == 5) && (false == m_parseDurationUs(vstrTokens[3], vstrTokens[4], szTimeoutUs))) {
+        auto lineNr = ustring::fmtLineNr(rawLine.iLineNumber);
+        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(lineNr.data());
+                  LOG_STRING("AWAIT: invalid timeout:"); LOG_STRING(vstrTokens[3]));
+        return false;
+    }
+
+    m_sScriptEntries->vCommands.emplace_back(ScriptLine{m_iCurrentSourceLine, AwaitStatement{vstrTokens[1], szTimeoutUs}});
+    return true;
+
+} // m_HandleAwait()
+
+
+
+/*-------------------------------------------------------------------------------
+  PERIOD_STMT handler:       PERIOD <value> <unit>
+  DELAY_UNTIL_STMT handler:  DELAY_UNTIL <value> <unit>
+  The lexer already checked the shape; the enclosing loop of a PERIOD is
+  filled in by m_resolveJumpTargets.
+-------------------------------------------------------------------------------*/
+
+bool ScriptValidator::m_HandlePeriod( const ScriptRawLine& rawLine ) noexcept
+{
+    std::vector<std::string> vstrTokens;
+    ustring::tokenize(rawLine.strContent, vstrTokens);
+
+    size_t szPeriodUs = 0U;
+    if ((vstrTokens.size() != 3) || (false == m_parseDurationUs(vstrTokens[1], vstrTokens[2], szPeriodUs))) {
+        return false;
+    }
+
+    m_sScriptEntries->vCommands.emplace_back(ScriptLine{m_iCurrentSourceLine, PeriodStatement{szPeriodUs}});
+    return true;
+
+} // m_HandlePeriod()
+
+
+
+bool ScriptValidator::m_HandleDelayUntil( const ScriptRawLine& rawLine ) noexcept
+{
+    std::vector<std::string> vstrTokens;
+    ustring::tokenize(rawLine.strContent, vstrTokens);
+
+    size_t szOffsetUs = 0U;
+    if ((vstrTokens.size() != 3) || (false == m_parseDurationUs(vstrTokens[1], vstrTokens[2], szOffsetUs))) {
+        return false;
+    }
+
+    m_sScriptEntries->vCommands.emplace_back(ScriptLine{m_iCurrentSourceLine, DelayUntilStatement{szOffsetUs}});
+    return true;
+
+} // m_HandleDelayUntil()
+
+
+
+bool ScriptValidator::m_parseDurationUs(const std::string& strValue, const std::string& strUnit, size_t& szUs) const noexcept
+{
+    const unsigned long long ullScale = (strUnit == "us") ? 1ULL : ((strUnit == "ms") ? 1000ULL : 1000000ULL);
+
+    try {
+        const unsigned long long ullVal = std::stoull(strValue);
+        if (ullVal > (std::numeric_limits<int64_t>::max() / 1000LL) / ullScale) {
+            return false;   // does not fit the ns deadlines of the interpreter
+        }
+        szUs = static_cast<size_t>(ullVal * ullScale);
+    } catch (...) {
+        return false;
+    }
+
+    return true;
+
+} // m_parseDurationUs()
+
+
 /*-------------------------------------------------------------------------------
 
 -------------------------------------------------------------------------------*/
@@ -1498,6 +2195,10 @@ bool ScriptValidator::m_ListStatements () noexcept
                 } else if constexpr (std::is_same_v<T, DelayStatement>) {
                     const std::string strUnit = (item.eUnit == DelayUnit::US)  ? "us"  :(item.eUnit == DelayUnit::MS)  ? "ms"  : "sec";
                     LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("     DELAY:"); LOG_STRING(std::to_string(item.szValue)); LOG_STRING(strUnit));
+                } else if constexpr (std::is_same_v<T, PeriodStatement>) {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("    PERIOD:"); LOG_SIZET(item.szPeriodUs); LOG_STRING("us loop:"); LOG_STRING(item.strLoopLabel.empty() ? "<none>" : item.strLoopLabel));
+                } else if constexpr (std::is_same_v<T, DelayUntilStatement>) {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("DELAY_UNTIL:"); LOG_SIZET(item.szOffsetUs); LOG_STRING("us"));
                 } else if constexpr (std::is_same_v<T, BreakpointStatement>) {
                     LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("BREAKPOINT:"); LOG_STRING(item.strLabelTpl.empty() ? "<none>" : item.strLabelTpl));
                 } else if constexpr (std::is_same_v<T, VarMacroInit>) {
@@ -1506,6 +2207,16 @@ bool ScriptValidator::m_ListStatements () noexcept
                     LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("    FORMAT:"); LOG_STRING(item.strName); LOG_STRING("<-["); LOG_STRING(item.strInputTpl); LOG_STRING("]|["); LOG_STRING(item.strFormatTpl); LOG_STRING("]"));
                 } else if constexpr (std::is_same_v<T, MathStatement>) {
                     LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("      MATH:"); LOG_STRING(item.strName); LOG_STRING("= eval["); LOG_STRING(item.strExprTpl); LOG_STRING("]"));
+                } else if constexpr (std::is_same_v<T, ParallelBegin>) {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("  PARALLEL:"); LOG_STRING(item.strLabel); LOG_STRING("branches:"); LOG_SIZET(item.vBranchIndices.size()));
+                } else if constexpr (std::is_same_v<T, ParallelBranch>) {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("    BRANCH"));
+                } else if constexpr (std::is_same_v<T, ParallelEnd>) {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("END_PARALLEL:"); LOG_STRING(item.strLabel));
+                } else if constexpr (std::is_same_v<T, AsyncCommand>) {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("     ASYNC:"); LOG_STRING(item.strPlugin + "." + item.strCommand); LOG_STRING(item.strParams); LOG_STRING("->"); LOG_STRING(item.strHandle));
+                } else if constexpr (std::is_same_v<T, AwaitStatement>) {
+                    LOG_PRINT(LOG_VERBOSE, LOG_HDR; LOG_STRING(lineNr.data()); LOG_STRING("     AWAIT:"); LOG_STRING(item.strHandle); LOG_STRING("timeout us:"); LOG_SIZET(item.szTimeoutUs));
                 }
             }, data.command);
         });
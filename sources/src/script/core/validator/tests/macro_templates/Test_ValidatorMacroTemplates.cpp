@@ -0,0 +1,130 @@
+/**
+ * @file    Test_ValidatorMacroTemplates.cpp
+ * @brief   Macro templates compiled by ScriptValidator: a literal '$' right before
+ *          a macro reference ("$$name") stays literal text in front of the macro
+ *          segment, and its expansion asks the interpreter for a rescan
+ */
+
+#include "uScriptValidator.hpp"
+#include "IPluginDataTypes.hpp"
+#include "uScriptCommandValidator.hpp"
+#include "uScriptReader.hpp"
+#include "uTestCheck.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char kScript[] =
+    "KEY := target\n"
+    "v ?= target\n"
+    "target ?= reached\n"
+    "PRINT $$v\n"
+    "PRINT cost 5$ $v\n"
+    "PRINT $$KEY\n";
+
+static bool validate(const std::string& strPath, ScriptEntriesType& sEntries)
+{
+    std::vector<ScriptRawLine> vLines;
+    ScriptValidator validator(std::make_shared<ScriptCommandValidator>());
+    return ScriptReader(strPath).readScript(vLines) && validator.validateScript(vLines, sEntries);
+}
+
+static const MacroTemplate *printTemplate(const ScriptEntriesType& sEntries, size_t szIndex)
+{
+    const auto *pPrint = std::get_if<PrintStatement>(&sEntries.vCommands[szIndex].command);
+    return (pPrint != nullptr) ? &pPrint->sTextTpl : nullptr;
+}
+
+static bool isSegment(const MacroTemplate& sTpl, size_t szIndex, MacroSegment::Kind eKind, const std::string& strText)
+{
+    return (szIndex < sTpl.vSegments.size()) &&
+           (sTpl.vSegments[szIndex].eKind == eKind) && (sTpl.vSegments[szIndex].strText == strText);
+}
+
+// the variable values the script assigns before its PRINT lines
+static bool expand(const ScriptEntriesType& sEntries, const MacroTemplate& sTpl, std::string& strOut)
+{
+    static const std::string strV = "target";
+    static const std::string strTarget = "reached";
+
+    auto resolve = [&sEntries](const std::string& strName, uint32_t uSlot) -> const std::string* {
+        // a validated template carries the slot of the name, a rescanned one does not
+        const bool bSlotMatches = (uSlot == kNoSlot) ||
+                                  ((uSlot < sEntries.vVarSlots.size()) && (sEntries.vVarSlots[uSlot] == strName));
+        if (!bSlotMatches) {
+            return nullptr;
+        }
+        return (strName == "v") ? &strV : ((strName == "target") ? &strTarget : nullptr);
+    };
+    auto element = [](const std::string&, uint32_t, const std::string*) -> std::pair<bool, const std::string*> {
+        return {false, nullptr};
+    };
+
+    return umacro::expandMacroTemplate(sTpl, strOut, resolve, element);
+}
+
+int main()
+{
+    LOG_INIT(LOG_FATAL, LOG_FATAL, false, false, false);
+
+    const fs::path dir = fs::temp_directory_path() / "test_validator_macro_templates";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string strScript = (dir / "script.txt").string();
+    std::ofstream(strScript, std::ios::binary | std::ios::trunc) << kScript;
+
+    ScriptEntriesType sEntries;
+    UTEST_CHECK(validate(strScript, sEntries));
+    UTEST_CHECK(sEntries.vCommands.size() == 5U);
+
+    if (sEntries.vCommands.size() == 5U) {
+        std::string strOut;
+
+        // "$$v": literal '$' then the slot bound macro; "$target" must be rescanned
+        const MacroTemplate *pTpl = printTemplate(sEntries, 2U);
+        UTEST_CHECK((pTpl != nullptr) && pTpl->bCompiled && pTpl->bHasMacros);
+        if (pTpl != nullptr) {
+            UTEST_CHECK(pTpl->vSegments.size() == 2U);
+            UTEST_CHECK(isSegment(*pTpl, 0U, MacroSegment::Kind::LITERAL, "$"));
+            UTEST_CHECK(isSegment(*pTpl, 1U, MacroSegment::Kind::MACRO, "v"));
+            UTEST_CHECK(expand(sEntries, *pTpl, strOut));
+            UTEST_CHECK(strOut == "$target");
+
+            // the rescan resolves the reference formed by the expansion
+            std::string strAgain;
+            UTEST_CHECK(!expand(sEntries, umacro::compileMacroTemplate(strOut), strAgain));
+            UTEST_CHECK(strAgain == "reached");
+        }
+
+        // a '$' not directly before the reference is plain text, no rescan
+        pTpl = printTemplate(sEntries, 3U);
+        UTEST_CHECK(pTpl != nullptr);
+        if (pTpl != nullptr) {
+            UTEST_CHECK(pTpl->vSegments.size() == 2U);
+            UTEST_CHECK(isSegment(*pTpl, 0U, MacroSegment::Kind::LITERAL, "cost 5$ "));
+            UTEST_CHECK(isSegment(*pTpl, 1U, MacroSegment::Kind::MACRO, "v"));
+            UTEST_CHECK(!expand(sEntries, *pTpl, strOut));
+            UTEST_CHECK(strOut == "cost 5$ target");
+        }
+
+        // a constant macro is substituted before compiling: "$$KEY" -> "$target"
+        pTpl = printTemplate(sEntries, 4U);
+        UTEST_CHECK(pTpl != nullptr);
+        if (pTpl != nullptr) {
+            UTEST_CHECK(pTpl->vSegments.size() == 1U);
+            UTEST_CHECK(isSegment(*pTpl, 0U, MacroSegment::Kind::MACRO, "target"));
+            UTEST_CHECK((pTpl->vSegments.size() == 1U) && (pTpl->vSegments[0].uVarSlot != kNoSlot));
+            UTEST_CHECK(!expand(sEntries, *pTpl, strOut));
+            UTEST_CHECK(strOut == "reached");
+        }
+    }
+
+    fs::remove_all(dir);
+
+    return utest::result("validator_macro_templates");
+}
@@ -5,6 +5,7 @@
 #include "IScriptReader.hpp"
 #include "IScriptValidator.hpp"
 #include "IScriptInterpreter.hpp"
+#include "IScriptCache.hpp"
 #include "uScriptDataTypes.hpp"
 
 #include "uLogger.hpp"
@@ -50,13 +51,17 @@ public:
      * @param shpScriptReader Script reader component
      * @param shvScriptValidator Script validator component
      * @param shvScriptInterpreter Script interpreter component (Level 1)
+     * @param shpScriptCache Optional cache of the validated entries; on a hit
+     *        reading and validation are skipped
      */
     explicit ScriptRunner( std::shared_ptr<IScriptReader> shpScriptReader,
                            std::shared_ptr<IScriptValidator<TScriptEntries>> shvScriptValidator,
-                           std::shared_ptr<IScriptInterpreter<TScriptEntries>> shvScriptInterpreter )
+                           std::shared_ptr<IScriptInterpreter<TScriptEntries>> shvScriptInterpreter,
+                           std::shared_ptr<IScriptCache<TScriptEntries>> shpScriptCache = nullptr )
         : m_shpScriptReader(std::move(shpScriptReader))
         , m_shpScriptValidator(std::move(shvScriptValidator))
         , m_shpScriptInterpreter(std::move(shvScriptInterpreter))
+        , m_shpScriptCache(std::move(shpScriptCache))
     {}
 
     bool runScript(const char *pstrCallCtx, bool bRealExec, bool bUseDryRun) override
@@ -67,16 +72,22 @@ public:
 
             // validation phase 
             if (!bRealExec) {
-                LOG_PRINT(LOG_FIXED, LOG_HDR; LOG_STRING("Reading"); LOG_STRING(pstrCallCtx));
-                if (false == m_shpScriptReader->readScript(m_vRawScriptLines)) {
-                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Script reading failed"));
-                    break;
-                }
-
-                LOG_PRINT(LOG_FIXED, LOG_HDR; LOG_STRING("Validating"); LOG_STRING(pstrCallCtx));
-                if (false == m_shpScriptValidator->validateScript(m_vRawScriptLines, m_sScriptEntries)) {
-                    LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Script validation failed"));
-                    break;
+                const bool bCacheHit = m_shpScriptCache && m_shpScriptCache->loadScript(m_sScriptEntries);
+
+                if (bCacheHit) {
+                    LOG_PRINT(LOG_FIXED, LOG_HDR; LOG_STRING("Loaded"); LOG_STRING(pstrCallCtx); LOG_STRING("from cache"));
+                } else {
+                    LOG_PRINT(LOG_FIXED, LOG_HDR; LOG_STRING("Reading"); LOG_STRING(pstrCallCtx));
+                    if (false == m_shpScriptReader->readScript(m_vRawScriptLines)) {
+                        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Script reading failed"));
+                        break;
+                    }
+
+                    LOG_PRINT(LOG_FIXED, LOG_HDR; LOG_STRING("Validating"); LOG_STRING(pstrCallCtx));
+                    if (false == m_shpScriptValidator->validateScript(m_vRawScriptLines, m_sScriptEntries)) {
+                        LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Script validation failed"));
+                        break;
+                    }
                 }
 
                 LOG_PRINT(LOG_FIXED, LOG_HDR; LOG_STRING("Dry interpreting"); LOG_STRING(pstrCallCtx));
@@ -85,6 +96,13 @@ public:
                     break;
                 }
 
+                // only entries that passed a complete dry run are cached
+                if (m_shpScriptCache && !bCacheHit) {
+                    if (false == m_shpScriptCache->storeScript(m_sScriptEntries)) {
+                        LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Script cache not updated"));
+                    }
+                }
+
             // execution phase    
             } else {
                 LOG_PRINT(LOG_FIXED, LOG_HDR; LOG_STRING("Interpreting"); LOG_STRING(pstrCallCtx));
@@ -107,6 +125,7 @@ protected:
     std::shared_ptr<IScriptReader> m_shpScriptReader;
     std::shared_ptr<IScriptValidator<TScriptEntries>> m_shpScriptValidator;
     std::shared_ptr<IScriptInterpreter<TScriptEntries>> m_shpScriptInterpreter;
+    std::shared_ptr<IScriptCache<TScriptEntries>> m_shpScriptCache;
 
 private:
 
@@ -162,6 +162,20 @@ inline bool m_isDelay(const std::string& expression)
     return std::regex_match(expression, pattern);
 }
 
+// validate PERIOD <value> <unit>   (unit: us | ms | sec)
+inline bool m_isPeriod(const std::string& expression)
+{
+    static const std::regex pattern(R"(^PERIOD\s+[1-9][0-9]*\s+(us|ms|sec)$)");
+    return std::regex_match(expression, pattern);
+}
+
+// validate DELAY_UNTIL <value> <unit>   (unit: us | ms | sec)
+inline bool m_isDelayUntil(const std::string& expression)
+{
+    static const std::regex pattern(R"(^DELAY_UNTIL\s+[0-9]+\s+(us|ms|sec)$)");
+    return std::regex_match(expression, pattern);
+}
+
 // validate BREAKPOINT [label]
 // A bare BREAKPOINT (no label) or BREAKPOINT followed by any text used
 // as a label.  The label may contain $macros — expanded at runtime.
@@ -171,6 +185,43 @@ inline bool m_isBreakpoint(const std::string& expression)
     return std::regex_match(expression, pattern);
 }
 
+// validate PARALLEL <label>
+inline bool m_isParallel(const std::string& expression)
+{
+    static const std::regex pattern(R"(^PARALLEL\s+[A-Za-z_][A-Za-z0-9_]*$)");
+    return std::regex_match(expression, pattern);
+}
+
+// validate BRANCH (bare keyword, opens the next branch of a PARALLEL block)
+inline bool m_isBranch(const std::string& expression)
+{
+    static const std::regex pattern(R"(^BRANCH$)");
+    return std::regex_match(expression, pattern);
+}
+
+// validate END_PARALLEL <label>
+inline bool m_isEndParallel(const std::string& expression)
+{
+    static const std::regex pattern(R"(^END_PARALLEL\s+[A-Za-z_][A-Za-z0-9_]*$)");
+    return std::regex_match(expression, pattern);
+}
+
+// validate handle ?= ASYNC PLUGIN.COMMAND [params]
+inline bool m_isAsync(const std::string& expression)
+{
+    static const std::regex pattern(
+        R"(^[A-Za-z_][A-Za-z0-9_]*\s*\?=\s*ASYNC\s+[A-Z][A-Z0-9_]*\.[A-Z][A-Z0-9_]*(\s.*)?$)");
+    return std::regex_match(expression, pattern);
+}
+
+// validate AWAIT <handle> [TIMEOUT <value> <unit>]   (unit: us | ms | sec)
+inline bool m_isAwait(const std::string& expression)
+{
+    static const std::regex pattern(
+        R"(^AWAIT\s+[A-Za-z_][A-Za-z0-9_]*(\s+TIMEOUT\s+[1-9][0-9]*\s+(us|ms|sec))?$)");
+    return std::regex_match(expression, pattern);
+}
+
 }; //namespace usyntax
 
 
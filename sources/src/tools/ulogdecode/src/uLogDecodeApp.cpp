@@ -0,0 +1,205 @@
+#include "uArgsParserExt.hpp"
+#include "uLogBinary.hpp"
+#include "uLogger.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////
+//                            LOCAL DEFINITIONS                                //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifdef LT_HDR
+    #undef LT_HDR
+#endif
+#ifdef LOG_HDR
+    #undef LOG_HDR
+#endif
+
+#define LT_HDR     "ULOG_DECODE |"
+#define LOG_HDR    LOG_STRING(LT_HDR)
+
+/*-------------------------------------------------------------------------------
+                             LOCAL TYPES
+-------------------------------------------------------------------------------*/
+
+struct Message {
+    int64_t     iTimeNs;
+    uint32_t    uTid;
+    uint16_t    uSite;
+    LogLevel    eLevel;
+    const char *pPayload;
+    size_t      szLength;
+};
+
+struct Site {
+    std::string strFile;
+    uint32_t    uLine;
+};
+
+/*-------------------------------------------------------------------------------
+                             LOCAL FUNCTIONS
+-------------------------------------------------------------------------------*/
+
+/**
+ * @brief Splits the records of the file into call sites and messages;
+ *        false if the file is not a binary log.
+ */
+static bool parseLog(const std::vector<char>& vFile, ulogbin::FileHeader& sHeader,
+                     std::map<uint16_t, Site>& mSites, std::vector<Message>& vMessages, bool& bComplete)
+{
+    if (vFile.size() < sizeof(ulogbin::FileHeader)) {
+        return false;
+    }
+    std::memcpy(&sHeader, vFile.data(), sizeof(sHeader));
+    if ((0 != std::memcmp(sHeader.magic, ulogbin::MAGIC, sizeof(ulogbin::MAGIC))) ||
+        (sHeader.version != ulogbin::VERSION) || (sHeader.headerSize > vFile.size())) {
+        return false;
+    }
+
+    size_t szPos = sHeader.headerSize;
+    bComplete = true;
+
+    while (szPos + sizeof(ulogbin::RecordHeader) <= vFile.size()) {
+        ulogbin::RecordHeader sRecord;
+        std::memcpy(&sRecord, vFile.data() + szPos, sizeof(sRecord));
+
+        // a record never completed ends the log
+        if ((0U == sRecord.size) || (szPos + sRecord.size > vFile.size()) ||
+            (sizeof(sRecord) + sRecord.length > sRecord.size)) {
+            bComplete = (0U != sHeader.used);
+            break;
+        }
+
+        const char *pPayload = vFile.data() + szPos + sizeof(sRecord);
+        if (sRecord.kind == static_cast<uint8_t>(ulogbin::RecordKind::SITE)) {
+            mSites[sRecord.site] = Site{std::string(pPayload, sRecord.length), sRecord.tid};
+        } else if (sRecord.kind == static_cast<uint8_t>(ulogbin::RecordKind::MESSAGE)) {
+            vMessages.push_back(Message{sRecord.timeNs, sRecord.tid, sRecord.site,
+                                        sizet2loglevel(sRecord.level).value_or(LOG_INFO),
+                                        pPayload, sRecord.length});
+        }
+        szPos += sRecord.size;
+    }
+
+    // records are stored in the order they were reserved, a thread may have
+    // been preempted between taking its time stamp and its reservation
+    std::stable_sort(vMessages.begin(), vMessages.end(), [](const Message& a, const Message& b) {
+        return a.iTimeNs < b.iTimeNs;
+    });
+    return true;
+
+} /* parseLog() */
+
+/*-------------------------------------------------------------------------------
+                             MAIN
+-------------------------------------------------------------------------------*/
+
+int main(int argc, char const *argv[])
+{
+    bool bRetVal = false;
+
+    LOG_INIT(LOG_INFO, LOG_INFO, false, true, false);
+
+    do {
+        CommandLineParser cli("Renders a binary log (LOG_BINARY) to text");
+        cli.add_option("input", "i", "binary log pathname", true);
+        cli.add_option("output", "o", "text log pathname, default: console", false);
+        cli.add_flag("date", "d", "include the date in the time stamps");
+        cli.add_flag("relative", "r", "time stamps in seconds since the log was started");
+        cli.add_flag("thread", "t", "show the thread id of every message");
+        cli.add_flag("site", "s", "show the source location of every message");
+
+        auto result = cli.parse(argc, argv);
+
+        if (!result) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Parsing failed!"));
+            CommandLineParser::print_errors(result);
+            cli.print_usage(argv[0]);
+            break;
+        }
+
+        const std::string strInput  = cli.get_or("input", "");
+        const std::string strOutput = cli.get_or("output", "");
+        const bool bDate   = cli.get_flag("date");
+        const bool bRel    = cli.get_flag("relative");
+        const bool bThread = cli.get_flag("thread");
+        const bool bSite   = cli.get_flag("site");
+
+        std::ifstream ifs(strInput, std::ios::binary);
+        if (!ifs) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Cannot open"); LOG_STRING(strInput));
+            break;
+        }
+        const std::vector<char> vFile((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+        ulogbin::FileHeader sHeader {};
+        std::map<uint16_t, Site> mSites;
+        std::vector<Message> vMessages;
+        bool bComplete = true;
+
+        if (!parseLog(vFile, sHeader, mSites, vMessages, bComplete)) {
+            LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING(strInput); LOG_STRING("is not a binary log"));
+            break;
+        }
+
+        std::ofstream ofs;
+        if (!strOutput.empty()) {
+            ofs.open(strOutput);
+            if (!ofs) {
+                LOG_PRINT(LOG_ERROR, LOG_HDR; LOG_STRING("Cannot create"); LOG_STRING(strOutput));
+                break;
+            }
+        }
+        std::ostream& out = strOutput.empty() ? std::cout : ofs;
+
+        std::string strLine;
+        for (const auto& sMessage : vMessages) {
+            strLine.clear();
+            if (sMessage.eLevel != LOG_EMPTY) {
+                char szTimestamp[LogBuffer::TIMESTAMP_SIZE];
+                strLine.append(szTimestamp, bRel ? LogBuffer::formatRelativeTimestamp(sMessage.iTimeNs, szTimestamp)
+                                                 : LogBuffer::formatWallTimestamp(sHeader.wallOriginUs + (sMessage.iTimeNs / 1000),
+                                                                                  bDate, szTimestamp));
+                strLine.append(toString(sMessage.eLevel));
+                strLine.append(" | ");
+                if (bThread) {
+                    strLine.append(std::to_string(sMessage.uTid));
+                    strLine.append(" | ");
+                }
+                if (bSite) {
+                    const auto it = mSites.find(sMessage.uSite);
+                    strLine.append((it != mSites.end()) ? (std::filesystem::path(it->second.strFile).filename().string() + ":" +
+                                                           std::to_string(it->second.uLine)) : std::string("?"));
+                    strLine.append(" | ");
+                }
+            }
+            if (!ulogbin::decodeArgs(sMessage.pPayload, sMessage.szLength, strLine)) {
+                strLine.append("<malformed>");
+            }
+            strLine.push_back('\n');
+            out << strLine;
+        }
+        out.flush();
+
+        LOG_PRINT(LOG_INFO, LOG_HDR; LOG_STRING("Messages:"); LOG_SIZET(vMessages.size());
+                                     LOG_STRING("call sites:"); LOG_SIZET(mSites.size()));
+        if (sHeader.dropped > 0U) {
+            LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("Messages dropped, the log was full:"); LOG_UINT64(sHeader.dropped));
+        }
+        if (!bComplete) {
+            LOG_PRINT(LOG_WARNING, LOG_HDR; LOG_STRING("The log was not closed, decoded up to the last complete record"));
+        }
+
+        bRetVal = out.good();
+
+    } while(false);
+
+    return (true == bRetVal) ? 0 : 1;
+}